@@ -11,6 +11,7 @@
 #include "stm32l0xx.h"		// Specific Device header
 #include <stdio.h>				// Standard input output
 #include "ADC.h"
+#include "Spin.h"				// Busy wait accounting
 /*-----------------------------------------Functions--------------------------------------------------*/
 
 /**
@@ -29,14 +30,18 @@ void ADC_Init(void){
 	}
 	
 	ADC1->CR |= ADC_CR_ADCAL;
+	SPIN_BEGIN(SPIN_ADC);
 	while((ADC1->ISR & ADC_ISR_EOCAL) == 0);
+	SPIN_END(SPIN_ADC);
 	ADC1->ISR |= ADC_ISR_EOCAL;
 	
 	/* Enable ADC */
 	ADC1->CR |= (1UL << 0);
 	
 	/* Wait for ISR bit to set */
+	SPIN_BEGIN(SPIN_ADC);
 	while((ADC1->ISR & 1) == 0);
+	SPIN_END(SPIN_ADC);
 }
 
 /**
@@ -103,13 +108,17 @@ void Unitialize_ADC(void){
 		ADC1->CR |= ADC_CR_ADSTP;
 	}
 	
+	SPIN_BEGIN(SPIN_ADC);
 	while((ADC1->CR & ADC_CR_ADSTP) != 0){
 		// Wait until conversion is stopped
 	}
+	SPIN_END(SPIN_ADC);
 	
 	/* Disable the ADC */
 	ADC1->CR |= ADC_CR_ADDIS; 
+	SPIN_BEGIN(SPIN_ADC);
 	while((ADC1->CR & ADC_CR_ADEN) != 0){
 		// Wait until ADC is disabled
 	}
+	SPIN_END(SPIN_ADC);
 }
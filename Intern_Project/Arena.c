@@ -0,0 +1,134 @@
+/*------------------------------------------------------------------------------------------------------
+ * Name:    Arena.c
+ * Purpose: Named regions of one static RAM arena and stack high water
+ * Date: 		10/19/26
+ * Author:	Christopher Jordan - Denny
+ *------------------------------------------------------------------------------------------------------
+ * Note(s): Large buffers are claimed from one static arena at initialization instead of each module
+						keeping its own array, so the RAM they take is one number that is checked when it is
+						built and printed by name at run time.
+						*	Regions are never given back, Arena_Alloc is only called while initializing
+						*	Sizes are word aligned
+						*	The sizes are in Arena.h, the build fails if they add up to more than ARENA_BUDGET
+						*	The stack is painted with ARENA_STACK_PAINT early in main. The deepest word that
+							no longer holds the paint is the most stack ever used, interrupts included.
+ *----------------------------------------------------------------------------------------------------*/
+
+/*---------------------------------------------Include Statements-------------------------------------*/
+#include <stdio.h>										// Printf
+#include "stm32l0xx.h"								// __get_MSP
+#include "Arena.h"
+/*---------------------------------------------Definitions--------------------------------------------*/
+#define STACK_MARGIN							8						// Words below the stack pointer left alone when painting
+
+/* Build fails here when the regions don't fit */
+typedef char Arena_Fits_Budget[(ARENA_SIZE <= ARENA_BUDGET) ? 1 : -1];
+/*---------------------------------------------Linker Symbols-----------------------------------------*/
+/* The STACK section of the startup file */
+extern uint32_t STACK$$Base;
+extern uint32_t STACK$$Limit;
+/*---------------------------------------------Globals------------------------------------------------*/
+uint32_t				Arena_Memory[ARENA_SIZE/4];									/* Words, so every region is aligned */
+int							Arena_Used = 0;															/* Bytes handed out */
+Arena_Region		Regions_Claimed[ARENA_MAX_REGIONS];
+int							Region_Count = 0;
+/*---------------------------------------------Functions----------------------------------------------*/
+
+/**
+  \fn					void* Arena_Alloc(const char* Name, int Size)
+  \brief			Claims a region of the arena for good
+	\param			const char* Name: Shown by Arena_Report
+	\param			int Size: Bytes, rounded up to a word
+	\returns		void*: The region, zeroed, or 0 if the arena is full
+*/
+
+void* Arena_Alloc(const char* Name, int Size){
+	
+	uint8_t* Base;
+	
+	Size = (Size + 3) & ~3;
+	if(((Arena_Used + Size) > ARENA_SIZE) || (Region_Count >= ARENA_MAX_REGIONS)){
+		return(0);
+	}
+	
+	Base = (uint8_t*)Arena_Memory + Arena_Used;
+	Arena_Used += Size;
+	
+	Regions_Claimed[Region_Count].Name = Name;
+	Regions_Claimed[Region_Count].Base = Base;
+	Regions_Claimed[Region_Count].Size = (uint16_t)Size;
+	Region_Count++;
+	
+	return(Base);
+}
+
+/**
+  \fn					int Arena_Free_Bytes(void)
+  \brief			Bytes of the arena nobody has claimed
+	\returns		int: Bytes
+*/
+
+int Arena_Free_Bytes(void){
+	
+	return(ARENA_SIZE - Arena_Used);
+}
+
+/**
+  \fn					void Arena_Paint_Stack(void)
+  \brief			Fills the unused part of the stack with ARENA_STACK_PAINT, call once early in main
+*/
+
+void Arena_Paint_Stack(void){
+	
+	volatile uint32_t* Word = &STACK$$Base;
+	uint32_t* End = (uint32_t*)__get_MSP() - STACK_MARGIN;
+	
+	while(Word < End){
+		*Word = ARENA_STACK_PAINT;
+		Word++;
+	}
+}
+
+/**
+  \fn					int Arena_Stack_Used(void)
+  \brief			Most stack used since Arena_Paint_Stack
+	\returns		int: Bytes
+*/
+
+int Arena_Stack_Used(void){
+	
+	const volatile uint32_t* Word = &STACK$$Base;
+	
+	while((Word < &STACK$$Limit) && (*Word == ARENA_STACK_PAINT)){
+		Word++;
+	}
+	
+	return((int)((const volatile uint8_t*)&STACK$$Limit - (const volatile uint8_t*)Word));
+}
+
+/**
+  \fn					int Arena_Stack_Size(void)
+  \brief			Size of the stack in the startup file
+	\returns		int: Bytes
+*/
+
+int Arena_Stack_Size(void){
+	
+	return((int)((uint8_t*)&STACK$$Limit - (uint8_t*)&STACK$$Base));
+}
+
+/**
+  \fn					void Arena_Report(void)
+  \brief			Prints every region and the stack high water to the serial monitor
+*/
+
+void Arena_Report(void){
+	
+	int i = 0;
+	
+	printf("Arena %d of %d bytes, %d free\r\n",Arena_Used,ARENA_SIZE,Arena_Free_Bytes());
+	for(i = 0;i < Region_Count;i++){
+		printf("  %-10s %4u\r\n",Regions_Claimed[i].Name,(unsigned int)Regions_Claimed[i].Size);
+	}
+	printf("Stack %d of %d bytes\r\n",Arena_Stack_Used(),Arena_Stack_Size());
+}
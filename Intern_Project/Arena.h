@@ -0,0 +1,47 @@
+/*------------------------------------------------------------------------------------------------------
+ * Name:    Arena.h
+ * Purpose: Named regions of one static RAM arena and stack high water
+ * Date: 		10/19/26
+ * Author:	Christopher Jordan - Denny
+ *------------------------------------------------------------------------------------------------------
+ * Note(s): See C file
+ *----------------------------------------------------------------------------------------------------*/
+
+/*-----------------------------------------Include Statements-----------------------------------------*/
+#include <stdint.h>
+
+#ifndef ARENA_H
+#define ARENA_H
+
+/*-----------------------------------------Region Sizes-----------------------------------------------*/
+/* Every region claimed with Arena_Alloc is listed here, so the size is known at build time */
+#define ARENA_NMEA_LINE						128					// Sentence being received by USART1
+#define ARENA_NMEA_MESSAGE				128					// Last GGA and last RMC sentence, one each
+#define ARENA_NMEA_COPY						128					// Sentence being split into fields
+#define ARENA_FLASH_LOG						512					// FLASH_LOG_BUFFER, page filling and page programming
+#define ARENA_XBEE_LINE						36					// AT reply being received and the last whole one, one each
+#define ARENA_FREE								0						// Not claimed yet
+
+#define ARENA_SIZE								(ARENA_NMEA_LINE + 2*ARENA_NMEA_MESSAGE + ARENA_NMEA_COPY + ARENA_FLASH_LOG + \
+																	2*ARENA_XBEE_LINE + ARENA_FREE)
+#define ARENA_BUDGET							1096				// Bytes of the 8 KB RAM given to the arena
+#define ARENA_MAX_REGIONS					8
+
+#define ARENA_STACK_PAINT					0xA5A5A5A5UL	// Stack words nothing has written yet
+
+/* One claimed region */
+typedef struct Arena_Region
+{
+	const char* Name;
+	uint8_t* Base;
+	uint16_t Size;
+}Arena_Region;
+
+extern void* Arena_Alloc(const char* Name, int Size);
+extern int Arena_Free_Bytes(void);
+extern void Arena_Paint_Stack(void);
+extern int Arena_Stack_Used(void);
+extern int Arena_Stack_Size(void);
+extern void Arena_Report(void);
+
+#endif
@@ -0,0 +1,121 @@
+/*------------------------------------------------------------------------------------------------------
+ * Name:    Deploy.c
+ * Purpose: Parachute deployment task
+ * Date: 		10/19/26
+ * Author:	Christopher Jordan - Denny
+ *------------------------------------------------------------------------------------------------------
+ * Note(s): The uplink (PendSV) and the backup timer (SysTick) move the servo themselves through
+						Deploy_Request, it is only TIM22 and GPIOC register writes, so the parachute never waits
+						behind whatever task is running. Only the event is left to the deploy task so no
+						interrupt waits on the event window. The request bit is the TELEMETRY_DEPLOY source.
+						Each request is timed from the command's last byte or the timer running out to the servo
+						write and checked against DEPLOY_BUDGET, 'd' on the console prints the times. The servo
+						pulse itself follows at TIM22's next period.
+ *----------------------------------------------------------------------------------------------------*/
+
+/*---------------------------------------------Include Statements-------------------------------------*/
+#include "stm32l053xx.h"							// Specific Device Header
+#include <stdio.h>										// Printf
+#include "Deploy.h"
+#include "Scheduler.h"								// Deploy task
+#include "Events.h"										// Deployment event
+#include "Timing.h"										// msTicks, Timing_Microseconds
+#include "PWM.h"											// Parachute servo
+/*---------------------------------------------Globals------------------------------------------------*/
+int			Deploy_Task = -1;
+int			Deployed = 0;																		/* Source bits that have fired */
+Deploy_Stats	Deploy;
+/*---------------------------------------------Functions----------------------------------------------*/
+
+/**
+  \fn					void Deploy_Run(uint8_t Events)
+  \brief			Reports the deployment, Deploy_Request has already moved the servo
+	\param			uint8_t Events: Bit n set for TELEMETRY_DEPLOY source n
+*/
+
+static void Deploy_Run(uint8_t Events){
+	
+	uint8_t Source = 0;
+	
+	for(Source = 0;Source < 7;Source++){
+		if((Events & (1 << Source)) == 0){
+			continue;
+		}
+		
+		/* A repeated command drives the servo again but is only reported once */
+		if((Deployed & (1 << Source)) == 0){
+			Events_Post(TELEMETRY_EVENT_DEPLOY,Source,msTicks);
+			Deployed |= (1 << Source);
+		}
+	}
+}
+
+/**
+  \fn					void Deploy_Init(void)
+  \brief			Adds the deploy task, it only runs on requests
+*/
+
+void Deploy_Init(void){
+	Deploy_Task = Scheduler_Add("Deploy",Deploy_Run,0);
+}
+
+/**
+  \fn					void Deploy_Request(uint8_t Source, uint32_t Requested)
+  \brief			Moves the servo now and asks the deploy task to report it, safe in interrupts
+	\param			uint8_t Source: TELEMETRY_DEPLOY source
+	\param			uint32_t Requested: Timing_Microseconds when the command's last byte came in or the
+							timer ran out
+*/
+
+void Deploy_Request(uint8_t Source, uint32_t Requested){
+	
+	/* Local Variables */
+	uint32_t Mask = __get_PRIMASK();
+	uint32_t Latency = 0;
+	
+	/* SysTick can land in the middle of the uplink's request */
+	__disable_irq();
+	Servo_Position((Source == TELEMETRY_DEPLOY_TIMER) ? DEPLOY_TIMER_ANGLE : DEPLOY_UPLINK_ANGLE);
+	Latency = Timing_Microseconds() - Requested;
+	Deploy.Requests++;
+	Deploy.Last_Latency = Latency;
+	if(Latency > Deploy.Max_Latency){
+		Deploy.Max_Latency = Latency;
+	}
+	if(Latency > DEPLOY_BUDGET){
+		Deploy.Over_Budget++;
+	}
+	__set_PRIMASK(Mask);
+	
+	Scheduler_Post(Deploy_Task,(uint8_t)(1 << Source));
+}
+
+/**
+  \fn					int Deploy_Get_State(void)
+  \brief			Which sources have deployed the parachute
+	\returns		int: Bit n set once TELEMETRY_DEPLOY source n has fired
+*/
+
+int Deploy_Get_State(void){
+	return(Deployed);
+}
+
+/**
+  \fn					void Deploy_Report(void)
+  \brief			Prints the request to servo times on the serial monitor
+*/
+
+void Deploy_Report(void){
+	
+	/* Local Variables */
+	Deploy_Stats Copy;
+	uint32_t Mask = __get_PRIMASK();
+	
+	__disable_irq();
+	Copy = Deploy;
+	__set_PRIMASK(Mask);
+	
+	printf("Deploy: %lu requests, sources 0x%02X, request to servo %lu us (max %lu us, %lu over %u us)\r\n",
+		(unsigned long)Copy.Requests,(unsigned int)Deployed,(unsigned long)Copy.Last_Latency,
+		(unsigned long)Copy.Max_Latency,(unsigned long)Copy.Over_Budget,(unsigned int)DEPLOY_BUDGET);
+}
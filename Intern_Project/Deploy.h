@@ -0,0 +1,35 @@
+/*------------------------------------------------------------------------------------------------------
+ * Name:    Deploy.h
+ * Purpose: Parachute deployment task
+ * Date: 		10/19/26
+ * Author:	Christopher Jordan - Denny
+ *------------------------------------------------------------------------------------------------------
+ * Note(s):
+ *----------------------------------------------------------------------------------------------------*/
+
+/*-----------------------------------------Include Statements-----------------------------------------*/
+#include <stdint.h>
+
+#ifndef DEPLOY_H
+#define DEPLOY_H
+
+/*-----------------------------------------Definitions------------------------------------------------*/
+#define DEPLOY_UPLINK_ANGLE				180						// Servo degrees for a ground station command
+#define DEPLOY_TIMER_ANGLE				170						// Servo degrees for the backup timer
+#define DEPLOY_BUDGET							1000					// us from the request to the servo write
+
+/* Request to servo timing */
+typedef struct Deploy_Stats
+{
+	uint32_t Requests;
+	uint32_t Last_Latency;							/* us from the command's last byte or the timer to the servo */
+	uint32_t Max_Latency;
+	uint32_t Over_Budget;								/* Requests that took longer than DEPLOY_BUDGET */
+}Deploy_Stats;
+
+extern void Deploy_Init(void);
+extern void Deploy_Request(uint8_t Source, uint32_t Requested);
+extern int Deploy_Get_State(void);
+extern void Deploy_Report(void);
+
+#endif
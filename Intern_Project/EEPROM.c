@@ -0,0 +1,157 @@
+/*------------------------------------------------------------------------------------------------------
+ * Name:    EEPROM.c
+ * Purpose: Reads and writes the STM32L053 data EEPROM
+ * Date: 		10/19/26
+ * Author:	Christopher Jordan - Denny
+ *------------------------------------------------------------------------------------------------------
+ * Note(s): The data EEPROM is memory mapped, so reads are plain loads. Writes need the PECR
+						register unlocked with the two PEKEY values and take about 3.2 ms per word, during
+						which the CPU stalls if it fetches from flash. Words that already hold the value
+						being written are skipped to save time and endurance (100k cycles).
+ *----------------------------------------------------------------------------------------------------*/
+
+/*---------------------------------------------Include Statements-------------------------------------*/
+#include "stm32l053xx.h"									// Specific Device header
+#include "EEPROM.h"
+#include "Spin.h"										// Busy wait accounting
+/*---------------------------------------------Definitions--------------------------------------------*/
+#define EEPROM_BASE_ADDRESS			0x08080000				// Start of the data EEPROM
+#define PEKEY1									0x89ABCDEF				// First key to unlock PECR
+#define PEKEY2									0x02030405				// Second key to unlock PECR
+#define TRUE										0x1
+#define FALSE										0x0
+/*---------------------------------------------Functions----------------------------------------------*/
+
+/**
+  \fn					void EEPROM_Unlock(void)
+  \brief			Unlocks the data EEPROM for writing
+*/
+
+void EEPROM_Unlock(void){
+	
+	/* Wait for any ongoing operation */
+	SPIN_BEGIN(SPIN_EEPROM);
+	while((FLASH->SR & FLASH_SR_BSY) != 0){
+		//Nop
+	}
+	SPIN_END(SPIN_EEPROM);
+	
+	/* Write the key sequence if locked */
+	if((FLASH->PECR & FLASH_PECR_PELOCK) != 0){
+		FLASH->PEKEYR = PEKEY1;
+		FLASH->PEKEYR = PEKEY2;
+	}
+}
+
+/**
+  \fn					void EEPROM_Lock(void)
+  \brief			Locks the data EEPROM against writing
+*/
+
+void EEPROM_Lock(void){
+	
+	/* Wait for any ongoing operation */
+	SPIN_BEGIN(SPIN_EEPROM);
+	while((FLASH->SR & FLASH_SR_BSY) != 0){
+		//Nop
+	}
+	SPIN_END(SPIN_EEPROM);
+	
+	FLASH->PECR |= FLASH_PECR_PELOCK;
+}
+
+/**
+  \fn					uint32_t EEPROM_Read_Word(uint32_t Offset)
+  \brief			Reads one word from the data EEPROM
+	\param			uint32_t Offset: Byte offset from the start of the EEPROM, word aligned
+	\returns		uint32_t: The word stored at the offset
+*/
+
+uint32_t EEPROM_Read_Word(uint32_t Offset){
+	return(*(volatile uint32_t*)(EEPROM_BASE_ADDRESS + Offset));
+}
+
+/**
+  \fn					uint8_t EEPROM_Write_Word(uint32_t Offset, uint32_t Data)
+  \brief			Writes one word to the data EEPROM, EEPROM must be unlocked
+	\param			uint32_t Offset: Byte offset from the start of the EEPROM, word aligned
+	\param			uint32_t Data: The word to write
+	\returns		uint8_t: 1 - Write succeeded, 0 - Write failed
+*/
+
+uint8_t EEPROM_Write_Word(uint32_t Offset, uint32_t Data){
+	
+	/* Check the address is within the EEPROM */
+	if((Offset & 0x3) || (Offset >= EEPROM_SIZE)){
+		return(FALSE);
+	}
+	
+	/* Nothing to do if the value is already there */
+	if(EEPROM_Read_Word(Offset) == Data){
+		return(TRUE);
+	}
+	
+	/* Write the word, the EEPROM erases it automatically */
+	*(volatile uint32_t*)(EEPROM_BASE_ADDRESS + Offset) = Data;
+	
+	/* Wait for the write to complete */
+	SPIN_BEGIN(SPIN_EEPROM);
+	while((FLASH->SR & FLASH_SR_BSY) != 0){
+		//Nop
+	}
+	SPIN_END(SPIN_EEPROM);
+	
+	/* Check for end of programming */
+	if((FLASH->SR & FLASH_SR_EOP) == 0){
+		return(FALSE);
+	}
+	
+	/* Clear EOP by writing 1 */
+	FLASH->SR = FLASH_SR_EOP;
+	
+	return(TRUE);
+}
+
+/**
+  \fn					void EEPROM_Read_Buffer(uint32_t Offset, void* Data, uint32_t Length)
+  \brief			Reads a block of words from the data EEPROM
+	\param			uint32_t Offset: Byte offset from the start of the EEPROM, word aligned
+	\param			void* Data: Destination, word aligned
+	\param			uint32_t Length: Number of bytes to read, multiple of 4
+*/
+
+void EEPROM_Read_Buffer(uint32_t Offset, void* Data, uint32_t Length){
+	
+	uint32_t* Destination = (uint32_t*)Data;
+	uint32_t i = 0;
+	
+	for(i = 0;i < Length;i += 4){
+		*Destination++ = EEPROM_Read_Word(Offset + i);
+	}
+}
+
+/**
+  \fn					uint8_t EEPROM_Write_Buffer(uint32_t Offset, const void* Data, uint32_t Length)
+  \brief			Writes a block of words to the data EEPROM, handles the lock itself
+	\param			uint32_t Offset: Byte offset from the start of the EEPROM, word aligned
+	\param			const void* Data: Source, word aligned
+	\param			uint32_t Length: Number of bytes to write, multiple of 4
+	\returns		uint8_t: 1 - Write succeeded, 0 - Write failed
+*/
+
+uint8_t EEPROM_Write_Buffer(uint32_t Offset, const void* Data, uint32_t Length){
+	
+	const uint32_t* Source = (const uint32_t*)Data;
+	uint32_t i = 0;
+	uint8_t Success = TRUE;
+	
+	EEPROM_Unlock();
+	
+	for(i = 0;(i < Length) && Success;i += 4){
+		Success = EEPROM_Write_Word(Offset + i,*Source++);
+	}
+	
+	EEPROM_Lock();
+	
+	return(Success);
+}
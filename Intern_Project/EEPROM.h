@@ -0,0 +1,29 @@
+/*------------------------------------------------------------------------------------------------------
+ * Name:    EEPROM.h
+ * Purpose: Reads and writes the STM32L053 data EEPROM
+ * Date: 		10/19/26
+ * Author:	Christopher Jordan - Denny
+ *------------------------------------------------------------------------------------------------------
+ * Note(s): See C file for further discription
+ *----------------------------------------------------------------------------------------------------*/
+
+/*-----------------------------------------Include Statements-----------------------------------------*/
+#include "stm32l053xx.h"
+
+#ifndef EEPROM_H
+#define EEPROM_H
+
+/*-----------------------------------------Memory Map-------------------------------------------------*/
+/* Offsets from the start of the data EEPROM, each block is word aligned */
+#define EEPROM_SIZE									2048				// 2 Kbytes of data EEPROM on the L053
+#define EEPROM_GPS_FIX_OFFSET				0x000				// Last known GPS fix, see GPS_Last_Fix
+#define EEPROM_XBEE_CONFIG_OFFSET		0x040				// Hash of the last XBee settings applied
+
+extern void EEPROM_Unlock(void);
+extern void EEPROM_Lock(void);
+extern uint32_t EEPROM_Read_Word(uint32_t Offset);
+extern uint8_t EEPROM_Write_Word(uint32_t Offset, uint32_t Data);
+extern void EEPROM_Read_Buffer(uint32_t Offset, void* Data, uint32_t Length);
+extern uint8_t EEPROM_Write_Buffer(uint32_t Offset, const void* Data, uint32_t Length);
+
+#endif
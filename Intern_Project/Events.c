@@ -0,0 +1,264 @@
+/*------------------------------------------------------------------------------------------------------
+ * Name:    Events.c
+ * Purpose: Reliable, selectively repeated delivery of critical events to the ground station
+ * Date: 		10/19/26
+ * Author:	Christopher Jordan - Denny
+ *------------------------------------------------------------------------------------------------------
+ * Note(s): Deployment, apogee and faults can't be lost the way a telemetry frame can, so they go out
+						as TELEMETRY_TYPE_EVENT frames and are sent again until the ground station
+						acknowledges them. Events_Poll hands back at most one frame a call, so events slot in
+						between telemetry frames and never hold them up.
+						
+						Acknowledgement:
+						----------------
+						*	Every event gets the next 8 bit sequence and up to EVENTS_WINDOW may be unacknowledged
+						*	The ground station answers with UPLINK_EVENT_ACK: Expected is the first sequence it
+							is missing, every earlier one has arrived. Bit i of Received means Expected + 1 + i
+							arrived too
+						*	Only the events that are still missing are sent again, each on its own timer starting
+							at EVENTS_TIMEOUT and doubling up to EVENTS_MAX_TIMEOUT
+						*	Events are never given up on, a full window drops new faults instead
+						*	Faults can't take the last EVENTS_RESERVED slots. Deployment is posted once per
+							TELEMETRY_DEPLOY source and apogee once, so a fault storm or a dead link can never
+							keep them out of the window
+						
+						Events_Post may be called from interrupts, Events_Ack runs in PendSV and Events_Poll
+						in the main loop, so the window is only touched with interrupts off.
+ *----------------------------------------------------------------------------------------------------*/
+
+/*---------------------------------------------Include Statements-------------------------------------*/
+#include "stm32l053xx.h"							// Specific Device Header
+#include <string.h>										// memset
+#include "Events.h"
+/*---------------------------------------------Definitions--------------------------------------------*/
+/* One event waiting for its ACK */
+typedef struct Events_Slot
+{
+	Telemetry_Event Event;
+	uint32_t Next_Send;																/* msTicks of the next transmission */
+	uint16_t Timeout;																	/* ms until the one after */
+	uint8_t Transmissions;
+	uint8_t Acked;
+}Events_Slot;
+/*---------------------------------------------Globals------------------------------------------------*/
+Events_Slot				Window[EVENTS_WINDOW];
+uint8_t						Window_Base = 0;												/* Oldest unacknowledged sequence */
+uint8_t						Next_Sequence = 0;
+Events_Stats			Events;
+/*---------------------------------------------Functions----------------------------------------------*/
+
+/**
+  \fn					int Events_Critical(uint8_t Type)
+  \brief			Whether an event may use the reserved slots
+*/
+
+static int Events_Critical(uint8_t Type){
+	return((Type == TELEMETRY_EVENT_DEPLOY) || (Type == TELEMETRY_EVENT_APOGEE));
+}
+
+/**
+  \fn					void Events_Init(void)
+  \brief			Empties the window and clears the counters
+*/
+
+void Events_Init(void){
+	
+	uint32_t Mask = __get_PRIMASK();
+	
+	__disable_irq();
+	Window_Base = 0;
+	Next_Sequence = 0;
+	memset(&Events,0,sizeof(Events));
+	__set_PRIMASK(Mask);
+}
+
+/**
+  \fn					int Events_Post(uint8_t Type, int32_t Value, uint32_t Now)
+  \brief			Queues an event for the ground station, safe in interrupts
+	\param			uint8_t Type: TELEMETRY_EVENT type
+	\param			int32_t Value: Depends on the type
+	\param			uint32_t Now: msTicks
+	\returns		int: 1 if queued, 0 if a fault found its part of the window full
+*/
+
+int Events_Post(uint8_t Type, int32_t Value, uint32_t Now){
+	
+	/* Local Variables */
+	uint32_t Mask = __get_PRIMASK();
+	Events_Slot* Slot;
+	int Limit = Events_Critical(Type) ? EVENTS_WINDOW : (EVENTS_WINDOW - EVENTS_RESERVED);
+	int Queued = 0;
+	
+	__disable_irq();
+	
+	Events.Posted++;
+	if((uint8_t)(Next_Sequence - Window_Base) < Limit){
+		Slot = &Window[Next_Sequence & (EVENTS_WINDOW - 1)];
+		Slot->Event.Sequence = Next_Sequence++;
+		Slot->Event.Type = Type;
+		Slot->Event.Timestamp = Now;
+		Slot->Event.Value = Value;
+		Slot->Next_Send = Now;
+		Slot->Timeout = EVENTS_TIMEOUT;
+		Slot->Transmissions = 0;
+		Slot->Acked = 0;
+		Queued = 1;
+	}
+	else{
+		Events.Dropped++;
+	}
+	
+	__set_PRIMASK(Mask);
+	
+	return(Queued);
+}
+
+/**
+  \fn					int Events_Poll(uint32_t Now, uint8_t* Frame)
+  \brief			Slides the window past acknowledged events and builds the next frame that is due,
+							oldest first
+	\param			uint32_t Now: msTicks
+	\param			uint8_t* Frame: At least TELEMETRY_MAX_FRAME bytes
+	\returns		int: Frame length to send, 0 if nothing is due
+*/
+
+int Events_Poll(uint32_t Now, uint8_t* Frame){
+	
+	/* Local Variables */
+	uint32_t Mask = __get_PRIMASK();
+	Telemetry_Event Event;
+	Events_Slot* Slot;
+	uint8_t Sequence = 0;
+	int Due = 0;
+	
+	__disable_irq();
+	
+	while((Window_Base != Next_Sequence) && Window[Window_Base & (EVENTS_WINDOW - 1)].Acked){
+		Window_Base++;
+	}
+	
+	for(Sequence = Window_Base;Sequence != Next_Sequence;Sequence++){
+		Slot = &Window[Sequence & (EVENTS_WINDOW - 1)];
+		if((Slot->Acked == 0) && ((int32_t)(Now - Slot->Next_Send) >= 0)){
+			
+			if(Slot->Transmissions == 0){
+				Events.Sent++;
+			}
+			else{
+				Events.Retransmissions++;
+			}
+			if(Slot->Transmissions < 255){
+				Slot->Transmissions++;
+			}
+			
+			/* Back off so a dead link doesn't crowd out the telemetry */
+			Slot->Next_Send = Now + Slot->Timeout;
+			if(Slot->Timeout < EVENTS_MAX_TIMEOUT){
+				Slot->Timeout *= 2;
+			}
+			
+			Event = Slot->Event;
+			Due = 1;
+			break;
+		}
+	}
+	
+	__set_PRIMASK(Mask);
+	
+	if(Due == 0){
+		return(0);
+	}
+	
+	return(Telemetry_Encode_Event(&Event,Frame));
+}
+
+/**
+  \fn					void Events_Acknowledge(Events_Slot* Slot, uint32_t Now)
+  \brief			Marks one event delivered, interrupts already off
+*/
+
+static void Events_Acknowledge(Events_Slot* Slot, uint32_t Now){
+	
+	uint32_t Latency = 0;
+	
+	if(Slot->Acked){
+		return;
+	}
+	
+	Slot->Acked = 1;
+	Events.Acked++;
+	
+	Latency = Now - Slot->Event.Timestamp;
+	Events.Last_Latency = Latency;
+	if(Latency > Events.Max_Latency){
+		Events.Max_Latency = Latency;
+	}
+}
+
+/**
+  \fn					void Events_Ack(uint8_t Expected, uint8_t Received, uint32_t Now)
+  \brief			Applies a selective ACK from the ground station
+	\param			uint8_t Expected: First sequence the ground station is missing
+	\param			uint8_t Received: Bit i set if Expected + 1 + i arrived
+	\param			uint32_t Now: msTicks
+*/
+
+void Events_Ack(uint8_t Expected, uint8_t Received, uint32_t Now){
+	
+	/* Local Variables */
+	uint32_t Mask = __get_PRIMASK();
+	uint8_t Cumulative = 0;
+	uint8_t Offset = 0;
+	uint8_t Sequence = 0;
+	
+	__disable_irq();
+	
+	/* A late ACK from before the window only counts for its bitmap */
+	Cumulative = (uint8_t)(Expected - Window_Base);
+	if(Cumulative > (uint8_t)(Next_Sequence - Window_Base)){
+		Cumulative = 0;
+	}
+	
+	for(Sequence = Window_Base;Sequence != Next_Sequence;Sequence++){
+		Offset = (uint8_t)(Sequence - Expected);
+		if(((uint8_t)(Sequence - Window_Base) < Cumulative) ||
+			((Offset >= 1) && (Offset <= 8) && (Received & (1 << (Offset - 1))))){
+			Events_Acknowledge(&Window[Sequence & (EVENTS_WINDOW - 1)],Now);
+		}
+	}
+	
+	__set_PRIMASK(Mask);
+}
+
+/**
+  \fn					int Events_Pending(void)
+  \brief			Events still waiting for an ACK
+	\returns		int: Number of events
+*/
+
+int Events_Pending(void){
+	
+	int Pending = 0;
+	uint8_t Sequence = 0;
+	uint32_t Mask = __get_PRIMASK();
+	
+	__disable_irq();
+	for(Sequence = Window_Base;Sequence != Next_Sequence;Sequence++){
+		if(Window[Sequence & (EVENTS_WINDOW - 1)].Acked == 0){
+			Pending++;
+		}
+	}
+	__set_PRIMASK(Mask);
+	
+	return(Pending);
+}
+
+/**
+  \fn					Events_Stats* Events_Get_Stats(void)
+  \brief			Retrieves the delivery counters and ACK latency
+	\returns		Events_Stats*: The counters
+*/
+
+Events_Stats* Events_Get_Stats(void){
+	return(&Events);
+}
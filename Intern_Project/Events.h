@@ -0,0 +1,42 @@
+/*------------------------------------------------------------------------------------------------------
+ * Name:    Events.h
+ * Purpose: Reliable, selectively repeated delivery of critical events to the ground station
+ * Date: 		10/19/26
+ * Author:	Christopher Jordan - Denny
+ *------------------------------------------------------------------------------------------------------
+ * Note(s): See C file for the acknowledgement scheme
+ *----------------------------------------------------------------------------------------------------*/
+
+/*-----------------------------------------Include Statements-----------------------------------------*/
+#include <stdint.h>
+#include "Telemetry.h"
+
+#ifndef EVENTS_H
+#define EVENTS_H
+
+/*-----------------------------------------Definitions------------------------------------------------*/
+#define EVENTS_WINDOW							8							// Events waiting for an ACK, a power of 2
+#define EVENTS_TIMEOUT						300						// ms before the first retransmission
+#define EVENTS_MAX_TIMEOUT				2400					// Backoff stops doubling here
+#define EVENTS_RESERVED						3							// Window slots only deployment and apogee may take
+
+/* Delivery counters */
+typedef struct Events_Stats
+{
+	uint32_t Posted;
+	uint32_t Dropped;										/* Faults posted with their part of the window full */
+	uint32_t Sent;											/* First transmissions */
+	uint32_t Retransmissions;
+	uint32_t Acked;
+	uint32_t Last_Latency;							/* ms from posting to the ACK */
+	uint32_t Max_Latency;
+}Events_Stats;
+
+extern void Events_Init(void);
+extern int Events_Post(uint8_t Type, int32_t Value, uint32_t Now);
+extern int Events_Poll(uint32_t Now, uint8_t* Frame);
+extern void Events_Ack(uint8_t Expected, uint8_t Received, uint32_t Now);
+extern int Events_Pending(void);
+extern Events_Stats* Events_Get_Stats(void);
+
+#endif
@@ -0,0 +1,104 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "Events.h"
+#include "Telemetry.h"
+#include "Serial.h"
+#include "Events_Test.h"
+
+#define EVENT_COUNT					40							// Events per run
+#define EVENT_SPACING				250							// ms between events
+#define STEP								10							// ms per simulated main loop
+#define RUN_LIMIT						60000						// ms before a run gives up
+
+/**
+  \fn					void Lossy_Link(int Loss)
+  \brief			Runs the events through a simulated link that loses Loss % of the event frames and
+							Loss % of the ACKs, the ground station side ACKs every frame it gets
+	\param			int Loss: % of frames lost each way
+*/
+
+static void Lossy_Link(int Loss){
+	
+	/* Local Variables */
+	uint8_t Frame[TELEMETRY_MAX_FRAME];
+	uint8_t Arrived[256];
+	Telemetry_Event Event;
+	Events_Stats* Stats = Events_Get_Stats();
+	uint32_t Now = 0;
+	uint32_t Latency = 0;
+	uint32_t Latency_Max = 0;
+	uint32_t Latency_Sum = 0;
+	uint8_t Expected = 0;
+	uint8_t Received = 0;
+	int Posted = 0;
+	int Delivered = 0;
+	int Length = 0;
+	int i = 0;
+	
+	Events_Init();
+	memset(Arrived,0,sizeof(Arrived));
+	
+	for(Now = 0;(Now < RUN_LIMIT) && ((Posted < EVENT_COUNT) || (Events_Pending() != 0));Now += STEP){
+		
+		if((Posted < EVENT_COUNT) && (Now >= (uint32_t)(Posted*EVENT_SPACING))){
+			Events_Post(TELEMETRY_EVENT_FAULT,Posted,Now);
+			Posted++;
+		}
+		
+		Length = Events_Poll(Now,Frame);
+		if((Length == 0) || ((rand() % 100) < Loss)){
+			continue;
+		}
+		
+		/* Ground station */
+		if(Telemetry_Decode_Event(Frame,Length,&Event) != TELEMETRY_OK){
+			continue;
+		}
+		if(Arrived[Event.Sequence] == 0){
+			Arrived[Event.Sequence] = 1;
+			Delivered++;
+			Latency = Now - Event.Timestamp;
+			Latency_Sum += Latency;
+			if(Latency > Latency_Max){
+				Latency_Max = Latency;
+			}
+		}
+		while(Arrived[Expected]){
+			Expected++;
+		}
+		Received = 0;
+		for(i = 0;i < 8;i++){
+			if(Arrived[(uint8_t)(Expected + 1 + i)]){
+				Received |= (uint8_t)(1 << i);
+			}
+		}
+		
+		if((rand() % 100) >= Loss){
+			Events_Ack(Expected,Received,Now);
+		}
+	}
+	
+	printf("Loss %i%%: %i/%i delivered, %u dropped, %u sent, %u resent\r\n",Loss,Delivered,EVENT_COUNT,
+		(unsigned int)Stats->Dropped,(unsigned int)Stats->Sent,(unsigned int)Stats->Retransmissions);
+	printf("  Delivery: %u ms mean, %u ms max, ACK: %u ms max\r\n",
+		(unsigned int)((Delivered != 0) ? (Latency_Sum/Delivered) : 0),(unsigned int)Latency_Max,
+		(unsigned int)Stats->Max_Latency);
+}
+
+/**
+  \fn					void Events_Test_Code(void)
+  \brief			Measures event latency and retransmissions over links of increasing loss
+*/
+
+void Events_Test_Code(void){
+	
+	const int Loss[4] = {0,10,30,50};
+	int i = 0;
+	
+	srand(5);
+	
+	for(i = 0;i < 4;i++){
+		Lossy_Link(Loss[i]);
+	}
+}
@@ -0,0 +1,6 @@
+#ifndef Events_Test_H
+#define Events_Test_H
+
+extern void Events_Test_Code(void);
+
+#endif
@@ -0,0 +1,531 @@
+/*------------------------------------------------------------------------------------------------------
+ * Name:    FEC.c
+ * Purpose: Reed-Solomon forward error correction over interleaved blocks
+ * Date: 		10/19/26
+ * Author:	Christopher Jordan - Denny
+ *------------------------------------------------------------------------------------------------------
+ * Note(s): Telemetry frames are packed back to back into fixed blocks that the ground station can
+						repair instead of drop. Only stdint is used so the ground station can build this file
+						as is and call FEC_Decode.
+						
+						Code:
+						-----
+						*	Reed-Solomon over GF(256), polynomial 0x11D, generator roots a^0..a^(Parity-1)
+						*	Each codeword is Data_Length bytes and Parity bytes, shortened from 255, and fixes
+							any Parity/2 wrong bytes. The code rate is Data_Length/(Data_Length + Parity)
+						*	Depth codewords are interleaved byte by byte, so a burst of up to Depth*Parity/2
+							bytes is spread thin enough for every codeword to fix its share
+						
+						Block Layout:
+						-------------
+						*	0		Sync					FEC_SYNC_1 FEC_SYNC_2
+						*	2		Data					Depth*Data_Length bytes, byte i is in codeword i % Depth
+						*	n		Parity				Depth*Parity bytes, parity byte t of codeword c is at t*Depth + c
+						
+						Cost:
+						-----
+						*	The encoder runs one byte at a time as FEC_Write is called, Parity table lookups
+							a byte, and needs FEC_MAX_BLOCK bytes of RAM for the block and 33 for the generator
+						*	The tables are const, 511 bytes of flash
+						*	Defaults in Intern_Project.c: 32 data, 8 parity, depth 4, a 162 byte block that fixes
+							16 byte bursts at a rate of 0.8
+ *----------------------------------------------------------------------------------------------------*/
+
+/*---------------------------------------------Include Statements-------------------------------------*/
+#include "FEC.h"
+/*---------------------------------------------Tables-------------------------------------------------*/
+/* a^i, i = 0..254 */
+static const uint8_t GF_Exp[255] = {
+	0x01,0x02,0x04,0x08,0x10,0x20,0x40,0x80,0x1D,0x3A,0x74,0xE8,0xCD,0x87,0x13,0x26,
+	0x4C,0x98,0x2D,0x5A,0xB4,0x75,0xEA,0xC9,0x8F,0x03,0x06,0x0C,0x18,0x30,0x60,0xC0,
+	0x9D,0x27,0x4E,0x9C,0x25,0x4A,0x94,0x35,0x6A,0xD4,0xB5,0x77,0xEE,0xC1,0x9F,0x23,
+	0x46,0x8C,0x05,0x0A,0x14,0x28,0x50,0xA0,0x5D,0xBA,0x69,0xD2,0xB9,0x6F,0xDE,0xA1,
+	0x5F,0xBE,0x61,0xC2,0x99,0x2F,0x5E,0xBC,0x65,0xCA,0x89,0x0F,0x1E,0x3C,0x78,0xF0,
+	0xFD,0xE7,0xD3,0xBB,0x6B,0xD6,0xB1,0x7F,0xFE,0xE1,0xDF,0xA3,0x5B,0xB6,0x71,0xE2,
+	0xD9,0xAF,0x43,0x86,0x11,0x22,0x44,0x88,0x0D,0x1A,0x34,0x68,0xD0,0xBD,0x67,0xCE,
+	0x81,0x1F,0x3E,0x7C,0xF8,0xED,0xC7,0x93,0x3B,0x76,0xEC,0xC5,0x97,0x33,0x66,0xCC,
+	0x85,0x17,0x2E,0x5C,0xB8,0x6D,0xDA,0xA9,0x4F,0x9E,0x21,0x42,0x84,0x15,0x2A,0x54,
+	0xA8,0x4D,0x9A,0x29,0x52,0xA4,0x55,0xAA,0x49,0x92,0x39,0x72,0xE4,0xD5,0xB7,0x73,
+	0xE6,0xD1,0xBF,0x63,0xC6,0x91,0x3F,0x7E,0xFC,0xE5,0xD7,0xB3,0x7B,0xF6,0xF1,0xFF,
+	0xE3,0xDB,0xAB,0x4B,0x96,0x31,0x62,0xC4,0x95,0x37,0x6E,0xDC,0xA5,0x57,0xAE,0x41,
+	0x82,0x19,0x32,0x64,0xC8,0x8D,0x07,0x0E,0x1C,0x38,0x70,0xE0,0xDD,0xA7,0x53,0xA6,
+	0x51,0xA2,0x59,0xB2,0x79,0xF2,0xF9,0xEF,0xC3,0x9B,0x2B,0x56,0xAC,0x45,0x8A,0x09,
+	0x12,0x24,0x48,0x90,0x3D,0x7A,0xF4,0xF5,0xF7,0xF3,0xFB,0xEB,0xCB,0x8B,0x0B,0x16,
+	0x2C,0x58,0xB0,0x7D,0xFA,0xE9,0xCF,0x83,0x1B,0x36,0x6C,0xD8,0xAD,0x47,0x8E
+};
+
+/* i for a^i, GF_Log[0] is unused */
+static const uint8_t GF_Log[256] = {
+	0x00,0x00,0x01,0x19,0x02,0x32,0x1A,0xC6,0x03,0xDF,0x33,0xEE,0x1B,0x68,0xC7,0x4B,
+	0x04,0x64,0xE0,0x0E,0x34,0x8D,0xEF,0x81,0x1C,0xC1,0x69,0xF8,0xC8,0x08,0x4C,0x71,
+	0x05,0x8A,0x65,0x2F,0xE1,0x24,0x0F,0x21,0x35,0x93,0x8E,0xDA,0xF0,0x12,0x82,0x45,
+	0x1D,0xB5,0xC2,0x7D,0x6A,0x27,0xF9,0xB9,0xC9,0x9A,0x09,0x78,0x4D,0xE4,0x72,0xA6,
+	0x06,0xBF,0x8B,0x62,0x66,0xDD,0x30,0xFD,0xE2,0x98,0x25,0xB3,0x10,0x91,0x22,0x88,
+	0x36,0xD0,0x94,0xCE,0x8F,0x96,0xDB,0xBD,0xF1,0xD2,0x13,0x5C,0x83,0x38,0x46,0x40,
+	0x1E,0x42,0xB6,0xA3,0xC3,0x48,0x7E,0x6E,0x6B,0x3A,0x28,0x54,0xFA,0x85,0xBA,0x3D,
+	0xCA,0x5E,0x9B,0x9F,0x0A,0x15,0x79,0x2B,0x4E,0xD4,0xE5,0xAC,0x73,0xF3,0xA7,0x57,
+	0x07,0x70,0xC0,0xF7,0x8C,0x80,0x63,0x0D,0x67,0x4A,0xDE,0xED,0x31,0xC5,0xFE,0x18,
+	0xE3,0xA5,0x99,0x77,0x26,0xB8,0xB4,0x7C,0x11,0x44,0x92,0xD9,0x23,0x20,0x89,0x2E,
+	0x37,0x3F,0xD1,0x5B,0x95,0xBC,0xCF,0xCD,0x90,0x87,0x97,0xB2,0xDC,0xFC,0xBE,0x61,
+	0xF2,0x56,0xD3,0xAB,0x14,0x2A,0x5D,0x9E,0x84,0x3C,0x39,0x53,0x47,0x6D,0x41,0xA2,
+	0x1F,0x2D,0x43,0xD8,0xB7,0x7B,0xA4,0x76,0xC4,0x17,0x49,0xEC,0x7F,0x0C,0x6F,0xF6,
+	0x6C,0xA1,0x3B,0x52,0x29,0x9D,0x55,0xAA,0xFB,0x60,0x86,0xB1,0xBB,0xCC,0x3E,0x5A,
+	0xCB,0x59,0x5F,0xB0,0x9C,0xA9,0xA0,0x51,0x0B,0xF5,0x16,0xEB,0x7A,0x75,0x2C,0xD7,
+	0x4F,0xAE,0xD5,0xE9,0xE6,0xE7,0xAD,0xE8,0x74,0xD6,0xF4,0xEA,0xA8,0x50,0x58,0xAF
+};
+/*---------------------------------------------Globals------------------------------------------------*/
+int								Data_Length = 0;													/* Data bytes per codeword */
+int								Parity_Length = 0;												/* Parity bytes per codeword, 0 is off */
+int								Depth = 1;																/* Codewords per block */
+int								Data_Bytes = 0;														/* Data bytes per block */
+uint8_t						Generator[FEC_MAX_PARITY + 1];						/* Coefficient of x^i, monic */
+FEC_Stats					Stats;
+
+/* Block being encoded */
+uint8_t						Block[FEC_MAX_BLOCK];
+int								Fill = 0;																	/* Data bytes written */
+int								Codeword = 0;															/* Codeword of the next data byte */
+/*---------------------------------------------Functions----------------------------------------------*/
+
+/**
+  \fn					uint8_t GF_Mul(uint8_t A, uint8_t B)
+  \brief			Multiplies in GF(256)
+*/
+
+static __inline uint8_t GF_Mul(uint8_t A, uint8_t B){
+	
+	int Sum = 0;
+	
+	if((A == 0) || (B == 0)){
+		return(0);
+	}
+	
+	Sum = GF_Log[A] + GF_Log[B];
+	if(Sum >= 255){
+		Sum -= 255;
+	}
+	
+	return(GF_Exp[Sum]);
+}
+
+/**
+  \fn					uint8_t GF_Div(uint8_t A, uint8_t B)
+  \brief			Divides in GF(256), B must not be 0
+*/
+
+static uint8_t GF_Div(uint8_t A, uint8_t B){
+	
+	int Difference = 0;
+	
+	if(A == 0){
+		return(0);
+	}
+	
+	Difference = GF_Log[A] - GF_Log[B];
+	if(Difference < 0){
+		Difference += 255;
+	}
+	
+	return(GF_Exp[Difference]);
+}
+
+/**
+  \fn					uint8_t GF_Pow(int Power)
+  \brief			a^Power for any Power >= 0
+*/
+
+static uint8_t GF_Pow(int Power){
+	
+	while(Power >= 255){
+		Power -= 255;
+	}
+	
+	return(GF_Exp[Power]);
+}
+
+/**
+  \fn					int FEC_Init(int Data, int Parity, int Interleave)
+  \brief			Sets the code, the ground station must use the same values
+	\param			int Data: Data bytes per codeword, at most 255 - Parity
+	\param			int Parity: Even number of parity bytes per codeword up to FEC_MAX_PARITY, 0 turns
+							the FEC off
+	\param			int Interleave: Codewords interleaved per block
+	\returns		int: FEC_OK or FEC_ERROR_CONFIG
+*/
+
+int FEC_Init(int Data, int Parity, int Interleave){
+	
+	/* Local Variables */
+	uint8_t Root = 0;
+	int i = 0;
+	int j = 0;
+	
+	if((Parity < 0) || (Parity > FEC_MAX_PARITY) || (Parity & 1) || (Data < 1) || ((Data + Parity) > 255) ||
+		(Interleave < 1) || ((FEC_SYNC_LENGTH + Interleave*(Data + Parity)) > FEC_MAX_BLOCK)){
+		Parity_Length = 0;
+		return(FEC_ERROR_CONFIG);
+	}
+	
+	Data_Length = Data;
+	Parity_Length = Parity;
+	Depth = Interleave;
+	Data_Bytes = Depth*Data_Length;
+	Fill = 0;
+	Codeword = 0;
+	
+	/* Product of (x + a^j) */
+	Generator[0] = 1;
+	for(i = 1;i <= FEC_MAX_PARITY;i++){
+		Generator[i] = 0;
+	}
+	for(j = 0;j < Parity_Length;j++){
+		Root = GF_Exp[j];
+		for(i = j + 1;i > 0;i--){
+			Generator[i] = Generator[i - 1] ^ GF_Mul(Generator[i],Root);
+		}
+		Generator[0] = GF_Mul(Generator[0],Root);
+	}
+	
+	return(FEC_OK);
+}
+
+/**
+  \fn					int FEC_Enabled(void)
+  \brief			Whether frames should go through FEC_Write
+	\returns		int: 1 if FEC_Init set a code, 0 if the FEC is off
+*/
+
+int FEC_Enabled(void){
+	return(Parity_Length != 0);
+}
+
+/**
+  \fn					int FEC_Block_Length(void)
+  \brief			Bytes in a block, sync included
+	\returns		int: Block length
+*/
+
+int FEC_Block_Length(void){
+	return(FEC_SYNC_LENGTH + Depth*(Data_Length + Parity_Length));
+}
+
+/**
+  \fn					int FEC_Coded_Length(int Length)
+  \brief			What Length bytes of frames cost on the link once coded, for the byte budget
+	\param			int Length: Frame bytes
+	\returns		int: Length with its share of the sync and parity, rounded up
+*/
+
+int FEC_Coded_Length(int Length){
+	
+	int Block_Length = FEC_Block_Length();
+	
+	if(Parity_Length == 0){
+		return(Length);
+	}
+	
+	return((Length*Block_Length + Data_Bytes - 1)/Data_Bytes);
+}
+
+/**
+  \fn					void FEC_Encode_Byte(uint8_t Byte)
+  \brief			Adds a data byte to the block and runs it through its codeword's parity register
+*/
+
+static void FEC_Encode_Byte(uint8_t Byte){
+	
+	/* Local Variables */
+	uint8_t* Parity = &Block[FEC_SYNC_LENGTH + Data_Bytes + Codeword];
+	uint8_t Feedback = 0;
+	int i = 0;
+	
+	/* New block */
+	if(Fill == 0){
+		Block[0] = FEC_SYNC_1;
+		Block[1] = FEC_SYNC_2;
+		for(i = FEC_SYNC_LENGTH + Data_Bytes;i < FEC_Block_Length();i++){
+			Block[i] = 0;
+		}
+	}
+	
+	Block[FEC_SYNC_LENGTH + Fill] = Byte;
+	Fill++;
+	if(++Codeword == Depth){
+		Codeword = 0;
+	}
+	
+	/* Highest power first, parity byte t is the coefficient of x^(Parity - 1 - t) */
+	Feedback = Byte ^ Parity[0];
+	for(i = 0;i < (Parity_Length - 1);i++){
+		Parity[i*Depth] = Parity[(i + 1)*Depth] ^ GF_Mul(Feedback,Generator[Parity_Length - 1 - i]);
+	}
+	Parity[i*Depth] = GF_Mul(Feedback,Generator[0]);
+}
+
+/**
+  \fn					int FEC_Write(const uint8_t* Data, int Length)
+  \brief			Adds frame bytes to the block, stops once the block is full
+	\param			const uint8_t* Data: Frame bytes
+	\param			int Length: Number of bytes
+	\returns		int: Bytes taken, call FEC_Take_Block and write the rest
+*/
+
+int FEC_Write(const uint8_t* Data, int Length){
+	
+	int Used = 0;
+	
+	while((Used < Length) && (Fill < Data_Bytes)){
+		FEC_Encode_Byte(Data[Used++]);
+	}
+	
+	return(Used);
+}
+
+/**
+  \fn					int FEC_Pad(void)
+  \brief			Fills the rest of a started block so it can be sent now, for when frames stop
+	\returns		int: Fill bytes added
+*/
+
+int FEC_Pad(void){
+	
+	int Padding = 0;
+	
+	if(Fill == 0){
+		return(0);
+	}
+	
+	while(Fill < Data_Bytes){
+		FEC_Encode_Byte(FEC_FILL);
+		Padding++;
+	}
+	
+	return(Padding);
+}
+
+/**
+  \fn					const uint8_t* FEC_Take_Block(void)
+  \brief			Hands over a full block and starts the next one
+	\returns		const uint8_t*: FEC_Block_Length bytes, valid until the next FEC_Write, 0 if the
+							block isn't full yet
+*/
+
+const uint8_t* FEC_Take_Block(void){
+	
+	if((Parity_Length == 0) || (Fill < Data_Bytes)){
+		return(0);
+	}
+	
+	Fill = 0;
+	Codeword = 0;
+	Stats.Blocks++;
+	
+	return(Block);
+}
+
+/**
+  \fn					uint8_t* FEC_Symbol(uint8_t* Data, int Word, int Index)
+  \brief			Finds byte Index of a codeword inside an interleaved block
+*/
+
+static uint8_t* FEC_Symbol(uint8_t* Data, int Word, int Index){
+	
+	if(Index < Data_Length){
+		return(&Data[Index*Depth + Word]);
+	}
+	
+	return(&Data[Data_Bytes + (Index - Data_Length)*Depth + Word]);
+}
+
+/**
+  \fn					int FEC_Decode_Codeword(uint8_t* Data, int Word)
+  \brief			Berlekamp-Massey, Chien search and Forney on one codeword of a block
+	\returns		int: Bytes corrected or FEC_ERROR_UNCORRECTABLE
+*/
+
+static int FEC_Decode_Codeword(uint8_t* Data, int Word){
+	
+	/* Local Variables */
+	uint8_t Syndrome[FEC_MAX_PARITY];
+	uint8_t Lambda[FEC_MAX_PARITY + 1];
+	uint8_t Previous[FEC_MAX_PARITY + 1];
+	uint8_t Temp[FEC_MAX_PARITY + 1];
+	uint8_t Omega[FEC_MAX_PARITY];
+	uint8_t Position[FEC_MAX_PARITY/2];
+	uint8_t Value[FEC_MAX_PARITY/2];
+	int Length = Data_Length + Parity_Length;
+	uint8_t Discrepancy = 0;
+	uint8_t Last_Discrepancy = 1;
+	uint8_t Scale = 0;
+	uint8_t Root = 0;
+	uint8_t Sum = 0;
+	uint8_t Derivative = 0;
+	uint8_t Power = 0;
+	int Errors = 0;
+	int Found = 0;
+	int Shift = 1;
+	int Nonzero = 0;
+	int i = 0;
+	int j = 0;
+	
+	/* Syndromes, the received word at a^j */
+	for(j = 0;j < Parity_Length;j++){
+		Root = GF_Exp[j];
+		Sum = 0;
+		for(i = 0;i < Length;i++){
+			Sum = GF_Mul(Sum,Root) ^ *FEC_Symbol(Data,Word,i);
+		}
+		Syndrome[j] = Sum;
+		Nonzero |= Sum;
+	}
+	if(Nonzero == 0){
+		return(0);
+	}
+	
+	/* Error locator */
+	for(i = 0;i <= Parity_Length;i++){
+		Lambda[i] = 0;
+		Previous[i] = 0;
+	}
+	Lambda[0] = 1;
+	Previous[0] = 1;
+	for(j = 0;j < Parity_Length;j++){
+		
+		Discrepancy = Syndrome[j];
+		for(i = 1;i <= Errors;i++){
+			Discrepancy ^= GF_Mul(Lambda[i],Syndrome[j - i]);
+		}
+		
+		if(Discrepancy == 0){
+			Shift++;
+			continue;
+		}
+		
+		Scale = GF_Div(Discrepancy,Last_Discrepancy);
+		for(i = 0;i <= Parity_Length;i++){
+			Temp[i] = Lambda[i];
+		}
+		for(i = Shift;i <= Parity_Length;i++){
+			Lambda[i] ^= GF_Mul(Scale,Previous[i - Shift]);
+		}
+		
+		if((2*Errors) <= j){
+			Errors = j + 1 - Errors;
+			for(i = 0;i <= Parity_Length;i++){
+				Previous[i] = Temp[i];
+			}
+			Last_Discrepancy = Discrepancy;
+			Shift = 1;
+		}
+		else{
+			Shift++;
+		}
+	}
+	if((2*Errors) > Parity_Length){
+		return(FEC_ERROR_UNCORRECTABLE);
+	}
+	
+	/* Error evaluator, Syndrome(x)*Lambda(x) mod x^Parity */
+	for(i = 0;i < Parity_Length;i++){
+		Omega[i] = 0;
+		for(j = 0;j <= i;j++){
+			Omega[i] ^= GF_Mul(Syndrome[i - j],Lambda[j]);
+		}
+	}
+	
+	/* Roots of Lambda at X^-1, X = a^(Length - 1 - i) for byte i */
+	for(i = 0;i < Length;i++){
+		
+		Power = GF_Pow(255 - (Length - 1 - i));
+		Root = 1;
+		Sum = 0;
+		for(j = 0;j <= Errors;j++){
+			Sum ^= GF_Mul(Lambda[j],Root);
+			Root = GF_Mul(Root,Power);
+		}
+		if(Sum != 0){
+			continue;
+		}
+		if(Found == Errors){
+			return(FEC_ERROR_UNCORRECTABLE);
+		}
+		
+		/* Forney: X*Omega(X^-1)/Lambda'(X^-1) */
+		Root = 1;
+		Sum = 0;
+		for(j = 0;j < Parity_Length;j++){
+			Sum ^= GF_Mul(Omega[j],Root);
+			Root = GF_Mul(Root,Power);
+		}
+		Root = 1;
+		Derivative = 0;
+		for(j = 1;j <= Errors;j += 2){
+			Derivative ^= GF_Mul(Lambda[j],Root);
+			Root = GF_Mul(Root,GF_Mul(Power,Power));
+		}
+		if(Derivative == 0){
+			return(FEC_ERROR_UNCORRECTABLE);
+		}
+		
+		Position[Found] = (uint8_t)i;
+		Value[Found] = GF_Mul(GF_Pow(Length - 1 - i),GF_Div(Sum,Derivative));
+		Found++;
+	}
+	if(Found != Errors){
+		return(FEC_ERROR_UNCORRECTABLE);
+	}
+	
+	/* Only touch the block once every error is known */
+	for(i = 0;i < Found;i++){
+		*FEC_Symbol(Data,Word,Position[i]) ^= Value[i];
+	}
+	
+	return(Found);
+}
+
+/**
+  \fn					int FEC_Decode(uint8_t* Received)
+  \brief			Repairs a received block in place, used by the ground station
+	\param			uint8_t* Received: FEC_Block_Length bytes starting at the sync
+	\returns		int: Bytes corrected, or FEC_ERROR_UNCORRECTABLE if any codeword couldn't be
+							fixed, the codewords that could are still repaired
+*/
+
+int FEC_Decode(uint8_t* Received){
+	
+	/* Local Variables */
+	int Corrected = 0;
+	int Result = FEC_OK;
+	int Failed = 0;
+	int i = 0;
+	
+	if(Parity_Length == 0){
+		return(0);
+	}
+	
+	Stats.Blocks++;
+	for(i = 0;i < Depth;i++){
+		Result = FEC_Decode_Codeword(Received + FEC_SYNC_LENGTH,i);
+		if(Result < 0){
+			Failed++;
+		}
+		else{
+			Corrected += Result;
+		}
+	}
+	
+	Stats.Corrected += Corrected;
+	Stats.Failed += Failed;
+	
+	return((Failed != 0) ? FEC_ERROR_UNCORRECTABLE : Corrected);
+}
+
+/**
+  \fn					FEC_Stats* FEC_Get_Stats(void)
+  \brief			Retrieves the block counters
+	\returns		FEC_Stats*: The counters
+*/
+
+FEC_Stats* FEC_Get_Stats(void){
+	return(&Stats);
+}
@@ -0,0 +1,47 @@
+/*------------------------------------------------------------------------------------------------------
+ * Name:    FEC.h
+ * Purpose: Reed-Solomon forward error correction over interleaved blocks
+ * Date: 		10/19/26
+ * Author:	Christopher Jordan - Denny
+ *------------------------------------------------------------------------------------------------------
+ * Note(s): See C file for the block layout
+ *----------------------------------------------------------------------------------------------------*/
+
+/*-----------------------------------------Include Statements-----------------------------------------*/
+#include <stdint.h>
+
+#ifndef FEC_H
+#define FEC_H
+
+/*-----------------------------------------Block Constants--------------------------------------------*/
+#define FEC_SYNC_1								0x1A					// Attached sync marker
+#define FEC_SYNC_2								0xCF
+#define FEC_SYNC_LENGTH						2
+#define FEC_MAX_PARITY						32						// Parity bytes per codeword, corrects half as many
+#define FEC_MAX_BLOCK							256						// Fits one XBee RF packet
+#define FEC_FILL									0x00					// Pads the last block, skipped by the telemetry sync search
+
+/* Results */
+#define FEC_OK										0
+#define FEC_ERROR_CONFIG					-1						// Parity odd or too big, or the block won't fit
+#define FEC_ERROR_UNCORRECTABLE		-2						// A codeword had more errors than it can fix
+
+/* Block counters */
+typedef struct FEC_Stats
+{
+	uint32_t Blocks;										/* Blocks encoded or decoded */
+	uint32_t Corrected;									/* Bytes repaired by FEC_Decode */
+	uint32_t Failed;										/* Codewords FEC_Decode gave up on */
+}FEC_Stats;
+
+extern int FEC_Init(int Data, int Parity, int Interleave);
+extern int FEC_Enabled(void);
+extern int FEC_Block_Length(void);
+extern int FEC_Coded_Length(int Length);
+extern int FEC_Write(const uint8_t* Data, int Length);
+extern int FEC_Pad(void);
+extern const uint8_t* FEC_Take_Block(void);
+extern int FEC_Decode(uint8_t* Received);
+extern FEC_Stats* FEC_Get_Stats(void);
+
+#endif
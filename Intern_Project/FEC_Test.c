@@ -0,0 +1,154 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "FEC.h"
+#include "Serial.h"
+#include "Timing.h"
+#include "FEC_Test.h"
+
+#define TEST_DATA						32
+#define TEST_PARITY					8
+#define TEST_DEPTH					4
+#define BLOCK_ITERATIONS		200
+#define BENCH_ITERATIONS		50
+
+/**
+  \fn					int Encode_Block(uint8_t* Block, uint8_t* Data)
+  \brief			Encodes one block of random data
+	\returns		int: Block length
+*/
+
+static int Encode_Block(uint8_t* Block, uint8_t* Data){
+	
+	int Length = FEC_Block_Length();
+	int i = 0;
+	
+	for(i = 0;i < (TEST_DATA*TEST_DEPTH);i++){
+		Data[i] = (uint8_t)rand();
+	}
+	
+	FEC_Write(Data,TEST_DATA*TEST_DEPTH);
+	memcpy(Block,FEC_Take_Block(),Length);
+	
+	return(Length);
+}
+
+/**
+  \fn					int Burst_Test(int Burst)
+  \brief			Corrupts a run of bytes in each block, up to TEST_DEPTH*TEST_PARITY/2 must always
+							come back exactly
+	\param			int Burst: Bytes corrupted in a row
+	\returns		int: Blocks repaired exactly
+*/
+
+static int Burst_Test(int Burst){
+	
+	uint8_t Block[FEC_MAX_BLOCK];
+	uint8_t Sent[FEC_MAX_BLOCK];
+	uint8_t Data[TEST_DATA*TEST_DEPTH];
+	int Length = 0;
+	int Start = 0;
+	int Repaired = 0;
+	int i = 0;
+	int j = 0;
+	
+	for(i = 0;i < BLOCK_ITERATIONS;i++){
+		
+		Length = Encode_Block(Block,Data);
+		memcpy(Sent,Block,Length);
+		
+		/* Anywhere after the sync */
+		Start = FEC_SYNC_LENGTH + (rand() % (Length - FEC_SYNC_LENGTH - Burst));
+		for(j = 0;j < Burst;j++){
+			Block[Start + j] ^= (uint8_t)(1 + (rand() % 255));
+		}
+		
+		if((FEC_Decode(Block) >= 0) && (memcmp(Block,Sent,Length) == 0)){
+			Repaired++;
+		}
+	}
+	
+	return(Repaired);
+}
+
+/**
+  \fn					int Channel_Test(int Bit_Error_Rate)
+  \brief			Sends blocks through a random bit error channel
+	\param			int Bit_Error_Rate: Flipped bits per million
+	\returns		int: Blocks repaired exactly
+*/
+
+static int Channel_Test(int Bit_Error_Rate){
+	
+	uint8_t Block[FEC_MAX_BLOCK];
+	uint8_t Sent[FEC_MAX_BLOCK];
+	uint8_t Data[TEST_DATA*TEST_DEPTH];
+	int Length = 0;
+	int Repaired = 0;
+	int i = 0;
+	int j = 0;
+	
+	for(i = 0;i < BLOCK_ITERATIONS;i++){
+		
+		Length = Encode_Block(Block,Data);
+		memcpy(Sent,Block,Length);
+		
+		/* The sync is found by the ground station, only the data and parity are tested */
+		for(j = FEC_SYNC_LENGTH*8;j < (Length*8);j++){
+			if((((uint32_t)rand() << 15 ^ (uint32_t)rand()) % 1000000) < (uint32_t)Bit_Error_Rate){
+				Block[j >> 3] ^= (uint8_t)(1 << (j & 7));
+			}
+		}
+		
+		if((FEC_Decode(Block) >= 0) && (memcmp(Block,Sent,Length) == 0)){
+			Repaired++;
+		}
+	}
+	
+	return(Repaired);
+}
+
+/**
+  \fn					void FEC_Test_Code(void)
+  \brief			Checks burst and bit error recovery and times the encoder and decoder
+*/
+
+void FEC_Test_Code(void){
+	
+	const int Rates[4] = {100,1000,3000,10000};
+	uint8_t Block[FEC_MAX_BLOCK];
+	uint8_t Data[TEST_DATA*TEST_DEPTH];
+	unsigned int Start = 0;
+	unsigned int Encode_Time = 0;
+	unsigned int Decode_Time = 0;
+	int Length = 0;
+	int i = 0;
+	
+	srand(4);
+	FEC_Init(TEST_DATA,TEST_PARITY,TEST_DEPTH);
+	
+	printf("Burst 16: %i/%i repaired\r\n",Burst_Test(TEST_DEPTH*TEST_PARITY/2),BLOCK_ITERATIONS);
+	printf("Burst 24: %i/%i repaired\r\n",Burst_Test(24),BLOCK_ITERATIONS);
+	for(i = 0;i < 4;i++){
+		printf("BER %i e-6: %i/%i repaired\r\n",Rates[i],Channel_Test(Rates[i]),BLOCK_ITERATIONS);
+	}
+	
+	/* Encoder, the data bytes only */
+	Start = msTicks;
+	for(i = 0;i < BENCH_ITERATIONS;i++){
+		FEC_Write(Data,TEST_DATA*TEST_DEPTH);
+		FEC_Take_Block();
+	}
+	Encode_Time = msTicks - Start;
+	
+	/* Decoder with four errors a codeword, the worst it can fix */
+	Length = Encode_Block(Block,Data);
+	Start = msTicks;
+	for(i = 0;i < BENCH_ITERATIONS;i++){
+		memset(&Block[FEC_SYNC_LENGTH],0x55,TEST_DEPTH*TEST_PARITY/2);
+		FEC_Decode(Block);
+	}
+	Decode_Time = msTicks - Start;
+	
+	printf("%i blocks of %i bytes, Encode: %u ms, Decode: %u ms\r\n",BENCH_ITERATIONS,Length,Encode_Time,Decode_Time);
+}
@@ -0,0 +1,6 @@
+#ifndef FEC_Test_H
+#define FEC_Test_H
+
+extern void FEC_Test_Code(void);
+
+#endif
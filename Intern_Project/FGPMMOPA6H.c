@@ -8,15 +8,28 @@
  * Note(s): This is created to be used with the adafruit GPS module.
  * A jumper between rx to pin 2 when on soft serial mode must 
  * be present.
+ *
+ * MTK binary mode needs the DIYDrones v1.9 firmware on the module. Each fix is one 37 byte
+ * message (2 preamble, 1 length, 32 payload, 2 checksum) instead of the ~145 bytes of a RMC
+ * and GGA sentence pair, and its fields sit at fixed offsets so nothing is tokenized. The
+ * setting is not saved by the module, a power cycle returns it to NMEA.
  *----------------------------------------------------------------------------------------------------*/
 
 /*---------------------------------Include Statements-------------------------------------------------*/
 #include "stm32l053xx.h"			//Specific Device Header
 #include <stdio.h>						//Standard input and output
 #include <string.h>						//Various useful string functions
-#include <stdlib.h>						//Various useful conversion functions
+#include <stddef.h>						//offsetof
 #include "FGPMMOPA6H.h"
+#include "NMEA_Parse.h"				//Fixed point field conversion
 #include "Serial.h"						//USART2 computer communication
+#include "Timing.h"						//msTicks for time to first fix
+#include "EEPROM.h"						//Last known fix storage
+#include "Profile.h"					//Interrupt and parse cycles
+#include "Trace.h"						//Event timeline
+#include "ISR_Monitor.h"			//Interrupt latency and budget
+#include "Arena.h"						//Sentence buffers
+#include "Spin.h"						//Busy wait accounting
 
 /*---------------------------------Define Statments---------------------------------------------------*/
 #define TRUE				0x1				//Truth value is 1
@@ -37,6 +50,12 @@
 #define PMTK_API_SET_FIX_CTL_5HZ							"$PMTK300,200,0,0,0,0*2F\r\n"
 // Can't fix position faster than 5 times a second!
 
+// Restart commands, hot uses everything kept in backup RAM, warm discards the ephemeris
+#define PMTK_CMD_HOT_START										"$PMTK101*32\r\n"
+#define PMTK_CMD_WARM_START										"$PMTK102*31\r\n"
+#define PMTK_CMD_COLD_START										"$PMTK103*30\r\n"
+#define PMTK_RESTART_TIMEOUT									1000					// ms to wait for the startup message
+
 #define PMTK_SET_BAUD_57600										"$PMTK251,57600*2C\r\n"
 #define PMTK_SET_BAUD_9600										"$PMTK251,9600*17\r\n"
 
@@ -49,34 +68,167 @@
 // turn off output
 #define PMTK_SET_NMEA_OUTPUT_OFF							"$PMTK314,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0*28\r\n"
 
+// MTK binary output (DIYDrones firmware), one message per fix
+#define PGCMD_SET_BINARY_OUTPUT								"$PGCMD,16,0,0,0,0,0*6A\r\n"
+
 #define PCLK	32000000									// Peripheral Clock
 #define BAUD	9600											// Baud rate
 
+#define GPS_LAST_FIX_MAGIC	0x47505346					// "GPSF"
+
+/*---------------------------------MTK Binary Message-------------------------------------------------*/
+#define MTK_PREAMBLE1_V16				0xD0						// First preamble byte, firmware v1.6
+#define MTK_PREAMBLE1_V19				0xD1						// First preamble byte, firmware v1.9
+#define MTK_PREAMBLE2						0xDD						// Second preamble byte
+#define MTK_PAYLOAD_LENGTH			32							// Third byte, payload length
+/* Little endian payload offsets */
+#define MTK_LATITUDE						0								// int32, 1e-7 degrees (1e-6 on v1.6)
+#define MTK_LONGITUDE						4								// int32, 1e-7 degrees (1e-6 on v1.6)
+#define MTK_ALTITUDE						8								// int32, centimeters
+#define MTK_GROUND_SPEED				12							// int32, centimeters per second
+#define MTK_COURSE							16							// int32, hundredths of a degree
+#define MTK_SATELLITES					20							// uint8
+#define MTK_FIX_TYPE						21							// uint8, 1 = none, 2 = 2D, 3 = 3D, 6/7 = SBAS 2D/3D
+#define MTK_DATE								22							// uint32, ddmmyy
+#define MTK_TIME								26							// uint32, hhmmssmmm
+#define MTK_HDOP								30							// uint16, hundredths
+
 /*---------------------------------NMEA Output Sentences----------------------------------------------*/
 static const char GGA_Tag[] = "$GPGGA";
-static const char GSA_Tag[] = "$GPGSA";
-static const char GSV_Tag[] = "$GPGSV";
 static const char RMC_Tag[] = "$GPRMC";
-static const char VTG_Tag[] = "$GPVTG";
+static const char Startup_Tag[] = "$PMTK010,001";		/* Sent by the module once it has restarted */
+
+/*---------------------------------Sentence Fields----------------------------------------------------*/
+/* Where each comma separated field of a sentence goes, in order */
+typedef struct NMEA_Field
+{
+	uint16_t Offset;
+	uint16_t Size;
+}NMEA_Field;
+
+#define FIELD(Type,Member)	{offsetof(Type,Member),sizeof(((Type*)0)->Member)}
+
+static const NMEA_Field GGA_Fields[] = {
+	FIELD(GGA_Data,Message_ID),FIELD(GGA_Data,UTC_Time),FIELD(GGA_Data,Latitude),
+	FIELD(GGA_Data,N_S_Indicator),FIELD(GGA_Data,Longitude),FIELD(GGA_Data,E_W_Indicator),
+	FIELD(GGA_Data,Position_Indicator),FIELD(GGA_Data,Satellites_Used),FIELD(GGA_Data,HDOP),
+	FIELD(GGA_Data,MSL_Altitude),FIELD(GGA_Data,Units_Altitude),FIELD(GGA_Data,Geoidal_Seperation),
+	FIELD(GGA_Data,Units_Geoidal_Seperation),FIELD(GGA_Data,Age_Of_Diff_Corr),FIELD(GGA_Data,Checksum)
+};
+#define GGA_FIELDS		((int)(sizeof(GGA_Fields)/sizeof(GGA_Fields[0])))
+
+static const NMEA_Field RMC_Fields[] = {
+	FIELD(RMC_Data,Message_ID),FIELD(RMC_Data,UTC_Time),FIELD(RMC_Data,Status),
+	FIELD(RMC_Data,Latitude),FIELD(RMC_Data,N_S_Indicator),FIELD(RMC_Data,Longitude),
+	FIELD(RMC_Data,E_W_Indicator),FIELD(RMC_Data,Speed_Over_Ground),FIELD(RMC_Data,Course_Over_Ground),
+	FIELD(RMC_Data,Date),FIELD(RMC_Data,Mode)
+};
+#define RMC_FIELDS		((int)(sizeof(RMC_Fields)/sizeof(RMC_Fields[0])))
 
 /*---------------------------------Globals------------------------------------------------------------*/
 volatile int 				CharIndex = 0;												/* Character index of the char array */
-const int 					NMEA_LENGTH = 128;										/* The max length of one NMEA line */
-char 								Rx_Data[NMEA_LENGTH] = "0";						/* Rx Sring */
+const int 					NMEA_LENGTH = ARENA_NMEA_LINE;				/* The max length of one NMEA line */
+char* 							Rx_Data = 0;													/* Rx Sring, in the arena */
 volatile uint8_t 		Transmission_In_Progress = FALSE;			/* Are we in between a $ and \n */
-char 								GGA_Message[128];											/* Original GGA message */
-char 								GSA_Message[128];											/* Original GSA message */
-char 								GSV_Message[128];											/* Original GSV message */
-char 								RMC_Message[128];											/* Original RMC message */
-char 								VTG_Message[128];											/* Original VTG message */
+char* 							GGA_Message = 0;											/* Original GGA message, in the arena */
+char* 							RMC_Message = 0;											/* Original RMC message, in the arena */
+char*								NMEA_Copy = 0;												/* Sentence being split, in the arena */
+volatile uint8_t		Module_Restarted = FALSE;							/* Startup message seen */
+uint32_t						TTFF_Start = 0;												/* msTicks when the module was restarted */
+uint32_t						TTFF = 0;															/* Time to first fix (ms), 0 until fixed */
+volatile uint8_t		GPS_Protocol = GPS_PROTOCOL_NMEA;			/* Format of the incoming data */
+uint8_t							MTK_Buffer[MTK_PAYLOAD_LENGTH];				/* Binary payload being received */
+uint8_t							MTK_Message[MTK_PAYLOAD_LENGTH];			/* Last complete binary payload */
+uint8_t							MTK_Revision = MTK_PREAMBLE1_V19;			/* Preamble of the last message */
+volatile uint8_t		MTK_New_Data_Ready = FALSE;						/* Binary payload recieved */
 
 /*---------------------------------Structure Instantiate----------------------------------------------*/
 RMC_Data RMC;
 GPS_Data GPS;
 GGA_Data GGA;
+GPS_Fix Fix;
 
 /*---------------------------------Functions----------------------------------------------------------*/
 
+/**
+  \fn          void Copy_Field(char* Field, int Size, const char* Token)
+  \brief       Copies one sentence field into its component, cut short if it doesn't fit
+*/
+
+static void Copy_Field(char* Field, int Size, const char* Token){
+	
+	strncpy(Field,Token,Size - 1);
+	Field[Size - 1] = '\0';
+}
+
+/**
+  \fn          void MTK_Binary_Receive(uint8_t Data)
+  \brief       Steps through a MTK binary message one byte at a time, called from the
+							 USART1 interrupt. The Fletcher checksum covers the length byte and payload.
+	\param			 uint8_t Data: The byte recieved
+*/
+
+static void MTK_Binary_Receive(uint8_t Data){
+	
+	static uint8_t Step = 0;
+	static uint8_t Index = 0;
+	static uint8_t CK_A = 0;
+	static uint8_t CK_B = 0;
+	static uint8_t Revision = MTK_PREAMBLE1_V19;
+	
+	switch(Step){
+		
+		/* Preamble */
+		case 0:
+			if((Data == MTK_PREAMBLE1_V19) || (Data == MTK_PREAMBLE1_V16)){
+				Revision = Data;
+				Step++;
+			}
+			break;
+		case 1:
+			Step = (Data == MTK_PREAMBLE2) ? 2 : 0;
+			break;
+			
+		/* Payload length */
+		case 2:
+			if(Data == MTK_PAYLOAD_LENGTH){
+				CK_A = Data;
+				CK_B = Data;
+				Index = 0;
+				Step++;
+			}
+			else Step = 0;
+			break;
+			
+		/* Payload */
+		case 3:
+			MTK_Buffer[Index++] = Data;
+			CK_A += Data;
+			CK_B += CK_A;
+			if(Index == MTK_PAYLOAD_LENGTH){
+				Step++;
+			}
+			break;
+			
+		/* Checksum */
+		case 4:
+			Step = (Data == CK_A) ? 5 : 0;
+			break;
+		case 5:
+			if(Data == CK_B){
+				memcpy(MTK_Message,MTK_Buffer,MTK_PAYLOAD_LENGTH);
+				MTK_Revision = Revision;
+				MTK_New_Data_Ready = TRUE;
+			}
+			Step = 0;
+			break;
+			
+		default:
+			Step = 0;
+			break;
+	}
+}
+
 /**
   \fn          void USART1_IRQHandler(void)
   \brief       Global interrupt handler for USART1, handles Rx interrupt
@@ -84,8 +236,27 @@ GGA_Data GGA;
 
 void USART1_IRQHandler(void){
 	
+	ISR_Monitor_Enter(ISR_MONITOR_GPS_UART,ISR_MONITOR_NO_LATENCY);
+	PROFILE_BEGIN(PROFILE_GPS_UART);
+	TRACE_BEGIN(TRACE_GPS_UART,0);
+	
+	/* A byte came before the last one was read, left set it would keep interrupting */
+	if(USART1->ISR & USART_ISR_ORE){
+		USART1->ICR = USART_ICR_ORECF;
+		ISR_Monitor_Overrun(ISR_MONITOR_GPS_UART);
+	}
+	
 	if(USART1->ISR & USART_ISR_RXNE){
 		
+		/* Binary messages have their own state machine, reading RDR clears RXNE */
+		if(GPS_Protocol == GPS_PROTOCOL_MTK_BINARY){
+			MTK_Binary_Receive(USART1->RDR);
+			TRACE_END(TRACE_GPS_UART,0);
+			PROFILE_END(PROFILE_GPS_UART);
+			ISR_Monitor_Exit(ISR_MONITOR_GPS_UART);
+			return;
+		}
+		
 		/* Reads and CLEARS RXNE Flag */
     Rx_Data[CharIndex] = USART1->RDR;
 		
@@ -105,28 +276,33 @@ void USART1_IRQHandler(void){
 					strcpy(GGA_Message,Rx_Data);
 					GGA.New_Data_Ready = TRUE;
 				}
-				if(strncmp(GSA_Tag,Rx_Data,(sizeof(GSA_Tag)-1)) == 0){
-					strcpy(GSA_Message,Rx_Data);
-				}
-				if(strncmp(GSV_Tag,Rx_Data,(sizeof(GSV_Tag)-1)) == 0){
-					strcpy(GSV_Message,Rx_Data);
-				}
 				if(strncmp(RMC_Tag,Rx_Data,(sizeof(RMC_Tag)-1)) == 0){
 					strcpy(RMC_Message,Rx_Data);
 					RMC.New_Data_Ready = TRUE;
 				}
-				if(strncmp(VTG_Tag,Rx_Data,(sizeof(VTG_Tag)-1)) == 0){
-					strcpy(VTG_Message,Rx_Data);
+				if(strncmp(Startup_Tag,Rx_Data,(sizeof(Startup_Tag)-1)) == 0){
+					Module_Restarted = TRUE;
 				}
 				Transmission_In_Progress = FALSE;
 				CharIndex = 0;
-				memset(Rx_Data,0,sizeof(Rx_Data));
+				memset(Rx_Data,0,NMEA_LENGTH);
 			}
-			else{
+			else if(CharIndex < (NMEA_LENGTH - 1)){
 				CharIndex++;
 			}
+			
+			/* Too long for a sentence, drop it rather than run into the next region */
+			else{
+				Transmission_In_Progress = FALSE;
+				CharIndex = 0;
+				memset(Rx_Data,0,NMEA_LENGTH);
+			}
 		}
 	}
+	
+	TRACE_END(TRACE_GPS_UART,0);
+	PROFILE_END(PROFILE_GPS_UART);
+	ISR_Monitor_Exit(ISR_MONITOR_GPS_UART);
 }
 
 /**
@@ -141,13 +317,21 @@ void USART1_Init(void){
   uint16_t USARTDIV = 0;
   uint16_t USART_FRACTION = 0;
   uint16_t USART_MANTISSA = 0;
+	
+	/* Sentence buffers, before the interrupt can use them */
+	if(Rx_Data == 0){
+		Rx_Data = Arena_Alloc("NMEA line",ARENA_NMEA_LINE);
+		GGA_Message = Arena_Alloc("GGA",ARENA_NMEA_MESSAGE);
+		RMC_Message = Arena_Alloc("RMC",ARENA_NMEA_MESSAGE);
+		NMEA_Copy = Arena_Alloc("NMEA copy",ARENA_NMEA_COPY);
+	}
 
 	RCC->IOPENR   |=   RCC_IOPENR_GPIOAEN;			/* Enable GPIOA clock */
 	RCC->APB2ENR  |=   RCC_APB2ENR_USART1EN;    /* Enable USART#1 clock */
 	
 	//interrupt init
 	NVIC_EnableIRQ(USART1_IRQn);
-	NVIC_SetPriority(USART1_IRQn,0);
+	NVIC_SetPriority(USART1_IRQn,1);						/* Below LPUART1, its characters come 12 times faster */
 	
 	//Make PA8 an input with a pull up resistor
 	GPIOA->MODER &= ~(( 3ul << 2* 8) | ( 3ul << 2* 8) ); /* Set to input */
@@ -189,10 +373,14 @@ void USART1_Init(void){
 								*	5s Position echo time
 								*	5s Update time 
 								*	Outputs both GGA and RMC message
+							The module is hot or warm started first, see FGPMMOPA6H_Fast_Start
 */
 
 void FGPMMOPA6H_Init(int Refresh_Rate){
 	
+	/* Restart from the last known fix, the restart clears the output settings */
+	FGPMMOPA6H_Fast_Start();
+	
 	/* Initialize Structures */
 	//Init_Structs();
 	if(Refresh_Rate == 1){
@@ -216,6 +404,330 @@ void FGPMMOPA6H_Init(int Refresh_Rate){
 	printf("#####  GPS             Initialized  #####\r\n");
 }
 
+/**
+  \fn					uint32_t Last_Fix_Checksum(GPS_Last_Fix* Fix)
+  \brief			Sums the words of a saved fix, excluding the checksum itself
+	\param			GPS_Last_Fix* Fix: The saved fix
+	\returns		uint32_t Checksum: The sum of the words
+*/
+
+static uint32_t Last_Fix_Checksum(GPS_Last_Fix* Fix){
+	
+	uint32_t Checksum = 0;
+	
+	Checksum += Fix->Magic;
+	Checksum += (uint32_t)Fix->Latitude;
+	Checksum += (uint32_t)Fix->Longitude;
+	Checksum += (uint32_t)Fix->Altitude;
+	Checksum += Fix->Date;
+	Checksum += Fix->Time;
+	Checksum += Fix->TTFF;
+	
+	return(Checksum);
+}
+
+/**
+  \fn					void Format_Degrees(char* Destination, int32_t Microdegrees)
+  \brief			Formats millionths of a degree as signed decimal degrees
+	\param			char* Destination: At least 13 characters
+	\param			int32_t Microdegrees: The angle to format
+*/
+
+static void Format_Degrees(char* Destination, int32_t Microdegrees){
+	
+	const char* Sign = "";
+	
+	if(Microdegrees < 0){
+		Sign = "-";
+		Microdegrees = -Microdegrees;
+	}
+	
+	sprintf(Destination,"%s%i.%06i",Sign,Microdegrees/1000000,Microdegrees%1000000);
+}
+
+/**
+  \fn					void Wait_For_Restart(void)
+  \brief			Waits for the startup message after a restart command, gives up after
+							PMTK_RESTART_TIMEOUT so a missing module does not hang initialization
+*/
+
+static void Wait_For_Restart(void){
+	
+	uint32_t Start = msTicks;
+	
+	SPIN_BEGIN(SPIN_GPS_DATA);
+	while((Module_Restarted == FALSE) && ((msTicks - Start) < PMTK_RESTART_TIMEOUT)){
+		//Nop
+	}
+	SPIN_END(SPIN_GPS_DATA);
+}
+
+/**
+  \fn					void FGPMMOPA6H_Send_Command(char Body[])
+  \brief			Sends a PMTK command, adding the $, checksum and line ending
+	\param			char Body[]: The command without $ or *, i.e. "PMTK101"
+*/
+
+void FGPMMOPA6H_Send_Command(char Body[]){
+	
+	char Command[96] = "";
+	uint8_t Checksum = 0;
+	int i = 0;
+	
+	/* XOR of every character between $ and * */
+	for(i = 0;Body[i] != '\0';i++){
+		Checksum ^= Body[i];
+	}
+	
+	sprintf(Command,"$%s*%02X\r\n",Body,Checksum);
+	USART1_Send(Command);
+}
+
+/**
+  \fn					void FGPMMOPA6H_Fast_Start(void)
+  \brief			Restarts the GPS module as fast as the saved data allows
+							*	Saved fix found: hot start, then seed the last position and time (PMTK741)
+							*	No saved fix: warm start, almanac and time kept in backup RAM are still used
+							The time to first fix is measured from here, see FGPMMOPA6H_Get_TTFF
+*/
+
+void FGPMMOPA6H_Fast_Start(void){
+	
+	/* Local Variables */
+	GPS_Last_Fix Last_Fix;
+	char Latitude[14] = "";
+	char Longitude[14] = "";
+	char Command[96] = "";
+	
+	/* Read the last known fix */
+	EEPROM_Read_Buffer(EEPROM_GPS_FIX_OFFSET,&Last_Fix,sizeof(Last_Fix));
+	
+	Module_Restarted = FALSE;
+	TTFF = 0;
+	TTFF_Start = msTicks;
+	
+	if((Last_Fix.Magic == GPS_LAST_FIX_MAGIC) && (Last_Fix.Checksum == Last_Fix_Checksum(&Last_Fix))){
+		
+		/* Hot start */
+		USART1_Send(PMTK_CMD_HOT_START);
+		Wait_For_Restart();
+		
+		/* Seed position and time: lat,long,alt,YYYY,MM,DD,hh,mm,ss */
+		Format_Degrees(Latitude,Last_Fix.Latitude);
+		Format_Degrees(Longitude,Last_Fix.Longitude);
+		sprintf(
+			Command,"PMTK741,%s,%s,%i,%u,%02u,%02u,%02u,%02u,%02u",
+			Latitude,
+			Longitude,
+			Last_Fix.Altitude,
+			2000 + (Last_Fix.Date % 100),							/* yy */
+			(Last_Fix.Date / 100) % 100,							/* mm */
+			Last_Fix.Date / 10000,										/* dd */
+			Last_Fix.Time / 10000,										/* hh */
+			(Last_Fix.Time / 100) % 100,							/* mm */
+			Last_Fix.Time % 100												/* ss */
+		);
+		FGPMMOPA6H_Send_Command(Command);
+		
+		printf("GPS hot start, last TTFF: %u ms\r\n",Last_Fix.TTFF);
+	}
+	else{
+		
+		/* Warm start */
+		USART1_Send(PMTK_CMD_WARM_START);
+		Wait_For_Restart();
+		
+		printf("GPS warm start, no saved fix\r\n");
+	}
+	
+	/* The restart resets the time of the first fix */
+	TTFF_Start = msTicks;
+}
+
+/**
+  \fn					void FGPMMOPA6H_Save_Fix(GPS_Fix* Current)
+  \brief			Logs the time to first fix and saves the current fix to the data EEPROM,
+							only called once per start to spare the EEPROM
+	\param			GPS_Fix* Current: The first valid fix
+*/
+
+static void FGPMMOPA6H_Save_Fix(GPS_Fix* Current){
+	
+	/* Local Variables */
+	GPS_Last_Fix Last_Fix;
+	
+	/* Time to first fix */
+	TTFF = msTicks - TTFF_Start;
+	if(TTFF == 0){
+		TTFF = 1;
+	}
+	printf("GPS time to first fix: %u ms\r\n",TTFF);
+	
+	/* Build the record */
+	Last_Fix.Magic = GPS_LAST_FIX_MAGIC;
+	Last_Fix.Latitude = Current->Latitude;
+	Last_Fix.Longitude = Current->Longitude;
+	Last_Fix.Altitude = Current->Altitude / 100;
+	Last_Fix.Date = Current->Date;
+	Last_Fix.Time = Current->Time / 1000;
+	Last_Fix.TTFF = TTFF;
+	Last_Fix.Checksum = Last_Fix_Checksum(&Last_Fix);
+	
+	EEPROM_Write_Buffer(EEPROM_GPS_FIX_OFFSET,&Last_Fix,sizeof(Last_Fix));
+}
+
+/**
+  \fn					void FGPMMOPA6H_Set_Protocol(int Protocol)
+  \brief			Selects the format the module sends fixes in
+	\param			int Protocol: GPS_PROTOCOL_NMEA or GPS_PROTOCOL_MTK_BINARY
+							Going back to NMEA needs a power cycle of the module
+*/
+
+void FGPMMOPA6H_Set_Protocol(int Protocol){
+	
+	if(Protocol == GPS_PROTOCOL_MTK_BINARY){
+		USART1_Send(PGCMD_SET_BINARY_OUTPUT);
+		MTK_New_Data_Ready = FALSE;
+		printf("#####  GPS       MTK Binary Output  #####\r\n");
+	}
+	
+	GPS_Protocol = Protocol;
+}
+
+/**
+  \fn					int32_t Read_Int32(uint8_t* Buffer, int Offset)
+  \brief			Reads a little endian 32 bit value from a binary payload
+	\param			uint8_t* Buffer: The payload
+	\param			int Offset: Byte offset of the field
+	\returns		int32_t: The field
+*/
+
+static int32_t Read_Int32(uint8_t* Buffer, int Offset){
+	return((int32_t)((uint32_t)Buffer[Offset] | ((uint32_t)Buffer[Offset + 1] << 8) |
+		((uint32_t)Buffer[Offset + 2] << 16) | ((uint32_t)Buffer[Offset + 3] << 24)));
+}
+
+/**
+  \fn					void FGPMMOPA6H_Decode_Binary(void)
+  \brief			Extracts the fix from the last MTK binary payload
+*/
+
+static void FGPMMOPA6H_Decode_Binary(void){
+	
+	/* Local Variables */
+	uint8_t Payload[MTK_PAYLOAD_LENGTH];
+	int32_t Scale = 10;
+	
+	/* Copy so the interrupt can keep writing */
+	NVIC_DisableIRQ(USART1_IRQn);
+	memcpy(Payload,MTK_Message,MTK_PAYLOAD_LENGTH);
+	if(MTK_Revision == MTK_PREAMBLE1_V16){
+		Scale = 1;
+	}
+	MTK_New_Data_Ready = FALSE;
+	NVIC_EnableIRQ(USART1_IRQn);
+	
+	/* Fixed offset fields */
+	Fix.Latitude = Read_Int32(Payload,MTK_LATITUDE) / Scale;
+	Fix.Longitude = Read_Int32(Payload,MTK_LONGITUDE) / Scale;
+	Fix.Altitude = Read_Int32(Payload,MTK_ALTITUDE);
+	Fix.Ground_Speed = Read_Int32(Payload,MTK_GROUND_SPEED);
+	Fix.Course = Read_Int32(Payload,MTK_COURSE);
+	Fix.Satellites = Payload[MTK_SATELLITES];
+	Fix.Date = (uint32_t)Read_Int32(Payload,MTK_DATE);
+	Fix.Time = (uint32_t)Read_Int32(Payload,MTK_TIME);
+	
+	/* SBAS fixes are reported as 6 and 7 */
+	Fix.Fix_Type = Payload[MTK_FIX_TYPE];
+	if(Fix.Fix_Type > 3){
+		Fix.Fix_Type -= 4;
+	}
+	Fix.Valid = (Fix.Fix_Type >= 2) ? TRUE : FALSE;
+}
+
+/**
+  \fn					void FGPMMOPA6H_Decode_NMEA(void)
+  \brief			Converts the last RMC and GGA sentences into the fix
+*/
+
+static void FGPMMOPA6H_Decode_NMEA(void){
+	
+	/* Local Variables */
+	int32_t Value = 0;
+	
+	/* Parse the RMC and GGA data */
+	FGPMMOPA6H_Parse_RMC_Data();
+	FGPMMOPA6H_Parse_GGA();
+	
+	/* Straight to fixed point, fields that fail to parse keep their last value */
+	NMEA_Parse_Coordinate(RMC.Latitude,RMC.N_S_Indicator[0],&Fix.Latitude);
+	NMEA_Parse_Coordinate(RMC.Longitude,RMC.E_W_Indicator[0],&Fix.Longitude);
+	NMEA_Parse_Meters(GGA.MSL_Altitude,&Fix.Altitude);
+	NMEA_Parse_Knots(RMC.Speed_Over_Ground,&Fix.Ground_Speed);
+	NMEA_Parse_Fixed(RMC.Course_Over_Ground,2,&Fix.Course);
+	NMEA_Parse_Time(RMC.UTC_Time,&Fix.Time);
+	if(NMEA_Parse_Fixed(GGA.Satellites_Used,0,&Value)){
+		Fix.Satellites = (uint8_t)Value;
+	}
+	if(NMEA_Parse_Fixed(RMC.Date,0,&Value)){
+		Fix.Date = (uint32_t)Value;
+	}
+	Fix.Valid = FGPMMOPA6H_Get_RMC_Status();
+	Fix.Fix_Type = Fix.Valid ? 3 : 1;
+	
+	/* Data has been read */
+	RMC.New_Data_Ready = 0;
+	GGA.New_Data_Ready = 0;
+}
+
+/**
+  \fn					int FGPMMOPA6H_Fix_Ready(void)
+  \brief			Checks for a new fix in the current protocol
+	\returns		int: 1 - New fix recieved, 0 - Nothing new
+*/
+
+int FGPMMOPA6H_Fix_Ready(void){
+	
+	if(GPS_Protocol == GPS_PROTOCOL_MTK_BINARY){
+		return(MTK_New_Data_Ready);
+	}
+	
+	return(RMC.New_Data_Ready);
+}
+
+/**
+  \fn					GPS_Fix* FGPMMOPA6H_Get_Fix(void)
+  \brief			Decodes the newest fix, call once FGPMMOPA6H_Fix_Ready returns 1
+	\returns		GPS_Fix* Fix: The decoded fix
+*/
+
+GPS_Fix* FGPMMOPA6H_Get_Fix(void){
+	
+	if(GPS_Protocol == GPS_PROTOCOL_MTK_BINARY){
+		FGPMMOPA6H_Decode_Binary();
+	}
+	else{
+		FGPMMOPA6H_Decode_NMEA();
+	}
+	
+	/* First fix since the restart */
+	if((Fix.Valid == TRUE) && (TTFF == 0)){
+		FGPMMOPA6H_Save_Fix(&Fix);
+	}
+	
+	return(&Fix);
+}
+
+/**
+  \fn					uint32_t FGPMMOPA6H_Get_TTFF(void)
+  \brief			Retrieves the time to first fix of this start
+	\returns		uint32_t TTFF: Time to first fix in ms, 0 if there is no fix yet
+*/
+
+uint32_t FGPMMOPA6H_Get_TTFF(void){
+	return(TTFF);
+}
+
 /**
 	\fn				char USART1_PutChar(char ch)
 	\brief		Puts a character to the USART
@@ -225,9 +737,11 @@ void FGPMMOPA6H_Init(int Refresh_Rate){
 char USART1_PutChar(char ch) {
 
 	//Wait for buffer to be empty
+  SPIN_BEGIN(SPIN_USART1_TXE);
   while ((USART1->ISR & USART_ISR_TXE) == 0){
 			//Nop
 	}
+  SPIN_END(SPIN_USART1_TXE);
 	
 	//Send character
   USART1->TDR = (ch);
@@ -259,43 +773,23 @@ void USART1_Send(char c[]){
 void FGPMMOPA6H_Parse_GGA(void){
 	
 	//Local Variables
-	char GGA_Message_Copy[128] = "";
 	const char delimeter[2] = ",";
 	char *token = "";
 	int i = 0;
-	char temp[15][12];		/* [15][12]: 15 strings, of length 12 */
 	
 	/* Copy original GGA message */
-	strcpy(GGA_Message_Copy,GGA_Message);
+	strcpy(NMEA_Copy,GGA_Message);
 	
 	//Seperate message
 	/* get the first token */
-	token = strtok(GGA_Message_Copy, delimeter);
-	
-	/* Walk through other tokens */
-	while( token != NULL ) 
-   {
-		 strcpy(temp[i],token);
-		 i++;
-     token = strtok(NULL, delimeter);
-   }
-	 
-	/* Copy the message into its individual components */
-	strcpy(GGA.Message_ID,temp[0]);
-	strcpy(GGA.UTC_Time,temp[1]);
-	strcpy(GGA.Latitude,temp[2]);
-	strcpy(GGA.N_S_Indicator,temp[3]);
-	strcpy(GGA.Longitude,temp[4]);
-	strcpy(GGA.E_W_Indicator,temp[5]);
-	strcpy(GGA.Position_Indicator,temp[6]);
-	strcpy(GGA.Satellites_Used,temp[7]);
-	strcpy(GGA.HDOP,temp[8]);
-	strcpy(GGA.MSL_Altitude,temp[9]);
-	strcpy(GGA.Units_Altitude,temp[10]);
-	strcpy(GGA.Geoidal_Seperation,temp[11]);
-	strcpy(GGA.Units_Geoidal_Seperation,temp[12]);
-	strcpy(GGA.Age_Of_Diff_Corr,temp[13]);
-	strcpy(GGA.Checksum,temp[14]);
+	token = strtok(NMEA_Copy, delimeter);
+	
+	/* Walk through other tokens, each goes straight into its component */
+	while((token != NULL) && (i < GGA_FIELDS)){
+		Copy_Field((char*)&GGA + GGA_Fields[i].Offset,GGA_Fields[i].Size,token);
+		i++;
+		token = strtok(NULL, delimeter);
+	}
 }
 
 /**
@@ -329,39 +823,23 @@ void Print_GGA_Data(void){
 void FGPMMOPA6H_Parse_RMC_Data(void){
 	
 	//Local Variables
-	char RMC_Message_Copy[128] = "";
 	const char delimeter[2] = ",";
 	char *token = "";
 	int i = 0;
-	char temp[11][12];			/* [11][12]: 11 strings, of length 12 */
 	
 	//Copy original RMC to a copy in order to not destroy message
-	strcpy(RMC_Message_Copy,RMC_Message);
+	strcpy(NMEA_Copy,RMC_Message);
 	
 	//Seperated Message
 	/* get the first token */
-   token = strtok(RMC_Message_Copy, delimeter);
-   
-   /* walk through other tokens */
-   while( token != NULL ) 
-   {
-		 strcpy(temp[i],token);
-		 i++;
-     token = strtok(NULL, delimeter);
-   }
-	 
-	 //Copy the message into its individual components
-	strcpy(RMC.Message_ID,temp[0]);
-	strcpy(RMC.UTC_Time,temp[1]);
-	strcpy(RMC.Status,temp[2]);
-	strcpy(RMC.Latitude,temp[3]);
-	strcpy(RMC.N_S_Indicator,temp[4]);
-	strcpy(RMC.Longitude,temp[5]);
-	strcpy(RMC.E_W_Indicator,temp[6]);
-	strcpy(RMC.Speed_Over_Ground,temp[7]);
-	strcpy(RMC.Course_Over_Ground,temp[8]);
-	strcpy(RMC.Date,temp[9]);
-	strcpy(RMC.Mode,temp[10]);
+	token = strtok(NMEA_Copy, delimeter);
+	
+	/* Walk through other tokens, each goes straight into its component */
+	while((token != NULL) && (i < RMC_FIELDS)){
+		Copy_Field((char*)&RMC + RMC_Fields[i].Offset,RMC_Fields[i].Size,token);
+		i++;
+		token = strtok(NULL, delimeter);
+	}
 }
 
 /**
@@ -391,24 +869,17 @@ void Print_RMC_Data(void){
 char* FGPMMOPA6H_Get_RMC_UTC_Time(void){
 	
 	/* Local Variables */
-	char hh[3] = "";
-	char mm[3] = "";
-	char ss[3] = "";
-//	char sss[5] = "";
+	uint32_t Time = 0;
 	int Hours = 0;
 	
-	/* Parse original UTC time */
-	strncpy(hh,RMC.UTC_Time,2);
-	strncpy(mm,(RMC.UTC_Time+2),2);
-	strncpy(ss,(RMC.UTC_Time+4),2);
-//	strncpy(sss,(RMC.UTC_Time+7),3);		//We want to skip the decimal point
+	/* Parse original UTC time, hhmmssmmm */
+	NMEA_Parse_Time(RMC.UTC_Time,&Time);
 	
-	/* Convert to integer and calculate TRF time */
-	Hours = atoi(hh);
-	Hours -= 5;
+	/* Calculate TRF time, UTC - 5 hours */
+	Hours = ((Time / 10000000) + 19) % 24;
 	
 	/* Put into time format */
-	sprintf(GPS.TRF_Time,"%i:%s:%s",Hours,mm,ss);
+	sprintf(GPS.TRF_Time,"%i:%02i:%02i",Hours,(Time / 100000) % 100,(Time / 1000) % 100);
 	
 	return(GPS.TRF_Time);
 }
@@ -470,15 +941,16 @@ char* FGPMMOPA6H_Get_RMC_Longitude(void){
 float FGPMMOPA6H_Get_RMC_Ground_Speed(void){
 	
 	/* Local Variables */
-	float MPH_Conversion = 1.15077945;	/* 1 Knot = 1.15..MPH */
+	int32_t Knots = 0;									/* Hundredths of a knot */
 	
 	GPS.Ground_Speed = 0.0;
 	
 	/* Get ground speed */
-	GPS.Ground_Speed = atof(RMC.Speed_Over_Ground);
-	
-	/* Convert Knots to MPH */
-	GPS.Ground_Speed *= MPH_Conversion;
+	if(NMEA_Parse_Fixed(RMC.Speed_Over_Ground,2,&Knots)){
+		
+		/* Convert Knots to MPH, 1 Knot = 1.151 MPH */
+		GPS.Ground_Speed = ((Knots * 1151) / 1000) / 100.0f;
+	}
 	
 	return(GPS.Ground_Speed);
 }
@@ -529,11 +1001,20 @@ char* FGPMMOPA6H_Get_RMC_Date(void){
 
 char* FGPMMOPA6H_Get_GGA_Altitude(void){
 	
-	float Altitude_In_Ft = 0.0;
+	/* Local Variables */
+	int32_t Altitude = 0;
+	const char* Sign = "";
+	
+	/* Centimeters to tenths of a foot, 1 ft = 30.48 cm */
+	NMEA_Parse_Meters(GGA.MSL_Altitude,&Altitude);
+	Altitude = (Altitude * 1000) / 3048;
 	
-	Altitude_In_Ft = atof(GGA.MSL_Altitude) * 3.28084;
+	if(Altitude < 0){
+		Sign = "-";
+		Altitude = -Altitude;
+	}
 	
-	sprintf(GPS.Altitude,"%f",Altitude_In_Ft);
+	sprintf(GPS.Altitude,"%s%i.%i",Sign,Altitude / 10,Altitude % 10);
 	
 	return(GPS.Altitude);
 }
@@ -547,9 +1028,11 @@ char* FGPMMOPA6H_Get_GGA_Altitude(void){
 void FGPMMOPA6H_Get_GPS_Data(void){
 	
 	/* Wait for New data to come */
+	SPIN_BEGIN(SPIN_GPS_DATA);
 	while(RMC.New_Data_Ready == 0){
 		//Nop
 	}
+	SPIN_END(SPIN_GPS_DATA);
 	/* Parse the RMC and GCC data */
 	FGPMMOPA6H_Parse_RMC_Data();
 	FGPMMOPA6H_Parse_GGA();
@@ -560,7 +1043,7 @@ void FGPMMOPA6H_Get_GPS_Data(void){
 	printf("Time: %s\r\n",FGPMMOPA6H_Get_RMC_UTC_Time());
 	printf("Latitude: %s\r\n",FGPMMOPA6H_Get_RMC_Latitude());
 	printf("Longitude: %s\r\n",FGPMMOPA6H_Get_RMC_Longitude());
-	printf("Speed: %f MPH\r\n",FGPMMOPA6H_Get_RMC_Ground_Speed());
+	printf("Speed: %i MPH\r\n",(int)(FGPMMOPA6H_Get_RMC_Ground_Speed() + 0.5f));		/* No %f, keeps the float printf out */
 	printf("Altitude: %s ft \r\n",FGPMMOPA6H_Get_GGA_Altitude());
 		
 	/* Data has been read, set new data ready to 0 */
@@ -568,61 +1051,6 @@ void FGPMMOPA6H_Get_GPS_Data(void){
 	GGA.New_Data_Ready = 0;
 }
 
-/**
-  \fn					char* FGPMMOPA6H_Package_Data(void)
-  \brief			Packages GPS Data
-	\returns		GPS_Data.Packaged: All the data chosen to format
-*/
-
-char* FGPMMOPA6H_Package_Data(void){
-	
-	/* Local Variables */
-	int i;
-	char Temp[128] = "";
-	int Checksum = 0;
-	
-	/* Wait for New data to come */
-	while(RMC.New_Data_Ready == 0){
-		//Nop
-	}
-	
-	/* Parse the RMC and GCC data */
-	FGPMMOPA6H_Parse_RMC_Data();
-	FGPMMOPA6H_Parse_GGA();
-	
-	if(FGPMMOPA6H_Get_RMC_Status() == 1){
-		
-		/* Package the data */
-		sprintf(
-			Temp,"%s,%s,%s,%s,%s,%f,%s",										/* GPS.Packaged is destination */
-			FGPMMOPA6H_Get_RMC_UTC_Time(),							/* TRF Time										 */
-			RMC.Latitude,																/* Latitude										 */
-			RMC.N_S_Indicator,													/* North or South							 */
-			RMC.Longitude,															/* Longitude									 */
-			RMC.E_W_Indicator,													/* East or West								 */
-			FGPMMOPA6H_Get_RMC_Ground_Speed(),					/* Speed											 */
-			GGA.MSL_Altitude														/* Altitude										 */
-		);
-		
-			/* Create Checksum */
-	for(i = 0;i < sizeof(Temp);i++){
-		Checksum += Temp[i];
-	}
-	
-	sprintf(GPS.Packaged,"$%s*%i\r\n",Temp,Checksum);
-	}
-	
-	else{
-		sprintf(GPS.Packaged,"");
-	}
-	
-	/* Data has been read, set new data ready to 0 */
-	RMC.New_Data_Ready = 0;
-	GGA.New_Data_Ready = 0;
-	
-	return(GPS.Packaged);
-}
-
 /**
   \fn					void Init_Structs(void)
   \brief			Clears all the structs
@@ -667,6 +1095,5 @@ char* FGPMMOPA6H_Package_Data(void){
 //	memset(GPS.Date,0,sizeof(GPS.Date));
 //	memset(GPS.Latitude,0,sizeof(GPS.Latitude));
 //	memset(GPS.Longitude,0,sizeof(GPS.Longitude));
-//	memset(GPS.Packaged,0,sizeof(GPS.Packaged));
 //	memset(GPS.TRF_Time,0,sizeof(GPS.TRF_Time));
 //}
@@ -17,11 +17,8 @@
 #define FGPMMOPA6H_H
 
 extern volatile uint8_t Transmission_In_Progress;
-extern char 						GGA_Message[128];											/* Original GGA message */
-extern char 						GSA_Message[128];											/* Original GSA message */
-extern char 						GSV_Message[128];											/* Original GSV message */
-extern char 						RMC_Message[128];											/* Original RMC message */
-extern char 						VTG_Message[128];											/* Original VTG message */
+extern char* 						GGA_Message;													/* Original GGA message */
+extern char* 						RMC_Message;													/* Original RMC message */
 
 /* Raw RMC data */
 typedef struct RMC_Data
@@ -34,7 +31,7 @@ typedef struct RMC_Data
 	char N_S_Indicator[3];				/* N = North, S = South */
 	char Longitude[11];						/* dddmm.mmmm */
 	char E_W_Indicator[3];				/* E = East, W = West */
-	char Speed_Over_Ground[5];		/* In Knots */
+	char Speed_Over_Ground[8];		/* In Knots, up to 9999.99 */
 	char Course_Over_Ground[7];		/* Degrees */
 	char Date[7];									/* ddmmyy */
 	char Mode[5];									/* A = autonomous mode, D = Differential mode, E = Estimated mode */
@@ -53,7 +50,7 @@ typedef struct GGA_Data
 	char Position_Indicator[2];				/* 0 = Fix not available, 1 = GPS Fix, 2 = Differential GPS fix */
 	char Satellites_Used[3];					/* Range from 0 - 14 */
 	char HDOP[5];											/* Horizontal Dilution of Precision */
-	char MSL_Altitude[6];							/* Antenna Altitude above or below mean sea level */
+	char MSL_Altitude[9];							/* Antenna Altitude above or below mean sea level, up to -99999.9 */
 	char Units_Altitude[2];						/* Units of antenna altitude */
 	char Geoidal_Seperation[6];				/*  */
 	char Units_Geoidal_Seperation[2];	/* Units for geoidal seperation */
@@ -65,18 +62,53 @@ typedef struct GGA_Data
 typedef struct GPS_Data
 {
 	int Valid_Data;
-	char Altitude[5];
+	char Altitude[16];
 	char TRF_Time[15];
 	char Date[9];
 	char Latitude[15];
 	char Longitude[15];
 	float Ground_Speed;
-	char Packaged[128];								/* Repackaged Data */
 }GPS_Data;
 
+/* Decoded fix, filled from either NMEA or MTK binary messages */
+typedef struct GPS_Fix
+{
+	int Valid;												/* 1 when the module reports a 2D or 3D fix */
+	int32_t Latitude;									/* Millionths of a degree, + North */
+	int32_t Longitude;								/* Millionths of a degree, + East */
+	int32_t Altitude;									/* Centimeters above mean sea level */
+	int32_t Ground_Speed;							/* Centimeters per second */
+	int32_t Course;										/* Hundredths of a degree */
+	uint8_t Satellites;								/* Satellites used */
+	uint8_t Fix_Type;									/* 1 = No fix, 2 = 2D, 3 = 3D */
+	uint32_t Date;										/* ddmmyy */
+	uint32_t Time;										/* hhmmssmmm UTC */
+}GPS_Fix;
+
+/* Last known fix, kept in the data EEPROM to seed the next start */
+typedef struct GPS_Last_Fix
+{
+	uint32_t Magic;										/* GPS_LAST_FIX_MAGIC when written */
+	int32_t Latitude;									/* Millionths of a degree, + North */
+	int32_t Longitude;								/* Millionths of a degree, + East */
+	int32_t Altitude;									/* Meters above mean sea level */
+	uint32_t Date;										/* ddmmyy */
+	uint32_t Time;										/* hhmmss UTC */
+	uint32_t TTFF;										/* Time to first fix of the start that saved this (ms) */
+	uint32_t Checksum;								/* Sum of the words above */
+}GPS_Last_Fix;
+
+/* Input protocols */
+#define GPS_PROTOCOL_NMEA						0				/* ASCII NMEA sentences, default */
+#define GPS_PROTOCOL_MTK_BINARY			1				/* MTK binary (DIYDrones v1.9 firmware) */
+
 /* Initialization methods */
 extern void USART1_Init(void);
 extern void FGPMMOPA6H_Init(int Refresh_Rate);
+extern void FGPMMOPA6H_Fast_Start(void);
+extern void FGPMMOPA6H_Send_Command(char Body[]);
+extern uint32_t FGPMMOPA6H_Get_TTFF(void);
+extern void FGPMMOPA6H_Set_Protocol(int Protocol);
 
 /* USART Methods */
 extern int USART1_GetChar(void);
@@ -95,11 +127,15 @@ extern char* FGPMMOPA6H_Get_RMC_Date(void);
 extern void Print_RMC_Data(void);
 
 /* GGA Data */
+extern void FGPMMOPA6H_Parse_GGA(void);
 extern char* FGPMMOPA6H_Get_GGA_Altitude(void);
 
+/* Fix Data, independent of the protocol */
+extern int FGPMMOPA6H_Fix_Ready(void);
+extern GPS_Fix* FGPMMOPA6H_Get_Fix(void);
+
 /*GPS Data*/
 extern void FGPMMOPA6H_Get_GPS_Data(void);
-extern char* FGPMMOPA6H_Package_Data(void);
 
 void Init_Structs(void);
 #endif
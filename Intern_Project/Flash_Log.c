@@ -0,0 +1,542 @@
+/*------------------------------------------------------------------------------------------------------
+ * Name:    Flash_Log.c
+ * Purpose: Black box log of binary records in SPI NOR flash
+ * Date: 		10/19/26
+ * Author:	Christopher Jordan - Denny
+ *------------------------------------------------------------------------------------------------------
+ * Note(s): The radio only carries what the byte budget allows, this keeps every sample on board.
+						Records are packed into a page in RAM and the page is programmed while the next one
+						fills, so Flash_Log_Append never waits for the chip. The chip is reached through a
+						Flash_Log_Device, NOR_Flash.c on the board and Tools/Flash_Log_Sim.c on the host, and
+						only stdint, stdio and string are used so the host can build this file as is.
+
+						Page Layout:
+						------------
+						*	0		Sequence			uint32, +1 every page, little endian
+						*	4		Check					uint32, ~Sequence
+						*	8		Records				Back to back, the rest of the page stays 0xFF
+
+						Record Layout:
+						--------------
+						*	0		Length				uint8, 1 to FLASH_LOG_MAX_RECORD, 0xFF ends the page
+						*	1		Data					Length bytes
+						*	n		CRC						uint16 CRC-16/CCITT (init 0xFFFF) of Length and Data, little endian
+
+						Erase Ahead:
+						------------
+						*	The log is a ring of whole sectors, the oldest sector is erased to make room
+						*	Sectors are erased while nothing is waiting to be programmed, until
+							FLASH_LOG_ERASE_AHEAD sectors in front of the write page are clean
+						*	A 4 KB erase takes ~45 ms and up to 400 ms, longer than the two pages of RAM last
+							at 100 records a second. When a page fills during an erase ahead the erase is
+							suspended, the page programmed and the erase resumed, so a page only waits for an
+							erase (Late_Erases) when the log is written faster than it can be erased
+						*	Nothing is erased before the first Append or Poll, so a power up alone never costs
+							the oldest sectors. Flash_Log_Close stops erasing ahead for good, what is in the chip
+							then stays until the next Flash_Log_Init
+						*	Tools/Flash_Log_Sim.c has the rates this keeps up with
+
+						Power Loss:
+						-----------
+						*	What is lost is the page being filled and the page being programmed, at most
+							2*FLASH_LOG_PAGE bytes. Every record in a programmed page is whole
+						*	A page cut off while programming can hold any mix of old and new bits. Its header
+							fails the complement check or its records fail their CRC, the reader skips it and
+							the pages around it read normally
+						*	Flash_Log_Init finds the newest sector from the first page of each sector and
+							carries on at the first page of it that is still all 0xFF. Sectors in front of that
+							are erased again before they are used, an erase that was cut off is never trusted
+
+						Dump:
+						-----
+						*	Flash_Log_Dump sends the whole log, oldest first, as one packet for
+							Tools/Flash_Log_Decode:
+
+							Byte		Field
+							0-1			Sync 'F' 'L'
+							2..			Every record read back as it is in the chip: Length, Data, CRC
+							end			Length 0, then the damaged pages skipped as uint16, little endian
+						*	At 9600 baud it takes ~60 s per 64 KB of log
+ *----------------------------------------------------------------------------------------------------*/
+
+/*---------------------------------------------Include Statements-------------------------------------*/
+#include <stdio.h>										// Printf
+#include <string.h>										// Memset, memcpy
+#include "Telemetry.h"								// CRC-16
+#include "Flash_Log.h"
+/*---------------------------------------------Definitions--------------------------------------------*/
+#define NO_PAGE										-1
+#define HEADER_VALID							1
+#define HEADER_ERASED							0
+#define HEADER_DAMAGED						-1
+/*---------------------------------------------Globals------------------------------------------------*/
+static const Flash_Log_Device*	Chip = 0;									/* 0 until Flash_Log_Init succeeds */
+static uint32_t									Log_Size = 0;							/* Bytes, whole sectors */
+static uint8_t*									Pages[2];
+static int											Filling = 0;							/* Page records go into */
+static int											Used = FLASH_LOG_PAGE_HEADER;	/* Bytes of it taken */
+static int											Waiting = NO_PAGE;				/* Full page not programmed yet */
+static int											Programming = 0;					/* Waiting is on the chip */
+static int											Erasing = 0;
+static int											Suspended = 0;						/* Erasing, paused for a program */
+static uint32_t									Erased_To = 0;						/* Write_Address up to here is clean */
+static int											Closed = 0;								/* No more records or erases ahead */
+static Flash_Log_Stats					Stats;
+/*---------------------------------------------Functions----------------------------------------------*/
+
+/**
+  \fn					uint32_t Next(uint32_t Address, uint32_t Step)
+  \brief			Steps around the ring
+*/
+
+static uint32_t Next(uint32_t Address, uint32_t Step){
+	
+	Address += Step;
+	if(Address >= Log_Size){
+		Address -= Log_Size;
+	}
+	
+	return(Address);
+}
+
+/**
+  \fn					void Put_Header(uint8_t* Page, uint32_t Sequence)
+  \brief			Writes the sequence and its complement
+*/
+
+static void Put_Header(uint8_t* Page, uint32_t Sequence){
+	
+	int i = 0;
+	
+	for(i = 0;i < 4;i++){
+		Page[i] = (uint8_t)(Sequence >> (8*i));
+		Page[i + 4] = (uint8_t)(~Sequence >> (8*i));
+	}
+}
+
+/**
+  \fn					int Get_Header(const uint8_t* Page, uint32_t* Sequence)
+  \brief			Reads a page header
+	\returns		int: HEADER_VALID, HEADER_ERASED or HEADER_DAMAGED
+*/
+
+static int Get_Header(const uint8_t* Page, uint32_t* Sequence){
+	
+	uint32_t Check = 0;
+	int Erased = 1;
+	int i = 0;
+	
+	*Sequence = 0;
+	for(i = 0;i < 4;i++){
+		*Sequence |= (uint32_t)Page[i] << (8*i);
+		Check |= (uint32_t)Page[i + 4] << (8*i);
+	}
+	for(i = 0;i < FLASH_LOG_PAGE_HEADER;i++){
+		if(Page[i] != FLASH_LOG_ERASED){
+			Erased = 0;
+		}
+	}
+	
+	if(Erased){
+		return(HEADER_ERASED);
+	}
+	
+	return((*Sequence == ~Check) ? HEADER_VALID : HEADER_DAMAGED);
+}
+
+/**
+  \fn					void Close_Page(void)
+  \brief			Hands the filling page over to be programmed and starts a clean one
+*/
+
+static void Close_Page(void){
+	
+	Put_Header(Pages[Filling],Stats.Page_Sequence++);
+	Waiting = Filling;
+	
+	Filling ^= 1;
+	memset(Pages[Filling],FLASH_LOG_ERASED,FLASH_LOG_PAGE);
+	Used = FLASH_LOG_PAGE_HEADER;
+}
+
+/**
+  \fn					void Start_Erase(void)
+  \brief			Erases the first sector past the clean ones
+*/
+
+static void Start_Erase(void){
+	
+	Chip->Erase(Erased_To);
+	Erasing = 1;
+}
+
+/**
+  \fn					int Flash_Log_Init(const Flash_Log_Device* Device, uint32_t Size, uint8_t* Buffer)
+  \brief			Finds the end of the log already in the chip and carries on after it, reads the first
+							page of every sector so it waits for the chip
+	\param			const Flash_Log_Device* Device: The chip
+	\param			uint32_t Size: Bytes of the chip given to the log, rounded down to whole sectors
+	\param			uint8_t* Buffer: FLASH_LOG_BUFFER bytes, kept for good
+	\returns		int: 1 if the log is ready, 0 if Size or Buffer can't hold it, Flash_Log_Append then
+							turns every record away
+*/
+
+int Flash_Log_Init(const Flash_Log_Device* Device, uint32_t Size, uint8_t* Buffer){
+	
+	/* Local Variables */
+	uint8_t Header[FLASH_LOG_PAGE_HEADER];
+	uint32_t Sequence = 0;
+	uint32_t Newest = 0;
+	uint32_t Address = 0;
+	int Found = 0;
+	int i = 0;
+	
+	Chip = 0;
+	Size &= ~(uint32_t)(FLASH_LOG_SECTOR - 1);
+	if((Device == 0) || (Buffer == 0) || (Size < ((FLASH_LOG_ERASE_AHEAD + 2)*FLASH_LOG_SECTOR))){
+		return(0);
+	}
+	
+	memset(&Stats,0,sizeof(Stats));
+	Log_Size = Size;
+	Pages[0] = Buffer;
+	Pages[1] = Buffer + FLASH_LOG_PAGE;
+	
+	/* Newest sector */
+	for(Address = 0;Address < Log_Size;Address += FLASH_LOG_SECTOR){
+		Device->Read(Address,Header,FLASH_LOG_PAGE_HEADER);
+		if((Get_Header(Header,&Sequence) == HEADER_VALID) && ((Found == 0) || (Sequence >= Stats.Page_Sequence))){
+			Stats.Page_Sequence = Sequence;
+			Newest = Address;
+			Found = 1;
+		}
+	}
+	
+	/* First clean page in it, or the next sector once it is full */
+	if(Found){
+		Stats.Page_Sequence++;
+		Erased_To = Next(Newest,FLASH_LOG_SECTOR);
+		Stats.Write_Address = Erased_To;
+		for(Address = Newest + FLASH_LOG_PAGE;Address < (Newest + FLASH_LOG_SECTOR);Address += FLASH_LOG_PAGE){
+			Device->Read(Address,Pages[0],FLASH_LOG_PAGE);
+			for(i = 0;(i < FLASH_LOG_PAGE) && (Pages[0][i] == FLASH_LOG_ERASED);i++){
+				//Nop
+			}
+			if(i == FLASH_LOG_PAGE){
+				Stats.Write_Address = Address;
+				break;
+			}
+			if((Get_Header(Pages[0],&Sequence) == HEADER_VALID) && (Sequence >= Stats.Page_Sequence)){
+				Stats.Page_Sequence = Sequence + 1;
+			}
+		}
+	}
+	else{
+		Stats.Page_Sequence = 0;
+		Stats.Write_Address = 0;
+		Erased_To = 0;
+	}
+	
+	Filling = 0;
+	Waiting = NO_PAGE;
+	Programming = 0;
+	Erasing = 0;
+	Suspended = 0;
+	Closed = 0;
+	memset(Pages[Filling],FLASH_LOG_ERASED,FLASH_LOG_PAGE);
+	Used = FLASH_LOG_PAGE_HEADER;
+	Chip = Device;
+	
+	return(1);
+}
+
+/**
+  \fn					int Flash_Log_Append(const uint8_t* Data, int Length)
+  \brief			Adds a record to the page being filled, never waits for the chip
+	\param			const uint8_t* Data: Record
+	\param			int Length: Bytes, 1 to FLASH_LOG_MAX_RECORD
+	\returns		int: 1 if it was added, 0 if both pages are full or the log isn't ready or closed
+*/
+
+int Flash_Log_Append(const uint8_t* Data, int Length){
+	
+	/* Local Variables */
+	uint8_t* Record;
+	uint16_t CRC = 0;
+	
+	if((Chip == 0) || Closed || (Length <= 0) || (Length > FLASH_LOG_MAX_RECORD)){
+		return(0);
+	}
+	
+	/* Start programming the page as soon as it is full */
+	if((Used + FLASH_LOG_RECORD_HEADER + Length + FLASH_LOG_RECORD_CRC) > FLASH_LOG_PAGE){
+		if(Waiting != NO_PAGE){
+			Stats.Dropped++;
+			return(0);
+		}
+		Close_Page();
+		Flash_Log_Poll();
+	}
+	
+	Record = Pages[Filling] + Used;
+	Record[0] = (uint8_t)Length;
+	memcpy(Record + FLASH_LOG_RECORD_HEADER,Data,Length);
+	CRC = Telemetry_CRC16(Record,FLASH_LOG_RECORD_HEADER + Length,0xFFFF);
+	Record[FLASH_LOG_RECORD_HEADER + Length] = (uint8_t)CRC;
+	Record[FLASH_LOG_RECORD_HEADER + Length + 1] = (uint8_t)(CRC >> 8);
+	
+	Used += FLASH_LOG_RECORD_HEADER + Length + FLASH_LOG_RECORD_CRC;
+	Stats.Records++;
+	
+	return(1);
+}
+
+/**
+  \fn					void Flash_Log_Poll(void)
+  \brief			Finishes what the chip was doing and starts the next program or erase, a waiting
+							page goes first
+*/
+
+void Flash_Log_Poll(void){
+	
+	if(Chip == 0){
+		return;
+	}
+	
+	/* A full page doesn't wait for an erase ahead, only for the sector it goes in */
+	if(Erasing && (Suspended == 0) && (Waiting != NO_PAGE) && (Chip->Suspend != 0) && (Erased_To != Stats.Write_Address)){
+		Chip->Suspend();
+		Suspended = 1;
+		Stats.Suspends++;
+	}
+	
+	if(Chip->Busy()){
+		return;
+	}
+	
+	if(Programming){
+		Programming = 0;
+		Waiting = NO_PAGE;
+		Stats.Pages++;
+		Stats.Write_Address = Next(Stats.Write_Address,FLASH_LOG_PAGE);
+	}
+	if(Erasing && (Suspended == 0)){
+		Erasing = 0;
+		Stats.Erases++;
+		Erased_To = Next(Erased_To,FLASH_LOG_SECTOR);
+	}
+	
+	if(Waiting != NO_PAGE){
+		if(Erased_To != Stats.Write_Address){
+			Chip->Program(Stats.Write_Address,Pages[Waiting],FLASH_LOG_PAGE);
+			Programming = 1;
+			return;
+		}
+		if(Erasing == 0){
+			Stats.Late_Erases++;
+			Start_Erase();
+			return;
+		}
+	}
+	
+	/* Nothing to program, get ahead on erasing */
+	if(Suspended){
+		Chip->Resume();
+		Suspended = 0;
+	}
+	else if((Erasing == 0) && (Closed == 0) && (((Erased_To + Log_Size - Stats.Write_Address) % Log_Size) < (FLASH_LOG_ERASE_AHEAD*FLASH_LOG_SECTOR))){
+		Start_Erase();
+	}
+}
+
+/**
+  \fn					int Flash_Log_Flush(void)
+  \brief			Sends the page being filled to be programmed even though it isn't full, the rest of
+							it is left unused
+	\returns		int: 1 once it has been handed over, 0 if the other page is still waiting, call again
+*/
+
+int Flash_Log_Flush(void){
+	
+	if((Chip == 0) || (Used == FLASH_LOG_PAGE_HEADER)){
+		return(1);
+	}
+	if(Waiting != NO_PAGE){
+		Flash_Log_Poll();
+		return(0);
+	}
+	
+	Close_Page();
+	Flash_Log_Poll();
+	
+	return(1);
+}
+
+/**
+  \fn					int Flash_Log_Idle(void)
+  \brief			Nothing is waiting for or on the chip, Flash_Log_Poll has to run to notice
+	\returns		int: 1 if idle
+*/
+
+int Flash_Log_Idle(void){
+	
+	return((Chip == 0) || ((Waiting == NO_PAGE) && (Erasing == 0)));
+}
+
+/**
+  \fn					int Flash_Log_Close(void)
+  \brief			Ends the log: the page being filled is programmed, Append turns records away and no
+							more sectors are erased ahead. Call until it returns 1
+	\returns		int: 1 once everything is on the chip and the chip is idle
+*/
+
+int Flash_Log_Close(void){
+	
+	Closed = 1;
+	if(Flash_Log_Flush() == 0){
+		return(0);
+	}
+	Flash_Log_Poll();
+	
+	return(Flash_Log_Idle());
+}
+
+/**
+  \fn					void Flash_Log_Start_Read(Flash_Log_Cursor* Cursor)
+  \brief			Points a cursor at the oldest page, the sector after the one being written
+	\param			Flash_Log_Cursor* Cursor: Filled in
+*/
+
+void Flash_Log_Start_Read(Flash_Log_Cursor* Cursor){
+	
+	Cursor->Address = Next(Stats.Write_Address & ~(uint32_t)(FLASH_LOG_SECTOR - 1),FLASH_LOG_SECTOR);
+	Cursor->Pages_Left = (Chip != 0) ? (Log_Size/FLASH_LOG_PAGE) : 0;
+	Cursor->Offset = 0;
+	Cursor->Bad_Pages = 0;
+}
+
+/**
+  \fn					int Flash_Log_Read(Flash_Log_Cursor* Cursor, uint8_t* Data)
+  \brief			Reads the next whole record, pages that are damaged are skipped. Only what has been
+							programmed is read, so Flush and wait for Flash_Log_Idle first
+	\param			Flash_Log_Cursor* Cursor: From Flash_Log_Start_Read
+	\param			uint8_t* Data: FLASH_LOG_MAX_RECORD + FLASH_LOG_RECORD_CRC bytes
+	\returns		int: Record length, 0 at the end of the log
+*/
+
+int Flash_Log_Read(Flash_Log_Cursor* Cursor, uint8_t* Data){
+	
+	/* Local Variables */
+	uint8_t Header[FLASH_LOG_PAGE_HEADER];
+	uint32_t Sequence = 0;
+	uint16_t CRC = 0;
+	uint8_t Length = 0;
+	int Valid = 0;
+	
+	while(Cursor->Pages_Left != 0){
+	
+		if(Cursor->Offset == 0){
+			Chip->Read(Cursor->Address,Header,FLASH_LOG_PAGE_HEADER);
+			Valid = Get_Header(Header,&Sequence);
+			if(Valid == HEADER_VALID){
+				Cursor->Offset = FLASH_LOG_PAGE_HEADER;
+			}
+			else if(Valid == HEADER_DAMAGED){
+				Cursor->Bad_Pages++;
+			}
+		}
+	
+		/* 0xFF or no room left ends the page */
+		if((Cursor->Offset != 0) && ((Cursor->Offset + FLASH_LOG_RECORD_HEADER + 1 + FLASH_LOG_RECORD_CRC) <= FLASH_LOG_PAGE)){
+			Chip->Read(Cursor->Address + Cursor->Offset,&Length,1);
+			if(Length != FLASH_LOG_ERASED){
+				if((Length != 0) && ((Cursor->Offset + FLASH_LOG_RECORD_HEADER + Length + FLASH_LOG_RECORD_CRC) <= FLASH_LOG_PAGE)){
+					Chip->Read(Cursor->Address + Cursor->Offset + FLASH_LOG_RECORD_HEADER,Data,Length + FLASH_LOG_RECORD_CRC);
+					CRC = Telemetry_CRC16(&Length,1,0xFFFF);
+					CRC = Telemetry_CRC16(Data,Length,CRC);
+					if(CRC == (Data[Length] | ((uint16_t)Data[Length + 1] << 8))){
+						Cursor->Offset += FLASH_LOG_RECORD_HEADER + Length + FLASH_LOG_RECORD_CRC;
+						return(Length);
+					}
+				}
+	
+				/* Nothing after a bad record can be trusted */
+				Cursor->Bad_Pages++;
+			}
+		}
+	
+		Cursor->Address = Next(Cursor->Address,FLASH_LOG_PAGE);
+		Cursor->Pages_Left--;
+		Cursor->Offset = 0;
+	}
+	
+	return(0);
+}
+
+/**
+  \fn					int Flash_Log_Dump(char (*Put)(char))
+  \brief			Sends the whole log as one packet, see the note. Waits for the chip on every read
+	\param			char (*Put)(char): Sends a byte, SER_PutChar on the board
+	\returns		int: 1 if it was sent, 0 if the chip is still busy with the log
+*/
+
+int Flash_Log_Dump(char (*Put)(char)){
+	
+	/* Local Variables */
+	Flash_Log_Cursor Cursor;
+	uint8_t Data[FLASH_LOG_MAX_RECORD + FLASH_LOG_RECORD_CRC];
+	uint32_t Bad_Pages = 0;
+	int Length = 0;
+	int i = 0;
+	
+	if(Flash_Log_Idle() == 0){
+		return(0);
+	}
+	
+	Put(FLASH_LOG_SYNC_1);
+	Put(FLASH_LOG_SYNC_2);
+	
+	Flash_Log_Start_Read(&Cursor);
+	while((Length = Flash_Log_Read(&Cursor,Data)) != 0){
+		Put((char)Length);
+		for(i = 0;i < (Length + FLASH_LOG_RECORD_CRC);i++){
+			Put((char)Data[i]);
+		}
+	}
+	
+	Bad_Pages = (Cursor.Bad_Pages > 0xFFFF) ? 0xFFFF : Cursor.Bad_Pages;
+	Put(0);
+	Put((char)Bad_Pages);
+	Put((char)(Bad_Pages >> 8));
+	
+	return(1);
+}
+
+/**
+  \fn					Flash_Log_Stats* Flash_Log_Get_Stats(void)
+  \brief			Counters since Flash_Log_Init
+	\returns		Flash_Log_Stats*: Read only
+*/
+
+Flash_Log_Stats* Flash_Log_Get_Stats(void){
+	
+	return(&Stats);
+}
+
+/**
+  \fn					void Flash_Log_Report(void)
+  \brief			Prints the counters on the serial monitor
+*/
+
+void Flash_Log_Report(void){
+	
+	if(Chip == 0){
+		printf("Flash log: no chip\r\n");
+		return;
+	}
+	
+	printf("Flash log: %lu records, %lu dropped, %lu pages, %lu erases (%lu late, %lu suspends), page 0x%06lX of %lu KB\r\n",
+		(unsigned long)Stats.Records,(unsigned long)Stats.Dropped,(unsigned long)Stats.Pages,
+		(unsigned long)Stats.Erases,(unsigned long)Stats.Late_Erases,(unsigned long)Stats.Suspends,
+		(unsigned long)Stats.Write_Address,(unsigned long)(Log_Size/1024));
+}
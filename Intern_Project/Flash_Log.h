@@ -0,0 +1,74 @@
+/*------------------------------------------------------------------------------------------------------
+ * Name:    Flash_Log.h
+ * Purpose: Black box log of binary records in SPI NOR flash
+ * Date: 		10/19/26
+ * Author:	Christopher Jordan - Denny
+ *------------------------------------------------------------------------------------------------------
+ * Note(s): See C file for the page and record layout
+ *----------------------------------------------------------------------------------------------------*/
+
+/*-----------------------------------------Include Statements-----------------------------------------*/
+#include <stdint.h>
+
+#ifndef FLASH_LOG_H
+#define FLASH_LOG_H
+
+/*-----------------------------------------Definitions------------------------------------------------*/
+#define FLASH_LOG_PAGE						256					// Bytes programmed at once
+#define FLASH_LOG_SECTOR					4096				// Smallest erase
+#define FLASH_LOG_PAGE_HEADER			8						// Page sequence and its complement
+#define FLASH_LOG_RECORD_HEADER		1						// Length
+#define FLASH_LOG_RECORD_CRC			2
+#define FLASH_LOG_MAX_RECORD			(FLASH_LOG_PAGE - FLASH_LOG_PAGE_HEADER - FLASH_LOG_RECORD_HEADER - FLASH_LOG_RECORD_CRC)
+#define FLASH_LOG_ERASE_AHEAD			2						// Sectors kept erased in front of the write page
+#define FLASH_LOG_BUFFER					(2*FLASH_LOG_PAGE)	// RAM given to Flash_Log_Init, one page filling, one programming
+#define FLASH_LOG_ERASED					0xFF
+#define FLASH_LOG_SYNC_1					'F'					// Flash_Log_Dump packet
+#define FLASH_LOG_SYNC_2					'L'
+
+/* The chip, every call but Read returns at once and the chip is busy until Busy returns 0 */
+typedef struct Flash_Log_Device
+{
+	int (*Busy)(void);
+	void (*Program)(uint32_t Address, const uint8_t* Data, int Length);		/* Data is untouched until not Busy */
+	void (*Erase)(uint32_t Address);																				/* FLASH_LOG_SECTOR at Address */
+	void (*Read)(uint32_t Address, uint8_t* Data, int Length);						/* Waits for the data */
+	void (*Suspend)(void);																									/* Pauses an erase, 0 if the chip can't */
+	void (*Resume)(void);
+}Flash_Log_Device;
+
+/* Counters since Flash_Log_Init */
+typedef struct Flash_Log_Stats
+{
+	uint32_t Records;										/* Appended */
+	uint32_t Dropped;										/* Both pages full, not appended */
+	uint32_t Pages;											/* Programmed */
+	uint32_t Erases;
+	uint32_t Late_Erases;								/* A full page had to wait for its sector to be erased */
+	uint32_t Suspends;									/* Erases paused to program a page */
+	uint32_t Write_Address;							/* Next page programmed */
+	uint32_t Page_Sequence;							/* Sequence the next page gets */
+}Flash_Log_Stats;
+
+/* Walks the log from the oldest page to the newest */
+typedef struct Flash_Log_Cursor
+{
+	uint32_t Address;										/* Page being read */
+	uint32_t Pages_Left;
+	int Offset;													/* Next record in the page, 0 before the header is checked */
+	uint32_t Bad_Pages;									/* Skipped for a bad header or a bad record CRC */
+}Flash_Log_Cursor;
+
+extern int Flash_Log_Init(const Flash_Log_Device* Device, uint32_t Size, uint8_t* Buffer);
+extern int Flash_Log_Append(const uint8_t* Data, int Length);
+extern void Flash_Log_Poll(void);
+extern int Flash_Log_Flush(void);
+extern int Flash_Log_Idle(void);
+extern int Flash_Log_Close(void);
+extern void Flash_Log_Start_Read(Flash_Log_Cursor* Cursor);
+extern int Flash_Log_Read(Flash_Log_Cursor* Cursor, uint8_t* Data);
+extern int Flash_Log_Dump(char (*Put)(char));
+extern Flash_Log_Stats* Flash_Log_Get_Stats(void);
+extern void Flash_Log_Report(void);
+
+#endif
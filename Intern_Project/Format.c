@@ -0,0 +1,256 @@
+/*------------------------------------------------------------------------------------------------------
+ * Name:    Format.c
+ * Purpose: Fixed point text formatting into a caller buffer
+ * Date: 		10/19/26
+ * Author:	Christopher Jordan - Denny
+ *------------------------------------------------------------------------------------------------------
+ * Note(s): Replaces sprintf("%f") when building telemetry. Values are written as scaled integers
+						with a set number of decimal places, so neither the float printf nor a divide is
+						needed: digits come from subtracting powers of ten, which suits the M0+ that has no
+						hardware divider.
+						
+						The buffer is always null terminated and Length always matches strlen. Anything that
+						does not fit is dropped whole and sets Overflow, so a frame is never half written.
+						
+						Usage:
+						------
+						*	Format_Init(&Buffer,Data,sizeof(Data));
+						*	Format_Fixed(&Buffer,2150,2);				-> "21.50"
+						*	Format_Char(&Buffer,',');
+						*	Format_Float(&Buffer,-0.125f,2);		-> "-0.13"
+ *----------------------------------------------------------------------------------------------------*/
+
+/*---------------------------------------------Include Statements-------------------------------------*/
+#include "Format.h"
+/*---------------------------------------------Definitions--------------------------------------------*/
+#define MAX_DIGITS					10							// Digits in a 32 bit value
+#define MAX_DECIMALS				8								// Decimals Format_Float can scale to
+/*---------------------------------------------Tables-------------------------------------------------*/
+static const uint32_t Powers_Of_Ten[MAX_DIGITS] = {
+	1000000000,100000000,10000000,1000000,100000,10000,1000,100,10,1
+};
+
+static const float Float_Scale[MAX_DECIMALS + 1] = {
+	1.0f,10.0f,100.0f,1000.0f,10000.0f,100000.0f,1000000.0f,10000000.0f,100000000.0f
+};
+/*---------------------------------------------Functions----------------------------------------------*/
+
+/**
+  \fn					int Unsigned_Digits(char* Digits, uint32_t Value, int Min_Digits)
+  \brief			Converts a value to decimal digits, most significant first
+	\param			char* Digits: At least MAX_DIGITS characters, not terminated
+	\param			uint32_t Value: The value to convert
+	\param			int Min_Digits: Pad with leading zeros to this many digits
+	\returns		int Count: Number of digits written
+*/
+
+static int Unsigned_Digits(char* Digits, uint32_t Value, int Min_Digits){
+	
+	int Count = 0;
+	int i = 0;
+	char Digit = 0;
+	
+	for(i = 0;i < MAX_DIGITS;i++){
+		
+		/* Count how many times this power fits */
+		Digit = '0';
+		while(Value >= Powers_Of_Ten[i]){
+			Value -= Powers_Of_Ten[i];
+			Digit++;
+		}
+		
+		/* Skip leading zeros outside the minimum width */
+		if((Count > 0) || (Digit != '0') || ((MAX_DIGITS - i) <= Min_Digits)){
+			Digits[Count++] = Digit;
+		}
+	}
+	
+	return(Count);
+}
+
+/**
+  \fn					void Format_Init(Format_Buffer* Buffer, char* Data, int Size)
+  \brief			Starts an empty string in the caller's buffer
+	\param			Format_Buffer* Buffer: The buffer state
+	\param			char* Data: Where the text goes
+	\param			int Size: Size of Data including the terminator
+*/
+
+void Format_Init(Format_Buffer* Buffer, char* Data, int Size){
+	
+	Buffer->Data = Data;
+	Buffer->Size = Size;
+	Buffer->Length = 0;
+	Buffer->Overflow = 0;
+	
+	if(Size > 0){
+		Data[0] = '\0';
+	}
+}
+
+/**
+  \fn					int Format_Char(Format_Buffer* Buffer, char Character)
+  \brief			Appends one character
+	\param			Format_Buffer* Buffer: The buffer state
+	\param			char Character: The character to append
+	\returns		int: 1 - Appended, 0 - Did not fit
+*/
+
+int Format_Char(Format_Buffer* Buffer, char Character){
+	
+	if((Buffer->Length + 1) >= Buffer->Size){
+		Buffer->Overflow = 1;
+		return(0);
+	}
+	
+	Buffer->Data[Buffer->Length++] = Character;
+	Buffer->Data[Buffer->Length] = '\0';
+	
+	return(1);
+}
+
+/**
+  \fn					int Format_String(Format_Buffer* Buffer, const char* String)
+  \brief			Appends a null terminated string
+	\param			Format_Buffer* Buffer: The buffer state
+	\param			const char* String: The string to append
+	\returns		int: 1 - Appended, 0 - Did not fit, nothing appended
+*/
+
+int Format_String(Format_Buffer* Buffer, const char* String){
+	
+	int Length = 0;
+	
+	while(String[Length] != '\0'){
+		Length++;
+	}
+	
+	if((Buffer->Length + Length) >= Buffer->Size){
+		Buffer->Overflow = 1;
+		return(0);
+	}
+	
+	/* Copy including the terminator */
+	for(Length = 0;String[Length] != '\0';Length++){
+		Buffer->Data[Buffer->Length++] = String[Length];
+	}
+	Buffer->Data[Buffer->Length] = '\0';
+	
+	return(1);
+}
+
+/**
+  \fn					int Format_Fixed(Format_Buffer* Buffer, int32_t Value, int Decimals)
+  \brief			Appends a scaled integer with a set number of decimal places
+	\param			Format_Buffer* Buffer: The buffer state
+	\param			int32_t Value: The value * 10^Decimals, i.e. 2150 with 2 decimals is 21.50
+	\param			int Decimals: Digits after the decimal point (0 - 9)
+	\returns		int: 1 - Appended, 0 - Did not fit, nothing appended
+*/
+
+int Format_Fixed(Format_Buffer* Buffer, int32_t Value, int Decimals){
+	
+	/* Local Variables */
+	char Digits[MAX_DIGITS];
+	uint32_t Magnitude = 0;
+	int Count = 0;
+	int Needed = 0;
+	int i = 0;
+	
+	/* Magnitude, written so INT32_MIN does not overflow */
+	Magnitude = (Value < 0) ? (0u - (uint32_t)Value) : (uint32_t)Value;
+	
+	/* At least one digit before the point */
+	Count = Unsigned_Digits(Digits,Magnitude,Decimals + 1);
+	
+	/* Sign, digits and point must all fit */
+	Needed = Count + (Value < 0) + (Decimals > 0);
+	if((Buffer->Length + Needed) >= Buffer->Size){
+		Buffer->Overflow = 1;
+		return(0);
+	}
+	
+	if(Value < 0){
+		Buffer->Data[Buffer->Length++] = '-';
+	}
+	
+	for(i = 0;i < Count;i++){
+		if(i == (Count - Decimals)){
+			Buffer->Data[Buffer->Length++] = '.';
+		}
+		Buffer->Data[Buffer->Length++] = Digits[i];
+	}
+	Buffer->Data[Buffer->Length] = '\0';
+	
+	return(1);
+}
+
+/**
+  \fn					int Format_Integer(Format_Buffer* Buffer, int32_t Value, int Width)
+  \brief			Appends an integer, zero padded to a minimum number of digits
+	\param			Format_Buffer* Buffer: The buffer state
+	\param			int32_t Value: The value
+	\param			int Width: Minimum number of digits, the sign is not counted
+	\returns		int: 1 - Appended, 0 - Did not fit, nothing appended
+*/
+
+int Format_Integer(Format_Buffer* Buffer, int32_t Value, int Width){
+	
+	/* Local Variables */
+	char Digits[MAX_DIGITS];
+	uint32_t Magnitude = 0;
+	int Count = 0;
+	int i = 0;
+	
+	Magnitude = (Value < 0) ? (0u - (uint32_t)Value) : (uint32_t)Value;
+	Count = Unsigned_Digits(Digits,Magnitude,(Width > 0) ? Width : 1);
+	
+	if((Buffer->Length + Count + (Value < 0)) >= Buffer->Size){
+		Buffer->Overflow = 1;
+		return(0);
+	}
+	
+	if(Value < 0){
+		Buffer->Data[Buffer->Length++] = '-';
+	}
+	
+	for(i = 0;i < Count;i++){
+		Buffer->Data[Buffer->Length++] = Digits[i];
+	}
+	Buffer->Data[Buffer->Length] = '\0';
+	
+	return(1);
+}
+
+/**
+  \fn					int Format_Float(Format_Buffer* Buffer, float Value, int Decimals)
+  \brief			Appends a float rounded to a set number of decimal places, one float multiply
+							and one conversion instead of the float printf
+	\param			Format_Buffer* Buffer: The buffer state
+	\param			float Value: The value, clamped to what fits in 32 bits once scaled
+	\param			int Decimals: Digits after the decimal point (0 - 8)
+	\returns		int: 1 - Appended, 0 - Did not fit, nothing appended
+*/
+
+int Format_Float(Format_Buffer* Buffer, float Value, int Decimals){
+	
+	float Scaled = 0.0f;
+	
+	if(Decimals > MAX_DECIMALS){
+		Decimals = MAX_DECIMALS;
+	}
+	
+	/* Scale and round half away from zero */
+	Scaled = Value * Float_Scale[Decimals];
+	Scaled += (Scaled < 0.0f) ? -0.5f : 0.5f;
+	
+	/* Clamp, also catches NaN */
+	if(!(Scaled < 2147483520.0f)){
+		Scaled = 2147483520.0f;
+	}
+	if(!(Scaled > -2147483520.0f)){
+		Scaled = -2147483520.0f;
+	}
+	
+	return(Format_Fixed(Buffer,(int32_t)Scaled,Decimals));
+}
@@ -0,0 +1,32 @@
+/*------------------------------------------------------------------------------------------------------
+ * Name:    Format.h
+ * Purpose: Fixed point text formatting into a caller buffer
+ * Date: 		10/19/26
+ * Author:	Christopher Jordan - Denny
+ *------------------------------------------------------------------------------------------------------
+ * Note(s): See C file for further discription
+ *----------------------------------------------------------------------------------------------------*/
+
+/*-----------------------------------------Include Statements-----------------------------------------*/
+#include <stdint.h>
+
+#ifndef FORMAT_H
+#define FORMAT_H
+
+/* Destination of the formatted text */
+typedef struct Format_Buffer
+{
+	char* Data;									/* Caller's buffer */
+	int Size;										/* Size of the buffer including the terminator */
+	int Length;									/* Characters written so far */
+	int Overflow;								/* Set once anything did not fit */
+}Format_Buffer;
+
+extern void Format_Init(Format_Buffer* Buffer, char* Data, int Size);
+extern int Format_Char(Format_Buffer* Buffer, char Character);
+extern int Format_String(Format_Buffer* Buffer, const char* String);
+extern int Format_Integer(Format_Buffer* Buffer, int32_t Value, int Width);
+extern int Format_Fixed(Format_Buffer* Buffer, int32_t Value, int Decimals);
+extern int Format_Float(Format_Buffer* Buffer, float Value, int Decimals);
+
+#endif
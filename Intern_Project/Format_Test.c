@@ -0,0 +1,134 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "Format.h"
+#include "Serial.h"
+#include "Timing.h"
+#include "Format_Test.h"
+
+#define COMPARE_ITERATIONS			2000
+#define BENCH_ITERATIONS				200
+
+/**
+  \fn					int Compare_Fixed(void)
+  \brief			Formats random scaled integers both ways, they must match exactly
+	\returns		int: Number of mismatches
+*/
+
+static int Compare_Fixed(void){
+	
+	char Fast[24];
+	char Reference[24];
+	Format_Buffer Text;
+	int32_t Value = 0;
+	int32_t Scale = 1;
+	int Decimals = 0;
+	int Mismatches = 0;
+	int i = 0;
+	int j = 0;
+	
+	srand(2);
+	
+	for(i = 0;i < COMPARE_ITERATIONS;i++){
+		
+		Value = (int32_t)(((uint32_t)rand() << 16) ^ (uint32_t)rand());
+		Decimals = rand() % 7;
+		for(j = 0,Scale = 1;j < Decimals;j++){
+			Scale *= 10;
+		}
+		
+		Format_Init(&Text,Fast,sizeof(Fast));
+		Format_Fixed(&Text,Value,Decimals);
+		
+		if(Decimals == 0){
+			sprintf(Reference,"%i",Value);
+		}
+		else{
+			sprintf(Reference,"%s%i.%0*i",(Value < 0) ? "-" : "",abs(Value / Scale),Decimals,abs(Value % Scale));
+		}
+		
+		if((strcmp(Fast,Reference) != 0) || (Text.Length != (int)strlen(Reference))){
+			Mismatches++;
+		}
+	}
+	
+	return(Mismatches);
+}
+
+/**
+  \fn					int Compare_Float(void)
+  \brief			Formats random floats both ways, they may only differ where a value sits
+							on a rounding boundary or the output is a negative zero
+	\returns		int: Number of values more than one count apart
+*/
+
+static int Compare_Float(void){
+	
+	char Fast[24];
+	char Reference[24];
+	Format_Buffer Text;
+	float Value = 0.0f;
+	float Difference = 0.0f;
+	int Mismatches = 0;
+	int i = 0;
+	
+	srand(3);
+	
+	for(i = 0;i < COMPARE_ITERATIONS;i++){
+		
+		Value = (float)((rand() % 200001) - 100000) / 97.0f;
+		
+		Format_Init(&Text,Fast,sizeof(Fast));
+		Format_Float(&Text,Value,2);
+		sprintf(Reference,"%.2f",Value);
+		
+		if(strcmp(Fast,Reference) != 0){
+			Difference = (float)atof(Fast) - (float)atof(Reference);
+			if((Difference > 0.011f) || (Difference < -0.011f)){
+				Mismatches++;
+			}
+		}
+	}
+	
+	return(Mismatches);
+}
+
+/**
+  \fn					void Format_Test_Code(void)
+  \brief			Checks the formatter against sprintf and times a sensor frame both ways
+*/
+
+void Format_Test_Code(void){
+	
+	const float Frame[9] = {21.53f,45.2f,-12.2f,3.05f,998.7f,120.25f,-87.5f,4.0f,1013.25f};
+	char Data[128];
+	Format_Buffer Text;
+	unsigned int Start = 0;
+	unsigned int Format_Time = 0;
+	unsigned int Sprintf_Time = 0;
+	int i = 0;
+	int j = 0;
+	
+	printf("Fixed mismatches: %i\r\n",Compare_Fixed());
+	printf("Float mismatches: %i\r\n",Compare_Float());
+	
+	/* The nine sensor fields the telemetry sent as text before the binary frames */
+	Start = msTicks;
+	for(i = 0;i < BENCH_ITERATIONS;i++){
+		Format_Init(&Text,Data,sizeof(Data));
+		for(j = 0;j < 9;j++){
+			Format_Float(&Text,Frame[j],2);
+			Format_Char(&Text,',');
+		}
+	}
+	Format_Time = msTicks - Start;
+	
+	Start = msTicks;
+	for(i = 0;i < BENCH_ITERATIONS;i++){
+		sprintf(Data,"%f,%f,%f,%f,%f,%f,%f,%f,%f",Frame[0],Frame[1],Frame[2],Frame[3],Frame[4],
+			Frame[5],Frame[6],Frame[7],Frame[8]);
+	}
+	Sprintf_Time = msTicks - Start;
+	
+	printf("%i frames, Format: %u ms, sprintf: %u ms\r\n",BENCH_ITERATIONS,Format_Time,Sprintf_Time);
+}
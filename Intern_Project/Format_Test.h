@@ -0,0 +1,6 @@
+#ifndef Format_Test_H
+#define Format_Test_H
+
+extern void Format_Test_Code(void);
+
+#endif
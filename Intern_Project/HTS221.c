@@ -13,6 +13,7 @@
 #include "I2C.h"													// I2C Support
 #include "HTS221.h"
 #include "Serial.h"												// USART2 Communication
+#include "Spin.h"													// Busy wait accounting
 
 /*------------------------------------Adresses--------------------------------------------------------*/
 #define HTS221_ADDRESS  					0x0000005F 		//Slave Address	for temp humidity sensor (WITHOUT R/W)
@@ -133,10 +134,12 @@ float HTS221_Temp_Read(void){
 	I2C_Write_Reg(HTS221_ADDRESS,HTS221_CTRL_REG2,HTS221_CTRL_REG2_ONE_SHOT);
 	
 	//Wait for Temperature data to be ready
+	SPIN_BEGIN(SPIN_HTS221);
 	do{
 		I2C_Read_Reg(HTS221_ADDRESS,HTS221_STATUS_REG);
 		STATUS_REG = I2C1->RXDR;
 	}while((STATUS_REG & HTS221_STATUS_REG_TDA) == 0);
+	SPIN_END(SPIN_HTS221);
 	
 	//Read Temperature Data and Calibration
 	I2C_Read_Reg(HTS221_ADDRESS,HTS221_TEMP_OUT_L);
@@ -217,10 +220,12 @@ float HTS221_Humidity_Read(void){
 	I2C_Write_Reg(HTS221_ADDRESS,HTS221_CTRL_REG2,HTS221_CTRL_REG2_ONE_SHOT);
 	
 	//Wait for Humidity data to be ready
+	SPIN_BEGIN(SPIN_HTS221);
 	do{
 		I2C_Read_Reg(HTS221_ADDRESS,HTS221_STATUS_REG);
 		STATUS_REG = I2C1->RXDR;
 	}while((STATUS_REG & HTS221_STATUS_REG_HDA) == 0);
+	SPIN_END(SPIN_HTS221);
 	
 	//Read Humidity data and Calibration
 	I2C_Read_Reg(HTS221_ADDRESS,HTS221_H0_rH_x2);
@@ -11,6 +11,9 @@
 /*-------------------------------------------Include Statements---------------------------------------*/
 #include "stm32l053xx.h"                  // Specific Device header
 #include "I2C.h"
+#include "Profile.h"											// Transaction cycles
+#include "Spin.h"												// Busy wait accounting
+#include "Trace.h"												// Event timeline
 /*-------------------------------------------Global Variables-----------------------------------------*/
 uint32_t I2C1_RX_Data = 0;
 /*-------------------------------------------Functions------------------------------------------------*/
@@ -79,11 +82,16 @@ void Reset_I2C(void){
 
 uint32_t I2C_Read_Reg(uint32_t Device,uint32_t Register){
 	
+	PROFILE_BEGIN(PROFILE_I2C);
+	TRACE_BEGIN(TRACE_I2C_READ,(uint16_t)Register);
+	
 	//Reset CR2 Register
 	I2C1->CR2 = 0x00000000;
 	
 	//Check to see if the bus is busy
+	SPIN_BEGIN(SPIN_I2C_BUSY);
 	while((I2C1->ISR & I2C_ISR_BUSY) == I2C_ISR_BUSY);
+	SPIN_END(SPIN_I2C_BUSY);
 	
 	//Set CR2 for 1-byte transfer for Device
 	I2C1->CR2 |=(1UL<<16) | (Device<<1);
@@ -97,7 +105,9 @@ uint32_t I2C_Read_Reg(uint32_t Device,uint32_t Register){
 	}
 	
 	//Wait for transfer to complete
+	SPIN_BEGIN(SPIN_I2C_TC);
 	while((I2C1->ISR & I2C_ISR_TC) == 0);
+	SPIN_END(SPIN_I2C_TC);
 
 	//Clear CR2 for new configuration
 	I2C1->CR2 = 0x00000000;
@@ -109,17 +119,24 @@ uint32_t I2C_Read_Reg(uint32_t Device,uint32_t Register){
 	I2C1->CR2 |= I2C_CR2_START;
 	
 	//Wait for transfer to complete
+	SPIN_BEGIN(SPIN_I2C_TC);
 	while((I2C1->ISR & I2C_ISR_TC) == 0);
+	SPIN_END(SPIN_I2C_TC);
 	
 	//Send Stop Condition
 	I2C1->CR2 |= I2C_CR2_STOP;
 	
 	//Check to see if the bus is busy
+	SPIN_BEGIN(SPIN_I2C_BUSY);
 	while((I2C1->ISR & I2C_ISR_BUSY) == I2C_ISR_BUSY);
+	SPIN_END(SPIN_I2C_BUSY);
 
 	//Clear Stop bit flag
 	I2C1->ICR |= I2C_ICR_STOPCF;
 	
+	TRACE_END(TRACE_I2C_READ,(uint16_t)Register);
+	PROFILE_END(PROFILE_I2C);
+	
 	return(I2C1_RX_Data);
 }
 
@@ -133,11 +150,16 @@ uint32_t I2C_Read_Reg(uint32_t Device,uint32_t Register){
 
 void I2C_Write_Reg(uint32_t Device,uint32_t Register, uint32_t Data){
 	
+	PROFILE_BEGIN(PROFILE_I2C);
+	TRACE_BEGIN(TRACE_I2C_WRITE,(uint16_t)Register);
+	
 	//Reset CR2 Register
 	I2C1->CR2 = 0x00000000;
 	
 	//Check to see if the bus is busy
+	SPIN_BEGIN(SPIN_I2C_BUSY);
 	while((I2C1->ISR & I2C_ISR_BUSY) == I2C_ISR_BUSY);
+	SPIN_END(SPIN_I2C_BUSY);
 	
 	//Set CR2 for 2-Byte Transfer, for Device
 	I2C1->CR2 |= (2UL<<16) | (Device<<1);
@@ -151,7 +173,9 @@ void I2C_Write_Reg(uint32_t Device,uint32_t Register, uint32_t Data){
 	}
 	
 	//Wait for TX Register to clear
+	SPIN_BEGIN(SPIN_I2C_TXE);
 	while((I2C1->ISR & I2C_ISR_TXE) == 0);
+	SPIN_END(SPIN_I2C_TXE);
 	
 	//Check Tx empty before writing to it
 	if((I2C1->ISR & I2C_ISR_TXE) == I2C_ISR_TXE){
@@ -159,14 +183,21 @@ void I2C_Write_Reg(uint32_t Device,uint32_t Register, uint32_t Data){
 	}
 	
 	//Wait for transfer to complete
+	SPIN_BEGIN(SPIN_I2C_TC);
 	while((I2C1->ISR & I2C_ISR_TC) == 0);
+	SPIN_END(SPIN_I2C_TC);
 	
 	//Send Stop Condition
 	I2C1->CR2 |= I2C_CR2_STOP;	
 	
 	//Check to see if the bus is busy
+	SPIN_BEGIN(SPIN_I2C_BUSY);
 	while((I2C1->ISR & I2C_ISR_BUSY) == I2C_ISR_BUSY);
+	SPIN_END(SPIN_I2C_BUSY);
 	
 	//Clear Stop bit flag
 	I2C1->ICR |= I2C_ICR_STOPCF;
+	
+	TRACE_END(TRACE_I2C_WRITE,(uint16_t)Register);
+	PROFILE_END(PROFILE_I2C);
 }
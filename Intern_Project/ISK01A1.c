@@ -56,6 +56,7 @@
 #include "LIS3MDL.h"										// Magnetometer drivers
 #include "LSM6DS0.h"										// Accelerometer and gyroscope
 #include "ISK01A1.h"
+/*------------------------------------------Definitions-----------------------------------------------*/
 /*------------------------------------------Structure Inits-------------------------------------------*/
 Pressure_Data Pressure;
 HTS221_Data HTS221;
@@ -345,50 +346,3 @@ float QuadCopter_Altitude(void){
 	
 	return(Altitude_Difference);
 }
-
-char* ISK01A1_Package_Data(void){
-	
-	/* Local Variables */
-	int Checksum = 0;
-	char Temp[128] = "";
-	int i = 0;
-
-	/* Get all the data */
-	ISK01A1_Get_Temperature();
-	ISK01A1_Get_Humidity();
-	ISK01A1_Get_Magnetic_X();
-	ISK01A1_Get_Magnetic_Y();
-	ISK01A1_Get_Magnetic_Z();
-	ISK01A1_Get_Acceleration_X();
-	ISK01A1_Get_Acceleration_Y();
-	ISK01A1_Get_Acceleration_Z();
-	ISK01A1_Get_Roll();
-	ISK01A1_Get_Pitch();
-	ISK01A1_Get_Yaw();
-	ISK01A1_Get_Altitude();
-	ISK01A1_Get_Pressure();
-	
-	/* Combine the data into a string */
-	sprintf(
-	Temp,																	/* Destination  */
-	"%f,%f,%f,%f,%f,%f,%f,%f,%f",					/* Foramat      */
-	HTS221.Temperature,										/* Temperature  */
-	HTS221.Humidity,											/* Humidity     */
-	LSM6DS0.X_Acceleration,								/* Acceleration */
-	LSM6DS0.Y_Acceleration,								/* Acceleration */
-	LSM6DS0.Z_Acceleration,								/* Acceleration */
-	LSM6DS0.Pitch,												/* Pitch        */
-	LSM6DS0.Roll,													/* roll         */
-	LSM6DS0.Yaw,													/* Yaw          */
-	LPS25HB.Pressure											/* Pressure     */
-	);
-	
-	/* Create Checksum */
-	for(i = 0;i < sizeof(Temp);i++){
-		Checksum += Temp[i];
-	}
-	
-	sprintf(ISK01A1.Packaged_Data,"%%%s*%i\r\n",Temp,Checksum);
-	
-	return(ISK01A1.Packaged_Data);
-}
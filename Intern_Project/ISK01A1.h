@@ -43,7 +43,6 @@ typedef struct LSM6DS0_Data
 
 typedef struct ISK01A1_Data
 {
-	char Packaged_Data[128];
 	float Altitude;
 }ISK01A1_Data;
 
@@ -70,6 +69,5 @@ extern float ISK01A1_Get_Pitch(void);
 extern float ISK01A1_Get_Yaw(void);
 extern float ISK01A1_Get_Altitude(void);
 extern float QuadCopter_Altitude(void);
-extern char* ISK01A1_Package_Data(void);
 
 #endif
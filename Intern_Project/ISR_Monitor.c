@@ -0,0 +1,191 @@
+/*------------------------------------------------------------------------------------------------------
+ * Name:    ISR_Monitor.c
+ * Purpose: Entry latency and run time of every interrupt against a budget
+ * Date: 		10/19/26
+ * Author:	Christopher Jordan - Denny
+ *------------------------------------------------------------------------------------------------------
+ * Note(s): Each handler calls ISR_Monitor_Enter first and ISR_Monitor_Exit last. Times are core clock
+						cycles from Profile_Cycles. The latency is found differently for each interrupt:
+						*	SysTick: cycles it has counted down since it reloaded, LOAD - VAL
+						*	TIM2: counts since it wrapped to 0, in us
+						*	PendSV: cycles since ISR_Monitor_Pend, which the LPUART1 interrupt calls when it
+							pends it
+						*	USART1 and LPUART1: the byte's arrival time isn't kept by the hardware, so only a
+							latency longer than one character is seen, as an overrun
+						A latency or run time over its budget counts a fault. The deployment command goes
+						LPUART1 -> PendSV -> Deploy task, so their high water marks bound how long a command
+						can be held up by the GPS interrupt.
+ *----------------------------------------------------------------------------------------------------*/
+
+/*---------------------------------------------Include Statements-------------------------------------*/
+#include <stdio.h>										// Printf
+#include "stm32l0xx.h"								// PRIMASK
+#include "ISR_Monitor.h"
+#include "Profile.h"									// Profile_Cycles
+/*---------------------------------------------Tables-------------------------------------------------*/
+static const char* const ISR_Name[ISR_MONITOR_ISRS] = {"SysTick","TIM2","USART1","LPUART1","PendSV","SPI DMA"};
+/*---------------------------------------------Globals------------------------------------------------*/
+ISR_Monitor_Stats			ISR_Stats[ISR_MONITOR_ISRS] = {
+	/* Latency and run time budgets in cycles at 32MHz */
+	{0,0,0,3200,1600,0,0},			/* SysTick: 100 us, 50 us */
+	{0,0,0,3200,640,0,0},				/* TIM2: 100 us, 20 us */
+	{0,0,0,0,3200,0,0},					/* USART1: -, 100 us */
+	{0,0,0,0,1600,0,0},					/* LPUART1: -, 50 us, a character is 87 us at 115200 baud */
+	{0,0,0,32000,16000,0,0},		/* PendSV: 1 ms, 0.5 ms */
+	{0,0,0,0,640,0,0}						/* SPI DMA: -, 20 us, waits out BSY above PendSV */
+};
+uint32_t							ISR_Start[ISR_MONITOR_ISRS];							/* Profile_Cycles at entry */
+uint32_t							ISR_Pend_Time[ISR_MONITOR_ISRS];					/* Profile_Cycles at ISR_Monitor_Pend */
+volatile uint8_t			ISR_Pended[ISR_MONITOR_ISRS];
+volatile uint32_t			Total_Faults = 0;
+/*---------------------------------------------Functions----------------------------------------------*/
+
+/**
+  \fn					void ISR_Monitor_Pend(int ISR)
+  \brief			Notes when a software interrupt was first requested, call just before pending it
+	\param			int ISR: ISR_MONITOR interrupt
+*/
+
+void ISR_Monitor_Pend(int ISR){
+	
+	uint32_t Mask = __get_PRIMASK();
+	
+	__disable_irq();
+	if(ISR_Pended[ISR] == 0){
+		ISR_Pend_Time[ISR] = Profile_Cycles();
+		ISR_Pended[ISR] = 1;
+	}
+	__set_PRIMASK(Mask);
+}
+
+/**
+  \fn					void ISR_Monitor_Enter(int ISR, uint32_t Latency)
+  \brief			Start of a handler
+	\param			int ISR: ISR_MONITOR interrupt
+	\param			uint32_t Latency: Cycles since the interrupt was raised, ISR_MONITOR_NO_LATENCY
+							if unknown or if it was pended with ISR_Monitor_Pend
+*/
+
+void ISR_Monitor_Enter(int ISR, uint32_t Latency){
+	
+	ISR_Monitor_Stats* Stats = &ISR_Stats[ISR];
+	
+	ISR_Start[ISR] = Profile_Cycles();
+	
+	if(ISR_Pended[ISR]){
+		Latency = ISR_Start[ISR] - ISR_Pend_Time[ISR];
+		ISR_Pended[ISR] = 0;
+	}
+	
+	Stats->Entries++;
+	if(Latency == ISR_MONITOR_NO_LATENCY){
+		return;
+	}
+	
+	if(Latency > Stats->Latency_Max){
+		Stats->Latency_Max = Latency;
+	}
+	if((Stats->Latency_Budget != 0) && (Latency > Stats->Latency_Budget)){
+		Stats->Faults++;
+		Total_Faults++;
+	}
+}
+
+/**
+  \fn					void ISR_Monitor_Exit(int ISR)
+  \brief			End of a handler, on every return path
+	\param			int ISR: ISR_MONITOR interrupt
+*/
+
+void ISR_Monitor_Exit(int ISR){
+	
+	ISR_Monitor_Stats* Stats = &ISR_Stats[ISR];
+	uint32_t Time = Profile_Cycles() - ISR_Start[ISR];
+	
+	if(Time > Stats->Time_Max){
+		Stats->Time_Max = Time;
+	}
+	if((Stats->Time_Budget != 0) && (Time > Stats->Time_Budget)){
+		Stats->Faults++;
+		Total_Faults++;
+	}
+}
+
+/**
+  \fn					void ISR_Monitor_Overrun(int ISR)
+  \brief			A UART lost a byte because its handler came too late
+	\param			int ISR: ISR_MONITOR_GPS_UART or ISR_MONITOR_XBEE_UART
+*/
+
+void ISR_Monitor_Overrun(int ISR){
+	
+	ISR_Stats[ISR].Overruns++;
+	ISR_Stats[ISR].Faults++;
+	Total_Faults++;
+}
+
+/**
+  \fn					void ISR_Monitor_Set_Budget(int ISR, uint32_t Latency, uint32_t Time)
+  \brief			Changes an interrupt's budgets
+	\param			int ISR: ISR_MONITOR interrupt
+	\param			uint32_t Latency: Cycles, 0 to not check
+	\param			uint32_t Time: Cycles, 0 to not check
+*/
+
+void ISR_Monitor_Set_Budget(int ISR, uint32_t Latency, uint32_t Time){
+	
+	uint32_t Mask = __get_PRIMASK();
+	
+	__disable_irq();
+	ISR_Stats[ISR].Latency_Budget = Latency;
+	ISR_Stats[ISR].Time_Budget = Time;
+	__set_PRIMASK(Mask);
+}
+
+/**
+  \fn					void ISR_Monitor_Get_Stats(int ISR, ISR_Monitor_Stats* Copy)
+  \brief			Copies an interrupt's figures without it changing them halfway
+	\param			int ISR: ISR_MONITOR interrupt
+	\param			ISR_Monitor_Stats* Copy: Filled with the figures
+*/
+
+void ISR_Monitor_Get_Stats(int ISR, ISR_Monitor_Stats* Copy){
+	
+	uint32_t Mask = __get_PRIMASK();
+	
+	__disable_irq();
+	*Copy = ISR_Stats[ISR];
+	__set_PRIMASK(Mask);
+}
+
+/**
+  \fn					uint32_t ISR_Monitor_Faults(void)
+  \brief			Budget faults and overruns of every interrupt since power on
+	\returns		uint32_t: Faults
+*/
+
+uint32_t ISR_Monitor_Faults(void){
+	
+	return(Total_Faults);
+}
+
+/**
+  \fn					void ISR_Monitor_Report(void)
+  \brief			Prints every interrupt's high water marks and faults to the serial monitor
+*/
+
+void ISR_Monitor_Report(void){
+	
+	/* Local Variables */
+	ISR_Monitor_Stats Copy;
+	int i = 0;
+	
+	printf("ISR       Entries  Latency max/budget    Time max/budget  Faults Overruns (cycles)\r\n");
+	
+	for(i = 0;i < ISR_MONITOR_ISRS;i++){
+		ISR_Monitor_Get_Stats(i,&Copy);
+		printf("%-8s %8u %9u/%-9u %9u/%-9u %6u %8u\r\n",ISR_Name[i],(unsigned int)Copy.Entries,
+			(unsigned int)Copy.Latency_Max,(unsigned int)Copy.Latency_Budget,(unsigned int)Copy.Time_Max,
+			(unsigned int)Copy.Time_Budget,(unsigned int)Copy.Faults,(unsigned int)Copy.Overruns);
+	}
+}
@@ -0,0 +1,48 @@
+/*------------------------------------------------------------------------------------------------------
+ * Name:    ISR_Monitor.h
+ * Purpose: Entry latency and run time of every interrupt against a budget
+ * Date: 		10/19/26
+ * Author:	Christopher Jordan - Denny
+ *------------------------------------------------------------------------------------------------------
+ * Note(s): See C file for how the latency of each interrupt is found
+ *----------------------------------------------------------------------------------------------------*/
+
+/*-----------------------------------------Include Statements-----------------------------------------*/
+#include <stdint.h>
+
+#ifndef ISR_MONITOR_H
+#define ISR_MONITOR_H
+
+/*-----------------------------------------Definitions------------------------------------------------*/
+#define ISR_MONITOR_SYSTICK				0
+#define ISR_MONITOR_TIM2					1
+#define ISR_MONITOR_GPS_UART			2						// USART1
+#define ISR_MONITOR_XBEE_UART			3						// LPUART1
+#define ISR_MONITOR_PENDSV				4
+#define ISR_MONITOR_SPI_DMA				5						// DMA1 channels 2/3 and 4/5, one DMA write at a time
+#define ISR_MONITOR_ISRS					6
+
+#define ISR_MONITOR_NO_LATENCY		0xFFFFFFFFUL		// Latency can't be measured for this entry
+
+/* Cycles, a budget of 0 is not checked */
+typedef struct ISR_Monitor_Stats
+{
+	uint32_t Entries;
+	uint32_t Latency_Max;								/* Event to first instruction of the handler */
+	uint32_t Time_Max;									/* Handler run time */
+	uint32_t Latency_Budget;
+	uint32_t Time_Budget;
+	uint32_t Faults;										/* Entries over either budget */
+	uint32_t Overruns;									/* UART bytes lost, latency longer than a character */
+}ISR_Monitor_Stats;
+
+extern void ISR_Monitor_Pend(int ISR);
+extern void ISR_Monitor_Enter(int ISR, uint32_t Latency);
+extern void ISR_Monitor_Exit(int ISR);
+extern void ISR_Monitor_Overrun(int ISR);
+extern void ISR_Monitor_Set_Budget(int ISR, uint32_t Latency, uint32_t Time);
+extern void ISR_Monitor_Get_Stats(int ISR, ISR_Monitor_Stats* Copy);
+extern uint32_t ISR_Monitor_Faults(void);
+extern void ISR_Monitor_Report(void);
+
+#endif
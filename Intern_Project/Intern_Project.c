@@ -21,33 +21,285 @@
 #include "ISK01A1.h"										// ISK01A1 expansion board Drivers (gryo,temp,accel etc...)
 #include "XBeePro24.h"									// XBee drivers
 #include "PWM.h"												// Servo Motor Control
-#include "Timer2.h"											// Time for parachute
+#include "Timer2.h"											// Microsecond timebase
 #include "string.h"											// Various useful string manipulation functions
+#include "Telemetry.h"									// Binary telemetry frames
+#include "XBee_API.h"										// XBee API frames
+#include "Telemetry_Scheduler.h"				// Channel rates and byte budget
+#include "Uplink.h"											// Ground station commands
+#include "Link_Quality.h"								// Adaptive downlink rate
+#include "FEC.h"													// Reed-Solomon blocks
+#include "Events.h"											// Reliable deployment, apogee and fault events
+#include "Scheduler.h"									// Cooperative tasks
+#include "Deploy.h"											// Parachute task
+#include "Pipeline.h"										// Acquire, encode and transmit slots
+#include "Profile.h"										// Hot path cycle counts
+#include "Spin.h"												// Busy wait accounting
+#include "Trace.h"											// Event timeline
+#include "ISR_Monitor.h"								// Interrupt latency and budgets
+#include "Arena.h"											// RAM regions and stack high water
+#include "NOR_Flash.h"									// SPI flash chip
+#include "Flash_Log.h"									// Black box log
 
 #define Green_LED  					5						// Green LED on board
 #define CHUTE_DEPLOY_ALT		1619.0			// Chute deployment altitude,TRF altitude(1119) + 500 ft
-/*-----------------------Structure Stuff--------------------------------------------------------------*/
-RMC_Data GPS_Ready;
+#define TELEMETRY_BUDGET		2000				// Telemetry bytes per second until Link_Quality measures the link
+#define FEC_DATA						32					// Data bytes per codeword, the ground station must match
+#define FEC_PARITY					8						// Parity bytes per codeword, 0 sends frames uncoded
+#define FEC_DEPTH						4						// Codewords interleaved per block
+#define FEC_PAD_TIME				100					// ms without frames before a started FEC block is padded and sent
+#define APOGEE_CLIMB				3000				// cm above the first baro altitude before apogee is looked for
+#define APOGEE_DROP					1000				// cm below the highest baro altitude that marks apogee
+#define EVENTS_PERIOD				10					// ms between critical event polls
+#define SENSOR_PERIOD				10					// ms between telemetry scheduler polls once armed
+#define GPS_PERIOD					50					// ms between checks for a new fix
+#define ARM_PERIOD					20					// ms between button checks
+#define LINK_PERIOD					100					// ms between link quality polls
+#define LOG_PERIOD					1000				// ms between runtime lines on the serial monitor
+#define TRANSMIT_PERIOD			2						// ms between retries while the transmit ring is full
+#define PIPELINE_READY			0x01				// A slot is ready for the next stage
+#define TRACE_MASK					TRACE_ALL		// Event ids captured for the timeline
+#define FLASH_PERIOD				1						// ms between flash log polls
+#define BLACK_BOX_CHANNELS	(TELEMETRY_CHANNEL_IMU | TELEMETRY_CHANNEL_BARO)		// Read every sensor run for the flash log
+#define LANDED_HEIGHT				1500				// cm above the first baro altitude that counts as landed after apogee
+#define LANDED_TIME					5000				// ms it has to stay there before the flash log is closed
+#define BLACK_BOX_AFTER_DEPLOY	90000		// ms logged after deployment if no landing is seen, a 1 MB chip holds ~2 minutes
+/*-----------------------Globals----------------------------------------------------------------------*/
+GPS_Fix* GPS_Latest = 0;								// Newest decoded fix
+int GPS_Fresh = 0;											// GPS_Latest hasn't been sent yet
+int32_t Ground_Altitude = 0;						// First baro altitude, cm
+int32_t Highest_Altitude = 0;						// Highest baro altitude so far, cm
+int Apogee_State = 0;										// 0 no reading yet, 1 climbing, 2 apogee posted
+int Black_Box_State = 0;								// 0 waiting for the button, 1 logging, 2 closing, 3 closed
+uint32_t Landed_Time = 0;								// msTicks the altitude came back near the ground, 0 if it hasn't
+uint32_t Deploy_Time = 0;								// msTicks the sensor task first saw a deployment, 0 if it hasn't
+int Arm_Task = -1;
+int Sensor_Task = -1;
+int Telemetry_Task = -1;
+int Transmit_Task = -1;
+int Log_Index = 0;											// Next task the log task prints
+uint32_t Last_Frame_Time = 0;						// msTicks of the last frame handed to Send_Telemetry
+Telemetry_Record Sample;								// Newest value of every channel, logged to flash every sensor run
+const Flash_Log_Device Flash_Chip = {NOR_Flash_Busy,NOR_Flash_Program,NOR_Flash_Erase,NOR_Flash_Read,NOR_Flash_Suspend,NOR_Flash_Resume};
 /*-----------------------Functions--------------------------------------------------------------------*/
 void IO_Init(void);
+void Collect_Telemetry(Telemetry_Record* Record, uint8_t Channels);
+void Send_Telemetry(const uint8_t* Frame, int Length);
+void Send_Started_Block(void);
+void Check_Apogee(int32_t Altitude);
+void Check_Landing(int32_t Altitude);
+void Events_Run(uint8_t Events);
+void Transmit_Run(uint8_t Events);
+void Telemetry_Run(uint8_t Events);
+void Sensor_Run(uint8_t Events);
+void GPS_Run(uint8_t Events);
+void Arm_Run(uint8_t Events);
+void Link_Run(uint8_t Events);
+void Log_Run(uint8_t Events);
+void Flash_Run(uint8_t Events);
 
 /**
   \fn          int main (void)
-  \brief       Initializes all peripherals and continually fetch data
+  \brief       Initializes all peripherals and hands over to the task scheduler
 */
 
 int main (void){
 	
-	/* Local Variables */
-	char Data[256];
-//	float GPS_Altitude = 0;
+	/* Before anything runs deep, so the high water covers everything */
+	Arena_Paint_Stack();
 	
 	/* Initialize I2C,XBEE,ADC,USART1,USART2,LPUART1,CLOCK,ISK01A1,GPIO */
 	IO_Init();
 	
-	/* Wait for Button press */
-	while(Button_Get_State() == 0){
-		//Nop
+	Telemetry_Scheduler_Init(TELEMETRY_BUDGET);
+	Link_Quality_Init();
+	FEC_Init(FEC_DATA,FEC_PARITY,FEC_DEPTH);
+	
+	/* Tasks, highest priority first */
+	Deploy_Init();
+	Scheduler_Add("Events",Events_Run,EVENTS_PERIOD);
+	Transmit_Task = Scheduler_Add("Transmit",Transmit_Run,TRANSMIT_PERIOD);
+	Telemetry_Task = Scheduler_Add("Telemetry",Telemetry_Run,0);
+	Sensor_Task = Scheduler_Add("Sensors",Sensor_Run,0);							/* Started by the button */
+	Scheduler_Add("GPS",GPS_Run,GPS_PERIOD);
+	Arm_Task = Scheduler_Add("Arm",Arm_Run,ARM_PERIOD);
+	Scheduler_Add("Link",Link_Run,LINK_PERIOD);
+	Scheduler_Add("Log",Log_Run,LOG_PERIOD);
+	Scheduler_Add("Flash",Flash_Run,FLASH_PERIOD);
+	
+	/* Never returns */
+	Scheduler_Run();
+	
+	return(0);
+}
+
+/**
+  \fn					void Events_Run(uint8_t Events)
+	\brief			Sends the next critical event frame that is due, they don't wait for the budget.
+							With the FEC on the event closes the block it lands in, so it goes out now and
+							gets the same protection as the telemetry
+*/
+
+void Events_Run(uint8_t Events){
+	
+	uint8_t Frame[TELEMETRY_MAX_FRAME];
+	int Length = Events_Poll(msTicks,Frame);
+	
+	if(Length != 0){
+		Telemetry_Scheduler_Charge(FEC_Coded_Length(Length));
+		Send_Telemetry(Frame,Length);
+		Send_Started_Block();
+		XBee_API_Flush();
+	}
+}
+
+/**
+  \fn					void Transmit_Run(uint8_t Events)
+	\brief			Last pipeline stage, hands the oldest encoded frame to the XBee once the transmit
+							ring has room for all of it, the interrupt puts it on the wire. Pads and sends a
+							started FEC block once no frame has come for FEC_PAD_TIME
+*/
+
+void Transmit_Run(uint8_t Events){
+	
+	/* Local Variables */
+	Pipeline_Slot* Slot;
+	int Needed = 0;
+	
+	if(Pipeline_Ready(PIPELINE_TRANSMIT) == 0){
+		
+		/* Frames stopped, don't leave the last ones waiting in a started block or a part filled packet */
+		if((msTicks - Last_Frame_Time) >= FEC_PAD_TIME){
+			if(FEC_Enabled() && XBee_API_Can_Queue(FEC_Block_Length())){
+				Send_Started_Block();
+			}
+			if(XBee_API_Can_Queue(0)){
+				XBee_API_Flush();
+			}
+		}
+		return;
+	}
+	
+	/* A frame can finish two FEC blocks */
+	Slot = Pipeline_Begin(PIPELINE_TRANSMIT);
+	Needed = FEC_Enabled() ? (2*FEC_Block_Length()) : Slot->Length;
+	if(XBee_API_Can_Queue(Needed) == 0){
+		Pipeline_Stall(PIPELINE_TRANSMIT);
+		return;
+	}
+	
+	PROFILE_BEGIN(PROFILE_SEND);
+	Send_Telemetry(Slot->Frame,Slot->Length);
+	PROFILE_END(PROFILE_SEND);
+	Last_Frame_Time = msTicks;
+	Pipeline_End(PIPELINE_TRANSMIT);
+	
+	if(Pipeline_Ready(PIPELINE_TRANSMIT)){
+		Scheduler_Post(Transmit_Task,PIPELINE_READY);
+	}
+}
+
+/**
+  \fn					void Telemetry_Run(uint8_t Events)
+	\brief			Middle pipeline stage, encodes the oldest acquired record
+*/
+
+void Telemetry_Run(uint8_t Events){
+	
+	Pipeline_Slot* Slot = Pipeline_Begin(PIPELINE_ENCODE);
+	
+	if(Slot == 0){
+		return;
+	}
+	
+	PROFILE_BEGIN(PROFILE_FORMAT);
+	Slot->Length = Telemetry_Compress(&Slot->Record,Slot->Frame);
+	PROFILE_END(PROFILE_FORMAT);
+	Telemetry_Scheduler_Charge(FEC_Coded_Length(Slot->Length));
+	Pipeline_End(PIPELINE_ENCODE);
+	
+	Scheduler_Post(Transmit_Task,PIPELINE_READY);
+	if(Pipeline_Ready(PIPELINE_ENCODE)){
+		Scheduler_Post(Telemetry_Task,PIPELINE_READY);
+	}
+}
+
+/**
+  \fn					void Sensor_Run(uint8_t Events)
+	\brief			First pipeline stage. Reads the black box channels every run and logs the sample to
+							flash until the landing, the channels that are due and fit the budget are also read
+							and go into a free slot for the radio
+*/
+
+void Sensor_Run(uint8_t Events){
+	
+	/* Local Variables */
+	Pipeline_Slot* Slot = 0;
+	uint8_t Frame[TELEMETRY_RECORD_FRAME];
+	uint8_t Available = Link_Quality_Channels();
+	uint8_t Channels = 0;
+	
+	/* GPS only has something new once a fix comes in */
+	if(GPS_Fresh == 0){
+		Available &= ~TELEMETRY_CHANNEL_GPS;
+	}
+	
+	/* Both slots are still on their way, leave the channels due for next time */
+	if(Pipeline_Ready(PIPELINE_ACQUIRE)){
+		Channels = Telemetry_Scheduler_Select(msTicks,Available);
+	}
+	else{
+		Pipeline_Stall(PIPELINE_ACQUIRE);
+	}
+	
+	Collect_Telemetry(&Sample,Channels | BLACK_BOX_CHANNELS);
+	/* A record frame, not the struct, so the layout doesn't depend on the compiler */
+	if(Black_Box_State == 1){
+		Sample.Sequence++;
+		Flash_Log_Append(Frame,Telemetry_Pack(&Sample,Frame));
+	}
+	Check_Apogee(Sample.Baro_Altitude);
+	Check_Landing(Sample.Baro_Altitude);
+	
+	if(Channels == 0){
+		return;
+	}
+	
+	Slot = Pipeline_Begin(PIPELINE_ACQUIRE);
+	Slot->Record = Sample;
+	Slot->Record.Channels = Channels;
+	Pipeline_End(PIPELINE_ACQUIRE);
+	
+	if(Channels & TELEMETRY_CHANNEL_GPS){
+		GPS_Fresh = 0;
+	}
+	
+	Scheduler_Post(Telemetry_Task,PIPELINE_READY);
+}
+
+/**
+  \fn					void GPS_Run(uint8_t Events)
+	\brief			Decodes a fix once the GPS interrupt has a complete one
+*/
+
+void GPS_Run(uint8_t Events){
+	if(FGPMMOPA6H_Fix_Ready()){
+		PROFILE_BEGIN(PROFILE_PARSE);
+		GPS_Latest = FGPMMOPA6H_Get_Fix();
+		PROFILE_END(PROFILE_PARSE);
+		GPS_Fresh = 1;
+	}
+}
+
+/**
+  \fn					void Arm_Run(uint8_t Events)
+	\brief			Waits for the button, then starts the sensors and the backup deployment timer
+*/
+
+void Arm_Run(uint8_t Events){
+	
+	if(Button_Get_State() == 0){
+		return;
 	}
 	
 	/* Turn on Green LED */
@@ -56,26 +308,278 @@ int main (void){
 	/* Enable Timer */
 	Start_15s_Timer();
 	
-	/* Grab data from sensors and send */
-  while (1) {	
+	/* Flash erase ahead starts now, not at power up */
+	Black_Box_State = 1;
+	Scheduler_Set_Period(Sensor_Task,SENSOR_PERIOD);
+	Scheduler_Set_Period(Arm_Task,0);
+}
 
-//		GPS_Altitude = atof(FGPMMOPA6H_Get_GGA_Altitude());
-//		
-//		if((FGPMMOPA6H_Get_RMC_Status() == 1) && (GPS_Altitude <= CHUTE_DEPLOY_ALT)){
-//			Servo_Position(180);
-//		}
-		
-		while(GPS_Ready.Status == 0){
-			//Nop
+/**
+  \fn					void Link_Run(uint8_t Events)
+	\brief			Steps the rate and encoding with the link
+*/
+
+void Link_Run(uint8_t Events){
+	Link_Quality_Poll(msTicks);
+}
+
+/**
+  \fn					void Flash_Run(uint8_t Events)
+	\brief			Starts the next page program or erase once the flash chip is free. Nothing is polled
+							before arming, so erase ahead doesn't wipe the oldest sectors on every power up, and
+							after the landing the log is closed so the flight isn't written over
+*/
+
+void Flash_Run(uint8_t Events){
+	
+	if(Black_Box_State == 1){
+		Flash_Log_Poll();
+	}
+	else if((Black_Box_State == 2) && Flash_Log_Close()){
+		Black_Box_State = 3;
+	}
+}
+
+/**
+  \fn					void Log_Run(uint8_t Events)
+	\brief			Prints one task's runtime or one pipeline stage a run, the serial monitor is only
+							9600 baud. Sending 'p' from the serial monitor prints the profile instead, 's' the
+							busy waits, 'r' clears both. 't' sends the event trace for Tools/Trace_Convert,
+							'i' prints the interrupt latencies and budget faults, 'm' the RAM regions and stack,
+							'f' the flash log counters, 'u' the uplink counters and command latency, 'd' the
+							deployment request to servo times. 'b' sends the flash log for Tools/Flash_Log_Decode
+							before arming or once it is closed after the landing, ~60 s per 64 KB.
+*/
+
+void Log_Run(uint8_t Events){
+	
+	int Command = SER_GetChar();
+	
+	if(Command == 'p'){
+		Profile_Report();
+		return;
+	}
+	if(Command == 's'){
+		Spin_Report();
+		return;
+	}
+	if(Command == 'm'){
+		Arena_Report();
+		return;
+	}
+	if(Command == 'i'){
+		ISR_Monitor_Report();
+		return;
+	}
+	if(Command == 't'){
+		Trace_Dump();
+		return;
+	}
+	if(Command == 'f'){
+		Flash_Log_Report();
+		return;
+	}
+	if(Command == 'b'){
+		if(((Black_Box_State != 0) && (Black_Box_State != 3)) || (Flash_Log_Dump(SER_PutChar) == 0)){
+			printf("Flash log: still logging, dump it after the landing\r\n");
 		}
+		return;
+	}
+	if(Command == 'u'){
+		Uplink_Report();
+		return;
+	}
+	if(Command == 'd'){
+		Deploy_Report();
+		return;
+	}
+	if(Command == 'r'){
+		Profile_Reset();
+		Spin_Reset();
+	}
+	
+	if(Log_Index < Scheduler_Task_Count()){
+		Scheduler_Print_Task(Log_Index);
+	}
+	else{
+		Pipeline_Print_Stage(Log_Index - Scheduler_Task_Count());
+	}
+	
+	Log_Index++;
+	if(Log_Index >= (Scheduler_Task_Count() + PIPELINE_STAGES)){
+		Log_Index = 0;
+	}
+}
+
+/**
+  \fn					void Send_Telemetry(const uint8_t* Frame, int Length)
+	\brief			Queues a frame for the XBee, through the FEC blocks when they are on
+	\param			const uint8_t* Frame: Telemetry frame
+	\param			int Length: Frame length in bytes
+*/
+
+void Send_Telemetry(const uint8_t* Frame, int Length){
+	
+	/* Local Variables */
+	const uint8_t* Block;
+	int Used = 0;
+	
+	/* Several records per RF packet */
+	if(FEC_Enabled() == 0){
+		XBee_API_Queue(Frame,Length);
+		return;
+	}
+	
+	/* Frames run across blocks, each full block is one RF packet and goes now */
+	while(Length > 0){
+		Used = FEC_Write(Frame,Length);
+		Frame += Used;
+		Length -= Used;
 		
-		/* Congregate Data */
-		sprintf(Data,"%s%s",FGPMMOPA6H_Package_Data(),ISK01A1_Package_Data());
-		
-		/* Send data over the XBEE */
-		LPUART1_Send(Data);
-  }
+		Block = FEC_Take_Block();
+		if(Block != 0){
+			XBee_API_Queue(Block,FEC_Block_Length());
+			XBee_API_Flush();
+		}
+	}
+}
+
+/**
+  \fn					void Send_Started_Block(void)
+	\brief			Pads the FEC block being filled and sends it, nothing happens with the FEC off or
+							the block empty
+*/
+
+void Send_Started_Block(void){
+	
+	int Padding = 0;
+	
+	if(FEC_Enabled() == 0){
+		return;
+	}
 	
+	Padding = FEC_Pad();
+	if(Padding != 0){
+		Telemetry_Scheduler_Charge(FEC_Coded_Length(Padding));
+		XBee_API_Queue(FEC_Take_Block(),FEC_Block_Length());
+		XBee_API_Flush();
+	}
+}
+
+/**
+  \fn					void Check_Apogee(int32_t Altitude)
+	\brief			Posts the apogee event once the baro altitude has climbed and fallen back
+	\param			int32_t Altitude: Baro altitude in cm
+*/
+
+void Check_Apogee(int32_t Altitude){
+	
+	if(Apogee_State == 0){
+		Ground_Altitude = Altitude;
+		Highest_Altitude = Altitude;
+		Apogee_State = 1;
+	}
+	if(Altitude > Highest_Altitude){
+		Highest_Altitude = Altitude;
+	}
+	
+	if((Apogee_State == 1) && ((Highest_Altitude - Ground_Altitude) > APOGEE_CLIMB) &&
+		(Altitude < (Highest_Altitude - APOGEE_DROP))){
+		Events_Post(TELEMETRY_EVENT_APOGEE,Highest_Altitude,msTicks);
+		Apogee_State = 2;
+	}
+}
+
+/**
+  \fn					void Check_Landing(int32_t Altitude)
+	\brief			Closes the flash log once the baro altitude has stayed near the ground for LANDED_TIME
+							after apogee, or BLACK_BOX_AFTER_DEPLOY after the deployment if no landing is seen
+	\param			int32_t Altitude: Baro altitude in cm
+*/
+
+void Check_Landing(int32_t Altitude){
+	
+	if(Black_Box_State != 1){
+		return;
+	}
+	
+	if((Deploy_Time == 0) && (Deploy_Get_State() != 0)){
+		Deploy_Time = msTicks | 1;
+	}
+	if((Apogee_State == 2) && (Altitude < (Ground_Altitude + LANDED_HEIGHT))){
+		if(Landed_Time == 0){
+			Landed_Time = msTicks | 1;
+		}
+	}
+	else{
+		Landed_Time = 0;
+	}
+	
+	if(((Landed_Time != 0) && ((msTicks - Landed_Time) >= LANDED_TIME)) ||
+		((Deploy_Time != 0) && ((msTicks - Deploy_Time) >= BLACK_BOX_AFTER_DEPLOY))){
+		Black_Box_State = 2;
+	}
+}
+
+/**
+  \fn					void Collect_Telemetry(Telemetry_Record* Record, uint8_t Channels)
+	\brief			Reads the sensors of the chosen channels into a telemetry record
+	\param			Telemetry_Record* Record: Filled with fixed point values
+	\param			uint8_t Channels: TELEMETRY_CHANNEL bits, the rest of Record is left alone
+*/
+
+void Collect_Telemetry(Telemetry_Record* Record, uint8_t Channels){
+	
+	/* Local Variables */
+	GPS_Fix* Fix;
+	XBee_API_Stats* Link;
+	
+	Record->Timestamp = Timing_Microseconds();
+	Record->Channels = Channels;
+	
+	/* GPS, decoded by the GPS task */
+	if((Channels & TELEMETRY_CHANNEL_GPS) && (GPS_Latest != 0)){
+		Fix = GPS_Latest;
+		Record->Latitude = Fix->Latitude;
+		Record->Longitude = Fix->Longitude;
+		Record->GPS_Altitude = Fix->Altitude;
+		Record->Ground_Speed = (uint16_t)Fix->Ground_Speed;
+		Record->GPS_Time = Fix->Time;
+		Record->GPS_Status = (uint8_t)(Fix->Satellites & TELEMETRY_GPS_SATELLITES);
+		if(Fix->Valid){
+			Record->GPS_Status |= TELEMETRY_GPS_VALID;
+		}
+	}
+	
+	/* Sensors, scaled to the units in Telemetry.h */
+	if(Channels & TELEMETRY_CHANNEL_ENV){
+		Record->Temperature = (int16_t)(ISK01A1_Get_Temperature()*100.0f);
+		Record->Humidity = (uint16_t)(ISK01A1_Get_Humidity()*100.0f);
+	}
+	if(Channels & TELEMETRY_CHANNEL_IMU){
+		Record->Acceleration[0] = (int16_t)ISK01A1_Get_Acceleration_X();
+		Record->Acceleration[1] = (int16_t)ISK01A1_Get_Acceleration_Y();
+		Record->Acceleration[2] = (int16_t)ISK01A1_Get_Acceleration_Z();
+		Record->Gyroscope[0] = (int16_t)(ISK01A1_Get_Pitch()/100.0f);			/* mdps to tenths of a dps */
+		Record->Gyroscope[1] = (int16_t)(ISK01A1_Get_Roll()/100.0f);
+		Record->Gyroscope[2] = (int16_t)(ISK01A1_Get_Yaw()/100.0f);
+		Record->Magnetic[0] = (int16_t)ISK01A1_Get_Magnetic_X();
+		Record->Magnetic[1] = (int16_t)ISK01A1_Get_Magnetic_Y();
+		Record->Magnetic[2] = (int16_t)ISK01A1_Get_Magnetic_Z();
+	}
+	if(Channels & TELEMETRY_CHANNEL_BARO){
+		Record->Pressure = (int32_t)(ISK01A1_Get_Pressure()*100.0f);
+		Record->Baro_Altitude = (int32_t)(ISK01A1_Get_Altitude()*100.0f);
+	}
+	
+	/* Link health */
+	if(Channels & TELEMETRY_CHANNEL_HEALTH){
+		Link = XBee_API_Get_Stats();
+		Record->Records_Dropped = (uint16_t)Link->Dropped;
+		Record->Link_Failures = (uint16_t)Link->Failed;
+		Record->RSSI = Link->RSSI;
+		Record->Link_Level = Link_Quality_Get_Stats()->Level;
+	}
 }
 
 /**
@@ -91,6 +595,7 @@ int main (void){
 							* ISK01A1 Expansion Board
 							*	FGMMOPA6H Gps module
 							*	XBEE Wireless communication
+							*	NOR flash black box log
 */
 
 void IO_Init(void){
@@ -99,6 +604,8 @@ void IO_Init(void){
 	SystemCoreClockInit();
   SystemCoreClockUpdate();
 	SysTick_Config(SystemCoreClock / 1000);  // SysTick 1 msec interrupts
+	Timer2_Init();														// 1 MHz timebase, before anything timestamps
+	Trace_Start(TRACE_MASK);
 	
   /* Port initializations */
 	GPIO_Output_Init(GPIOA,Green_LED);										//LD2 Initialization
@@ -107,26 +614,43 @@ void IO_Init(void){
 	/* Serial Communications Initializations */
   SER_Initialize();
 	USART1_Init();		/* For the GPS */
+	Uplink_Init();		/* Received bytes are decoded in PendSV */
 	LPUART_Init();		/* For XBee */
 	
+	/* XBee Initialization */
+	/* The AT command sequence needs 1 second guard times, so it runs
+	 * while everything else initializes
+	 */
+	XBee_Config_Start(XBee_900HP_Steps);			//Used with long distance 900 MHz XBee, 115200 baud, API mode
+//	XBee_Config_Start(XBee_ProS1_Steps);			//Used with 2.4 GHz Xbee
+	
 	/* ADC Initializations */
 	ADC_Init();
+	XBee_Config_Poll();
 	
 	/* I2C Initialization */
 	I2C_Init();
+	XBee_Config_Poll();
 	
 	/* Mems board Initialization */
 	ISK01A1_Init();
+	XBee_Config_Poll();
+	
+	/* Black box flash, finds the end of the log by reading the first page of every sector */
+	Flash_Log_Init(&Flash_Chip,NOR_Flash_Init(),Arena_Alloc("Flash log",ARENA_FLASH_LOG));
+	XBee_Config_Poll();
 	
 	/* GPS Initialization with 1 second refresh rate */
 	FGPMMOPA6H_Init(4);
+//	FGPMMOPA6H_Set_Protocol(GPS_PROTOCOL_MTK_BINARY);		//Binary fixes, needs the DIYDrones MTK firmware
 	
-	/* XBee Initialization */
-	/* Note that setup takes 2 seconds due to 1 second delays required
-	 * By the XBee AT command Sequence
-	 */
-	XBee_900HP_Init();			//Used with long distance 900 MHz XBee
-//	XBee_ProS1_Init();			//Used with 2.4 GHz Xbee
+	/* Finish the XBee, every step has a timeout so a missing radio can't hang here */
+	while(XBee_Config_Poll() == XBEE_CONFIG_BUSY){
+		//Nop
+	}
+	if(XBee_Config_Status() == XBEE_CONFIG_FAILED){
+		Events_Post(TELEMETRY_EVENT_FAULT,TELEMETRY_FAULT_XBEE_CONFIG,msTicks);
+	}
 	
 	/*Position the servo*/
 	Servo_Position(0);
@@ -12,6 +12,7 @@
 #include <stdio.h>												// Standard input output
 #include "I2C.h"													// I2C Support
 #include "Serial.h"												// USART Drivers
+#include "Spin.h"													// Busy wait accounting
 #include "LIS3MDL.h"
 /*------------------------------------Addresses-------------------------------------------------------*/
 #define LIS3MDL_ADDRESS						0x1E		//Slave Address without the r/w
@@ -138,10 +139,12 @@ float LIS3MDL_X_Read(void){
 	I2C_Write_Reg(LIS3MDL_ADDRESS,LTS3MDL_CTRL_REG3,LIS3MDL_CTRL_REG3_MD0);
 	
 	//Wait for X coordinate data to be ready
+	SPIN_BEGIN(SPIN_LIS3MDL);
 	do{
 		I2C_Read_Reg(LIS3MDL_ADDRESS,LIS3MDL_STATUS_REG);
 		LIS3MDL_STATUS = I2C1->RXDR;
 	}while((LIS3MDL_STATUS & LIS3MDL_STATUS_REG_XDA) == 0);
+	SPIN_END(SPIN_LIS3MDL);
 	
 	//Read X Axis magnetic field
 	I2C_Read_Reg(LIS3MDL_ADDRESS,LIS3MDL_OUT_X_L);
@@ -180,10 +183,12 @@ float LIS3MDL_Y_Read(void){
 	I2C_Write_Reg(LIS3MDL_ADDRESS,LTS3MDL_CTRL_REG3,LIS3MDL_CTRL_REG3_MD0);
 	
 	//Wait for X coordinate data to be ready
+	SPIN_BEGIN(SPIN_LIS3MDL);
 	do{
 		I2C_Read_Reg(LIS3MDL_ADDRESS,LIS3MDL_STATUS_REG);
 		LIS3MDL_STATUS = I2C1->RXDR;
 	}while((LIS3MDL_STATUS & LIS3MDL_STATUS_REG_YDA) == 0);
+	SPIN_END(SPIN_LIS3MDL);
 	
 	//Read Y Axis magnetic field
 	I2C_Read_Reg(LIS3MDL_ADDRESS,LIS3MDL_OUT_Y_L);
@@ -219,10 +224,12 @@ float LIS3MDL_Z_Read(void){
 	I2C_Write_Reg(LIS3MDL_ADDRESS,LTS3MDL_CTRL_REG3,LIS3MDL_CTRL_REG3_MD0);
 	
 	//Wait for X coordinate data to be ready
+	SPIN_BEGIN(SPIN_LIS3MDL);
 	do{
 		I2C_Read_Reg(LIS3MDL_ADDRESS,LIS3MDL_STATUS_REG);
 		LIS3MDL_STATUS = I2C1->RXDR;
 	}while((LIS3MDL_STATUS & LIS3MDL_STATUS_REG_ZDA) == 0);
+	SPIN_END(SPIN_LIS3MDL);
 	
 	//Read Z Axis magnetic field
 	I2C_Read_Reg(LIS3MDL_ADDRESS,LIS3MDL_OUT_Z_L);
@@ -12,6 +12,7 @@
 #include <stdio.h>													// Standard input and output
 #include "I2C.h"														// I2C Drivers
 #include "Serial.h"													// Usart Drivers
+#include "Spin.h"													// Busy wait accounting
 #include "LPS25HB.h"
 /*---------------------------------Addresses----------------------------------------------------------*/
 #define LPS25HB_ADDRESS 							0x5D	//Note that SA0 = 1 so address is 1011101 and not 1011100
@@ -104,10 +105,12 @@ float LPS25HB_Pressure_Read(void){
 	I2C_Write_Reg(LPS25HB_ADDRESS,LPS25HB_CTRL_REG2,LPS25HB_CTRL_REG2_ONE_SHOT);
 	
 	//Wait for Temperature data to be ready
+	SPIN_BEGIN(SPIN_LPS25HB);
 	do{
 		I2C_Read_Reg(LPS25HB_ADDRESS,LPS25HB_STATUS_REG);
 		LPS25HB_STATUS = I2C1->RXDR;
 	}while((LPS25HB_STATUS & LPS25HB_STATUS_REG_PDA) == 0);
+	SPIN_END(SPIN_LPS25HB);
 	
 	//Read the pressure output registers
 	I2C_Read_Reg(LPS25HB_ADDRESS,LPS25HB_PRESS_OUT_XL);
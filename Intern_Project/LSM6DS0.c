@@ -12,6 +12,7 @@
 #include <stdio.h>												// Standard Input Output
 #include "I2C.h"													// I2C Drivers
 #include "Serial.h"												// USART Drivers
+#include "Spin.h"													// Busy wait accounting
 #include "LSM6DS0.h"
 /*------------------------------------Addresses-------------------------------------------------------*/
 #define LSM6DS0_ADDRESS								0x6B		//The slave address of the device without r/w
@@ -109,10 +110,12 @@ float LSM6DS0_X_Acceleration_Read(void){
 	float Acceleration_X = 0;
 	
 	//Wait for acceleration data to be ready
+	SPIN_BEGIN(SPIN_LSM6DS0);
 	do{
 		I2C_Read_Reg(LSM6DS0_ADDRESS,LSM6DS0_STATUS_REG);
 		LSM6DS0_STATUS = I2C1->RXDR;
 	}while((LSM6DS0_STATUS & LSM6DS0_STATUS_REG_XLDA) == 0);
+	SPIN_END(SPIN_LSM6DS0);
 	
 	//Read acceleration output registers
 	I2C_Read_Reg(LSM6DS0_ADDRESS,LSM6DS0_OUT_X_XL_L);
@@ -146,10 +149,12 @@ float LSM6DS0_Y_Acceleration_Read(void){
 	float Acceleration_Y = 0;
 	
 	//Wait for acceleration data to be ready
+	SPIN_BEGIN(SPIN_LSM6DS0);
 	do{
 		I2C_Read_Reg(LSM6DS0_ADDRESS,LSM6DS0_STATUS_REG);
 		LSM6DS0_STATUS = I2C1->RXDR;
 	}while((LSM6DS0_STATUS & LSM6DS0_STATUS_REG_XLDA) == 0);
+	SPIN_END(SPIN_LSM6DS0);
 	
 	//Read acceleration output registers
 	I2C_Read_Reg(LSM6DS0_ADDRESS,LSM6DS0_OUT_Y_XL_L);
@@ -183,10 +188,12 @@ float LSM6DS0_Z_Acceleration_Read(void){
 	float Acceleration_Z = 0;
 	
 	//Wait for acceleration data to be ready
+	SPIN_BEGIN(SPIN_LSM6DS0);
 	do{
 		I2C_Read_Reg(LSM6DS0_ADDRESS,LSM6DS0_STATUS_REG);
 		LSM6DS0_STATUS = I2C1->RXDR;
 	}while((LSM6DS0_STATUS & LSM6DS0_STATUS_REG_XLDA) == 0);
+	SPIN_END(SPIN_LSM6DS0);
 	
 	//Read acceleration output registers
 	I2C_Read_Reg(LSM6DS0_ADDRESS,LSM6DS0_OUT_Z_XL_L);
@@ -220,10 +227,12 @@ float LSM6DS0_Gyroscope_Roll_Read(void){
 	float Roll = 0;
 	
 	//Wait for roll data to be ready
+	SPIN_BEGIN(SPIN_LSM6DS0);
 	do{
 		I2C_Read_Reg(LSM6DS0_ADDRESS,LSM6DS0_STATUS_REG);
 		LSM6DS0_STATUS = I2C1->RXDR;
 	}while((LSM6DS0_STATUS & LSM6DS0_STATUS_REG_GDA) == 0);
+	SPIN_END(SPIN_LSM6DS0);
 	
 	//Read Gyroscope output registers
 	I2C_Read_Reg(LSM6DS0_ADDRESS,LSM6DS0_OUT_X_G_L);
@@ -257,10 +266,12 @@ float LSM6DS0_Gyroscope_Pitch_Read(void){
 	float Pitch = 0;
 	
 	//Wait for pitch data to be ready
+	SPIN_BEGIN(SPIN_LSM6DS0);
 	do{
 		I2C_Read_Reg(LSM6DS0_ADDRESS,LSM6DS0_STATUS_REG);
 		LSM6DS0_STATUS = I2C1->RXDR;
 	}while((LSM6DS0_STATUS & LSM6DS0_STATUS_REG_GDA) == 0);
+	SPIN_END(SPIN_LSM6DS0);
 	
 	//Read gyroscope output registers
 	I2C_Read_Reg(LSM6DS0_ADDRESS,LSM6DS0_OUT_Y_G_L);
@@ -294,10 +305,12 @@ float LSM6DS0_Gyroscope_Yaw_Read(void){
 	float Yaw = 0;
 	
 	//Wait for Yaw data to be ready
+	SPIN_BEGIN(SPIN_LSM6DS0);
 	do{
 		I2C_Read_Reg(LSM6DS0_ADDRESS,LSM6DS0_STATUS_REG);
 		LSM6DS0_STATUS = I2C1->RXDR;
 	}while((LSM6DS0_STATUS & LSM6DS0_STATUS_REG_GDA) == 0);
+	SPIN_END(SPIN_LSM6DS0);
 	
 	//Read gyroscope output registers
 	I2C_Read_Reg(LSM6DS0_ADDRESS,LSM6DS0_OUT_Z_G_L);
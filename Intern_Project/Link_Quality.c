@@ -0,0 +1,186 @@
+/*------------------------------------------------------------------------------------------------------
+ * Name:    Link_Quality.c
+ * Purpose: Measures the XBee link and steps the telemetry rate and encoding to match it
+ * Date: 		10/19/26
+ * Author:	Christopher Jordan - Denny
+ *------------------------------------------------------------------------------------------------------
+ * Note(s): Once a LINK_QUALITY_PERIOD the TX Status counters are sampled and ATDB is requested as a
+						local AT Command frame, so the radio never leaves API mode and no telemetry waits on it.
+						Nothing is measured in transparent mode and the level stays at LINK_QUALITY_START.
+						
+						*	A poor sample steps down one level at once, LINK_UP_SAMPLES good samples in a row
+							step up one level, so the rate falls quickly at range and only climbs back once
+							the link has shown it can carry it
+						*	Poor: under LINK_POOR_DELIVERY % delivered, RSSI weaker than LINK_POOR_RSSI, more
+							than one retry a frame, records dropped, or frames sent with no TX Status back
+						*	Good: everything delivered, RSSI at least LINK_GOOD_RSSI, at most one retry in four
+							frames and nothing dropped
+						
+						Levels:
+						-------
+						*	Level		Budget		Keyframe every		Channels
+						*	0				4000 B/s	50 frames					All
+						*	1				2000 B/s	25 frames					All
+						*	2				1000 B/s	10 frames					All
+						*	3				500 B/s		5 frames					No IMU
+						*	4				200 B/s		3 frames					BARO, GPS and HEALTH
+ *----------------------------------------------------------------------------------------------------*/
+
+/*---------------------------------------------Include Statements-------------------------------------*/
+#include "Link_Quality.h"
+#include "XBee_API.h"									// TX Status counters and ATDB
+#include "Telemetry.h"								// Channels and keyframe interval
+#include "Telemetry_Scheduler.h"			// Byte budget
+/*---------------------------------------------Definitions--------------------------------------------*/
+#define LINK_UP_SAMPLES						5							// Good samples in a row before stepping up
+#define LINK_POOR_DELIVERY				80						// % delivered below which the level steps down
+#define LINK_POOR_RSSI						95						// -dBm, 900HP sensitivity is -101 dBm at 200 kbps
+#define LINK_GOOD_RSSI						85						// -dBm
+
+/* What each level sends */
+typedef struct Link_Level
+{
+	uint16_t Budget;																	/* Bytes per second */
+	uint8_t Keyframe_Interval;												/* Frames */
+	uint8_t Channels;																	/* TELEMETRY_CHANNEL bits allowed */
+}Link_Level;
+/*---------------------------------------------Tables-------------------------------------------------*/
+static const Link_Level Levels[LINK_QUALITY_LEVELS] = {
+	{4000,	50,	TELEMETRY_CHANNEL_ALL},
+	{2000,	25,	TELEMETRY_CHANNEL_ALL},
+	{1000,	10,	TELEMETRY_CHANNEL_ALL},
+	{500,		5,	TELEMETRY_CHANNEL_ALL & ~TELEMETRY_CHANNEL_IMU},
+	{200,		3,	TELEMETRY_CHANNEL_BARO | TELEMETRY_CHANNEL_GPS | TELEMETRY_CHANNEL_HEALTH}
+};
+/*---------------------------------------------Globals------------------------------------------------*/
+Link_Quality_Stats	Link_Quality;
+uint32_t						Next_Sample = 0;
+XBee_API_Stats			Last_Link;												/* Counters at the last sample */
+/*---------------------------------------------Functions----------------------------------------------*/
+
+/**
+  \fn					void Link_Quality_Apply(void)
+  \brief			Hands the current level to the scheduler and the encoder
+*/
+
+static void Link_Quality_Apply(void){
+	Telemetry_Scheduler_Set_Budget(Levels[Link_Quality.Level].Budget);
+	Telemetry_Set_Keyframe_Interval(Levels[Link_Quality.Level].Keyframe_Interval);
+}
+
+/**
+  \fn					void Link_Quality_Init(void)
+  \brief			Starts at LINK_QUALITY_START, call after Telemetry_Scheduler_Init
+*/
+
+void Link_Quality_Init(void){
+	Link_Quality.Level = LINK_QUALITY_START;
+	Last_Link = *XBee_API_Get_Stats();
+	Link_Quality_Apply();
+}
+
+/**
+  \fn					void Link_Quality_Poll(uint32_t Now)
+  \brief			Takes a sample once a LINK_QUALITY_PERIOD and moves the level, call every loop
+	\param			uint32_t Now: msTicks
+*/
+
+void Link_Quality_Poll(uint32_t Now){
+	
+	/* Local Variables */
+	XBee_API_Stats* Link = XBee_API_Get_Stats();
+	uint32_t Delivered = 0;
+	uint32_t Failed = 0;
+	uint32_t Retries = 0;
+	uint32_t Sent = 0;
+	uint32_t Dropped = 0;
+	uint32_t Statuses = 0;
+	int Poor = 0;
+	int Good = 0;
+	
+	if(((int32_t)(Now - Next_Sample) < 0) || (XBee_API_Get_Mode() == XBEE_API_MODE_OFF)){
+		return;
+	}
+	Next_Sample = Now + LINK_QUALITY_PERIOD;
+	
+	/* What happened since the last sample */
+	Delivered = Link->Delivered - Last_Link.Delivered;
+	Failed = Link->Failed - Last_Link.Failed;
+	Retries = Link->Retries - Last_Link.Retries;
+	Sent = Link->Frames_Sent - Last_Link.Frames_Sent;
+	Dropped = Link->Dropped - Last_Link.Dropped;
+	Last_Link = *Link;
+	Statuses = Delivered + Failed;
+	
+	/* Answered before the next sample */
+	XBee_API_Request_RSSI();
+	Link_Quality.RSSI = Link->RSSI;
+	Link_Quality.Samples++;
+	
+	if(Statuses != 0){
+		Link_Quality.Delivery = (uint8_t)((Delivered*100)/Statuses);
+		Poor = (Link_Quality.Delivery < LINK_POOR_DELIVERY) || (Retries > Statuses);
+		Good = (Failed == 0) && ((Retries*4) <= Statuses);
+	}
+	else if(Sent > 1){
+		
+		/* Frames went out and nothing came back, one may still be in the air */
+		Link_Quality.Delivery = 0;
+		Poor = 1;
+	}
+	else{
+		
+		/* Nothing sent, nothing learned */
+		return;
+	}
+	
+	if(Dropped != 0){
+		Poor = 1;
+		Good = 0;
+	}
+	if(Link_Quality.RSSI != 0){
+		Poor |= (Link_Quality.RSSI > LINK_POOR_RSSI);
+		Good &= (Link_Quality.RSSI <= LINK_GOOD_RSSI);
+	}
+	
+	if(Poor){
+		Link_Quality.Good_Samples = 0;
+		if(Link_Quality.Level < (LINK_QUALITY_LEVELS - 1)){
+			Link_Quality.Level++;
+			Link_Quality.Step_Downs++;
+			Link_Quality_Apply();
+		}
+	}
+	else if(Good){
+		Link_Quality.Good_Samples++;
+		if((Link_Quality.Good_Samples >= LINK_UP_SAMPLES) && (Link_Quality.Level > 0)){
+			Link_Quality.Good_Samples = 0;
+			Link_Quality.Level--;
+			Link_Quality.Step_Ups++;
+			Link_Quality_Apply();
+		}
+	}
+	else{
+		Link_Quality.Good_Samples = 0;
+	}
+}
+
+/**
+  \fn					uint8_t Link_Quality_Channels(void)
+  \brief			Channels the current level may send
+	\returns		uint8_t: TELEMETRY_CHANNEL bits
+*/
+
+uint8_t Link_Quality_Channels(void){
+	return(Levels[Link_Quality.Level].Channels);
+}
+
+/**
+  \fn					Link_Quality_Stats* Link_Quality_Get_Stats(void)
+  \brief			Retrieves the level and the newest sample
+	\returns		Link_Quality_Stats*: The counters
+*/
+
+Link_Quality_Stats* Link_Quality_Get_Stats(void){
+	return(&Link_Quality);
+}
@@ -0,0 +1,38 @@
+/*------------------------------------------------------------------------------------------------------
+ * Name:    Link_Quality.h
+ * Purpose: Measures the XBee link and steps the telemetry rate and encoding to match it
+ * Date: 		10/19/26
+ * Author:	Christopher Jordan - Denny
+ *------------------------------------------------------------------------------------------------------
+ * Note(s): See C file for the levels
+ *----------------------------------------------------------------------------------------------------*/
+
+/*-----------------------------------------Include Statements-----------------------------------------*/
+#include <stdint.h>
+
+#ifndef LINK_QUALITY_H
+#define LINK_QUALITY_H
+
+/*-----------------------------------------Definitions------------------------------------------------*/
+#define LINK_QUALITY_PERIOD				1000					// ms between samples
+#define LINK_QUALITY_LEVELS				5							// Level 0 is the best link
+#define LINK_QUALITY_START				1							// Level until the link has been measured
+
+/* Newest sample and the controller's history */
+typedef struct Link_Quality_Stats
+{
+	uint8_t Level;											/* Current level */
+	uint8_t Delivery;										/* % of TX Status delivered in the last sample */
+	uint8_t RSSI;												/* -dBm, 0 until the radio answers ATDB */
+	uint8_t Good_Samples;								/* Good samples in a row */
+	uint32_t Samples;
+	uint32_t Step_Downs;
+	uint32_t Step_Ups;
+}Link_Quality_Stats;
+
+extern void Link_Quality_Init(void);
+extern void Link_Quality_Poll(uint32_t Now);
+extern uint8_t Link_Quality_Channels(void);
+extern Link_Quality_Stats* Link_Quality_Get_Stats(void);
+
+#endif
@@ -0,0 +1,218 @@
+/*------------------------------------------------------------------------------------------------------
+ * Name:    NMEA_Parse.c
+ * Purpose: Converts NMEA decimal fields straight into scaled integers
+ * Date: 		10/19/26
+ * Author:	Christopher Jordan - Denny
+ *------------------------------------------------------------------------------------------------------
+ * Note(s): Replaces atof/atoi on the GPS path. Each field is read once, left to right, with no
+						copies, no allocation and no floating point, which keeps the soft float and libc
+						conversion code out of the M0+ image.
+						
+						Every function stops at the first character that does not belong to the number
+						(',', '*', '\0', ...) and returns how many characters it used, 0 when the field is
+						empty or malformed. The output is only written on success.
+						
+						Results:
+						--------
+						*	Fixed: Value * 10^Decimals, extra decimals are truncated
+						*	Coordinate: (d)ddmm.mmmm as millionths of a degree, negative for S and W
+						*	Time: hhmmss.sss as hhmmssmmm
+						*	Knots: Speed in centimeters per second
+						*	Meters: Distance in centimeters
+ *----------------------------------------------------------------------------------------------------*/
+
+/*---------------------------------------------Include Statements-------------------------------------*/
+#include "NMEA_Parse.h"
+/*---------------------------------------------Definitions--------------------------------------------*/
+#define MAX_DIGITS						9								// Digits that always fit in an int32_t
+#define IS_DIGIT(c)						(((c) >= '0') && ((c) <= '9'))
+/*---------------------------------------------Functions----------------------------------------------*/
+
+/**
+  \fn					int NMEA_Parse_Fixed(const char* Field, int Decimals, int32_t* Value)
+  \brief			Parses [-]digits[.digits] into a scaled integer
+	\param			const char* Field: The start of the field
+	\param			int Decimals: Number of decimal places to keep (0 - 8)
+	\param			int32_t* Value: The field * 10^Decimals
+	\returns		int: Characters used, 0 if the field is not a number or is too long
+*/
+
+int NMEA_Parse_Fixed(const char* Field, int Decimals, int32_t* Value){
+	
+	/* Local Variables */
+	const char* Position = Field;
+	int32_t Result = 0;
+	int Negative = 0;
+	int Found_Digit = 0;
+	int Digits = 0;								/* Significant digits in Result */
+	int Fraction_Digits = 0;
+	
+	/* Sign */
+	if((*Position == '-') || (*Position == '+')){
+		Negative = (*Position == '-');
+		Position++;
+	}
+	
+	/* Integer part, leading zeros do not count towards the limit. Past MAX_DIGITS the digit is only
+		 counted, which fails the check below before Result can overflow */
+	while(IS_DIGIT(*Position)){
+		if(Digits < MAX_DIGITS){
+			Result = (Result * 10) + (*Position - '0');
+		}
+		if(Result != 0){
+			Digits++;
+		}
+		Found_Digit = 1;
+		Position++;
+	}
+	
+	/* Fraction, truncated to the requested decimals */
+	if(*Position == '.'){
+		Position++;
+		while(IS_DIGIT(*Position)){
+			if(Fraction_Digits < Decimals){
+				if(Digits < MAX_DIGITS){
+					Result = (Result * 10) + (*Position - '0');
+				}
+				if(Result != 0){
+					Digits++;
+				}
+				Fraction_Digits++;
+			}
+			Found_Digit = 1;
+			Position++;
+		}
+	}
+	
+	/* Pad the missing decimals */
+	while(Fraction_Digits < Decimals){
+		if(Digits < MAX_DIGITS){
+			Result *= 10;
+		}
+		if(Result != 0){
+			Digits++;
+		}
+		Fraction_Digits++;
+	}
+	
+	/* Needs a digit and must fit */
+	if((Found_Digit == 0) || (Digits > MAX_DIGITS)){
+		return(0);
+	}
+	
+	*Value = Negative ? -Result : Result;
+	
+	return(Position - Field);
+}
+
+/**
+  \fn					int NMEA_Parse_Coordinate(const char* Field, char Indicator, int32_t* Microdegrees)
+  \brief			Parses a ddmm.mmmm latitude or dddmm.mmmm longitude
+	\param			const char* Field: The start of the field
+	\param			char Indicator: N, S, E or W, S and W give a negative result
+	\param			int32_t* Microdegrees: Millionths of a degree
+	\returns		int: Characters used, 0 if the field is malformed
+*/
+
+int NMEA_Parse_Coordinate(const char* Field, char Indicator, int32_t* Microdegrees){
+	
+	/* Local Variables */
+	int32_t Degrees = 0;
+	int32_t Micro_Minutes = 0;
+	int Degree_Digits = 0;
+	int Length = 0;
+	int i = 0;
+	
+	/* The degrees are every integer digit except the last two */
+	while(IS_DIGIT(Field[Degree_Digits])){
+		Degree_Digits++;
+	}
+	Degree_Digits -= 2;
+	if((Degree_Digits < 1) || (Degree_Digits > 3)){
+		return(0);
+	}
+	for(i = 0;i < Degree_Digits;i++){
+		Degrees = (Degrees * 10) + (Field[i] - '0');
+	}
+	
+	/* Minutes with six decimals, millionths of a degree would overflow past 2147 minutes */
+	Length = NMEA_Parse_Fixed(Field + Degree_Digits,6,&Micro_Minutes);
+	if((Length == 0) || (Micro_Minutes >= 60000000) || (Degrees > 180)){
+		return(0);
+	}
+	
+	/* One minute is 1/60 of a degree, rounded */
+	Degrees = (Degrees * 1000000) + ((Micro_Minutes + 30) / 60);
+	
+	if((Indicator == 'S') || (Indicator == 'W')){
+		Degrees = -Degrees;
+	}
+	
+	*Microdegrees = Degrees;
+	
+	return(Degree_Digits + Length);
+}
+
+/**
+  \fn					int NMEA_Parse_Time(const char* Field, uint32_t* Time)
+  \brief			Parses a hhmmss.sss UTC time
+	\param			const char* Field: The start of the field
+	\param			uint32_t* Time: hhmmssmmm
+	\returns		int: Characters used, 0 if the field is malformed
+*/
+
+int NMEA_Parse_Time(const char* Field, uint32_t* Time){
+	
+	/* Local Variables */
+	int32_t Value = 0;
+	int Length = 0;
+	
+	Length = NMEA_Parse_Fixed(Field,3,&Value);
+	
+	/* hh < 24, mm < 60, ss < 61 (leap second) */
+	if((Length == 0) || (Value < 0) || (Value / 10000000 > 23) ||
+		((Value / 100000) % 100 > 59) || ((Value / 1000) % 100 > 60)){
+		return(0);
+	}
+	
+	*Time = (uint32_t)Value;
+	
+	return(Length);
+}
+
+/**
+  \fn					int NMEA_Parse_Knots(const char* Field, int32_t* Speed)
+  \brief			Parses a speed over ground in knots
+	\param			const char* Field: The start of the field
+	\param			int32_t* Speed: Centimeters per second
+	\returns		int: Characters used, 0 if the field is malformed
+*/
+
+int NMEA_Parse_Knots(const char* Field, int32_t* Speed){
+	
+	/* Local Variables */
+	int32_t Hundredths = 0;
+	int Length = 0;
+	
+	Length = NMEA_Parse_Fixed(Field,2,&Hundredths);
+	if((Length == 0) || (Hundredths < 0) || (Hundredths > 1000000)){
+		return(0);
+	}
+	
+	/* 0.01 knot = 0.51444 cm/s, 1286/2500 keeps the product inside 32 bits */
+	*Speed = ((Hundredths * 1286) + 1250) / 2500;
+	
+	return(Length);
+}
+
+/**
+  \fn					int NMEA_Parse_Meters(const char* Field, int32_t* Distance)
+  \brief			Parses a distance in meters, i.e. the GGA altitude
+	\param			const char* Field: The start of the field
+	\param			int32_t* Distance: Centimeters
+	\returns		int: Characters used, 0 if the field is malformed
+*/
+
+int NMEA_Parse_Meters(const char* Field, int32_t* Distance){
+	return(NMEA_Parse_Fixed(Field,2,Distance));
+}
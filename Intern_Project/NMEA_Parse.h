@@ -0,0 +1,22 @@
+/*------------------------------------------------------------------------------------------------------
+ * Name:    NMEA_Parse.h
+ * Purpose: Converts NMEA decimal fields straight into scaled integers
+ * Date: 		10/19/26
+ * Author:	Christopher Jordan - Denny
+ *------------------------------------------------------------------------------------------------------
+ * Note(s): See C file for further discription
+ *----------------------------------------------------------------------------------------------------*/
+
+/*-----------------------------------------Include Statements-----------------------------------------*/
+#include <stdint.h>
+
+#ifndef NMEA_PARSE_H
+#define NMEA_PARSE_H
+
+extern int NMEA_Parse_Fixed(const char* Field, int Decimals, int32_t* Value);
+extern int NMEA_Parse_Coordinate(const char* Field, char Indicator, int32_t* Microdegrees);
+extern int NMEA_Parse_Time(const char* Field, uint32_t* Time);
+extern int NMEA_Parse_Knots(const char* Field, int32_t* Speed);
+extern int NMEA_Parse_Meters(const char* Field, int32_t* Distance);
+
+#endif
@@ -0,0 +1,133 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "NMEA_Parse.h"
+#include "Serial.h"
+#include "Timing.h"
+#include "NMEA_Parse_Test.h"
+
+#define FUZZ_ITERATIONS				5000
+#define BENCH_ITERATIONS			1000
+
+/**
+  \fn					int Known_Values(void)
+  \brief			Checks a few fields from real sentences
+	\returns		int: Number of failures
+*/
+
+static int Known_Values(void){
+	
+	int Failures = 0;
+	int32_t Value = 0;
+	uint32_t Time = 0;
+	
+	if((NMEA_Parse_Coordinate("4807.038,N",'N',&Value) != 8) || (Value != 48117300)) Failures++;
+	if((NMEA_Parse_Coordinate("01131.000,E",'W',&Value) != 9) || (Value != -11516667)) Failures++;
+	if((NMEA_Parse_Time("123519.123,",&Time) != 10) || (Time != 123519123)) Failures++;
+	if((NMEA_Parse_Knots("022.4",&Value) != 5) || (Value != 1152)) Failures++;
+	if((NMEA_Parse_Meters("-545.4*",&Value) != 6) || (Value != -54540)) Failures++;
+	if(NMEA_Parse_Fixed("",2,&Value) != 0) Failures++;
+	if(NMEA_Parse_Fixed(".",2,&Value) != 0) Failures++;
+	if(NMEA_Parse_Fixed("9999999999",0,&Value) != 0) Failures++;
+	if(NMEA_Parse_Time("256000.000",&Time) != 0) Failures++;
+	
+	return(Failures);
+}
+
+/**
+  \fn					int Fuzz(void)
+  \brief			Feeds random fields and random valid numbers through the parser
+							*	Random characters: the parser must never read past the field
+							*	Random numbers: printed then parsed back, must match exactly
+	\returns		int: Number of failures
+*/
+
+static int Fuzz(void){
+	
+	const char Alphabet[] = "0123456789.-+,*NSEW";
+	char Field[24];
+	int Failures = 0;
+	int Length = 0;
+	int Used = 0;
+	int Decimals = 0;
+	int32_t Value = 0;
+	int32_t Expected = 0;
+	int32_t Scale = 1;
+	uint32_t Time = 0;
+	int i = 0;
+	int j = 0;
+	
+	srand(1);
+	
+	for(i = 0;i < FUZZ_ITERATIONS;i++){
+		
+		/* Random characters */
+		Length = rand() % 16;
+		for(j = 0;j < Length;j++){
+			Field[j] = Alphabet[rand() % (sizeof(Alphabet) - 1)];
+		}
+		Field[Length] = '\0';
+		
+		Used = NMEA_Parse_Fixed(Field,rand() % 7,&Value);
+		if(Used > Length) Failures++;
+		Used = NMEA_Parse_Coordinate(Field,'S',&Value);
+		if(Used > Length) Failures++;
+		Used = NMEA_Parse_Time(Field,&Time);
+		if(Used > Length) Failures++;
+		
+		/* Random numbers that fit in 9 digits */
+		Decimals = rand() % 5;
+		for(j = 0,Scale = 1;j < Decimals;j++){
+			Scale *= 10;
+		}
+		Expected = (int32_t)(((uint32_t)rand() << 15) ^ (uint32_t)rand()) % 100000000;
+		sprintf(Field,"%s%i.%0*i",(Expected < 0) ? "-" : "",abs(Expected / Scale),Decimals,abs(Expected % Scale));
+		if(Decimals == 0){
+			sprintf(Field,"%i",Expected);
+		}
+		
+		Used = NMEA_Parse_Fixed(Field,Decimals,&Value);
+		if((Used != (int)strlen(Field)) || (Value != Expected)) Failures++;
+	}
+	
+	return(Failures);
+}
+
+/**
+  \fn					void NMEA_Parse_Test_Code(void)
+  \brief			Runs the parser checks and compares its speed with atof
+*/
+
+void NMEA_Parse_Test_Code(void){
+	
+	unsigned int Start = 0;
+	unsigned int Fixed_Time = 0;
+	unsigned int Atof_Time = 0;
+	volatile int32_t Value = 0;
+	volatile float Result = 0;
+	int32_t Parsed = 0;
+	int i = 0;
+	
+	printf("Known values failures: %i\r\n",Known_Values());
+	printf("Fuzz failures: %i\r\n",Fuzz());
+	
+	/* The three fields of a RMC/GGA pair that used to go through atof */
+	Start = msTicks;
+	for(i = 0;i < BENCH_ITERATIONS;i++){
+		NMEA_Parse_Coordinate("4807.0380",'N',&Parsed);
+		NMEA_Parse_Knots("022.4",&Parsed);
+		NMEA_Parse_Meters("545.4",&Parsed);
+		Value = Parsed;
+	}
+	Fixed_Time = msTicks - Start;
+	
+	Start = msTicks;
+	for(i = 0;i < BENCH_ITERATIONS;i++){
+		Result = atof("4807.0380");
+		Result = atof("022.4") * 1.15077945;
+		Result = atof("545.4") * 3.28084;
+	}
+	Atof_Time = msTicks - Start;
+	
+	printf("%i iterations, fixed point: %u ms, atof: %u ms\r\n",BENCH_ITERATIONS,Fixed_Time,Atof_Time);
+}
@@ -0,0 +1,6 @@
+#ifndef NMEA_Parse_Test_H
+#define NMEA_Parse_Test_H
+
+extern void NMEA_Parse_Test_Code(void);
+
+#endif
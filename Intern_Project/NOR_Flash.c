@@ -0,0 +1,197 @@
+/*------------------------------------------------------------------------------------------------------
+ * Name:    NOR_Flash.c
+ * Purpose: SPI NOR flash chip, W25Q series commands
+ * Date: 		10/19/26
+ * Author:	Christopher Jordan - Denny
+ *------------------------------------------------------------------------------------------------------
+ * Note(s): The Flash_Log_Device of the black box log. Program, erase, suspend and resume only send
+						their command and return, the chip works on its own until NOR_Flash_Busy says it's
+						done.
+						*	The page data of a program goes out by DMA, the command and address by hand. Chip
+							select rising at the end of the DMA starts the program
+						*	Busy is one status read, ~2 us at 16 MHz
+						*	Any chip with the W25Q commands works (Winbond, Macronix MX25, ISSI IS25, GigaDevice
+							GD25), 24 bit addresses so up to 16 MB
+ *----------------------------------------------------------------------------------------------------*/
+
+/*---------------------------------------------Include Statements-------------------------------------*/
+#include "NOR_Flash.h"
+#include "SPI.h"											// Chip select, transfers and DMA
+#include "Timing.h"										// Delay, msTicks
+#include "Spin.h"											// Busy wait accounting
+/*---------------------------------------------Functions----------------------------------------------*/
+
+/**
+  \fn					void Command(const uint8_t* Tx, int Tx_Length, uint8_t* Rx, int Rx_Length)
+  \brief			One chip select cycle: Tx_Length bytes out, then Rx_Length bytes in
+*/
+
+static void Command(const uint8_t* Tx, int Tx_Length, uint8_t* Rx, int Rx_Length){
+	
+	SPI_Select(NOR_FLASH_SPI);
+	SPI_Transfer(NOR_FLASH_SPI,Tx,0,Tx_Length);
+	if(Rx_Length != 0){
+		SPI_Transfer(NOR_FLASH_SPI,0,Rx,Rx_Length);
+	}
+	SPI_Deselect(NOR_FLASH_SPI);
+}
+
+/**
+  \fn					void Put_Address(uint8_t* Tx, uint8_t Code, uint32_t Address)
+  \brief			Command code and 24 bit address, MSB first
+*/
+
+static void Put_Address(uint8_t* Tx, uint8_t Code, uint32_t Address){
+	
+	Tx[0] = Code;
+	Tx[1] = (uint8_t)(Address >> 16);
+	Tx[2] = (uint8_t)(Address >> 8);
+	Tx[3] = (uint8_t)Address;
+}
+
+/**
+  \fn					void Write_Enable(void)
+  \brief			Needed before every program and erase
+*/
+
+static void Write_Enable(void){
+	
+	uint8_t Tx = NOR_WRITE_ENABLE;
+	
+	Command(&Tx,1,0,0);
+}
+
+/**
+  \fn					uint32_t NOR_Flash_Init(void)
+  \brief			Resets the chip, which also ends a program or erase left over from before the micro
+							reset, and reads its size
+	\returns		uint32_t: Bytes, 0 if no chip answers or it stays busy past NOR_INIT_TIMEOUT
+*/
+
+uint32_t NOR_Flash_Init(void){
+	
+	uint8_t Tx = 0;
+	uint8_t ID[3];
+	uint32_t Start = 0;
+	int Busy = 0;
+	
+	SPI_Master_Init(NOR_FLASH_SPI);
+	
+	Tx = NOR_ENABLE_RESET;
+	Command(&Tx,1,0,0);
+	Tx = NOR_RESET;
+	Command(&Tx,1,0,0);
+	Tx = NOR_RELEASE_POWER_DOWN;
+	Command(&Tx,1,0,0);
+	Delay(1);
+	
+	/* Manufacturer, type, log2 of the size */
+	Tx = NOR_JEDEC_ID;
+	Command(&Tx,1,ID,3);
+	if((ID[0] == 0x00) || (ID[0] == 0xFF) || (ID[2] < 16) || (ID[2] > 24)){
+		return(0);
+	}
+	
+	Start = msTicks;
+	SPIN_BEGIN(SPIN_SPI);
+	do{
+		Busy = NOR_Flash_Busy();
+	}while(Busy && ((msTicks - Start) < NOR_INIT_TIMEOUT));
+	SPIN_END(SPIN_SPI);
+	if(Busy){
+		return(0);
+	}
+	
+	return(1ul << ID[2]);
+}
+
+/**
+  \fn					int NOR_Flash_Busy(void)
+  \brief			A DMA write, program or erase is still going
+	\returns		int: 1 if busy
+*/
+
+int NOR_Flash_Busy(void){
+	
+	uint8_t Tx = NOR_READ_STATUS;
+	uint8_t Status = 0;
+	
+	if(SPI_DMA_Busy()){
+		return(1);
+	}
+	
+	Command(&Tx,1,&Status,1);
+	
+	return((Status & NOR_STATUS_BUSY) ? 1 : 0);
+}
+
+/**
+  \fn					void NOR_Flash_Program(uint32_t Address, const uint8_t* Data, int Length)
+  \brief			Starts programming a page, the address wraps inside the page
+	\param			const uint8_t* Data: Left alone until NOR_Flash_Busy returns 0
+	\param			int Length: Bytes, up to 256
+*/
+
+void NOR_Flash_Program(uint32_t Address, const uint8_t* Data, int Length){
+	
+	uint8_t Tx[4];
+	
+	Write_Enable();
+	
+	Put_Address(Tx,NOR_PAGE_PROGRAM,Address);
+	SPI_Select(NOR_FLASH_SPI);
+	SPI_Transfer(NOR_FLASH_SPI,Tx,0,4);
+	SPI_DMA_Write(NOR_FLASH_SPI,Data,Length);
+}
+
+/**
+  \fn					void NOR_Flash_Erase(uint32_t Address)
+  \brief			Starts erasing the 4 KB sector at Address
+*/
+
+void NOR_Flash_Erase(uint32_t Address){
+	
+	uint8_t Tx[4];
+	
+	Write_Enable();
+	
+	Put_Address(Tx,NOR_SECTOR_ERASE,Address);
+	Command(Tx,4,0,0);
+}
+
+/**
+  \fn					void NOR_Flash_Suspend(void)
+  \brief			Pauses an erase so other sectors can be programmed, ignored if no erase is running
+*/
+
+void NOR_Flash_Suspend(void){
+	
+	uint8_t Tx = NOR_ERASE_SUSPEND;
+	
+	Command(&Tx,1,0,0);
+}
+
+/**
+  \fn					void NOR_Flash_Resume(void)
+  \brief			Carries on with a suspended erase
+*/
+
+void NOR_Flash_Resume(void){
+	
+	uint8_t Tx = NOR_ERASE_RESUME;
+	
+	Command(&Tx,1,0,0);
+}
+
+/**
+  \fn					void NOR_Flash_Read(uint32_t Address, uint8_t* Data, int Length)
+  \brief			Reads while the chip isn't busy, returns with the data
+*/
+
+void NOR_Flash_Read(uint32_t Address, uint8_t* Data, int Length){
+	
+	uint8_t Tx[4];
+	
+	Put_Address(Tx,NOR_READ_DATA,Address);
+	Command(Tx,4,Data,Length);
+}
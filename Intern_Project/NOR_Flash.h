@@ -0,0 +1,43 @@
+/*------------------------------------------------------------------------------------------------------
+ * Name:    NOR_Flash.h
+ * Purpose: SPI NOR flash chip, W25Q series commands
+ * Date: 		10/19/26
+ * Author:	Christopher Jordan - Denny
+ *------------------------------------------------------------------------------------------------------
+ * Note(s): See C file
+ *----------------------------------------------------------------------------------------------------*/
+
+/*-----------------------------------------Include Statements-----------------------------------------*/
+#include "stm32l053xx.h"
+
+#ifndef NOR_FLASH_H
+#define NOR_FLASH_H
+
+/*-----------------------------------------Definitions------------------------------------------------*/
+#define NOR_FLASH_SPI							SPI2				// PB12-PB15
+
+/* Commands */
+#define NOR_WRITE_ENABLE					0x06
+#define NOR_READ_STATUS						0x05
+#define NOR_READ_DATA							0x03
+#define NOR_PAGE_PROGRAM					0x02
+#define NOR_SECTOR_ERASE					0x20				// 4 KB
+#define NOR_ERASE_SUSPEND					0x75
+#define NOR_ERASE_RESUME					0x7A
+#define NOR_JEDEC_ID							0x9F
+#define NOR_RELEASE_POWER_DOWN		0xAB
+#define NOR_ENABLE_RESET					0x66
+#define NOR_RESET									0x99
+
+#define NOR_STATUS_BUSY						0x01
+#define NOR_INIT_TIMEOUT					10					// ms for the chip to come out of reset
+
+extern uint32_t NOR_Flash_Init(void);
+extern int NOR_Flash_Busy(void);
+extern void NOR_Flash_Program(uint32_t Address, const uint8_t* Data, int Length);
+extern void NOR_Flash_Erase(uint32_t Address);
+extern void NOR_Flash_Suspend(void);
+extern void NOR_Flash_Resume(void);
+extern void NOR_Flash_Read(uint32_t Address, uint8_t* Data, int Length);
+
+#endif
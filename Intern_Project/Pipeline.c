@@ -0,0 +1,140 @@
+/*------------------------------------------------------------------------------------------------------
+ * Name:    Pipeline.c
+ * Purpose: Double buffered frame slots between the acquire, encode and transmit stages
+ * Date: 		10/19/26
+ * Author:	Christopher Jordan - Denny
+ *------------------------------------------------------------------------------------------------------
+ * Note(s): Each slot goes acquire -> encode -> transmit -> acquire. With PIPELINE_SLOTS slots frame
+						N+1 can be read while frame N waits to be encoded or for room in the LPUART1 transmit
+						ring, and frame N-1 drains from the ring in the interrupt. The frame rate is then set
+						by the slowest stage instead of the sum of all three.
+						
+						*	Every stage keeps its own count, so a stage can only take a slot the stage before it
+							has finished: Acquired >= Encoded >= Transmitted >= Acquired - PIPELINE_SLOTS
+						*	The stages are scheduler tasks, so no locking is needed
+						*	Stalls show the bottleneck: acquire stalls mean encode or transmit can't keep up,
+							transmit stalls mean the radio link can't
+						*	A new acquire starts from the previous record, so channels that weren't read keep
+							their last value for the next keyframe
+ *----------------------------------------------------------------------------------------------------*/
+
+/*---------------------------------------------Include Statements-------------------------------------*/
+#include <stdio.h>										// Printf
+#include "Pipeline.h"
+#include "Timing.h"										// Timing_Microseconds
+#include "Trace.h"										// Stages on the event timeline
+/*---------------------------------------------Tables-------------------------------------------------*/
+static const char* const Stage_Name[PIPELINE_STAGES] = {"Acquire","Encode","Transmit"};
+/*---------------------------------------------Globals------------------------------------------------*/
+Pipeline_Slot			Slots[PIPELINE_SLOTS];
+uint32_t					Stage_Count[PIPELINE_STAGES];						/* Slots each stage has finished */
+uint32_t					Stage_Start[PIPELINE_STAGES];						/* Timing_Microseconds at Pipeline_Begin */
+uint8_t						Stage_Open[PIPELINE_STAGES];						/* Between Pipeline_Begin and End or Stall */
+Pipeline_Stats		Stage_Stats[PIPELINE_STAGES];
+/*---------------------------------------------Functions----------------------------------------------*/
+
+/**
+  \fn					int Pipeline_Ready(int Stage)
+  \brief			Whether a stage has a slot to work on
+	\param			int Stage: PIPELINE_ACQUIRE, PIPELINE_ENCODE or PIPELINE_TRANSMIT
+	\returns		int: 1 if Pipeline_Begin will return a slot
+*/
+
+int Pipeline_Ready(int Stage){
+	
+	/* Acquire needs a slot transmit is done with */
+	if(Stage == PIPELINE_ACQUIRE){
+		return((Stage_Count[PIPELINE_ACQUIRE] - Stage_Count[PIPELINE_TRANSMIT]) < PIPELINE_SLOTS);
+	}
+	
+	return(Stage_Count[Stage] != Stage_Count[Stage - 1]);
+}
+
+/**
+  \fn					Pipeline_Slot* Pipeline_Begin(int Stage)
+  \brief			Hands a stage its next slot and starts its timer
+	\param			int Stage: PIPELINE_ACQUIRE, PIPELINE_ENCODE or PIPELINE_TRANSMIT
+	\returns		Pipeline_Slot*: The slot, 0 if Pipeline_Ready is 0
+*/
+
+Pipeline_Slot* Pipeline_Begin(int Stage){
+	
+	Pipeline_Slot* Slot;
+	
+	if(Pipeline_Ready(Stage) == 0){
+		return(0);
+	}
+	
+	Slot = &Slots[Stage_Count[Stage] & (PIPELINE_SLOTS - 1)];
+	if(Stage == PIPELINE_ACQUIRE){
+		Slot->Record = Slots[(Stage_Count[Stage] - 1) & (PIPELINE_SLOTS - 1)].Record;
+	}
+	
+	Stage_Open[Stage] = 1;
+	TRACE_BEGIN(TRACE_STAGE,(uint16_t)Stage);
+	Stage_Start[Stage] = Timing_Microseconds();
+	
+	return(Slot);
+}
+
+/**
+  \fn					void Pipeline_End(int Stage)
+  \brief			Passes the slot from Pipeline_Begin on to the next stage
+	\param			int Stage: PIPELINE_ACQUIRE, PIPELINE_ENCODE or PIPELINE_TRANSMIT
+*/
+
+void Pipeline_End(int Stage){
+	
+	uint32_t Time = Timing_Microseconds() - Stage_Start[Stage];
+	
+	Stage_Open[Stage] = 0;
+	TRACE_END(TRACE_STAGE,(uint16_t)Stage);
+	
+	Stage_Count[Stage]++;
+	Stage_Stats[Stage].Frames++;
+	Stage_Stats[Stage].Time += Time;
+	if(Time > Stage_Stats[Stage].Max_Time){
+		Stage_Stats[Stage].Max_Time = Time;
+	}
+}
+
+/**
+  \fn					void Pipeline_Stall(int Stage)
+  \brief			Counts a stage that had work but had to wait
+	\param			int Stage: PIPELINE_ACQUIRE, PIPELINE_ENCODE or PIPELINE_TRANSMIT
+*/
+
+void Pipeline_Stall(int Stage){
+	
+	/* Transmit gives its slot back after Pipeline_Begin when the ring is full */
+	if(Stage_Open[Stage]){
+		Stage_Open[Stage] = 0;
+		TRACE_END(TRACE_STAGE,(uint16_t)Stage);
+	}
+	TRACE_INSTANT(TRACE_STALL,(uint16_t)Stage);
+	
+	Stage_Stats[Stage].Stalls++;
+}
+
+/**
+  \fn					Pipeline_Stats* Pipeline_Get_Stats(int Stage)
+  \brief			Retrieves a stage's counters
+	\param			int Stage: PIPELINE_ACQUIRE, PIPELINE_ENCODE or PIPELINE_TRANSMIT
+	\returns		Pipeline_Stats*: The counters
+*/
+
+Pipeline_Stats* Pipeline_Get_Stats(int Stage){
+	return(&Stage_Stats[Stage]);
+}
+
+/**
+  \fn					void Pipeline_Print_Stage(int Stage)
+  \brief			Prints one stage's counters to the serial monitor
+	\param			int Stage: PIPELINE_ACQUIRE, PIPELINE_ENCODE or PIPELINE_TRANSMIT
+*/
+
+void Pipeline_Print_Stage(int Stage){
+	printf("Stage %s: %u frames, %u us total, %u us max, %u stalls\r\n",Stage_Name[Stage],
+		(unsigned int)Stage_Stats[Stage].Frames,(unsigned int)Stage_Stats[Stage].Time,
+		(unsigned int)Stage_Stats[Stage].Max_Time,(unsigned int)Stage_Stats[Stage].Stalls);
+}
@@ -0,0 +1,50 @@
+/*------------------------------------------------------------------------------------------------------
+ * Name:    Pipeline.h
+ * Purpose: Double buffered frame slots between the acquire, encode and transmit stages
+ * Date: 		10/19/26
+ * Author:	Christopher Jordan - Denny
+ *------------------------------------------------------------------------------------------------------
+ * Note(s): See C file for how the slots move
+ *----------------------------------------------------------------------------------------------------*/
+
+/*-----------------------------------------Include Statements-----------------------------------------*/
+#include <stdint.h>
+#include "Telemetry.h"
+
+#ifndef PIPELINE_H
+#define PIPELINE_H
+
+/*-----------------------------------------Definitions------------------------------------------------*/
+#define PIPELINE_SLOTS						2							// Frames in flight, a power of 2
+
+/* Stages in the order a slot goes through them */
+#define PIPELINE_ACQUIRE					0
+#define PIPELINE_ENCODE						1
+#define PIPELINE_TRANSMIT					2
+#define PIPELINE_STAGES						3
+
+/* One frame on its way through */
+typedef struct Pipeline_Slot
+{
+	Telemetry_Record Record;						/* Filled by acquire */
+	uint8_t Frame[TELEMETRY_MAX_FRAME];	/* Filled by encode */
+	int Length;
+}Pipeline_Slot;
+
+/* Per stage counters */
+typedef struct Pipeline_Stats
+{
+	uint32_t Frames;										/* Slots the stage finished */
+	uint32_t Time;											/* us from Pipeline_Begin to Pipeline_End */
+	uint32_t Max_Time;
+	uint32_t Stalls;										/* Times the stage had work but couldn't take it */
+}Pipeline_Stats;
+
+extern int Pipeline_Ready(int Stage);
+extern Pipeline_Slot* Pipeline_Begin(int Stage);
+extern void Pipeline_End(int Stage);
+extern void Pipeline_Stall(int Stage);
+extern Pipeline_Stats* Pipeline_Get_Stats(int Stage);
+extern void Pipeline_Print_Stage(int Stage);
+
+#endif
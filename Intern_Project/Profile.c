@@ -0,0 +1,118 @@
+/*------------------------------------------------------------------------------------------------------
+ * Name:    Profile.c
+ * Purpose: Cycle counts of named hot path regions
+ * Date: 		10/19/26
+ * Author:	Christopher Jordan - Denny
+ *------------------------------------------------------------------------------------------------------
+ * Note(s): The M0+ has no DWT cycle counter, so the count comes from Timing_Cycles, msTicks and the
+						SysTick current value. SysTick counts down from LOAD once per ms at the core clock, so the
+						cycles since power on are msTicks*(LOAD+1) plus how far it has counted.
+						*	Differences are correct across the 32 bit wrap, which is about 134 s at 32MHz
+						*	A region's time includes any interrupt that preempted it, the interrupts have their
+							own regions to subtract
+						*	PROFILE_BEGIN in SysTick_Handler has to come after msTicks++, the pending flag is
+							already cleared by then
+						*	Begin and end cost about 30 cycles, which is in every figure
+						*	Profile_Report prints over USART2 at 9600 baud, so it takes around half a second
+ *----------------------------------------------------------------------------------------------------*/
+
+/*---------------------------------------------Include Statements-------------------------------------*/
+#include <stdio.h>										// Printf
+#include <string.h>										// Memset
+#include "stm32l0xx.h"								// PRIMASK
+#include "Profile.h"
+#include "Timing.h"										// Timing_Cycles
+/*---------------------------------------------Tables-------------------------------------------------*/
+static const char* const Region_Name[PROFILE_REGIONS] = {
+	"I2C","Parse","Format","Send","SysTick","TIM2","GPS UART","XBee UART","PendSV","SPI DMA"
+};
+/*---------------------------------------------Globals------------------------------------------------*/
+uint32_t				Profile_Start[PROFILE_REGIONS];							/* Profile_Cycles at PROFILE_BEGIN */
+Profile_Region	Regions[PROFILE_REGIONS];
+/*---------------------------------------------Functions----------------------------------------------*/
+
+/**
+  \fn					uint32_t Profile_Cycles(void)
+  \brief			Core clock cycles since power on, safe in interrupts that preempt SysTick. Only use
+							differences.
+	\returns		uint32_t: Cycles
+*/
+
+uint32_t Profile_Cycles(void){
+	return(Timing_Cycles());
+}
+
+/**
+  \fn					void Profile_End(int Region)
+  \brief			Adds the cycles since PROFILE_BEGIN to a region
+	\param			int Region: PROFILE region
+*/
+
+void Profile_End(int Region){
+	
+	/* Local Variables */
+	uint32_t Cycles = Profile_Cycles() - Profile_Start[Region];
+	Profile_Region* Entry = &Regions[Region];
+	
+	if((Entry->Count == 0) || (Cycles < Entry->Min)){
+		Entry->Min = Cycles;
+	}
+	if(Cycles > Entry->Max){
+		Entry->Max = Cycles;
+	}
+	Entry->Total += Cycles;
+	Entry->Count++;
+}
+
+/**
+  \fn					void Profile_Get_Region(int Region, Profile_Region* Copy)
+  \brief			Copies a region without an interrupt changing it halfway
+	\param			int Region: PROFILE region
+	\param			Profile_Region* Copy: Filled with the region's figures
+*/
+
+void Profile_Get_Region(int Region, Profile_Region* Copy){
+	
+	uint32_t Mask = __get_PRIMASK();
+	
+	__disable_irq();
+	*Copy = Regions[Region];
+	__set_PRIMASK(Mask);
+}
+
+/**
+  \fn					void Profile_Reset(void)
+  \brief			Clears every region
+*/
+
+void Profile_Reset(void){
+	
+	uint32_t Mask = __get_PRIMASK();
+	
+	__disable_irq();
+	memset(Regions,0,sizeof(Regions));
+	__set_PRIMASK(Mask);
+}
+
+/**
+  \fn					void Profile_Report(void)
+  \brief			Prints every region that ran to the serial monitor, times in cycles
+*/
+
+void Profile_Report(void){
+	
+	/* Local Variables */
+	Profile_Region Copy;
+	int i = 0;
+	
+	printf("Region     Count      Min     Mean      Max (cycles)\r\n");
+	
+	for(i = 0;i < PROFILE_REGIONS;i++){
+		Profile_Get_Region(i,&Copy);
+		if(Copy.Count == 0){
+			continue;
+		}
+		printf("%-9s %6u %8u %8u %8u\r\n",Region_Name[i],(unsigned int)Copy.Count,
+			(unsigned int)Copy.Min,(unsigned int)(Copy.Total/Copy.Count),(unsigned int)Copy.Max);
+	}
+}
@@ -0,0 +1,57 @@
+/*------------------------------------------------------------------------------------------------------
+ * Name:    Profile.h
+ * Purpose: Cycle counts of named hot path regions
+ * Date: 		10/19/26
+ * Author:	Christopher Jordan - Denny
+ *------------------------------------------------------------------------------------------------------
+ * Note(s): Wrap a region in PROFILE_BEGIN and PROFILE_END, see C file
+ *----------------------------------------------------------------------------------------------------*/
+
+/*-----------------------------------------Include Statements-----------------------------------------*/
+#include <stdint.h>
+
+#ifndef PROFILE_H
+#define PROFILE_H
+
+/*-----------------------------------------Definitions------------------------------------------------*/
+#define PROFILE_ENABLE						1						// 0 compiles the macros out
+
+/* Regions, each one is only ever entered from one place at a time */
+#define PROFILE_I2C								0						// One register read or write
+#define PROFILE_PARSE							1						// NMEA sentences to a GPS fix
+#define PROFILE_FORMAT						2						// Record to telemetry frame
+#define PROFILE_SEND							3						// Frame into the XBee transmit ring
+#define PROFILE_SYSTICK						4						// Interrupts
+#define PROFILE_TIM2							5
+#define PROFILE_GPS_UART					6
+#define PROFILE_XBEE_UART					7
+#define PROFILE_PENDSV						8
+#define PROFILE_SPI_DMA						9
+#define PROFILE_REGIONS						10
+
+/* Accumulated in cycles */
+typedef struct Profile_Region
+{
+	uint32_t Count;
+	uint32_t Min;
+	uint32_t Max;
+	uint64_t Total;
+}Profile_Region;
+
+#if PROFILE_ENABLE
+#define PROFILE_BEGIN(Region)			(Profile_Start[(Region)] = Profile_Cycles())
+#define PROFILE_END(Region)				Profile_End(Region)
+#else
+#define PROFILE_BEGIN(Region)			((void)0)
+#define PROFILE_END(Region)				((void)0)
+#endif
+
+extern uint32_t Profile_Start[PROFILE_REGIONS];
+
+extern uint32_t Profile_Cycles(void);
+extern void Profile_End(int Region);
+extern void Profile_Get_Region(int Region, Profile_Region* Copy);
+extern void Profile_Reset(void);
+extern void Profile_Report(void);
+
+#endif
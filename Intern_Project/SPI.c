@@ -1,35 +1,264 @@
 /*-------------------------------------------------------------------------------------------------------------------
  * Name:    SPI.c
- * Purpose: SPI Initialization
+ * Purpose: SPI Initialization, byte transfers and DMA writes
  * Date: 		6/18/15
  * Author:	Christopher Jordan - Denny
  *-------------------------------------------------------------------------------------------------------------------
- * Note(s): 
+ * Note(s): Mode 0, 8 bit, PCLK/2 = 16 MHz, chip select is the NSS pin driven by software.
+						*	SPI1: PA5 SCK, PA6 MISO, PA7 MOSI, PA4 CS. PA5 is also the green LED
+						*	SPI2: PB13 SCK, PB14 MISO, PB15 MOSI, PB12 CS. Only on the morpho headers, so it is
+							clear of the expansion board
+						*	MISO is pulled up so a missing chip reads 0xFF instead of a floating pin
+						*	SPI_DMA_Write sends a block without the CPU, DMA channels 2/3 for SPI1 and 4/5 for
+							SPI2. The received bytes go to one dummy byte, and receive complete means the last
+							bit is out, so the interrupt raises chip select then. One DMA write at a time.
  *-------------------------------------------------------------------------------------------------------------------*/
- 
+
  /*---------------------------------------------Include Statements---------------------------------------------------*/
  #include "stm32l053xx.h"				//Specific Device Header
  #include "SPI.h"								//SPI Driver header
- 
+ #include "Spin.h"							//Busy wait accounting
+ #include "Profile.h"						//Interrupt cycles
+ #include "Trace.h"							//Event timeline
+ #include "ISR_Monitor.h"				//Interrupt latency and budget
+/*---------------------------------------------Globals--------------------------------------------------------------*/
+volatile int SPI_DMA_Active = 0;								/* A DMA write hasn't raised chip select yet */
+SPI_TypeDef* DMA_SPI = 0;												/* SPI of the DMA write */
+uint8_t DMA_Dummy = 0;													/* Bytes received during a DMA write */
+/*---------------------------------------------Functions------------------------------------------------------------*/
+
+/**
+  \fn					void Pins_Init(GPIO_TypeDef* Port, int SCK, int CS)
+  \brief			SCK, MISO and MOSI are three pins in a row on alternate function 0, chip select idles high
+*/
+
+static void Pins_Init(GPIO_TypeDef* Port, int SCK, int CS){
+	
+	int Pin = 0;
+	
+	for(Pin = SCK;Pin < (SCK + 3);Pin++){
+		Port->AFR[Pin >> 3] &= ~(15ul << 4*(Pin & 7));			/* Alternate function 0 */
+		Port->MODER &= ~(3ul << 2*Pin);
+		Port->MODER |= (2ul << 2*Pin);											/* Alternate function mode */
+		Port->OSPEEDR |= (3ul << 2*Pin);										/* Fast enough for 16 MHz */
+	}
+	Port->PUPDR &= ~(3ul << 2*(SCK + 1));
+	Port->PUPDR |= (1ul << 2*(SCK + 1));										/* MISO pulled up, reads 0xFF with no chip */
+	
+	Port->BSRR = (1ul << CS);
+	Port->MODER &= ~(3ul << 2*CS);
+	Port->MODER |= (1ul << 2*CS);													/* Output */
+}
+
+ /**
+  \fn					void SPI_Master_Init(SPI_TypeDef* SPIx)
+  \brief			Sets up the pins, clock and DMA request of SPI1 or SPI2 as master
+	\param			SPI_TypeDef* SPIx: SPI1 or SPI2
+*/
+
  void SPI_Master_Init(SPI_TypeDef* SPIx){
-	 
+	
 	 if(SPIx == SPI1){
-		 
+	
 		 /* Enable GPIO clock */
-		 
+		 RCC->IOPENR |= RCC_IOPENR_GPIOAEN;
+		 Pins_Init(SPI1_CS_PORT,5,SPI1_CS_PIN);
+	
 		 /* Enable SPI1 clock */
 		 RCC->APB2ENR |= RCC_APB2ENR_SPI1EN;
-		 
+	
+		 /* Channels 2 and 3 */
+		 DMA1_CSELR->CSELR = (DMA1_CSELR->CSELR & ~((15ul << 4) | (15ul << 8))) | (1ul << 4) | (1ul << 8);
+		 NVIC_SetPriority(DMA1_Channel2_3_IRQn,2);
+		 NVIC_EnableIRQ(DMA1_Channel2_3_IRQn);
 	 }
-	 
+	 if(SPIx == SPI2){
+	
+		 /* Enable GPIO clock */
+		 RCC->IOPENR |= RCC_IOPENR_GPIOBEN;
+		 Pins_Init(SPI2_CS_PORT,13,SPI2_CS_PIN);
+	
+		 /* Enable SPI2 clock */
+		 RCC->APB1ENR |= RCC_APB1ENR_SPI2EN;
+	
+		 /* Channels 4 and 5 */
+		 DMA1_CSELR->CSELR = (DMA1_CSELR->CSELR & ~((15ul << 12) | (15ul << 16))) | (2ul << 12) | (2ul << 16);
+		 NVIC_SetPriority(DMA1_Channel4_5_6_7_IRQn,2);			/* Below the UARTs, a page program only starts a little later */
+		 NVIC_EnableIRQ(DMA1_Channel4_5_6_7_IRQn);
+	 }
+	 RCC->AHBENR |= RCC_AHBENR_DMAEN;
+	
 	 /* SPI Configuration */
-	 SPIx->CR1 = SPI_CR1_MSTR | SPI_CR1_BR;
-	 SPIx->CR2 = SPI_CR2_SSOE | SPI_CR2_RXNEIE;
-	 
+	 SPIx->CR1 = SPI_CR1_MSTR | SPI_CR1_SSM | SPI_CR1_SSI;		/* PCLK/2, chip select by software */
+	 SPIx->CR2 = 0;
+	
 	 /* Start SPI */
-	 SPIx->CR1 = SPI_CR1_SPE;
-	 
+	 SPIx->CR1 |= SPI_CR1_SPE;
+	
  }
 
- 
- 
\ No newline at end of file
+/**
+  \fn					void SPI_Select(SPI_TypeDef* SPIx)
+  \brief			Pulls chip select low
+*/
+
+void SPI_Select(SPI_TypeDef* SPIx){
+	
+	if(SPIx == SPI1){
+		SPI1_CS_PORT->BSRR = (1ul << (SPI1_CS_PIN + 16));
+	}
+	else{
+		SPI2_CS_PORT->BSRR = (1ul << (SPI2_CS_PIN + 16));
+	}
+}
+
+/**
+  \fn					void SPI_Deselect(SPI_TypeDef* SPIx)
+  \brief			Lets chip select go high
+*/
+
+void SPI_Deselect(SPI_TypeDef* SPIx){
+	
+	if(SPIx == SPI1){
+		SPI1_CS_PORT->BSRR = (1ul << SPI1_CS_PIN);
+	}
+	else{
+		SPI2_CS_PORT->BSRR = (1ul << SPI2_CS_PIN);
+	}
+}
+
+/**
+  \fn					void SPI_Transfer(SPI_TypeDef* SPIx, const uint8_t* Tx, uint8_t* Rx, int Length)
+  \brief			Sends and receives bytes, for commands and short reads
+	\param			const uint8_t* Tx: Bytes sent, 0 sends 0xFF
+	\param			uint8_t* Rx: Bytes received, 0 throws them away
+	\param			int Length: Bytes
+*/
+
+void SPI_Transfer(SPI_TypeDef* SPIx, const uint8_t* Tx, uint8_t* Rx, int Length){
+	
+	uint8_t Byte = 0;
+	int i = 0;
+	
+	SPIN_BEGIN(SPIN_SPI);
+	for(i = 0;i < Length;i++){
+		while((SPIx->SR & SPI_SR_TXE) == 0){
+			//Nop
+		}
+		SPIx->DR = (Tx != 0) ? Tx[i] : 0xFF;
+	
+		while((SPIx->SR & SPI_SR_RXNE) == 0){
+			//Nop
+		}
+		Byte = (uint8_t)SPIx->DR;
+		if(Rx != 0){
+			Rx[i] = Byte;
+		}
+	}
+	SPIN_END(SPIN_SPI);
+}
+
+/**
+  \fn					void SPI_DMA_Write(SPI_TypeDef* SPIx, const uint8_t* Data, int Length)
+  \brief			Sends a block by DMA and returns at once, chip select must already be low and goes
+							high when the last byte is out
+	\param			const uint8_t* Data: Left alone until SPI_DMA_Busy returns 0
+	\param			int Length: Bytes, 1 to 65535
+*/
+
+void SPI_DMA_Write(SPI_TypeDef* SPIx, const uint8_t* Data, int Length){
+	
+	DMA_Channel_TypeDef* Rx_Channel = (SPIx == SPI1) ? DMA1_Channel2 : DMA1_Channel4;
+	DMA_Channel_TypeDef* Tx_Channel = (SPIx == SPI1) ? DMA1_Channel3 : DMA1_Channel5;
+	
+	DMA_SPI = SPIx;
+	SPI_DMA_Active = 1;
+	
+	/* Receive first so no byte is missed, the interrupt is on receive complete */
+	SPIx->CR2 |= SPI_CR2_RXDMAEN;
+	Rx_Channel->CCR = 0;
+	Rx_Channel->CPAR = (uint32_t)&SPIx->DR;
+	Rx_Channel->CMAR = (uint32_t)&DMA_Dummy;
+	Rx_Channel->CNDTR = (uint32_t)Length;
+	Rx_Channel->CCR = DMA_CCR_TCIE | DMA_CCR_EN;
+	
+	Tx_Channel->CCR = 0;
+	Tx_Channel->CPAR = (uint32_t)&SPIx->DR;
+	Tx_Channel->CMAR = (uint32_t)Data;
+	Tx_Channel->CNDTR = (uint32_t)Length;
+	Tx_Channel->CCR = DMA_CCR_MINC | DMA_CCR_DIR | DMA_CCR_EN;
+	
+	SPIx->CR2 |= SPI_CR2_TXDMAEN;
+}
+
+/**
+  \fn					int SPI_DMA_Busy(void)
+  \brief			A DMA write is still going
+	\returns		int: 1 if busy
+*/
+
+int SPI_DMA_Busy(void){
+	
+	return(SPI_DMA_Active);
+}
+
+/**
+  \fn					void DMA_Finish(DMA_Channel_TypeDef* Rx_Channel, DMA_Channel_TypeDef* Tx_Channel)
+  \brief			Ends a DMA write and raises chip select
+*/
+
+static void DMA_Finish(DMA_Channel_TypeDef* Rx_Channel, DMA_Channel_TypeDef* Tx_Channel){
+	
+	Rx_Channel->CCR = 0;
+	Tx_Channel->CCR = 0;
+	
+	while(DMA_SPI->SR & SPI_SR_BSY){
+		//Nop
+	}
+	DMA_SPI->CR2 &= ~(SPI_CR2_RXDMAEN | SPI_CR2_TXDMAEN);
+	SPI_Deselect(DMA_SPI);
+	
+	SPI_DMA_Active = 0;
+}
+
+/**
+  \fn					void DMA1_Channel2_3_IRQHandler(void)
+  \brief			SPI1 DMA write done
+*/
+
+void DMA1_Channel2_3_IRQHandler(void){
+	
+	ISR_Monitor_Enter(ISR_MONITOR_SPI_DMA,ISR_MONITOR_NO_LATENCY);
+	PROFILE_BEGIN(PROFILE_SPI_DMA);
+	TRACE_BEGIN(TRACE_SPI_DMA,1);
+	
+	if(DMA1->ISR & DMA_ISR_TCIF2){
+		DMA1->IFCR = DMA_IFCR_CGIF2 | DMA_IFCR_CGIF3;
+		DMA_Finish(DMA1_Channel2,DMA1_Channel3);
+	}
+	
+	TRACE_END(TRACE_SPI_DMA,1);
+	PROFILE_END(PROFILE_SPI_DMA);
+	ISR_Monitor_Exit(ISR_MONITOR_SPI_DMA);
+}
+
+/**
+  \fn					void DMA1_Channel4_5_6_7_IRQHandler(void)
+  \brief			SPI2 DMA write done
+*/
+
+void DMA1_Channel4_5_6_7_IRQHandler(void){
+	
+	ISR_Monitor_Enter(ISR_MONITOR_SPI_DMA,ISR_MONITOR_NO_LATENCY);
+	PROFILE_BEGIN(PROFILE_SPI_DMA);
+	TRACE_BEGIN(TRACE_SPI_DMA,2);
+	
+	if(DMA1->ISR & DMA_ISR_TCIF4){
+		DMA1->IFCR = DMA_IFCR_CGIF4 | DMA_IFCR_CGIF5;
+		DMA_Finish(DMA1_Channel4,DMA1_Channel5);
+	}
+	
+	TRACE_END(TRACE_SPI_DMA,2);
+	PROFILE_END(PROFILE_SPI_DMA);
+	ISR_Monitor_Exit(ISR_MONITOR_SPI_DMA);
+}
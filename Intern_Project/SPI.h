@@ -1,8 +1,19 @@
-#include "stm32l053xx.h"
+ #include "stm32l053xx.h"
 
 #ifndef	SPI_H
 #define SPI_H
 
+/* Chip selects, the NSS pins driven as GPIO */
+#define SPI1_CS_PORT			GPIOA
+#define SPI1_CS_PIN				4
+#define SPI2_CS_PORT			GPIOB
+#define SPI2_CS_PIN				12
+
 extern void SPI_Master_Init(SPI_TypeDef* SPIx);
+extern void SPI_Select(SPI_TypeDef* SPIx);
+extern void SPI_Deselect(SPI_TypeDef* SPIx);
+extern void SPI_Transfer(SPI_TypeDef* SPIx, const uint8_t* Tx, uint8_t* Rx, int Length);
+extern void SPI_DMA_Write(SPI_TypeDef* SPIx, const uint8_t* Data, int Length);
+extern int SPI_DMA_Busy(void);
 
 #endif
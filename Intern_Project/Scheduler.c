@@ -0,0 +1,216 @@
+/*------------------------------------------------------------------------------------------------------
+ * Name:    Scheduler.c
+ * Purpose: Cooperative run to completion task scheduler with timers and event bits
+ * Date: 		10/19/26
+ * Author:	Christopher Jordan - Denny
+ *------------------------------------------------------------------------------------------------------
+ * Note(s): Replaces the main loop that waited on each peripheral in turn. Every task runs to the end
+						and returns, so one slow sensor only delays the others by its own run time, never by
+						how long it waits for data.
+						
+						*	A task runs when it has pending event bits, from Scheduler_Post or from its timer
+							(SCHEDULER_TIMER every Period ms)
+						*	Tasks are checked in the order they were added, which is their priority. After each
+							run the search starts over from the first task
+						*	Scheduler_Post may be called from interrupts, it is how the drivers hand work to
+							the tasks
+						*	With nothing to run the core sleeps until the next interrupt, at most 1 ms with
+							SysTick running
+						*	Runs, total and longest run time are kept for every task with Timing_Microseconds
+ *----------------------------------------------------------------------------------------------------*/
+
+/*---------------------------------------------Include Statements-------------------------------------*/
+#include "stm32l053xx.h"							// Specific Device Header
+#include <stdio.h>										// Printf
+#include "Scheduler.h"
+#include "Timing.h"										// msTicks and Timing_Microseconds
+#include "Trace.h"										// Task runs on the event timeline
+/*---------------------------------------------Globals------------------------------------------------*/
+Scheduler_Task	Tasks[SCHEDULER_MAX_TASKS];
+int							Task_Count = 0;
+/*---------------------------------------------Functions----------------------------------------------*/
+
+/**
+  \fn					int Scheduler_Add(const char* Name, Scheduler_Function Run, uint32_t Period)
+  \brief			Adds a task after the ones already added, so at a lower priority
+	\param			const char* Name: For Scheduler_Print_Stats
+	\param			Scheduler_Function Run: Called with the pending event bits
+	\param			uint32_t Period: ms between timer events, 0 runs only on posted events
+	\returns		int: Task number for Scheduler_Post, -1 if the table is full
+*/
+
+int Scheduler_Add(const char* Name, Scheduler_Function Run, uint32_t Period){
+	
+	Scheduler_Task* Task;
+	
+	if(Task_Count == SCHEDULER_MAX_TASKS){
+		return(-1);
+	}
+	
+	Task = &Tasks[Task_Count];
+	Task->Name = Name;
+	Task->Run = Run;
+	Task->Period = Period;
+	Task->Next_Run = msTicks + Period;
+	Task->Events = 0;
+	Task->Runs = 0;
+	Task->Time = 0;
+	Task->Max_Time = 0;
+	
+	return(Task_Count++);
+}
+
+/**
+  \fn					void Scheduler_Set_Period(int Task, uint32_t Period)
+  \brief			Changes a task's timer, the next timer event is a full period away
+	\param			int Task: From Scheduler_Add
+	\param			uint32_t Period: ms, 0 stops the timer
+*/
+
+void Scheduler_Set_Period(int Task, uint32_t Period){
+	
+	if((Task < 0) || (Task >= Task_Count)){
+		return;
+	}
+	
+	Tasks[Task].Period = Period;
+	Tasks[Task].Next_Run = msTicks + Period;
+}
+
+/**
+  \fn					void Scheduler_Post(int Task, uint8_t Events)
+  \brief			Gives a task event bits to handle, safe in interrupts
+	\param			int Task: From Scheduler_Add
+	\param			uint8_t Events: Bits the task defines, SCHEDULER_TIMER is taken
+*/
+
+void Scheduler_Post(int Task, uint8_t Events){
+	
+	uint32_t Mask = 0;
+	
+	if((Task < 0) || (Task >= Task_Count)){
+		return;
+	}
+	
+	Mask = __get_PRIMASK();
+	__disable_irq();
+	Tasks[Task].Events |= Events;
+	__set_PRIMASK(Mask);
+}
+
+/**
+  \fn					int Scheduler_Run_Once(void)
+  \brief			Raises due timer events and runs the highest priority task that has events
+	\returns		int: 1 if a task ran, 0 if there was nothing to do
+*/
+
+int Scheduler_Run_Once(void){
+	
+	/* Local Variables */
+	Scheduler_Task* Task;
+	uint32_t Now = msTicks;
+	uint32_t Mask = 0;
+	uint32_t Start = 0;
+	uint32_t Time = 0;
+	uint8_t Events = 0;
+	int i = 0;
+	
+	for(i = 0;i < Task_Count;i++){
+		Task = &Tasks[i];
+		if((Task->Period != 0) && ((int32_t)(Now - Task->Next_Run) >= 0)){
+			Scheduler_Post(i,SCHEDULER_TIMER);
+			
+			/* Keep the rate, unless the task has fallen a whole period behind */
+			Task->Next_Run += Task->Period;
+			if((int32_t)(Now - Task->Next_Run) >= 0){
+				Task->Next_Run = Now + Task->Period;
+			}
+		}
+	}
+	
+	for(i = 0;i < Task_Count;i++){
+		Task = &Tasks[i];
+		if(Task->Events == 0){
+			continue;
+		}
+		
+		/* Take the events, anything posted while it runs comes next time */
+		Mask = __get_PRIMASK();
+		__disable_irq();
+		Events = Task->Events;
+		Task->Events = 0;
+		__set_PRIMASK(Mask);
+		
+		TRACE_BEGIN(TRACE_TASK,(uint16_t)i);
+		Start = Timing_Microseconds();
+		Task->Run(Events);
+		Time = Timing_Microseconds() - Start;
+		TRACE_END(TRACE_TASK,(uint16_t)i);
+		
+		Task->Runs++;
+		Task->Time += Time;
+		if(Time > Task->Max_Time){
+			Task->Max_Time = Time;
+		}
+		
+		return(1);
+	}
+	
+	return(0);
+}
+
+/**
+  \fn					void Scheduler_Run(void)
+  \brief			Runs the tasks forever, sleeping whenever none of them has anything to do
+*/
+
+void Scheduler_Run(void){
+	
+	while(1){
+		if(Scheduler_Run_Once() == 0){
+			__WFI();
+		}
+	}
+}
+
+/**
+  \fn					Scheduler_Task* Scheduler_Get_Task(int Task)
+  \brief			Retrieves a task's schedule and runtime
+	\param			int Task: From Scheduler_Add
+	\returns		Scheduler_Task*: The task, 0 if there is no such task
+*/
+
+Scheduler_Task* Scheduler_Get_Task(int Task){
+	
+	if((Task < 0) || (Task >= Task_Count)){
+		return(0);
+	}
+	
+	return(&Tasks[Task]);
+}
+
+/**
+  \fn					void Scheduler_Print_Task(int Task)
+  \brief			Prints one task's runtime to the serial monitor, one line so a logging task stays short
+	\param			int Task: From Scheduler_Add
+*/
+
+void Scheduler_Print_Task(int Task){
+	
+	if((Task < 0) || (Task >= Task_Count)){
+		return;
+	}
+	
+	printf("Task %s: %u runs, %u us total, %u us max\r\n",Tasks[Task].Name,(unsigned int)Tasks[Task].Runs,
+		(unsigned int)Tasks[Task].Time,(unsigned int)Tasks[Task].Max_Time);
+}
+
+/**
+  \fn					int Scheduler_Task_Count(void)
+  \brief			Number of tasks added
+	\returns		int: Tasks
+*/
+
+int Scheduler_Task_Count(void){
+	return(Task_Count);
+}
@@ -0,0 +1,45 @@
+/*------------------------------------------------------------------------------------------------------
+ * Name:    Scheduler.h
+ * Purpose: Cooperative run to completion task scheduler with timers and event bits
+ * Date: 		10/19/26
+ * Author:	Christopher Jordan - Denny
+ *------------------------------------------------------------------------------------------------------
+ * Note(s): See C file for how tasks are picked
+ *----------------------------------------------------------------------------------------------------*/
+
+/*-----------------------------------------Include Statements-----------------------------------------*/
+#include <stdint.h>
+
+#ifndef SCHEDULER_H
+#define SCHEDULER_H
+
+/*-----------------------------------------Definitions------------------------------------------------*/
+#define SCHEDULER_MAX_TASKS				10
+#define SCHEDULER_TIMER						0x80					// Event bit set when a task's period is up
+
+/* Called with the event bits that were pending, SCHEDULER_TIMER included */
+typedef void (*Scheduler_Function)(uint8_t Events);
+
+/* One task and its runtime */
+typedef struct Scheduler_Task
+{
+	const char* Name;
+	Scheduler_Function Run;
+	uint32_t Period;										/* ms, 0 runs only on events */
+	uint32_t Next_Run;									/* msTicks of the next timer event */
+	volatile uint8_t Events;						/* Pending event bits */
+	uint32_t Runs;
+	uint32_t Time;											/* us spent in Run, wraps after ~71 minutes */
+	uint32_t Max_Time;									/* Longest single run in us */
+}Scheduler_Task;
+
+extern int Scheduler_Add(const char* Name, Scheduler_Function Run, uint32_t Period);
+extern void Scheduler_Set_Period(int Task, uint32_t Period);
+extern void Scheduler_Post(int Task, uint8_t Events);
+extern int Scheduler_Run_Once(void);
+extern void Scheduler_Run(void);
+extern Scheduler_Task* Scheduler_Get_Task(int Task);
+extern void Scheduler_Print_Task(int Task);
+extern int Scheduler_Task_Count(void);
+
+#endif
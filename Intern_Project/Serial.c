@@ -10,6 +10,7 @@
 /*-------------------------------------------------Include Statements---------------------------------*/
 #include "stm32l0xx.h"                  // Specific Device header
 #include "Serial.h"
+#include "Spin.h"											// Busy wait accounting
 /*-------------------------------------------------Define Statements----------------------------------*/
 #define PCLK	32000000									// Peripheral Clock
 #define BAUD	9600											// Baud rate
@@ -67,9 +68,11 @@ void SER_Initialize (void){
 char SER_PutChar(char ch){
 
 	//Wait for buffer to be empty
+  SPIN_BEGIN(SPIN_USART2_TXE);
   while ((USART2->ISR & USART_ISR_TXE) == 0){
 			//Nop
 	}
+  SPIN_END(SPIN_USART2_TXE);
 	
 	//Send character
   USART2->TDR = (ch);
@@ -0,0 +1,154 @@
+/*------------------------------------------------------------------------------------------------------
+ * Name:    Spin.c
+ * Purpose: Time lost in busy wait loops, per wait site
+ * Date: 		10/19/26
+ * Author:	Christopher Jordan - Denny
+ *------------------------------------------------------------------------------------------------------
+ * Note(s): Every polling loop that waits on hardware or a flag is wrapped in SPIN_BEGIN and SPIN_END.
+						The cycles come from Profile_Cycles, so a wait includes the interrupts that ran during it.
+						*	Each site keeps its waits, total and longest wait. A wait over the site's budget is
+							counted so long stalls show even when the total is small.
+						*	Spin_Report lists the sites by total, the top of the list is where moving to
+							interrupts or DMA pays off most
+						*	The clock setup waits run before SysTick starts and are not counted
+						*	Spin_Report prints through SER_PutChar, which is a wait site itself, so the serial
+							monitor line grows while it prints
+ *----------------------------------------------------------------------------------------------------*/
+
+/*---------------------------------------------Include Statements-------------------------------------*/
+#include <stdio.h>										// Printf
+#include "stm32l0xx.h"								// SysTick and PRIMASK
+#include "Spin.h"
+/*---------------------------------------------Tables-------------------------------------------------*/
+static const char* const Site_Name[SPIN_SITES] = {
+	"I2C BUSY","I2C TC","I2C TXE","HTS221","LPS25HB","LIS3MDL","LSM6DS0","USART2 TXE",
+	"USART1 TXE","LPUART1 TX","XBee OK","XBee data","GPS data","Delay","EEPROM","ADC","SPI"
+};
+/*---------------------------------------------Globals------------------------------------------------*/
+uint32_t		Spin_Start[SPIN_SITES];												/* Profile_Cycles at SPIN_BEGIN */
+Spin_Site		Sites[SPIN_SITES];
+/*---------------------------------------------Functions----------------------------------------------*/
+
+/**
+  \fn					void Spin_End(int Site)
+  \brief			Adds the cycles since SPIN_BEGIN to a wait site
+	\param			int Site: SPIN site
+*/
+
+void Spin_End(int Site){
+	
+	/* Local Variables */
+	uint32_t Cycles = Profile_Cycles() - Spin_Start[Site];
+	Spin_Site* Entry = &Sites[Site];
+	uint32_t Budget = (Entry->Budget != 0) ? Entry->Budget : SPIN_BUDGET;
+	
+	if(Cycles > Entry->Max){
+		Entry->Max = Cycles;
+	}
+	if(Cycles > Budget){
+		Entry->Over_Budget++;
+	}
+	Entry->Total += Cycles;
+	Entry->Waits++;
+}
+
+/**
+  \fn					void Spin_Set_Budget(int Site, uint32_t Cycles)
+  \brief			Changes how long a site may wait before it is counted as over budget
+	\param			int Site: SPIN site
+	\param			uint32_t Cycles: Budget, 0 goes back to SPIN_BUDGET
+*/
+
+void Spin_Set_Budget(int Site, uint32_t Cycles){
+	
+	Sites[Site].Budget = Cycles;
+}
+
+/**
+  \fn					void Spin_Get_Site(int Site, Spin_Site* Copy)
+  \brief			Copies a site without an interrupt changing it halfway
+	\param			int Site: SPIN site
+	\param			Spin_Site* Copy: Filled with the site's figures
+*/
+
+void Spin_Get_Site(int Site, Spin_Site* Copy){
+	
+	uint32_t Mask = __get_PRIMASK();
+	
+	__disable_irq();
+	*Copy = Sites[Site];
+	__set_PRIMASK(Mask);
+	
+	if(Copy->Budget == 0){
+		Copy->Budget = SPIN_BUDGET;
+	}
+}
+
+/**
+  \fn					void Spin_Reset(void)
+  \brief			Clears every site's figures, budgets are kept
+*/
+
+void Spin_Reset(void){
+	
+	/* Local Variables */
+	uint32_t Mask = __get_PRIMASK();
+	int i = 0;
+	
+	__disable_irq();
+	for(i = 0;i < SPIN_SITES;i++){
+		Sites[i].Waits = 0;
+		Sites[i].Max = 0;
+		Sites[i].Total = 0;
+		Sites[i].Over_Budget = 0;
+	}
+	__set_PRIMASK(Mask);
+}
+
+/**
+  \fn					void Spin_Report(void)
+  \brief			Prints the sites that waited to the serial monitor, most time lost first. Over budget
+							sites are marked with a !
+*/
+
+void Spin_Report(void){
+	
+	/* Local Variables */
+	Spin_Site Site;
+	uint8_t Printed[SPIN_SITES];
+	uint32_t Cycles_Per_ms = SysTick->LOAD + 1;
+	uint32_t Largest_Total = 0;
+	int Largest = 0;
+	int i = 0;
+	int j = 0;
+	
+	for(i = 0;i < SPIN_SITES;i++){
+		Printed[i] = 0;
+	}
+	
+	printf("Wait site    Waits  Total ms   Max cycles  Over budget\r\n");
+	
+	/* Selection by total, one site on the stack at a time, there are only a few sites */
+	for(i = 0;i < SPIN_SITES;i++){
+		Largest = -1;
+		for(j = 0;j < SPIN_SITES;j++){
+			if(Printed[j] != 0){
+				continue;
+			}
+			Spin_Get_Site(j,&Site);
+			if((Site.Waits != 0) && ((Largest < 0) || (Site.Total > Largest_Total))){
+				Largest = j;
+				Largest_Total = Site.Total;
+			}
+		}
+		if(Largest < 0){
+			break;
+		}
+		Printed[Largest] = 1;
+		
+		Spin_Get_Site(Largest,&Site);
+		printf("%-11s %6u %9u %12u %12u%s\r\n",Site_Name[Largest],(unsigned int)Site.Waits,
+			(unsigned int)(Site.Total/Cycles_Per_ms),(unsigned int)Site.Max,
+			(unsigned int)Site.Over_Budget,(Site.Over_Budget != 0) ? " !" : "");
+	}
+}
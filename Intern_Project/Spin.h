@@ -0,0 +1,67 @@
+/*------------------------------------------------------------------------------------------------------
+ * Name:    Spin.h
+ * Purpose: Time lost in busy wait loops, per wait site
+ * Date: 		10/19/26
+ * Author:	Christopher Jordan - Denny
+ *------------------------------------------------------------------------------------------------------
+ * Note(s): Put SPIN_BEGIN before a wait loop and SPIN_END after it, see C file
+ *----------------------------------------------------------------------------------------------------*/
+
+/*-----------------------------------------Include Statements-----------------------------------------*/
+#include <stdint.h>
+#include "Profile.h"
+
+#ifndef SPIN_H
+#define SPIN_H
+
+/*-----------------------------------------Definitions------------------------------------------------*/
+#define SPIN_ENABLE								1						// 0 compiles the macros out
+#define SPIN_BUDGET								32000				// Default cycles a wait may take, 1 ms at 32MHz
+
+/* Wait sites */
+#define SPIN_I2C_BUSY							0						// Bus free before and after a transfer
+#define SPIN_I2C_TC								1						// Transfer complete
+#define SPIN_I2C_TXE							2						// Transmit register empty
+#define SPIN_HTS221								3						// STATUS register polls
+#define SPIN_LPS25HB							4
+#define SPIN_LIS3MDL							5
+#define SPIN_LSM6DS0							6
+#define SPIN_USART2_TXE						7						// Serial monitor character
+#define SPIN_USART1_TXE						8						// GPS character
+#define SPIN_LPUART1_TX						9						// Room in or end of the XBee transmit ring
+#define SPIN_XBEE_OK							10					// Wait_For_OK and Wait_For_OK_Timeout
+#define SPIN_XBEE_DATA						11					// Wait_For_Data
+#define SPIN_GPS_DATA							12					// New sentences or restart message
+#define SPIN_DELAY								13
+#define SPIN_EEPROM								14					// Flash busy
+#define SPIN_ADC									15					// Calibration, enable and disable
+#define SPIN_SPI									16					// Byte transfers, flash commands and reads
+#define SPIN_SITES								17
+
+/* Accumulated in cycles */
+typedef struct Spin_Site
+{
+	uint32_t Waits;
+	uint32_t Max;
+	uint64_t Total;
+	uint32_t Budget;										/* Waits longer than this are counted in Over_Budget */
+	uint32_t Over_Budget;
+}Spin_Site;
+
+#if SPIN_ENABLE
+#define SPIN_BEGIN(Site)					(Spin_Start[(Site)] = Profile_Cycles())
+#define SPIN_END(Site)						Spin_End(Site)
+#else
+#define SPIN_BEGIN(Site)					((void)0)
+#define SPIN_END(Site)						((void)0)
+#endif
+
+extern uint32_t Spin_Start[SPIN_SITES];
+
+extern void Spin_End(int Site);
+extern void Spin_Set_Budget(int Site, uint32_t Cycles);
+extern void Spin_Get_Site(int Site, Spin_Site* Copy);
+extern void Spin_Reset(void);
+extern void Spin_Report(void);
+
+#endif
@@ -0,0 +1,726 @@
+/*------------------------------------------------------------------------------------------------------
+ * Name:    Telemetry.c
+ * Purpose: Packs sensor and GPS data into binary telemetry frames and unpacks them again
+ * Date: 		10/19/26
+ * Author:	Christopher Jordan - Denny
+ *------------------------------------------------------------------------------------------------------
+ * Note(s): Replaces the $GPS and %sensor text packets. Only stdint is used so the ground station
+						can build this file as is and call Telemetry_Decode.
+						
+						Frame Layout (little endian):
+						-----------------------------
+						*	0		Sync					0xEB 0x90
+						*	2		Version				TELEMETRY_VERSION
+						*	3		Type					TELEMETRY_TYPE_RECORD, _DELTA or _EVENT
+						*	4		Sequence			uint16, +1 every frame
+						*	6		Timestamp			uint32, us since power on, wraps after 71 minutes. ms for events
+						*	10	Length				uint8, payload bytes
+						*	11	Payload				See Telemetry_Encode
+						*	n		CRC						uint16 CRC-16/CCITT (0x1021, init 0xFFFF) of Version..Payload
+						
+						Size:
+						-----
+						*	Binary frame: 68 bytes for every field, GPS, magnetometer and baro altitude included
+						*	Text packets: ~70 byte $GPS packet + ~80 byte %sensor packet at two decimals, and
+							~150 bytes for the sensors alone with the old %f formatting
+						
+						Delta Frames:
+						-------------
+						*	Telemetry_Compress sends a full record frame (the keyframe) every
+							Keyframe_Interval frames and TELEMETRY_TYPE_DELTA frames in between. Link_Quality
+							shortens the interval on a lossy link so a lost keyframe costs fewer frames
+						*	Delta payload: uint16 keyframe sequence, uint8 channel bits, then each field of those
+							channels as a zig-zag varint of (field - keyframe field)/Field_Step in the order of
+							Telemetry_Get_Fields. Field_Step is the precision each channel is sent at.
+						*	Deltas are always against the keyframe, never the previous frame, so a dropped
+							delta costs nothing and a dropped keyframe costs at most one interval
+						*	A delta frame is typically 35-40 bytes against 68 with every channel in it, and
+							~20 bytes with only the barometer
+ *----------------------------------------------------------------------------------------------------*/
+
+/*---------------------------------------------Include Statements-------------------------------------*/
+#include "Telemetry.h"
+/*---------------------------------------------Definitions--------------------------------------------*/
+#define BARO_ALTITUDE_MAX				8388607			// cm, largest 24 bit keyframe value, +/-83 km
+/*---------------------------------------------Tables-------------------------------------------------*/
+/* CRC-16/CCITT one nibble at a time, 32 bytes of flash instead of 512 */
+static const uint16_t CRC16_Table[16] = {
+	0x0000,0x1021,0x2042,0x3063,0x4084,0x50A5,0x60C6,0x70E7,
+	0x8108,0x9129,0xA14A,0xB16B,0xC18C,0xD1AD,0xE1CE,0xF1EF
+};
+
+/* Channel of each field, in Telemetry_Get_Fields order */
+static const uint8_t Field_Channel[TELEMETRY_FIELDS] = {
+	TELEMETRY_CHANNEL_GPS,TELEMETRY_CHANNEL_GPS,TELEMETRY_CHANNEL_GPS,
+	TELEMETRY_CHANNEL_GPS,TELEMETRY_CHANNEL_GPS,TELEMETRY_CHANNEL_GPS,
+	TELEMETRY_CHANNEL_ENV,TELEMETRY_CHANNEL_ENV,
+	TELEMETRY_CHANNEL_IMU,TELEMETRY_CHANNEL_IMU,TELEMETRY_CHANNEL_IMU,
+	TELEMETRY_CHANNEL_IMU,TELEMETRY_CHANNEL_IMU,TELEMETRY_CHANNEL_IMU,
+	TELEMETRY_CHANNEL_IMU,TELEMETRY_CHANNEL_IMU,TELEMETRY_CHANNEL_IMU,
+	TELEMETRY_CHANNEL_BARO,TELEMETRY_CHANNEL_BARO,
+	TELEMETRY_CHANNEL_HEALTH,TELEMETRY_CHANNEL_HEALTH,
+	TELEMETRY_CHANNEL_HEALTH,TELEMETRY_CHANNEL_HEALTH
+};
+
+/* Delta precision of each field, in the field's own units */
+static const uint16_t Field_Step[TELEMETRY_FIELDS] = {
+	1,1,10,												/* Latitude, Longitude 1e-6 degree, GPS altitude 10 cm */
+	10,1,1,												/* Ground speed 10 cm/s, time, status */
+	10,50,												/* Temperature 0.1 C, Humidity 0.5 %rH */
+	4,4,4,												/* Acceleration 4 mg */
+	5,5,5,												/* Gyroscope 0.5 dps */
+	10,10,10,											/* Magnetic 10 mG */
+	1,1,													/* Pressure 1 Pa, Baro altitude 1 cm */
+	1,1,													/* Health counters */
+	1,1														/* RSSI, link level */
+};
+/*---------------------------------------------Globals------------------------------------------------*/
+uint16_t Telemetry_Sequence = 0;										/* Sequence of the next frame */
+Telemetry_Record Keyframe;													/* What delta frames are taken against */
+int Since_Keyframe = 0;															/* Frames sent since Keyframe, 0 forces one */
+int Keyframe_Interval = TELEMETRY_KEYFRAME_INTERVAL;
+Telemetry_Stats Compress_Stats;
+/*---------------------------------------------Functions----------------------------------------------*/
+
+/**
+  \fn					uint16_t Telemetry_CRC16(const uint8_t* Data, int Length, uint16_t CRC)
+  \brief			CRC-16/CCITT, start with 0xFFFF, pass the result back in to continue
+	\param			const uint8_t* Data: The bytes to check
+	\param			int Length: Number of bytes
+	\param			uint16_t CRC: 0xFFFF or the previous result
+	\returns		uint16_t CRC: The updated CRC
+*/
+
+uint16_t Telemetry_CRC16(const uint8_t* Data, int Length, uint16_t CRC){
+	
+	int i = 0;
+	
+	for(i = 0;i < Length;i++){
+		CRC = (uint16_t)((CRC << 4) ^ CRC16_Table[(CRC >> 12) ^ (Data[i] >> 4)]);
+		CRC = (uint16_t)((CRC << 4) ^ CRC16_Table[(CRC >> 12) ^ (Data[i] & 0x0F)]);
+	}
+	
+	return(CRC);
+}
+
+/**
+  \fn					uint8_t* Put_16(uint8_t* Position, uint16_t Value)
+  \brief			Writes a little endian 16 bit value
+	\returns		uint8_t*: The byte after the value
+*/
+
+static uint8_t* Put_16(uint8_t* Position, uint16_t Value){
+	Position[0] = (uint8_t)Value;
+	Position[1] = (uint8_t)(Value >> 8);
+	return(Position + 2);
+}
+
+/**
+  \fn					uint8_t* Put_32(uint8_t* Position, uint32_t Value)
+  \brief			Writes a little endian 32 bit value
+	\returns		uint8_t*: The byte after the value
+*/
+
+static uint8_t* Put_32(uint8_t* Position, uint32_t Value){
+	Position[0] = (uint8_t)Value;
+	Position[1] = (uint8_t)(Value >> 8);
+	Position[2] = (uint8_t)(Value >> 16);
+	Position[3] = (uint8_t)(Value >> 24);
+	return(Position + 4);
+}
+
+/**
+  \fn					uint16_t Get_16(const uint8_t* Position)
+  \brief			Reads a little endian 16 bit value
+*/
+
+static uint16_t Get_16(const uint8_t* Position){
+	return((uint16_t)(Position[0] | (Position[1] << 8)));
+}
+
+/**
+  \fn					uint32_t Get_32(const uint8_t* Position)
+  \brief			Reads a little endian 32 bit value
+*/
+
+static uint32_t Get_32(const uint8_t* Position){
+	return((uint32_t)Position[0] | ((uint32_t)Position[1] << 8) |
+		((uint32_t)Position[2] << 16) | ((uint32_t)Position[3] << 24));
+}
+
+/**
+  \fn					int32_t Clamp_Baro(int32_t Altitude)
+  \brief			Holds the baro altitude to the 24 bits a record frame carries. Delta frames take the
+							clamped value too, so a keyframe and its deltas always agree
+*/
+
+static int32_t Clamp_Baro(int32_t Altitude){
+	
+	if(Altitude > BARO_ALTITUDE_MAX){
+		return(BARO_ALTITUDE_MAX);
+	}
+	if(Altitude < -BARO_ALTITUDE_MAX){
+		return(-BARO_ALTITUDE_MAX);
+	}
+	
+	return(Altitude);
+}
+
+/**
+  \fn					int Telemetry_Pack(const Telemetry_Record* Record, uint8_t* Frame)
+  \brief			Builds a record frame with the record's own sequence number, the flash log keeps its
+							samples this way so they have the same layout on every compiler
+	\param			const Telemetry_Record* Record: The data
+	\param			uint8_t* Frame: At least TELEMETRY_RECORD_FRAME bytes
+	\returns		int: Frame length in bytes
+	
+							Payload:
+							--------
+							*	0		Latitude, Longitude, GPS_Altitude		int32 x3
+							*	12	Ground_Speed												uint16
+							*	14	GPS_Time														uint32
+							*	18	GPS_Status													uint8
+							*	19	Temperature													int16
+							*	21	Humidity														uint16
+							*	23	Acceleration, Gyroscope, Magnetic		int16 x9
+							*	41	Pressure														int32
+							*	45	Baro_Altitude												int24, clamped to +/-83 km
+							*	48	Records_Dropped, Link_Failures			uint16 x2
+							*	52	RSSI, Link_Level										uint8 x2
+							*	54	Channels														uint8
+*/
+
+int Telemetry_Pack(const Telemetry_Record* Record, uint8_t* Frame){
+	
+	/* Local Variables */
+	uint8_t* Position = Frame;
+	uint16_t CRC = 0;
+	int32_t Baro = Clamp_Baro(Record->Baro_Altitude);
+	int i = 0;
+	
+	/* Header */
+	*Position++ = TELEMETRY_SYNC_1;
+	*Position++ = TELEMETRY_SYNC_2;
+	*Position++ = TELEMETRY_VERSION;
+	*Position++ = TELEMETRY_TYPE_RECORD;
+	Position = Put_16(Position,Record->Sequence);
+	Position = Put_32(Position,Record->Timestamp);
+	*Position++ = TELEMETRY_RECORD_LENGTH;
+	
+	/* GPS */
+	Position = Put_32(Position,(uint32_t)Record->Latitude);
+	Position = Put_32(Position,(uint32_t)Record->Longitude);
+	Position = Put_32(Position,(uint32_t)Record->GPS_Altitude);
+	Position = Put_16(Position,Record->Ground_Speed);
+	Position = Put_32(Position,Record->GPS_Time);
+	*Position++ = Record->GPS_Status;
+	
+	/* Sensors */
+	Position = Put_16(Position,(uint16_t)Record->Temperature);
+	Position = Put_16(Position,Record->Humidity);
+	for(i = 0;i < 3;i++){
+		Position = Put_16(Position,(uint16_t)Record->Acceleration[i]);
+	}
+	for(i = 0;i < 3;i++){
+		Position = Put_16(Position,(uint16_t)Record->Gyroscope[i]);
+	}
+	for(i = 0;i < 3;i++){
+		Position = Put_16(Position,(uint16_t)Record->Magnetic[i]);
+	}
+	Position = Put_32(Position,(uint32_t)Record->Pressure);
+	*Position++ = (uint8_t)Baro;
+	*Position++ = (uint8_t)(Baro >> 8);
+	*Position++ = (uint8_t)(Baro >> 16);
+	
+	/* Health */
+	Position = Put_16(Position,Record->Records_Dropped);
+	Position = Put_16(Position,Record->Link_Failures);
+	*Position++ = Record->RSSI;
+	*Position++ = Record->Link_Level;
+	*Position++ = Record->Channels;
+	
+	/* CRC of everything after the sync */
+	CRC = Telemetry_CRC16(Frame + 2,(int)(Position - Frame) - 2,0xFFFF);
+	Position = Put_16(Position,CRC);
+	
+	return((int)(Position - Frame));
+}
+
+/**
+  \fn					int Telemetry_Encode(Telemetry_Record* Record, uint8_t* Frame)
+  \brief			Builds a record frame and assigns it the next sequence number
+	\param			Telemetry_Record* Record: The data to send, Sequence is written back
+	\param			uint8_t* Frame: At least TELEMETRY_MAX_FRAME bytes
+	\returns		int: Frame length in bytes
+*/
+
+int Telemetry_Encode(Telemetry_Record* Record, uint8_t* Frame){
+	
+	Record->Sequence = Telemetry_Sequence++;
+	
+	return(Telemetry_Pack(Record,Frame));
+}
+
+/**
+  \fn					int Telemetry_Check_Frame(const uint8_t* Frame, int Length, uint8_t Type)
+  \brief			Checks the sync, version, type, length and CRC of a frame
+	\returns		int: TELEMETRY_OK or one of the TELEMETRY_ERROR values
+*/
+
+static int Telemetry_Check_Frame(const uint8_t* Frame, int Length, uint8_t Type){
+	
+	int Frame_Length = 0;
+	
+	if((Length < TELEMETRY_HEADER_LENGTH) || (Frame[0] != TELEMETRY_SYNC_1) || (Frame[1] != TELEMETRY_SYNC_2)){
+		return(TELEMETRY_ERROR_SYNC);
+	}
+	if((Frame[2] != TELEMETRY_VERSION) || (Frame[3] != Type)){
+		return(TELEMETRY_ERROR_VERSION);
+	}
+	
+	Frame_Length = TELEMETRY_HEADER_LENGTH + Frame[10] + TELEMETRY_CRC_LENGTH;
+	if(Length < Frame_Length){
+		return(TELEMETRY_ERROR_LENGTH);
+	}
+	
+	if(Telemetry_CRC16(Frame + 2,Frame_Length - 4,0xFFFF) != Get_16(Frame + Frame_Length - 2)){
+		return(TELEMETRY_ERROR_CRC);
+	}
+	
+	return(TELEMETRY_OK);
+}
+
+/**
+  \fn					int Telemetry_Decode(const uint8_t* Frame, int Length, Telemetry_Record* Record)
+  \brief			Checks and unpacks a record frame, used by the ground station
+	\param			const uint8_t* Frame: Starts at the sync bytes
+	\param			int Length: Bytes available
+	\param			Telemetry_Record* Record: The unpacked data, only written when TELEMETRY_OK
+	\returns		int: TELEMETRY_OK or one of the TELEMETRY_ERROR values
+*/
+
+int Telemetry_Decode(const uint8_t* Frame, int Length, Telemetry_Record* Record){
+	
+	/* Local Variables */
+	const uint8_t* Position = Frame + TELEMETRY_HEADER_LENGTH;
+	int32_t Baro = 0;
+	int Result = 0;
+	int i = 0;
+	
+	Result = Telemetry_Check_Frame(Frame,Length,TELEMETRY_TYPE_RECORD);
+	if(Result != TELEMETRY_OK){
+		return(Result);
+	}
+	if(Frame[10] != TELEMETRY_RECORD_LENGTH){
+		return(TELEMETRY_ERROR_LENGTH);
+	}
+	
+	/* Header */
+	Record->Sequence = Get_16(Frame + 4);
+	Record->Timestamp = Get_32(Frame + 6);
+	
+	/* GPS */
+	Record->Latitude = (int32_t)Get_32(Position);				Position += 4;
+	Record->Longitude = (int32_t)Get_32(Position);			Position += 4;
+	Record->GPS_Altitude = (int32_t)Get_32(Position);		Position += 4;
+	Record->Ground_Speed = Get_16(Position);						Position += 2;
+	Record->GPS_Time = Get_32(Position);								Position += 4;
+	Record->GPS_Status = *Position++;
+	
+	/* Sensors */
+	Record->Temperature = (int16_t)Get_16(Position);		Position += 2;
+	Record->Humidity = Get_16(Position);								Position += 2;
+	for(i = 0;i < 3;i++){
+		Record->Acceleration[i] = (int16_t)Get_16(Position);	Position += 2;
+	}
+	for(i = 0;i < 3;i++){
+		Record->Gyroscope[i] = (int16_t)Get_16(Position);			Position += 2;
+	}
+	for(i = 0;i < 3;i++){
+		Record->Magnetic[i] = (int16_t)Get_16(Position);			Position += 2;
+	}
+	Record->Pressure = (int32_t)Get_32(Position);				Position += 4;
+	
+	/* Sign extend the 24 bit altitude */
+	Baro = (int32_t)((uint32_t)Position[0] | ((uint32_t)Position[1] << 8) | ((uint32_t)Position[2] << 16));
+	if(Baro & 0x00800000){
+		Baro |= (int32_t)0xFF000000;
+	}
+	Record->Baro_Altitude = Baro;
+	Position += 3;
+	
+	/* Health */
+	Record->Records_Dropped = Get_16(Position);				Position += 2;
+	Record->Link_Failures = Get_16(Position);					Position += 2;
+	Record->RSSI = *Position++;
+	Record->Link_Level = *Position++;
+	Record->Channels = *Position;
+	
+	return(TELEMETRY_OK);
+}
+
+/**
+  \fn					void Telemetry_Get_Fields(const Telemetry_Record* Record, int32_t* Fields)
+  \brief			Lists the record fields in delta frame order
+	\param			int32_t* Fields: TELEMETRY_FIELDS values
+*/
+
+static void Telemetry_Get_Fields(const Telemetry_Record* Record, int32_t* Fields){
+	
+	int i = 0;
+	
+	Fields[0] = Record->Latitude;
+	Fields[1] = Record->Longitude;
+	Fields[2] = Record->GPS_Altitude;
+	Fields[3] = Record->Ground_Speed;
+	Fields[4] = (int32_t)Record->GPS_Time;
+	Fields[5] = Record->GPS_Status;
+	Fields[6] = Record->Temperature;
+	Fields[7] = Record->Humidity;
+	for(i = 0;i < 3;i++){
+		Fields[8 + i] = Record->Acceleration[i];
+		Fields[11 + i] = Record->Gyroscope[i];
+		Fields[14 + i] = Record->Magnetic[i];
+	}
+	Fields[17] = Record->Pressure;
+	Fields[18] = Clamp_Baro(Record->Baro_Altitude);
+	Fields[19] = Record->Records_Dropped;
+	Fields[20] = Record->Link_Failures;
+	Fields[21] = Record->RSSI;
+	Fields[22] = Record->Link_Level;
+}
+
+/**
+  \fn					int32_t Clamp(int32_t Value, int32_t Low, int32_t High)
+  \brief			A delta rounded to its Field_Step can land just outside a 16 bit field, i.e. a ground
+							speed of 2 against a keyframe of 7 comes back as -3, keep it in range instead of
+							letting it wrap
+*/
+
+static int32_t Clamp(int32_t Value, int32_t Low, int32_t High){
+	
+	if(Value < Low){
+		return(Low);
+	}
+	if(Value > High){
+		return(High);
+	}
+	
+	return(Value);
+}
+
+/**
+  \fn					void Telemetry_Set_Fields(Telemetry_Record* Record, const int32_t* Fields)
+  \brief			Fills a record from a list made by Telemetry_Get_Fields
+*/
+
+static void Telemetry_Set_Fields(Telemetry_Record* Record, const int32_t* Fields){
+	
+	int i = 0;
+	
+	Record->Latitude = Fields[0];
+	Record->Longitude = Fields[1];
+	Record->GPS_Altitude = Fields[2];
+	Record->Ground_Speed = (uint16_t)Clamp(Fields[3],0,65535);
+	Record->GPS_Time = (uint32_t)Fields[4];
+	Record->GPS_Status = (uint8_t)Fields[5];
+	Record->Temperature = (int16_t)Clamp(Fields[6],-32768,32767);
+	Record->Humidity = (uint16_t)Clamp(Fields[7],0,65535);
+	for(i = 0;i < 3;i++){
+		Record->Acceleration[i] = (int16_t)Clamp(Fields[8 + i],-32768,32767);
+		Record->Gyroscope[i] = (int16_t)Clamp(Fields[11 + i],-32768,32767);
+		Record->Magnetic[i] = (int16_t)Clamp(Fields[14 + i],-32768,32767);
+	}
+	Record->Pressure = Fields[17];
+	Record->Baro_Altitude = Fields[18];
+	Record->Records_Dropped = (uint16_t)Fields[19];
+	Record->Link_Failures = (uint16_t)Fields[20];
+	Record->RSSI = (uint8_t)Fields[21];
+	Record->Link_Level = (uint8_t)Fields[22];
+}
+
+/**
+  \fn					uint8_t* Put_Varint(uint8_t* Position, int32_t Value)
+  \brief			Writes a zig-zag varint, 7 bits a byte with the top bit set on all but the last
+	\returns		uint8_t*: The byte after the value
+*/
+
+static uint8_t* Put_Varint(uint8_t* Position, int32_t Value){
+	
+	/* Zig-zag so small negative numbers stay small */
+	uint32_t Zigzag = (Value < 0) ? ~((uint32_t)Value << 1) : ((uint32_t)Value << 1);
+	
+	while(Zigzag >= 0x80){
+		*Position++ = (uint8_t)(Zigzag | 0x80);
+		Zigzag >>= 7;
+	}
+	*Position++ = (uint8_t)Zigzag;
+	
+	return(Position);
+}
+
+/**
+  \fn					int Get_Varint(const uint8_t* Position, const uint8_t* End, int32_t* Value)
+  \brief			Reads a zig-zag varint
+	\returns		int: Bytes used, 0 if it runs past End or is longer than 5 bytes
+*/
+
+static int Get_Varint(const uint8_t* Position, const uint8_t* End, int32_t* Value){
+	
+	uint32_t Zigzag = 0;
+	int Count = 0;
+	
+	while((Position + Count) < End){
+		Zigzag |= (uint32_t)(Position[Count] & 0x7F) << (7*Count);
+		if((Position[Count++] & 0x80) == 0){
+			*Value = (int32_t)((Zigzag >> 1) ^ (0u - (Zigzag & 1)));
+			return(Count);
+		}
+		if(Count == 5){
+			break;
+		}
+	}
+	
+	return(0);
+}
+
+/**
+  \fn					int Telemetry_Compress(Telemetry_Record* Record, uint8_t* Frame)
+  \brief			Builds a keyframe or a delta frame against the last keyframe, delta frames only
+							carry the channels in Record->Channels
+	\param			Telemetry_Record* Record: The data to send, Sequence is written back
+	\param			uint8_t* Frame: At least TELEMETRY_MAX_FRAME bytes
+	\returns		int: Frame length in bytes
+*/
+
+int Telemetry_Compress(Telemetry_Record* Record, uint8_t* Frame){
+	
+	/* Local Variables */
+	int32_t Fields[TELEMETRY_FIELDS];
+	int32_t Key_Fields[TELEMETRY_FIELDS];
+	uint8_t* Position = Frame;
+	uint16_t CRC = 0;
+	int32_t Delta = 0;
+	int32_t Step = 0;
+	int Length = 0;
+	int i = 0;
+	
+	Compress_Stats.Frames++;
+	Compress_Stats.Raw_Bytes += TELEMETRY_RECORD_FRAME;
+	
+	/* Keyframe */
+	if(Since_Keyframe == 0){
+		Length = Telemetry_Encode(Record,Frame);
+		Keyframe = *Record;
+		Since_Keyframe = 1;
+		Compress_Stats.Keyframes++;
+		Compress_Stats.Sent_Bytes += Length;
+		return(Length);
+	}
+	
+	Since_Keyframe++;
+	if(Since_Keyframe >= Keyframe_Interval){
+		Since_Keyframe = 0;
+	}
+	
+	Record->Sequence = Telemetry_Sequence++;
+	
+	/* Header, the length is filled in once known */
+	*Position++ = TELEMETRY_SYNC_1;
+	*Position++ = TELEMETRY_SYNC_2;
+	*Position++ = TELEMETRY_VERSION;
+	*Position++ = TELEMETRY_TYPE_DELTA;
+	Position = Put_16(Position,Record->Sequence);
+	Position = Put_32(Position,Record->Timestamp);
+	Position++;
+	
+	/* Keyframe these deltas are against and the channels carried */
+	Position = Put_16(Position,Keyframe.Sequence);
+	*Position++ = Record->Channels;
+	
+	Telemetry_Get_Fields(Record,Fields);
+	Telemetry_Get_Fields(&Keyframe,Key_Fields);
+	for(i = 0;i < TELEMETRY_FIELDS;i++){
+		if((Record->Channels & Field_Channel[i]) == 0){
+			continue;
+		}
+		
+		/* Round to the channel precision */
+		Delta = (int32_t)((uint32_t)Fields[i] - (uint32_t)Key_Fields[i]);
+		Step = Field_Step[i];
+		if(Step > 1){
+			Delta = (Delta >= 0) ? ((Delta + Step/2)/Step) : -((Step/2 - Delta)/Step);
+		}
+		Position = Put_Varint(Position,Delta);
+	}
+	Frame[10] = (uint8_t)(Position - Frame - TELEMETRY_HEADER_LENGTH);
+	
+	/* CRC of everything after the sync */
+	CRC = Telemetry_CRC16(Frame + 2,(int)(Position - Frame) - 2,0xFFFF);
+	Position = Put_16(Position,CRC);
+	
+	Length = (int)(Position - Frame);
+	Compress_Stats.Sent_Bytes += Length;
+	
+	return(Length);
+}
+
+/**
+  \fn					int Telemetry_Decompress(Telemetry_Decoder* Decoder, const uint8_t* Frame, int Length, Telemetry_Record* Record)
+  \brief			Unpacks a keyframe or a delta frame, used by the ground station
+	\param			Telemetry_Decoder* Decoder: Keyframe state, zero it before the first frame
+	\param			const uint8_t* Frame: Starts at the sync bytes
+	\param			int Length: Bytes available
+	\param			Telemetry_Record* Record: The unpacked data, only written when TELEMETRY_OK
+	\returns		int: TELEMETRY_OK or one of the TELEMETRY_ERROR values, TELEMETRY_ERROR_KEYFRAME
+							means the keyframe was lost and frames resume at the next one
+*/
+
+int Telemetry_Decompress(Telemetry_Decoder* Decoder, const uint8_t* Frame, int Length, Telemetry_Record* Record){
+	
+	/* Local Variables */
+	int32_t Fields[TELEMETRY_FIELDS];
+	int32_t Key_Fields[TELEMETRY_FIELDS];
+	const uint8_t* Position = Frame + TELEMETRY_HEADER_LENGTH;
+	const uint8_t* End = 0;
+	int32_t Delta = 0;
+	uint8_t Channels = 0;
+	int Result = 0;
+	int Used = 0;
+	int i = 0;
+	
+	/* Keyframe */
+	if((Length >= TELEMETRY_HEADER_LENGTH) && (Frame[3] == TELEMETRY_TYPE_RECORD)){
+		Result = Telemetry_Decode(Frame,Length,Record);
+		if(Result == TELEMETRY_OK){
+			Decoder->Keyframe = *Record;
+			Decoder->Last = *Record;
+			Decoder->Keyframe_Valid = 1;
+		}
+		return(Result);
+	}
+	
+	Result = Telemetry_Check_Frame(Frame,Length,TELEMETRY_TYPE_DELTA);
+	if(Result != TELEMETRY_OK){
+		return(Result);
+	}
+	if(Frame[10] < 3){
+		return(TELEMETRY_ERROR_LENGTH);
+	}
+	End = Position + Frame[10];
+	
+	if((Decoder->Keyframe_Valid == 0) || (Get_16(Position) != Decoder->Keyframe.Sequence)){
+		Decoder->Keyframe_Valid = 0;
+		return(TELEMETRY_ERROR_KEYFRAME);
+	}
+	Channels = Position[2];
+	Position += 3;
+	
+	/* Channels not in this frame keep their newest value */
+	Telemetry_Get_Fields(&Decoder->Keyframe,Key_Fields);
+	Telemetry_Get_Fields(&Decoder->Last,Fields);
+	for(i = 0;i < TELEMETRY_FIELDS;i++){
+		if((Channels & Field_Channel[i]) == 0){
+			continue;
+		}
+		Used = Get_Varint(Position,End,&Delta);
+		if(Used == 0){
+			return(TELEMETRY_ERROR_LENGTH);
+		}
+		Fields[i] = (int32_t)((uint32_t)Key_Fields[i] + (uint32_t)(Delta*(int32_t)Field_Step[i]));
+		Position += Used;
+	}
+	
+	Telemetry_Set_Fields(&Decoder->Last,Fields);
+	Decoder->Last.Sequence = Get_16(Frame + 4);
+	Decoder->Last.Timestamp = Get_32(Frame + 6);
+	Decoder->Last.Channels = Channels;
+	*Record = Decoder->Last;
+	
+	return(TELEMETRY_OK);
+}
+
+/**
+  \fn					int Telemetry_Encode_Event(const Telemetry_Event* Event, uint8_t* Frame)
+  \brief			Builds an event frame, the header sequence is the event sequence so events don't
+							count as lost telemetry frames
+	\param			const Telemetry_Event* Event: The event
+	\param			uint8_t* Frame: At least TELEMETRY_MAX_FRAME bytes
+	\returns		int: Frame length in bytes
+	
+							Payload:
+							--------
+							*	0		Type																uint8
+							*	1		Value																int32
+*/
+
+int Telemetry_Encode_Event(const Telemetry_Event* Event, uint8_t* Frame){
+	
+	/* Local Variables */
+	uint8_t* Position = Frame;
+	uint16_t CRC = 0;
+	
+	*Position++ = TELEMETRY_SYNC_1;
+	*Position++ = TELEMETRY_SYNC_2;
+	*Position++ = TELEMETRY_VERSION;
+	*Position++ = TELEMETRY_TYPE_EVENT;
+	Position = Put_16(Position,Event->Sequence);
+	Position = Put_32(Position,Event->Timestamp);
+	*Position++ = TELEMETRY_EVENT_LENGTH;
+	*Position++ = Event->Type;
+	Position = Put_32(Position,(uint32_t)Event->Value);
+	
+	CRC = Telemetry_CRC16(Frame + 2,(int)(Position - Frame) - 2,0xFFFF);
+	Position = Put_16(Position,CRC);
+	
+	return((int)(Position - Frame));
+}
+
+/**
+  \fn					int Telemetry_Decode_Event(const uint8_t* Frame, int Length, Telemetry_Event* Event)
+  \brief			Checks and unpacks an event frame, used by the ground station
+	\param			const uint8_t* Frame: Starts at the sync bytes
+	\param			int Length: Bytes available
+	\param			Telemetry_Event* Event: The unpacked event, only written when TELEMETRY_OK
+	\returns		int: TELEMETRY_OK or one of the TELEMETRY_ERROR values
+*/
+
+int Telemetry_Decode_Event(const uint8_t* Frame, int Length, Telemetry_Event* Event){
+	
+	int Result = Telemetry_Check_Frame(Frame,Length,TELEMETRY_TYPE_EVENT);
+	
+	if(Result != TELEMETRY_OK){
+		return(Result);
+	}
+	if(Frame[10] != TELEMETRY_EVENT_LENGTH){
+		return(TELEMETRY_ERROR_LENGTH);
+	}
+	
+	Event->Sequence = Frame[4];
+	Event->Timestamp = Get_32(Frame + 6);
+	Event->Type = Frame[TELEMETRY_HEADER_LENGTH];
+	Event->Value = (int32_t)Get_32(Frame + TELEMETRY_HEADER_LENGTH + 1);
+	
+	return(TELEMETRY_OK);
+}
+
+/**
+  \fn					void Telemetry_Set_Keyframe_Interval(int Interval)
+  \brief			Changes how many frames go from one keyframe to the next, deltas already sent
+							still refer to the current keyframe
+	\param			int Interval: Frames, at least 2
+*/
+
+void Telemetry_Set_Keyframe_Interval(int Interval){
+	Keyframe_Interval = (Interval < 2) ? 2 : Interval;
+}
+
+/**
+  \fn					Telemetry_Stats* Telemetry_Get_Stats(void)
+  \brief			Bytes sent by Telemetry_Compress against full frames, for the compression ratio
+	\returns		Telemetry_Stats*: The counters
+*/
+
+Telemetry_Stats* Telemetry_Get_Stats(void){
+	return(&Compress_Stats);
+}
@@ -0,0 +1,126 @@
+/*------------------------------------------------------------------------------------------------------
+ * Name:    Telemetry.h
+ * Purpose: Packs sensor and GPS data into binary telemetry frames and unpacks them again
+ * Date: 		10/19/26
+ * Author:	Christopher Jordan - Denny
+ *------------------------------------------------------------------------------------------------------
+ * Note(s): See C file for the frame layout
+ *----------------------------------------------------------------------------------------------------*/
+
+/*-----------------------------------------Include Statements-----------------------------------------*/
+#include <stdint.h>
+
+#ifndef TELEMETRY_H
+#define TELEMETRY_H
+
+/*-----------------------------------------Frame Constants--------------------------------------------*/
+#define TELEMETRY_SYNC_1						0xEB				// First sync byte
+#define TELEMETRY_SYNC_2						0x90				// Second sync byte
+#define TELEMETRY_VERSION						4						// Bump when the layout changes
+#define TELEMETRY_TYPE_RECORD				1						// Full sensor and GPS record, also the keyframe
+#define TELEMETRY_TYPE_DELTA				2						// Varint deltas against the last keyframe
+#define TELEMETRY_TYPE_EVENT				3						// Critical event, acknowledged by the ground station
+#define TELEMETRY_EVENT_LENGTH			5						// Payload of an event frame
+#define TELEMETRY_HEADER_LENGTH			11					// Sync to payload length
+#define TELEMETRY_RECORD_LENGTH			55					// Payload of a record frame
+#define TELEMETRY_CRC_LENGTH				2
+#define TELEMETRY_RECORD_FRAME			(TELEMETRY_HEADER_LENGTH + TELEMETRY_RECORD_LENGTH + TELEMETRY_CRC_LENGTH)
+#define TELEMETRY_FIELDS						23					// Fields carried in a delta frame
+#define TELEMETRY_DELTA_MAX_LENGTH	(3 + 5*TELEMETRY_FIELDS)
+#define TELEMETRY_MAX_FRAME					(TELEMETRY_HEADER_LENGTH + TELEMETRY_DELTA_MAX_LENGTH + TELEMETRY_CRC_LENGTH)
+#define TELEMETRY_KEYFRAME_INTERVAL	25					// Default frames from one keyframe to the next
+
+/* Decode results */
+#define TELEMETRY_OK								0
+#define TELEMETRY_ERROR_SYNC				1
+#define TELEMETRY_ERROR_VERSION			2
+#define TELEMETRY_ERROR_LENGTH			3
+#define TELEMETRY_ERROR_CRC					4
+#define TELEMETRY_ERROR_KEYFRAME		5						// Delta frame without its keyframe
+
+/* Channels, a frame carries any mix of them */
+#define TELEMETRY_CHANNEL_IMU				0x01				// Acceleration, Gyroscope, Magnetic
+#define TELEMETRY_CHANNEL_BARO			0x02				// Pressure, Baro_Altitude
+#define TELEMETRY_CHANNEL_GPS				0x04				// Position, speed, time and status
+#define TELEMETRY_CHANNEL_ENV				0x08				// Temperature, Humidity
+#define TELEMETRY_CHANNEL_HEALTH		0x10				// Link counters
+#define TELEMETRY_CHANNEL_ALL				0x1F
+#define TELEMETRY_CHANNELS					5
+
+/* Event types and their values */
+#define TELEMETRY_EVENT_DEPLOY			1						// Value: TELEMETRY_DEPLOY source
+#define TELEMETRY_EVENT_APOGEE			2						// Value: highest baro altitude in cm
+#define TELEMETRY_EVENT_FAULT				3						// Value: TELEMETRY_FAULT code
+
+#define TELEMETRY_DEPLOY_UPLINK			0						// Ground station command
+#define TELEMETRY_DEPLOY_TIMER			1						// Backup timer after the button press
+
+#define TELEMETRY_FAULT_XBEE_CONFIG	1						// XBee bring-up failed
+
+/* GPS_Status bits */
+#define TELEMETRY_GPS_VALID					0x80				// Fix is valid
+#define TELEMETRY_GPS_SATELLITES		0x1F				// Satellites used
+
+/* One frame worth of data, every field is fixed point */
+typedef struct Telemetry_Record
+{
+	uint16_t Sequence;									/* Set by Telemetry_Encode */
+	uint32_t Timestamp;									/* us since power on, wraps after 71 minutes */
+	uint8_t Channels;										/* TELEMETRY_CHANNEL bits sampled for this frame */
+	int32_t Latitude;										/* Millionths of a degree, + North */
+	int32_t Longitude;									/* Millionths of a degree, + East */
+	int32_t GPS_Altitude;								/* Centimeters above mean sea level */
+	uint16_t Ground_Speed;							/* Centimeters per second */
+	uint32_t GPS_Time;									/* hhmmssmmm UTC */
+	uint8_t GPS_Status;									/* TELEMETRY_GPS_VALID | satellites */
+	int16_t Temperature;								/* Hundredths of a degree C */
+	uint16_t Humidity;									/* Hundredths of a %rH */
+	int16_t Acceleration[3];						/* X,Y,Z in mg */
+	int16_t Gyroscope[3];								/* Pitch,Roll,Yaw in tenths of a degree/second */
+	int16_t Magnetic[3];								/* X,Y,Z in mG */
+	int32_t Pressure;										/* Hundredths of a mbar (Pa) */
+	int32_t Baro_Altitude;							/* Centimeters from the pressure, frames clamp it to +/-83 km */
+	uint16_t Records_Dropped;						/* Records the XBee queue had no room for */
+	uint16_t Link_Failures;							/* TX Status failures */
+	uint8_t RSSI;												/* -dBm of the last packet the rocket received */
+	uint8_t Link_Level;									/* Link_Quality level, 0 is the best link */
+}Telemetry_Record;
+
+/* Deployment, apogee and faults, see Events.c */
+typedef struct Telemetry_Event
+{
+	uint8_t Sequence;										/* Event sequence, separate from the frame sequence */
+	uint8_t Type;												/* TELEMETRY_EVENT */
+	uint32_t Timestamp;									/* ms since power on when it happened */
+	int32_t Value;
+}Telemetry_Event;
+
+/* Ground station state for Telemetry_Decompress */
+typedef struct Telemetry_Decoder
+{
+	Telemetry_Record Keyframe;
+	Telemetry_Record Last;							/* Newest value of every channel */
+	int Keyframe_Valid;
+}Telemetry_Decoder;
+
+/* Telemetry_Compress byte counts */
+typedef struct Telemetry_Stats
+{
+	uint32_t Frames;
+	uint32_t Keyframes;
+	uint32_t Raw_Bytes;									/* Bytes as full record frames */
+	uint32_t Sent_Bytes;								/* Bytes actually produced */
+}Telemetry_Stats;
+
+extern uint16_t Telemetry_CRC16(const uint8_t* Data, int Length, uint16_t CRC);
+extern int Telemetry_Pack(const Telemetry_Record* Record, uint8_t* Frame);
+extern int Telemetry_Encode(Telemetry_Record* Record, uint8_t* Frame);
+extern int Telemetry_Decode(const uint8_t* Frame, int Length, Telemetry_Record* Record);
+extern int Telemetry_Compress(Telemetry_Record* Record, uint8_t* Frame);
+extern int Telemetry_Decompress(Telemetry_Decoder* Decoder, const uint8_t* Frame, int Length, Telemetry_Record* Record);
+extern int Telemetry_Encode_Event(const Telemetry_Event* Event, uint8_t* Frame);
+extern int Telemetry_Decode_Event(const uint8_t* Frame, int Length, Telemetry_Event* Event);
+extern void Telemetry_Set_Keyframe_Interval(int Interval);
+extern Telemetry_Stats* Telemetry_Get_Stats(void);
+
+#endif
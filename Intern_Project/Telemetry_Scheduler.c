@@ -0,0 +1,207 @@
+/*------------------------------------------------------------------------------------------------------
+ * Name:    Telemetry_Scheduler.c
+ * Purpose: Decides which telemetry channels go in the next frame within a byte budget
+ * Date: 		10/19/26
+ * Author:	Christopher Jordan - Denny
+ *------------------------------------------------------------------------------------------------------
+ * Note(s): The link can't carry every field at full rate, so each channel gets a priority, a rate and
+						(through Field_Step in Telemetry.c) a precision.
+						
+						*	The budget is a token bucket refilled at Budget bytes per second and capped at
+							TELEMETRY_BURST bytes
+						*	Due channels are taken in priority order while the bucket covers the frame. The first
+							due channel that doesn't fit stops the search so lower priorities can never starve
+							the barometer before apogee
+						*	Telemetry_Scheduler_Charge takes off what the frame really cost, keyframes included,
+							so the bucket may go into debt and hold the next frames back
+						
+						Defaults:
+						---------
+						*	Priority	Channel		Rate
+						*	0					BARO			20 Hz
+						*	1					IMU				10 Hz
+						*	2					GPS				When a fix comes in, at most 1 Hz
+						*	3					ENV				0.2 Hz
+						*	4					HEALTH		0.1 Hz
+ *----------------------------------------------------------------------------------------------------*/
+
+/*---------------------------------------------Include Statements-------------------------------------*/
+#include "Telemetry_Scheduler.h"
+/*---------------------------------------------Definitions--------------------------------------------*/
+#define FRAME_OVERHEAD					(TELEMETRY_HEADER_LENGTH + 3 + TELEMETRY_CRC_LENGTH)		/* Delta frame without fields */
+/*---------------------------------------------Globals------------------------------------------------*/
+Telemetry_Channel Channels[TELEMETRY_CHANNELS] = {
+	{TELEMETRY_CHANNEL_BARO,		0,		50,			4,	0,0,0},
+	{TELEMETRY_CHANNEL_IMU,			1,		100,		12,	0,0,0},
+	{TELEMETRY_CHANNEL_GPS,			2,		1000,		10,	0,0,0},
+	{TELEMETRY_CHANNEL_ENV,			3,		5000,		2,	0,0,0},
+	{TELEMETRY_CHANNEL_HEALTH,	4,		10000,	2,	0,0,0}
+};
+uint8_t Order[TELEMETRY_CHANNELS] = {0,1,2,3,4};				/* Channels sorted by priority */
+int32_t Bucket = 0;																			/* Thousandths of a byte */
+uint32_t Budget_Rate = 0;																/* Bytes per second */
+uint32_t Last_Refill = 0;
+/*---------------------------------------------Functions----------------------------------------------*/
+
+/**
+  \fn					void Telemetry_Scheduler_Sort(void)
+  \brief			Orders the channels by priority
+*/
+
+static void Telemetry_Scheduler_Sort(void){
+	
+	int i = 0;
+	int j = 0;
+	uint8_t Temp = 0;
+	
+	for(i = 1;i < TELEMETRY_CHANNELS;i++){
+		Temp = Order[i];
+		for(j = i;(j > 0) && (Channels[Order[j - 1]].Priority > Channels[Temp].Priority);j--){
+			Order[j] = Order[j - 1];
+		}
+		Order[j] = Temp;
+	}
+}
+
+/**
+  \fn					void Telemetry_Scheduler_Init(uint32_t Budget)
+  \brief			Starts the scheduler with a full bucket
+	\param			uint32_t Budget: Bytes per second the telemetry may use
+*/
+
+void Telemetry_Scheduler_Init(uint32_t Budget){
+	Budget_Rate = Budget;
+	Bucket = TELEMETRY_BURST*1000;
+	Telemetry_Scheduler_Sort();
+}
+
+/**
+  \fn					void Telemetry_Scheduler_Set_Budget(uint32_t Budget)
+  \brief			Changes the byte rate without emptying the bucket, used by Link_Quality
+	\param			uint32_t Budget: Bytes per second the telemetry may use
+*/
+
+void Telemetry_Scheduler_Set_Budget(uint32_t Budget){
+	Budget_Rate = Budget;
+}
+
+/**
+  \fn					Telemetry_Channel* Telemetry_Scheduler_Get_Channel(uint8_t Mask)
+  \brief			Retrieves a channel's schedule and counters
+	\param			uint8_t Mask: A TELEMETRY_CHANNEL bit
+	\returns		Telemetry_Channel*: The channel, 0 if Mask is not a channel
+*/
+
+Telemetry_Channel* Telemetry_Scheduler_Get_Channel(uint8_t Mask){
+	
+	int i = 0;
+	
+	for(i = 0;i < TELEMETRY_CHANNELS;i++){
+		if(Channels[i].Mask == Mask){
+			return(&Channels[i]);
+		}
+	}
+	
+	return(0);
+}
+
+/**
+  \fn					void Telemetry_Scheduler_Set_Channel(uint8_t Mask, uint8_t Priority, uint16_t Period)
+  \brief			Changes a channel's priority and rate
+	\param			uint8_t Mask: A TELEMETRY_CHANNEL bit
+	\param			uint8_t Priority: 0 is sent first
+	\param			uint16_t Period: ms between samples, 0 turns the channel off
+*/
+
+void Telemetry_Scheduler_Set_Channel(uint8_t Mask, uint8_t Priority, uint16_t Period){
+	
+	Telemetry_Channel* Channel = Telemetry_Scheduler_Get_Channel(Mask);
+	
+	if(Channel == 0){
+		return;
+	}
+	
+	Channel->Priority = Priority;
+	Channel->Period = Period;
+	Telemetry_Scheduler_Sort();
+}
+
+/**
+  \fn					void Telemetry_Scheduler_Set_Period(uint8_t Mask, uint16_t Period)
+  \brief			Changes a channel's rate and keeps its priority, used by the uplink
+	\param			uint8_t Mask: A TELEMETRY_CHANNEL bit
+	\param			uint16_t Period: ms between samples, 0 turns the channel off
+*/
+
+void Telemetry_Scheduler_Set_Period(uint8_t Mask, uint16_t Period){
+	
+	Telemetry_Channel* Channel = Telemetry_Scheduler_Get_Channel(Mask);
+	
+	if(Channel != 0){
+		Channel->Period = Period;
+	}
+}
+
+/**
+  \fn					uint8_t Telemetry_Scheduler_Select(uint32_t Now, uint8_t Available)
+  \brief			Picks the channels for the next frame
+	\param			uint32_t Now: msTicks
+	\param			uint8_t Available: Channels with new data, the GPS only has some once a second
+	\returns		uint8_t: TELEMETRY_CHANNEL bits to sample and send, 0 for no frame
+*/
+
+uint8_t Telemetry_Scheduler_Select(uint32_t Now, uint8_t Available){
+	
+	/* Local Variables */
+	Telemetry_Channel* Channel;
+	uint8_t Selected = 0;
+	int32_t Cost = FRAME_OVERHEAD;
+	uint32_t Elapsed = Now - Last_Refill;
+	int i = 0;
+	
+	/* Refill, a second is more than enough to fill it */
+	if(Elapsed > 1000){
+		Elapsed = 1000;
+	}
+	Bucket += (int32_t)(Elapsed*Budget_Rate);
+	if(Bucket > (TELEMETRY_BURST*1000)){
+		Bucket = TELEMETRY_BURST*1000;
+	}
+	Last_Refill = Now;
+	
+	for(i = 0;i < TELEMETRY_CHANNELS;i++){
+		Channel = &Channels[Order[i]];
+		
+		if((Channel->Period == 0) || ((Available & Channel->Mask) == 0) || ((int32_t)(Now - Channel->Next_Due) < 0)){
+			continue;
+		}
+		
+		/* Highest priority that doesn't fit waits for the bucket */
+		if(Bucket < ((Cost + Channel->Cost)*1000)){
+			Channel->Late++;
+			break;
+		}
+		
+		Cost += Channel->Cost;
+		Selected |= Channel->Mask;
+		Channel->Sent++;
+		
+		/* Keep the rate, unless we have fallen a whole period behind */
+		Channel->Next_Due += Channel->Period;
+		if((int32_t)(Now - Channel->Next_Due) >= 0){
+			Channel->Next_Due = Now + Channel->Period;
+		}
+	}
+	
+	return(Selected);
+}
+
+/**
+  \fn					void Telemetry_Scheduler_Charge(int Length)
+  \brief			Takes what the frame really cost out of the budget
+	\param			int Length: Frame length in bytes
+*/
+
+void Telemetry_Scheduler_Charge(int Length){
+	Bucket -= Length*1000;
+}
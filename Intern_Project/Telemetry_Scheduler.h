@@ -0,0 +1,40 @@
+/*------------------------------------------------------------------------------------------------------
+ * Name:    Telemetry_Scheduler.h
+ * Purpose: Decides which telemetry channels go in the next frame within a byte budget
+ * Date: 		10/19/26
+ * Author:	Christopher Jordan - Denny
+ *------------------------------------------------------------------------------------------------------
+ * Note(s):
+ *----------------------------------------------------------------------------------------------------*/
+
+/*-----------------------------------------Include Statements-----------------------------------------*/
+#include <stdint.h>
+#include "Telemetry.h"
+
+#ifndef TELEMETRY_SCHEDULER_H
+#define TELEMETRY_SCHEDULER_H
+
+/*-----------------------------------------Definitions------------------------------------------------*/
+#define TELEMETRY_BURST						256							// Most bytes the budget can save up
+
+/* One channel's schedule */
+typedef struct Telemetry_Channel
+{
+	uint8_t Mask;												/* TELEMETRY_CHANNEL bit */
+	uint8_t Priority;										/* 0 is sent first */
+	uint16_t Period;										/* ms between samples, 0 turns the channel off */
+	uint8_t Cost;												/* Typical bytes in a delta frame */
+	uint32_t Next_Due;									/* msTicks of the next sample */
+	uint32_t Sent;											/* Samples sent */
+	uint32_t Late;											/* Polls where it was due but the budget ran out */
+}Telemetry_Channel;
+
+extern void Telemetry_Scheduler_Init(uint32_t Budget);
+extern void Telemetry_Scheduler_Set_Budget(uint32_t Budget);
+extern void Telemetry_Scheduler_Set_Channel(uint8_t Mask, uint8_t Priority, uint16_t Period);
+extern void Telemetry_Scheduler_Set_Period(uint8_t Mask, uint16_t Period);
+extern uint8_t Telemetry_Scheduler_Select(uint32_t Now, uint8_t Available);
+extern void Telemetry_Scheduler_Charge(int Length);
+extern Telemetry_Channel* Telemetry_Scheduler_Get_Channel(uint8_t Mask);
+
+#endif
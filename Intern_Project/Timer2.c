@@ -1,14 +1,123 @@
-#include "stm32l053xx.h"					//Specific Device header
+/*------------------------------------------------------------------------------------------------------
+ * Name:    Timer2.c
+ * Purpose: Free running microsecond timebase on TIM2
+ * Date: 		10/19/26
+ * Author:	Christopher Jordan - Denny
+ *------------------------------------------------------------------------------------------------------
+ * Note(s): TIM2 is only 16 bits, it counts 1 MHz and wraps every 65.536 ms. The update interrupt
+						counts the wraps in Timer2_Overflows, which are the upper bits of the time.
+						*	Reading is lock free: the count is read between two reads of the overflow counter and
+							read again if the interrupt ran in between
+						*	A reader with interrupts off, or one in an interrupt at the same priority, can see the
+							counter wrap before the interrupt has counted it. The pending flag then says the
+							overflow is missing, a count in the lower half means it was read after the wrap.
+						*	The update interrupt has the highest priority and is only a few instructions, so the
+							flag is never left pending for half a wrap
+						*	64 bits of microseconds don't wrap, the low 32 bits wrap after about 71 minutes
+ *----------------------------------------------------------------------------------------------------*/
+
+/*---------------------------------------------Include Statements-------------------------------------*/
+#include "Timer2.h"
+#include "Profile.h"
+#include "Trace.h"
+#include "ISR_Monitor.h"
+/*---------------------------------------------Definitions--------------------------------------------*/
+#define TIMER2_PRESCALER					31												/* 32MHz/(31+1) = 1MHz */
+#define TIMER2_HALF								0x8000
+/*---------------------------------------------Globals------------------------------------------------*/
+volatile uint32_t Timer2_Overflows = 0;														/* 65.536 ms each */
+/*---------------------------------------------Functions----------------------------------------------*/
+
+/**
+  \fn					void TIM2_IRQHandler(void)
+  \brief			Counts TIM2 wrapping from 0xFFFF to 0
+*/
 
 void TIM2_IRQHandler(void){
 	
+	/* The count is the us since the wrap that raised it */
+	if(TIM2->SR & TIM_SR_UIF){
+		ISR_Monitor_Enter(ISR_MONITOR_TIM2,(TIM2->CNT & 0xFFFF)*(TIMER2_PRESCALER + 1));
+	}
+	else{
+		ISR_Monitor_Enter(ISR_MONITOR_TIM2,ISR_MONITOR_NO_LATENCY);
+	}
+	PROFILE_BEGIN(PROFILE_TIM2);
+	TRACE_BEGIN(TRACE_TIM2,0);
+	
+	/* rc_w0, writing 1 leaves a flag alone, so a read-modify-write could clear one that just set */
+	if(TIM2->SR & TIM_SR_UIF){
+		TIM2->SR = ~TIM_SR_UIF;
+		Timer2_Overflows++;
+	}
+	
+	TRACE_END(TRACE_TIM2,0);
+	PROFILE_END(PROFILE_TIM2);
+	ISR_Monitor_Exit(ISR_MONITOR_TIM2);
 }
 
+/**
+  \fn					void Timer2_Init(void)
+  \brief			Starts TIM2 counting microseconds, call before anything that reads the time
+*/
+
 void Timer2_Init(void){
 	
 	RCC->APB1ENR |= RCC_APB1ENR_TIM2EN;
 	
-	TIM2->PSC = 31999;								//CK_CNT=Fck_psc/(PSC[15:0]+1), so 32MHz clock becomes 1kHz
-  TIM2->ARR = 1000;									//Clock is 1kHz so period becomes 1s
+	TIM2->CR1 = 0;
+	TIM2->PSC = TIMER2_PRESCALER;			//CK_CNT=Fck_psc/(PSC[15:0]+1), so 32MHz clock becomes 1MHz
+  TIM2->ARR = 0xFFFF;								//Free running, wraps every 65.536ms
+	TIM2->CNT = 0;
+	
+	/* Load the prescaler now, only a real wrap should count */
+	TIM2->CR1 |= TIM_CR1_URS;
+	TIM2->EGR = TIM_EGR_UG;
+	TIM2->SR = 0;
+	Timer2_Overflows = 0;
+	
+	TIM2->DIER |= TIM_DIER_UIE;
+	NVIC_SetPriority(TIM2_IRQn,0);
+	NVIC_EnableIRQ(TIM2_IRQn);
+	
+	TIM2->CR1 |= TIM_CR1_CEN;
+}
+
+/**
+  \fn					uint64_t Timer2_Read(void)
+  \brief			Microseconds since Timer2_Init, safe anywhere including interrupts and with
+							interrupts off
+	\returns		uint64_t: Microseconds
+*/
+
+uint64_t Timer2_Read(void){
+	
+	/* Local Variables */
+	uint32_t Overflows = 0;
+	uint32_t Count = 0;
+	uint32_t Pending = 0;
+	
+	do{
+		Overflows = Timer2_Overflows;
+		Count = TIM2->CNT & 0xFFFF;
+		Pending = TIM2->SR & TIM_SR_UIF;
+	}while(Overflows != Timer2_Overflows);
+	
+	/* Wrapped but not counted yet */
+	if((Pending != 0) && (Count < TIMER2_HALF)){
+		Overflows++;
+	}
+	
+	return((((uint64_t)Overflows) << 16) | Count);
 }
 
+/**
+  \fn					uint32_t Timer2_Microseconds(void)
+  \brief			Low 32 bits of Timer2_Read, only use differences
+	\returns		uint32_t: Microseconds
+*/
+
+uint32_t Timer2_Microseconds(void){
+	
+	return((uint32_t)Timer2_Read());
+}
@@ -1,10 +1,20 @@
+/*------------------------------------------------------------------------------------------------------
+ * Name:    Timer2.h
+ * Purpose: Free running microsecond timebase on TIM2
+ * Date: 		10/19/26
+ * Author:	Christopher Jordan - Denny
+ *------------------------------------------------------------------------------------------------------
+ * Note(s): See C file
+ *----------------------------------------------------------------------------------------------------*/
+
+#include <stdint.h>
 #include "stm32l053xx.h"
 
 #ifndef Timer2_H
 #define Timer2_H
 
-void Timer2_Init(void);
+extern void Timer2_Init(void);
+extern uint64_t Timer2_Read(void);
+extern uint32_t Timer2_Microseconds(void);
 
 #endif
-
-//
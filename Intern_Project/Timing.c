@@ -10,7 +10,13 @@
 /*---------------------------------------Include Statements-------------------------------------------*/
 #include "stm32l0xx.h"                  // Device header
 #include "Timing.h"
-#include "PWM.h"
+#include "Telemetry.h"
+#include "Deploy.h"
+#include "Timer2.h"
+#include "Profile.h"
+#include "Trace.h"
+#include "ISR_Monitor.h"
+#include "Spin.h"
 /*---------------------------------------Global Variables---------------------------------------------*/
 volatile unsigned int msTicks;															// counts 1ms timeTicks
 unsigned int Start_Timer = 0;														// Start Timer is false
@@ -25,15 +31,60 @@ unsigned int Ticks = 0;																			// Just another msTick
 
 void SysTick_Handler(void){
   msTicks++;
+	ISR_Monitor_Enter(ISR_MONITOR_SYSTICK,SysTick->LOAD - SysTick->VAL);
+	PROFILE_BEGIN(PROFILE_SYSTICK);
+	TRACE_BEGIN(TRACE_SYSTICK,0);
 	
 	if(Start_Timer == 1){
 		Ticks++;
 		if(Ticks > 15000){
-			Servo_Position(170);
+			Deploy_Request(TELEMETRY_DEPLOY_TIMER,Timing_Microseconds());
 			Ticks = 0;
 			Start_Timer = 0;
 		}
 	}
+	
+	TRACE_END(TRACE_SYSTICK,0);
+	PROFILE_END(PROFILE_SYSTICK);
+	ISR_Monitor_Exit(ISR_MONITOR_SYSTICK);
+}
+
+/**
+  \fn          uint32_t Timing_Microseconds(void)
+	\brief       Microseconds from the TIM2 timebase, safe anywhere. Wraps after about 71 minutes,
+							 only use differences, Timer2_Read has all 64 bits.
+*/
+
+uint32_t Timing_Microseconds(void){
+	
+	return(Timer2_Microseconds());
+}
+
+/**
+  \fn          uint32_t Timing_Cycles(void)
+	\brief       Core clock cycles since power on from msTicks and the SysTick counter, safe in
+							 interrupts that preempt SysTick. Wraps after about 134 s at 32MHz, only use differences.
+*/
+
+uint32_t Timing_Cycles(void){
+	
+	/* Local Variables */
+	uint32_t Milliseconds = 0;
+	uint32_t Count = 0;
+	uint32_t Reload = SysTick->LOAD + 1;
+	
+	/* msTicks must not change between the two reads */
+	do{
+		Milliseconds = msTicks;
+		Count = SysTick->VAL;
+	}while(Milliseconds != msTicks);
+	
+	/* SysTick wrapped but its handler hasn't run yet */
+	if(((SCB->ICSR & SCB_ICSR_PENDSTSET_Msk) != 0) && (Count > (Reload/2))){
+		Milliseconds++;
+	}
+	
+	return((Milliseconds*Reload) + (Reload - 1 - Count));
 }
 
 /**
@@ -102,7 +153,9 @@ void Delay (unsigned int dlyTicks){
   unsigned int curTicks;
 
   curTicks = msTicks;
+  SPIN_BEGIN(SPIN_DELAY);
   while ((msTicks - curTicks) < dlyTicks) { __NOP(); }
+  SPIN_END(SPIN_DELAY);
 }
 
 void Start_15s_Timer(void){
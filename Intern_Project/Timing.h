@@ -7,12 +7,18 @@
  * Note(s):
  *----------------------------------------------------------------------------------------------------*/
 
+#include <stdint.h>
+
 #ifndef Timing_H
 #define Timing_H
 
+extern volatile unsigned int msTicks;
+
 extern void SystemCoreClockInit(void);
 extern void Delay (unsigned int dlyTicks);
 extern void Start_15s_Timer(void);
+extern uint32_t Timing_Microseconds(void);
+extern uint32_t Timing_Cycles(void);
 
 #endif
 
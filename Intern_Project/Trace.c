@@ -0,0 +1,155 @@
+/*------------------------------------------------------------------------------------------------------
+ * Name:    Trace.c
+ * Purpose: Timestamped begin, end and instant events in a ring, dumped over USART2
+ * Date: 		10/19/26
+ * Author:	Christopher Jordan - Denny
+ *------------------------------------------------------------------------------------------------------
+ * Note(s): Interrupts, I2C transfers, scheduler tasks and pipeline stages record events with their
+						Timing_Microseconds timestamp, so one timeline shows what preempted what.
+						*	A capture starts with Trace_Start and keeps the first TRACE_SIZE events after it. The
+							serial monitor is far too slow to stream every event, so the ring stops when full
+							rather than overwrite the start of the capture.
+						*	The mask picks the ids to record, SysTick alone fills the ring in 32 ms, a begin
+							and an end event every tick
+						*	Recording is safe from any interrupt, claiming a slot is done with interrupts off
+						*	Trace_Dump sends the capture between the serial monitor text as one packet:
+							
+							Byte		Field
+							0-1			Sync 'T' 'R'
+							2				Events (N)
+							3				Events lost because the ring was full
+							4..			N events of 8 bytes, little endian:
+											Timestamp (4), Type (1), Id (1), Arg (2)
+							end			CRC-16/CCITT of bytes 2 to the end of the events, big endian
+ *----------------------------------------------------------------------------------------------------*/
+
+/*---------------------------------------------Include Statements-------------------------------------*/
+#include "stm32l0xx.h"								// PRIMASK
+#include "Trace.h"
+#include "Timing.h"										// Timing_Microseconds
+#include "Serial.h"										// SER_PutChar
+#include "Telemetry.h"								// Telemetry_CRC16
+/*---------------------------------------------Globals------------------------------------------------*/
+Trace_Event					Trace_Ring[TRACE_SIZE];
+volatile int				Trace_Used = 0;														/* Events in the ring */
+volatile uint32_t		Trace_Mask = 0;														/* Ids being recorded, 0 until started */
+volatile uint8_t		Trace_Lost = 0;														/* Events after the ring filled, stops at 255 */
+/*---------------------------------------------Functions----------------------------------------------*/
+
+/**
+  \fn					void Trace_Start(uint32_t Mask)
+  \brief			Empties the ring and starts a capture
+	\param			uint32_t Mask: Bit per id to record, TRACE_ALL for everything, 0 stops recording
+*/
+
+void Trace_Start(uint32_t Mask){
+	
+	uint32_t Interrupts = __get_PRIMASK();
+	
+	__disable_irq();
+	Trace_Used = 0;
+	Trace_Lost = 0;
+	Trace_Mask = Mask;
+	__set_PRIMASK(Interrupts);
+}
+
+/**
+  \fn					void Trace_Record(uint8_t Type, uint8_t Id, uint16_t Arg)
+  \brief			Adds an event to the capture if its id is being recorded and there is room
+	\param			uint8_t Type: TRACE_BEGIN_EVENT, TRACE_END_EVENT or TRACE_INSTANT_EVENT
+	\param			uint8_t Id: TRACE event id
+	\param			uint16_t Arg: Depends on the id
+*/
+
+void Trace_Record(uint8_t Type, uint8_t Id, uint16_t Arg){
+	
+	/* Local Variables */
+	uint32_t Interrupts = 0;
+	Trace_Event* Event;
+	
+	if((Trace_Mask & (1UL << Id)) == 0){
+		return;
+	}
+	
+	Interrupts = __get_PRIMASK();
+	__disable_irq();
+	
+	if(Trace_Used >= TRACE_SIZE){
+		if(Trace_Lost < 255){
+			Trace_Lost++;
+		}
+		__set_PRIMASK(Interrupts);
+		return;
+	}
+	
+	Event = &Trace_Ring[Trace_Used];
+	Trace_Used++;
+	
+	Event->Timestamp = Timing_Microseconds();
+	Event->Type = Type;
+	Event->Id = Id;
+	Event->Arg = Arg;
+	
+	__set_PRIMASK(Interrupts);
+}
+
+/**
+  \fn					int Trace_Count(void)
+  \brief			Events in the current capture
+	\returns		int: 0 to TRACE_SIZE
+*/
+
+int Trace_Count(void){
+	
+	return(Trace_Used);
+}
+
+/**
+  \fn					void Trace_Dump(void)
+  \brief			Sends the capture over USART2 as one packet and starts a new capture with the same
+							mask. Takes about 0.6 s at 9600 baud with a full ring.
+*/
+
+void Trace_Dump(void){
+	
+	/* Local Variables */
+	uint8_t Bytes[TRACE_RECORD_LENGTH];
+	uint32_t Mask = Trace_Mask;
+	uint16_t CRC = 0xFFFF;
+	int Count = 0;
+	int i = 0;
+	int j = 0;
+	
+	/* Nothing is added while it is sent */
+	Trace_Mask = 0;
+	Count = Trace_Used;
+	
+	Bytes[0] = (uint8_t)Count;
+	Bytes[1] = Trace_Lost;
+	CRC = Telemetry_CRC16(Bytes,2,CRC);
+	SER_PutChar(TRACE_SYNC_1);
+	SER_PutChar(TRACE_SYNC_2);
+	SER_PutChar((char)Bytes[0]);
+	SER_PutChar((char)Bytes[1]);
+	
+	for(i = 0;i < Count;i++){
+		Bytes[0] = (uint8_t)Trace_Ring[i].Timestamp;
+		Bytes[1] = (uint8_t)(Trace_Ring[i].Timestamp >> 8);
+		Bytes[2] = (uint8_t)(Trace_Ring[i].Timestamp >> 16);
+		Bytes[3] = (uint8_t)(Trace_Ring[i].Timestamp >> 24);
+		Bytes[4] = Trace_Ring[i].Type;
+		Bytes[5] = Trace_Ring[i].Id;
+		Bytes[6] = (uint8_t)Trace_Ring[i].Arg;
+		Bytes[7] = (uint8_t)(Trace_Ring[i].Arg >> 8);
+		
+		CRC = Telemetry_CRC16(Bytes,TRACE_RECORD_LENGTH,CRC);
+		for(j = 0;j < TRACE_RECORD_LENGTH;j++){
+			SER_PutChar((char)Bytes[j]);
+		}
+	}
+	
+	SER_PutChar((char)(CRC >> 8));
+	SER_PutChar((char)CRC);
+	
+	Trace_Start(Mask);
+}
@@ -0,0 +1,67 @@
+/*------------------------------------------------------------------------------------------------------
+ * Name:    Trace.h
+ * Purpose: Timestamped begin, end and instant events in a ring, dumped over USART2
+ * Date: 		10/19/26
+ * Author:	Christopher Jordan - Denny
+ *------------------------------------------------------------------------------------------------------
+ * Note(s): See C file for the stream layout, Tools/Trace_Convert.c turns it into a Chrome trace
+ *----------------------------------------------------------------------------------------------------*/
+
+/*-----------------------------------------Include Statements-----------------------------------------*/
+#include <stdint.h>
+
+#ifndef TRACE_H
+#define TRACE_H
+
+/*-----------------------------------------Definitions------------------------------------------------*/
+#define TRACE_ENABLE							1						// 0 compiles the macros out
+#define TRACE_SIZE								64					// Events, power of 2
+#define TRACE_SYNC_1							'T'
+#define TRACE_SYNC_2							'R'
+#define TRACE_RECORD_LENGTH				8						// Bytes per event in the stream
+
+/* Event types */
+#define TRACE_BEGIN_EVENT					0
+#define TRACE_END_EVENT						1
+#define TRACE_INSTANT_EVENT				2
+
+/* Event ids, Tools/Trace_Convert.c has the same list */
+#define TRACE_SYSTICK							0						// Interrupts
+#define TRACE_TIM2								1
+#define TRACE_GPS_UART						2
+#define TRACE_XBEE_UART						3
+#define TRACE_PENDSV							4
+#define TRACE_I2C_READ						5						// Arg: register
+#define TRACE_I2C_WRITE						6						// Arg: register
+#define TRACE_TASK								7						// Arg: scheduler task
+#define TRACE_STAGE								8						// Arg: pipeline stage
+#define TRACE_STALL								9						// Instant, Arg: pipeline stage
+#define TRACE_SPI_DMA							10					// Interrupt, Arg: SPI 1 or 2
+#define TRACE_IDS									11
+#define TRACE_ALL									((1UL << TRACE_IDS) - 1)
+
+/* One event, 8 bytes in the stream */
+typedef struct Trace_Event
+{
+	uint32_t Timestamp;									/* Timing_Microseconds */
+	uint8_t Type;												/* TRACE event type */
+	uint8_t Id;													/* TRACE event id */
+	uint16_t Arg;
+}Trace_Event;
+
+#if TRACE_ENABLE
+#define TRACE_BEGIN(Id,Arg)				Trace_Record(TRACE_BEGIN_EVENT,(Id),(Arg))
+#define TRACE_END(Id,Arg)					Trace_Record(TRACE_END_EVENT,(Id),(Arg))
+#define TRACE_INSTANT(Id,Arg)			Trace_Record(TRACE_INSTANT_EVENT,(Id),(Arg))
+#else
+#define TRACE_BEGIN(Id,Arg)				((void)0)
+#define TRACE_END(Id,Arg)					((void)0)
+#define TRACE_INSTANT(Id,Arg)			((void)0)
+#endif
+
+extern void Trace_Start(uint32_t Mask);
+extern void Trace_Record(uint8_t Type, uint8_t Id, uint16_t Arg);
+extern int Trace_Count(void);
+extern void Trace_Dump(void);
+
+#endif
@@ -0,0 +1,325 @@
+/*------------------------------------------------------------------------------------------------------
+ * Name:    Uplink.c
+ * Purpose: Framed, CRC checked commands from the ground station
+ * Date: 		10/19/26
+ * Author:	Christopher Jordan - Denny
+ *------------------------------------------------------------------------------------------------------
+ * Note(s): The LPUART1 interrupt only pushes bytes into a single producer, single consumer ring and
+						pends PendSV. PendSV runs at the lowest priority right after the interrupt, pulls the
+						bytes out and decodes XBee API frames, AT replies and the commands below. Nothing in
+						the interrupt can overrun a buffer or take longer than a few instructions.
+						
+						Frame Layout:
+						-------------
+						*	0		Sync					UPLINK_SYNC
+						*	1		Length				Bytes from Command to the last argument
+						*	2		Command				See Command_Table
+						*	3		Sequence			Chosen by the ground station, echoed in Uplink_Stats
+						*	4		Arguments			Length - 2 bytes, little endian
+						*	n		CRC						uint16 CRC-16/CCITT of Length..Arguments, see Telemetry_CRC16
+						
+						Latency:
+						--------
+						*	Measured from the interrupt that received the last byte of the frame to the end of the
+							handler, with Timing_Microseconds. Only frames that empty the ring are measured.
+						*	The bound is one PendSV pass over at most UPLINK_RX_SIZE bytes, PendSV is only held
+							off by the GPS and LPUART1 interrupts.
+ *----------------------------------------------------------------------------------------------------*/
+
+/*---------------------------------------------Include Statements-------------------------------------*/
+#include "stm32l053xx.h"							// Specific Device Header
+#include <stdio.h>										// Printf
+#include "Uplink.h"
+#include "Telemetry.h"								// CRC-16
+#include "Telemetry_Scheduler.h"			// Channel rates
+#include "Timing.h"										// Timing_Microseconds
+#include "ISR_Monitor.h"							// PendSV latency
+#include "Events.h"										// Event ACKs
+#include "Deploy.h"										// Parachute
+/*---------------------------------------------Definitions--------------------------------------------*/
+#define UPLINK_RX_SIZE						128						// Receive ring, must be a power of 2
+
+/* Receive states */
+#define RX_SYNC										0
+#define RX_LENGTH									1
+#define RX_BODY										2
+#define RX_CRC_LOW								3
+#define RX_CRC_HIGH								4
+
+/* One command the ground station can send */
+typedef struct Uplink_Command
+{
+	uint8_t Command;
+	uint8_t Length;																/* Argument bytes */
+	void (*Handler)(const uint8_t* Arguments);
+}Uplink_Command;
+/*---------------------------------------------Prototypes---------------------------------------------*/
+static void Uplink_Deploy(const uint8_t* Arguments);
+static void Uplink_Set_Rate(const uint8_t* Arguments);
+static void Uplink_Sensor_Mode(const uint8_t* Arguments);
+static void Uplink_Event_Ack(const uint8_t* Arguments);
+/*---------------------------------------------Tables-------------------------------------------------*/
+static const Uplink_Command Command_Table[] = {
+	{UPLINK_DEPLOY,				1,		Uplink_Deploy},
+	{UPLINK_SET_RATE,			3,		Uplink_Set_Rate},
+	{UPLINK_SENSOR_MODE,	1,		Uplink_Sensor_Mode},
+	{UPLINK_EVENT_ACK,		2,		Uplink_Event_Ack}
+};
+
+/* Channel periods in ms for each sensor mode, 0 is off. BARO, IMU, GPS, ENV, HEALTH */
+static const uint16_t Mode_Periods[3][TELEMETRY_CHANNELS] = {
+	{50,		100,	1000,	5000,	10000},								/* UPLINK_MODE_FLIGHT */
+	{1000,	0,		1000,	5000,	5000},								/* UPLINK_MODE_PAD */
+	{1000,	0,		1000,	0,		10000}								/* UPLINK_MODE_RECOVERY */
+};
+static const uint8_t Mode_Channels[TELEMETRY_CHANNELS] = {
+	TELEMETRY_CHANNEL_BARO,TELEMETRY_CHANNEL_IMU,TELEMETRY_CHANNEL_GPS,TELEMETRY_CHANNEL_ENV,TELEMETRY_CHANNEL_HEALTH
+};
+/*---------------------------------------------Globals------------------------------------------------*/
+uint8_t						RX_Ring[UPLINK_RX_SIZE];
+volatile uint8_t	RX_Head = 0;														/* Written by the LPUART1 interrupt only */
+volatile uint8_t	RX_Tail = 0;														/* Written by PendSV only */
+volatile uint32_t	Last_Byte_Time = 0;											/* Timing_Microseconds of the newest byte */
+Uplink_Stats			Uplink;
+
+/* Frame decoder state, PendSV only */
+uint8_t						Frame[UPLINK_MAX_LENGTH + 1];
+int								Frame_State = RX_SYNC;
+int								Frame_Index = 0;
+uint16_t					Frame_CRC = 0;
+/*---------------------------------------------Functions----------------------------------------------*/
+
+/**
+  \fn					void Uplink_Init(void)
+  \brief			PendSV at the lowest priority so it runs once the interrupts are done
+*/
+
+void Uplink_Init(void){
+	NVIC_SetPriority(PendSV_IRQn,3);
+}
+
+/**
+  \fn					void Uplink_RX_Push(uint8_t Byte)
+  \brief			Called from the LPUART1 interrupt for every received byte
+	\param			uint8_t Byte: The byte
+*/
+
+void Uplink_RX_Push(uint8_t Byte){
+	
+	uint8_t Head = RX_Head;
+	uint8_t Next = (uint8_t)((Head + 1) & (UPLINK_RX_SIZE - 1));
+	
+	if(Next == RX_Tail){
+		Uplink.Overruns++;
+	}
+	else{
+		RX_Ring[Head] = Byte;
+		RX_Head = Next;
+	}
+	
+	Last_Byte_Time = Timing_Microseconds();
+	ISR_Monitor_Pend(ISR_MONITOR_PENDSV);
+	SCB->ICSR = SCB_ICSR_PENDSVSET_Msk;
+}
+
+/**
+  \fn					int Uplink_RX_Pop(uint8_t* Byte)
+  \brief			Takes the oldest byte out of the receive ring, PendSV only
+	\param			uint8_t* Byte: The byte
+	\returns		int: 1 if there was a byte, 0 if the ring is empty
+*/
+
+int Uplink_RX_Pop(uint8_t* Byte){
+	
+	uint8_t Tail = RX_Tail;
+	
+	if(Tail == RX_Head){
+		return(0);
+	}
+	
+	*Byte = RX_Ring[Tail];
+	RX_Tail = (uint8_t)((Tail + 1) & (UPLINK_RX_SIZE - 1));
+	
+	return(1);
+}
+
+/**
+  \fn					void Uplink_Dispatch(void)
+  \brief			Runs the handler of a frame that passed its CRC
+*/
+
+static void Uplink_Dispatch(void){
+	
+	/* Local Variables */
+	uint8_t Length = Frame[0];
+	uint32_t Latency = 0;
+	unsigned int i = 0;
+	
+	for(i = 0;i < (sizeof(Command_Table)/sizeof(Command_Table[0]));i++){
+		if(Command_Table[i].Command == Frame[1]){
+			break;
+		}
+	}
+	
+	if((i == (sizeof(Command_Table)/sizeof(Command_Table[0]))) || ((Length - 2) != Command_Table[i].Length)){
+		Uplink.Rejected++;
+		return;
+	}
+	
+	Command_Table[i].Handler(&Frame[3]);
+	Uplink.Commands++;
+	Uplink.Last_Sequence = Frame[2];
+	
+	/* A newer byte would make the stamp wrong */
+	if(RX_Tail == RX_Head){
+		Latency = Timing_Microseconds() - Last_Byte_Time;
+		Uplink.Last_Latency = Latency;
+		if(Latency > Uplink.Max_Latency){
+			Uplink.Max_Latency = Latency;
+		}
+	}
+}
+
+/**
+  \fn					void Uplink_Receive_Byte(uint8_t Byte)
+  \brief			Command frame decoder, fed from PendSV with transparent bytes or API RX payloads
+	\param			uint8_t Byte: Next byte from the ground station
+*/
+
+void Uplink_Receive_Byte(uint8_t Byte){
+	
+	switch(Frame_State){
+		
+		case RX_SYNC:
+			if(Byte == UPLINK_SYNC){
+				Frame_State = RX_LENGTH;
+			}
+			break;
+		
+		case RX_LENGTH:
+			if((Byte < 2) || (Byte > UPLINK_MAX_LENGTH)){
+				Frame_State = (Byte == UPLINK_SYNC) ? RX_LENGTH : RX_SYNC;
+			}
+			else{
+				Frame[0] = Byte;
+				Frame_Index = 1;
+				Frame_State = RX_BODY;
+			}
+			break;
+		
+		case RX_BODY:
+			Frame[Frame_Index++] = Byte;
+			if(Frame_Index > Frame[0]){
+				Frame_State = RX_CRC_LOW;
+			}
+			break;
+		
+		case RX_CRC_LOW:
+			Frame_CRC = Byte;
+			Frame_State = RX_CRC_HIGH;
+			break;
+		
+		case RX_CRC_HIGH:
+			Frame_CRC |= (uint16_t)(Byte << 8);
+			if(Frame_CRC == Telemetry_CRC16(Frame,Frame[0] + 1,0xFFFF)){
+				Uplink_Dispatch();
+			}
+			else{
+				Uplink.CRC_Errors++;
+			}
+			Frame_State = RX_SYNC;
+			break;
+		
+		default:
+			Frame_State = RX_SYNC;
+			break;
+	}
+}
+
+/**
+  \fn					void Uplink_Deploy(const uint8_t* Arguments)
+  \brief			Deploys the parachute, the servo moves before this returns
+*/
+
+static void Uplink_Deploy(const uint8_t* Arguments){
+	if(Arguments[0] == UPLINK_DEPLOY_KEY){
+		Deploy_Request(TELEMETRY_DEPLOY_UPLINK,Last_Byte_Time);
+	}
+}
+
+/**
+  \fn					void Uplink_Set_Rate(const uint8_t* Arguments)
+  \brief			Changes how often the channels are sent, 0 turns them off
+*/
+
+static void Uplink_Set_Rate(const uint8_t* Arguments){
+	
+	uint16_t Period = (uint16_t)(Arguments[1] | (Arguments[2] << 8));
+	int i = 0;
+	
+	for(i = 0;i < TELEMETRY_CHANNELS;i++){
+		if(Arguments[0] & Mode_Channels[i]){
+			Telemetry_Scheduler_Set_Period(Mode_Channels[i],Period);
+		}
+	}
+}
+
+/**
+  \fn					void Uplink_Sensor_Mode(const uint8_t* Arguments)
+  \brief			Picks which sensors are read and how often
+*/
+
+static void Uplink_Sensor_Mode(const uint8_t* Arguments){
+	
+	int i = 0;
+	
+	if(Arguments[0] > UPLINK_MODE_RECOVERY){
+		Uplink.Rejected++;
+		return;
+	}
+	
+	for(i = 0;i < TELEMETRY_CHANNELS;i++){
+		Telemetry_Scheduler_Set_Period(Mode_Channels[i],Mode_Periods[Arguments[0]][i]);
+	}
+}
+
+/**
+  \fn					void Uplink_Event_Ack(const uint8_t* Arguments)
+  \brief			Selective ACK of the events the ground station has
+*/
+
+static void Uplink_Event_Ack(const uint8_t* Arguments){
+	Events_Ack(Arguments[0],Arguments[1],msTicks);
+}
+
+/**
+  \fn					Uplink_Stats* Uplink_Get_Stats(void)
+  \brief			Retrieves the receive counters and latency
+	\returns		Uplink_Stats*: The counters
+*/
+
+Uplink_Stats* Uplink_Get_Stats(void){
+	return(&Uplink);
+}
+
+/**
+  \fn					void Uplink_Report(void)
+  \brief			Prints the receive counters and command latency on the serial monitor
+*/
+
+void Uplink_Report(void){
+	
+	/* Local Variables */
+	Uplink_Stats Copy;
+	uint32_t Mask = __get_PRIMASK();
+	
+	/* PendSV updates them */
+	__disable_irq();
+	Copy = Uplink;
+	__set_PRIMASK(Mask);
+	
+	printf("Uplink: %lu commands (last #%u), %lu CRC errors, %lu rejected, %lu overruns, latency %lu us (max %lu us)\r\n",
+		(unsigned long)Copy.Commands,(unsigned int)Copy.Last_Sequence,(unsigned long)Copy.CRC_Errors,
+		(unsigned long)Copy.Rejected,(unsigned long)Copy.Overruns,(unsigned long)Copy.Last_Latency,
+		(unsigned long)Copy.Max_Latency);
+}
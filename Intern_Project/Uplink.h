@@ -0,0 +1,52 @@
+/*------------------------------------------------------------------------------------------------------
+ * Name:    Uplink.h
+ * Purpose: Framed, CRC checked commands from the ground station
+ * Date: 		10/19/26
+ * Author:	Christopher Jordan - Denny
+ *------------------------------------------------------------------------------------------------------
+ * Note(s): See C file for the frame layout and commands
+ *----------------------------------------------------------------------------------------------------*/
+
+/*-----------------------------------------Include Statements-----------------------------------------*/
+#include <stdint.h>
+
+#ifndef UPLINK_H
+#define UPLINK_H
+
+/*-----------------------------------------Frame Constants--------------------------------------------*/
+#define UPLINK_SYNC								0xA5					// First byte of every command
+#define UPLINK_MAX_LENGTH					16						// Command, sequence and arguments
+
+/* Commands */
+#define UPLINK_DEPLOY							0x01					// Args: UPLINK_DEPLOY_KEY
+#define UPLINK_SET_RATE						0x02					// Args: channel bits, period ms (uint16)
+#define UPLINK_SENSOR_MODE				0x03					// Args: UPLINK_MODE value
+#define UPLINK_EVENT_ACK					0x04					// Args: expected event sequence, received bits, see Events.c
+
+#define UPLINK_DEPLOY_KEY					0x5A					// Stops a corrupted frame from deploying
+
+/* Sensor modes */
+#define UPLINK_MODE_FLIGHT				0							// Every channel at its full rate
+#define UPLINK_MODE_PAD						1							// Slow barometer, no IMU
+#define UPLINK_MODE_RECOVERY			2							// GPS and health for finding the rocket
+
+/* Receive counters */
+typedef struct Uplink_Stats
+{
+	uint32_t Commands;									/* Commands dispatched */
+	uint32_t CRC_Errors;								/* Frames dropped for a bad CRC */
+	uint32_t Rejected;									/* Unknown command or wrong length */
+	uint32_t Overruns;									/* Bytes lost with the receive ring full */
+	uint8_t Last_Sequence;							/* Sequence of the newest command */
+	uint32_t Last_Latency;							/* us from the last byte to the action */
+	uint32_t Max_Latency;
+}Uplink_Stats;
+
+extern void Uplink_Init(void);
+extern void Uplink_RX_Push(uint8_t Byte);
+extern int Uplink_RX_Pop(uint8_t* Byte);
+extern void Uplink_Receive_Byte(uint8_t Byte);
+extern Uplink_Stats* Uplink_Get_Stats(void);
+extern void Uplink_Report(void);
+
+#endif
@@ -17,8 +17,15 @@
 #include "string.h"						//String functions
 #include "Serial.h"						//Printf function
 #include "Timing.h"						//Delay function
-#include "PWM.h"							//To control the Servo for parachute deployment
 #include "XBeePro24.h"
+#include "XBee_API.h"					//API frame decoder
+#include "Uplink.h"						//Receive ring and ground station commands
+#include "EEPROM.h"						//Hash of the applied settings
+#include "Profile.h"					//Interrupt cycles
+#include "Trace.h"						//Event timeline
+#include "ISR_Monitor.h"			//Interrupt latency and budget
+#include "Spin.h"						//Busy wait accounting
+#include "Arena.h"						//Reply line buffers
 /*---------------------------------XBee Commands----------------------------------------------------------------------*/
 /* Prefix(AT) + ASCII Command + Space(Optional) + Parameter(Optional,HEX) + Carridge Return */
 #define ENTER_AT_COMMAND_MODE					"+++"					//Enter three plus characters within 1s there is no \r on purpose
@@ -35,45 +42,267 @@
 #define READ_ATID											"ATID\r"			//Read ID register
 #define READ_ATDH											"ATDH\r"			//Read DH register
 #define READ_ATDL											"ATDL\r"			//Read DL register
-#define READ_ATCH											"ADCH\r"			//Read CH register
+#define READ_ATCH											"ATCH\r"			//Read CH register
+#define READ_ATHP											"ATHP\r"			//Read HP register
 /*---------------------------------XBee 900HP Commands----------------------------------------------------------------*/
 #define SET_DESTINATION_H							"ATDH 13A200\r"	//Specific Serial Address of Matt's XBee
 #define SET_DESTINATION_L							"ATDL 40E35DC2\r"	//Specific Serial Address of Matt's Xbee
 #define SET_ATHP											"ATHP 5\r"				//The preamble ID, must be the same for XBee's to communicate
+#define SET_ATBR											"ATBR 1\r"				//200 kbps RF data rate, the ground XBee must match
+#define SET_ATBD_FAST									"ATBD 7\r"				//115200 baud interface
+#define SET_ATBD_DEFAULT							"ATBD 3\r"				//9600 baud interface
+#define SET_ATAP											"ATAP 1\r"				//API mode without escaping
 /*---------------------------------More defines-----------------------------------------------------------------------*/
 #define TRUE	1;
 #define FALSE 0;
 #define PCLK	32000000									// Peripheral Clock
 #define BAUD	9600											// Baud rate
+#define FAST_BAUD	115200								// Baud rate once XBee_900HP_Steps sets ATBD 7
+#define GUARD_TIME	1000								// ms of silence around +++
+#define OK_TIMEOUT	1500								// ms to wait for an OK before giving up
+#define AT_TIMEOUT	500									// ms to wait for the OK to a command
+#define TX_SIZE	512										// Transmit ring size, must be a power of 2
 /*---------------------------------Globals----------------------------------------------------------------------------*/
-char 										RX_Data[33] = 				"";				//Rx
+char* 									RX_Data = 						0;				//Rx, in the arena
 uint8_t 								ChIndex =							0;				//Character Index
-char 										XBee_Message[33] = 		"";				//Message Recieved by the XBee
+char* 									XBee_Message = 				0;				//Message Recieved by the XBee, in the arena
 static const char				OK[] = 								"OK";			//When data has been written XBee will send an OK
-uint8_t									Device_Ack_Flag = 		FALSE;		//XBee OK acknowledge
-uint8_t									XBee_Ready_To_Read = 	FALSE;		//XBee data ready
+volatile uint8_t				Device_Ack_Flag = 		FALSE;		//XBee OK acknowledge
+volatile uint8_t				XBee_Ready_To_Read = 	FALSE;		//XBee data ready
+uint8_t									TX_Ring[TX_SIZE];								//Bytes waiting for the transmitter
+volatile uint16_t				TX_Head = 						0;				//Next free byte, written by LPUART1_Submit
+volatile uint16_t				TX_Tail = 						0;				//Next byte to send, written by the interrupt
+
+/* AT command sequence state, see XBee_Config_Poll */
+const XBee_Step*				Config_Steps;
+int											Config_Index = 				0;
+int											Config_Sent = 				0;
+int											Config_Attempts = 		0;
+int											Config_Status = 			XBEE_CONFIG_DONE;
+uint32_t								Config_Start = 				0;
+uint32_t								Config_Step_Start = 	0;
+uint32_t								Config_Time = 				0;
+uint32_t								Config_Hash = 				0;				//Hash of the settings being applied
+int											Config_Dirty = 				0;				//A setting differed, ATWR needed
+char										Config_Reply[16] = 		"";				//Last reply to a read
+/*--------------------------------Step Names------------------------------------------------------------------------*/
+/* Branch targets in the tables below, in table order */
+typedef enum XBee_900HP_Step_Names
+{
+	XBEE_900HP_GUARD					= 0,
+	XBEE_900HP_ENTER					= 1,
+	XBEE_900HP_READ_SERIAL				= 2,
+	XBEE_900HP_HASH						= 3,
+	XBEE_900HP_CHECK_DH					= 4,
+	XBEE_900HP_SET_DH					= 5,
+	XBEE_900HP_CHECK_DL					= 6,
+	XBEE_900HP_SET_DL					= 7,
+	XBEE_900HP_CHECK_ID					= 8,
+	XBEE_900HP_SET_ID					= 9,
+	XBEE_900HP_CHECK_HP					= 10,
+	XBEE_900HP_SET_HP					= 11,
+	XBEE_900HP_SAVE						= 12,
+	XBEE_900HP_SET_BR					= 13,
+	XBEE_900HP_SET_BD_FAST				= 14,
+	XBEE_900HP_EXIT						= 15,
+	XBEE_900HP_BAUD_FAST				= 16,
+	XBEE_900HP_FAST_GUARD				= 17,
+	XBEE_900HP_FAST_ENTER				= 18,
+	XBEE_900HP_FAST_SET_AP				= 19,
+	XBEE_900HP_FAST_EXIT				= 20,
+	XBEE_900HP_FAST_API					= 21,
+	XBEE_900HP_FAST_DONE				= 22,
+	XBEE_900HP_RETRY_GUARD				= 23,
+	XBEE_900HP_RETRY_ENTER				= 24,
+	XBEE_900HP_SET_BD_DEFAULT			= 25,
+	XBEE_900HP_DEFAULT_SET_AP			= 26,
+	XBEE_900HP_DEFAULT_EXIT				= 27,
+	XBEE_900HP_BAUD_DEFAULT				= 28,
+	XBEE_900HP_DEFAULT_API				= 29,
+	XBEE_900HP_DEFAULT_DONE				= 30,
+	XBEE_900HP_SLOW_BAUD				= 31,
+	XBEE_900HP_SLOW_GUARD				= 32,
+	XBEE_900HP_SLOW_ENTER				= 33,
+	XBEE_900HP_SLOW_JUMP				= 34,
+	XBEE_900HP_PROBE_BAUD				= 35,
+	XBEE_900HP_PROBE_GUARD				= 36,
+	XBEE_900HP_PROBE_ENTER				= 37,
+	XBEE_900HP_PROBE_JUMP				= 38,
+	XBEE_900HP_STEP_COUNT				= 39
+}XBee_900HP_Step_Names;
+
+typedef enum XBee_ProS1_Step_Names
+{
+	XBEE_PROS1_GUARD					= 0,
+	XBEE_PROS1_ENTER					= 1,
+	XBEE_PROS1_READ_SERIAL				= 2,
+	XBEE_PROS1_HASH						= 3,
+	XBEE_PROS1_CHECK_MY					= 4,
+	XBEE_PROS1_SET_MY					= 5,
+	XBEE_PROS1_CHECK_ID					= 6,
+	XBEE_PROS1_SET_ID					= 7,
+	XBEE_PROS1_CHECK_DH					= 8,
+	XBEE_PROS1_SET_DH					= 9,
+	XBEE_PROS1_CHECK_DL					= 10,
+	XBEE_PROS1_SET_DL					= 11,
+	XBEE_PROS1_CHECK_CH					= 12,
+	XBEE_PROS1_SET_CH					= 13,
+	XBEE_PROS1_SAVE						= 14,
+	XBEE_PROS1_EXIT						= 15,
+	XBEE_PROS1_DONE						= 16,
+	XBEE_PROS1_STEP_COUNT				= 17
+}XBee_ProS1_Step_Names;
+/*--------------------------------AT Command Sequences----------------------------------------------------------------*/
+/*
+ * Each setting is read first and only written if it differs, and ATWR only runs if one did.
+ * The settings and the radio's serial number are hashed into the data EEPROM once applied,
+ * when the hash matches on the next boot none of them are read at all.
+ * Nothing after ATWR is saved, so the radio always powers up transparent at 9600 baud.
+ * The interface rate and API mode take effect on ATCN, then +++ at 115200 checks the link.
+ * If that gets no answer +++ is tried at 115200 once more and then at 9600, and whichever
+ * answers puts ATBD back before API mode goes on, so the link ends up at 9600 either way.
+ * A reset of the micro alone leaves the radio at 115200, so no OK at 9600 tries 115200 too.
+ */
+const XBee_Step XBee_900HP_Steps[] = {
+	/*	Action								Command										Timeout				Retries		Branch							Expected */
+	{XBEE_STEP_GUARD,				0,												GUARD_TIME,		0,				XBEE_STEP_ABORT,		0},						/* 0 */
+	{XBEE_STEP_COMMAND,			ENTER_AT_COMMAND_MODE,		OK_TIMEOUT,		1,				XBEE_900HP_PROBE_BAUD,		0},						/* 1 */
+	{XBEE_STEP_READ,				READ_SERIAL_ADDRESS_LOW,	AT_TIMEOUT,		1,				XBEE_900HP_CHECK_DH,			0},						/* 2 */
+	{XBEE_STEP_HASH,				0,												0,						0,				XBEE_900HP_SET_BR,				0},						/* 3 */
+	{XBEE_STEP_CHECK,				READ_ATDH,								AT_TIMEOUT,		1,				0,									"13A200"},		/* 4 Serial Address of matt's xbee */
+	{XBEE_STEP_COMMAND,			SET_DESTINATION_H,				AT_TIMEOUT,		2,				XBEE_STEP_ABORT,		0},						/* 5 */
+	{XBEE_STEP_CHECK,				READ_ATDL,								AT_TIMEOUT,		1,				0,									"40E35DC2"},	/* 6 */
+	{XBEE_STEP_COMMAND,			SET_DESTINATION_L,				AT_TIMEOUT,		2,				XBEE_STEP_ABORT,		0},						/* 7 */
+	{XBEE_STEP_CHECK,				READ_ATID,								AT_TIMEOUT,		1,				0,									"3001"},			/* 8 PAN = 3001 */
+	{XBEE_STEP_COMMAND,			SET_ATID,									AT_TIMEOUT,		2,				XBEE_STEP_ABORT,		0},						/* 9 */
+	{XBEE_STEP_CHECK,				READ_ATHP,								AT_TIMEOUT,		1,				0,									"5"},					/* 10 HP = 5 */
+	{XBEE_STEP_COMMAND,			SET_ATHP,									AT_TIMEOUT,		2,				XBEE_STEP_ABORT,		0},						/* 11 */
+	{XBEE_STEP_SAVE,				SAVE_SETTINGS,						OK_TIMEOUT,		1,				XBEE_STEP_ABORT,		0},						/* 12 */
+	{XBEE_STEP_COMMAND,			SET_ATBR,									AT_TIMEOUT,		1,				XBEE_900HP_SET_BD_FAST,		0},						/* 13 200 kbps RF if supported */
+	{XBEE_STEP_COMMAND,			SET_ATBD_FAST,						AT_TIMEOUT,		1,				XBEE_900HP_DEFAULT_SET_AP,	0},						/* 14 Stay at 9600 if refused */
+	{XBEE_STEP_COMMAND,			EXIT_AT_COMMAND_MODE,			AT_TIMEOUT,		1,				XBEE_STEP_ABORT,		0},						/* 15 */
+	{XBEE_STEP_BAUD_FAST,		0,												0,						0,				XBEE_STEP_ABORT,		0},						/* 16 */
+	{XBEE_STEP_GUARD,				0,												GUARD_TIME,		0,				XBEE_STEP_ABORT,		0},						/* 17 */
+	{XBEE_STEP_COMMAND,			ENTER_AT_COMMAND_MODE,		OK_TIMEOUT,		0,				XBEE_900HP_RETRY_GUARD,		0},						/* 18 Verify 115200 */
+	{XBEE_STEP_COMMAND,			SET_ATAP,									AT_TIMEOUT,		1,				XBEE_STEP_ABORT,		0},						/* 19 */
+	{XBEE_STEP_COMMAND,			EXIT_AT_COMMAND_MODE,			AT_TIMEOUT,		1,				XBEE_STEP_ABORT,		0},						/* 20 */
+	{XBEE_STEP_API,					0,												0,						0,				XBEE_STEP_ABORT,		0},						/* 21 */
+	{XBEE_STEP_DONE,				0,												0,						0,				XBEE_STEP_ABORT,		0},						/* 22 */
+	{XBEE_STEP_GUARD,				0,												GUARD_TIME,		0,				XBEE_STEP_ABORT,		0},						/* 23 No answer, try 115200 again */
+	{XBEE_STEP_COMMAND,			ENTER_AT_COMMAND_MODE,		OK_TIMEOUT,		1,				XBEE_900HP_SLOW_BAUD,			0},						/* 24 */
+	{XBEE_STEP_COMMAND,			SET_ATBD_DEFAULT,					AT_TIMEOUT,		1,				XBEE_STEP_ABORT,		0},						/* 25 */
+	{XBEE_STEP_COMMAND,			SET_ATAP,									AT_TIMEOUT,		1,				XBEE_STEP_ABORT,		0},						/* 26 */
+	{XBEE_STEP_COMMAND,			EXIT_AT_COMMAND_MODE,			AT_TIMEOUT,		1,				XBEE_STEP_ABORT,		0},						/* 27 9600 from here */
+	{XBEE_STEP_BAUD_DEFAULT,0,												0,						0,				XBEE_STEP_ABORT,		0},						/* 28 */
+	{XBEE_STEP_API,					0,												0,						0,				XBEE_STEP_ABORT,		0},						/* 29 */
+	{XBEE_STEP_DONE,				0,												0,						0,				XBEE_STEP_ABORT,		0},						/* 30 */
+	{XBEE_STEP_BAUD_DEFAULT,0,												0,						0,				XBEE_STEP_ABORT,		0},						/* 31 ATBD 7 never took */
+	{XBEE_STEP_GUARD,				0,												GUARD_TIME,		0,				XBEE_STEP_ABORT,		0},						/* 32 */
+	{XBEE_STEP_COMMAND,			ENTER_AT_COMMAND_MODE,		OK_TIMEOUT,		1,				XBEE_STEP_ABORT,		0},						/* 33 */
+	{XBEE_STEP_JUMP,				0,												0,						0,				XBEE_900HP_SET_BD_DEFAULT,	0},						/* 34 */
+	{XBEE_STEP_BAUD_FAST,		0,												0,						0,				XBEE_STEP_ABORT,		0},						/* 35 Only the micro reset, radio still at 115200 */
+	{XBEE_STEP_GUARD,				0,												GUARD_TIME,		0,				XBEE_STEP_ABORT,		0},						/* 36 */
+	{XBEE_STEP_COMMAND,			ENTER_AT_COMMAND_MODE,		OK_TIMEOUT,		1,				XBEE_STEP_ABORT,		0},						/* 37 */
+	{XBEE_STEP_JUMP,				0,												0,						0,				XBEE_900HP_READ_SERIAL,		0}						/* 38 */
+};
+
+const XBee_Step XBee_ProS1_Steps[] = {
+	/*	Action								Command										Timeout				Retries		Branch							Expected */
+	{XBEE_STEP_GUARD,				0,												GUARD_TIME,		0,				XBEE_STEP_ABORT,		0},						/* 0 */
+	{XBEE_STEP_COMMAND,			ENTER_AT_COMMAND_MODE,		OK_TIMEOUT,		1,				XBEE_STEP_ABORT,		0},						/* 1 */
+	{XBEE_STEP_READ,				READ_SERIAL_ADDRESS_LOW,	AT_TIMEOUT,		1,				XBEE_PROS1_CHECK_MY,			0},						/* 2 */
+	{XBEE_STEP_HASH,				0,												0,						0,				XBEE_PROS1_EXIT,					0},						/* 3 */
+	{XBEE_STEP_CHECK,				READ_ATMY,								AT_TIMEOUT,		1,				0,									"2"},					/* 4 MY address = 2 */
+	{XBEE_STEP_COMMAND,			SET_ATMY,									AT_TIMEOUT,		2,				XBEE_STEP_ABORT,		0},						/* 5 */
+	{XBEE_STEP_CHECK,				READ_ATID,								AT_TIMEOUT,		1,				0,									"3001"},			/* 6 PAN = 3001 */
+	{XBEE_STEP_COMMAND,			SET_ATID,									AT_TIMEOUT,		2,				XBEE_STEP_ABORT,		0},						/* 7 */
+	{XBEE_STEP_CHECK,				READ_ATDH,								AT_TIMEOUT,		1,				0,									"0"},					/* 8 */
+	{XBEE_STEP_COMMAND,			SET_ATDH,									AT_TIMEOUT,		2,				XBEE_STEP_ABORT,		0},						/* 9 */
+	{XBEE_STEP_CHECK,				READ_ATDL,								AT_TIMEOUT,		1,				0,									"1"},					/* 10 */
+	{XBEE_STEP_COMMAND,			SET_ATDL,									AT_TIMEOUT,		2,				XBEE_STEP_ABORT,		0},						/* 11 */
+	{XBEE_STEP_CHECK,				READ_ATCH,								AT_TIMEOUT,		1,				0,									"C"},					/* 12 Channel */
+	{XBEE_STEP_COMMAND,			SET_ATCH,									AT_TIMEOUT,		2,				XBEE_STEP_ABORT,		0},						/* 13 */
+	{XBEE_STEP_SAVE,				SAVE_SETTINGS,						OK_TIMEOUT,		1,				XBEE_STEP_ABORT,		0},						/* 14 */
+	{XBEE_STEP_COMMAND,			EXIT_AT_COMMAND_MODE,			AT_TIMEOUT,		1,				XBEE_STEP_ABORT,		0},						/* 15 */
+	{XBEE_STEP_DONE,				0,												0,						0,				XBEE_STEP_ABORT,		0}						/* 16 */
+};
+
+/* The names above have to follow the tables */
+typedef char XBee_900HP_Steps_Named[(sizeof(XBee_900HP_Steps)/sizeof(XBee_Step) == XBEE_900HP_STEP_COUNT) ? 1 : -1];
+typedef char XBee_ProS1_Steps_Named[(sizeof(XBee_ProS1_Steps)/sizeof(XBee_Step) == XBEE_PROS1_STEP_COUNT) ? 1 : -1];
 /*--------------------------------Struct Initialize-------------------------------------------------------------------*/
 AT_Data AT;
 /*--------------------------------Functions---------------------------------------------------------------------------*/
 
 /**
 	\fn			void RNG_LPUART1_IRQHandler(void)
-	\brief	Global interrupt handler for LPUART, Currently only handles RX
+	\brief	Global interrupt handler for LPUART, queues received bytes and drains the transmit ring
 */
 
 void RNG_LPUART1_IRQHandler(void){
+	
+	ISR_Monitor_Enter(ISR_MONITOR_XBEE_UART,ISR_MONITOR_NO_LATENCY);
+	PROFILE_BEGIN(PROFILE_XBEE_UART);
+	TRACE_BEGIN(TRACE_XBEE_UART,0);
+	
+	/* A byte came before the last one was read, left set it would keep interrupting */
+	if(LPUART1->ISR & USART_ISR_ORE){
+		LPUART1->ICR = USART_ICR_ORECF;
+		ISR_Monitor_Overrun(ISR_MONITOR_XBEE_UART);
+	}
+	
+	/* Transmit register empty, send the next queued byte */
+	if(((LPUART1->CR1 & USART_CR1_TXEIE) != 0) && ((LPUART1->ISR & USART_ISR_TXE) == USART_ISR_TXE)){
+		if(TX_Tail != TX_Head){
+			LPUART1->TDR = TX_Ring[TX_Tail];
+			TX_Tail = (TX_Tail + 1) & (TX_SIZE - 1);
+		}
+		else{
+			LPUART1->CR1 &= ~USART_CR1_TXEIE;
+		}
+	}
+	
+	/* Receive, the byte is decoded in PendSV_Handler */
 	if((LPUART1->ISR & USART_ISR_RXNE) == USART_ISR_RXNE){
+		Uplink_RX_Push((uint8_t)LPUART1->RDR);
+	}
+	
+	TRACE_END(TRACE_XBEE_UART,0);
+	PROFILE_END(PROFILE_XBEE_UART);
+	ISR_Monitor_Exit(ISR_MONITOR_XBEE_UART);
+}
+
+/**
+	\fn			void PendSV_Handler(void)
+	\brief	Decodes the bytes the LPUART1 interrupt received, runs at the lowest priority
+*/
+
+void PendSV_Handler(void){
+	
+	uint8_t Byte = 0;
+	
+	ISR_Monitor_Enter(ISR_MONITOR_PENDSV,ISR_MONITOR_NO_LATENCY);
+	PROFILE_BEGIN(PROFILE_PENDSV);
+	TRACE_BEGIN(TRACE_PENDSV,0);
+	
+	while(Uplink_RX_Pop(&Byte)){
+		
+		/* Frames are decoded byte by byte once the radio is in API mode */
+		if(XBee_API_Get_Mode() != XBEE_API_MODE_OFF){
+			XBee_API_Receive_Byte(Byte);
+			continue;
+		}
 		
-		/* Read RX Data */
-		RX_Data[ChIndex] = LPUART1->RDR;
+		/* Ground station commands in transparent mode */
+		Uplink_Receive_Byte(Byte);
 		
-		/* Check for parachute deployment signal */
-		if(RX_Data[ChIndex] == '!'){
-			Servo_Position(180);
+		/* AT command replies, long lines are cut short rather than overrun RX_Data */
+		if(ChIndex < (ARENA_XBEE_LINE - 1)){
+			RX_Data[ChIndex] = (char)Byte;
 		}
 		
 		/* Check for end of recieved data */
-		if(RX_Data[ChIndex] == '\r'){
+		if(Byte == '\r'){
 			
 			/* Compare string to OK to see if Acknowledged */
 			if(strncmp(OK,RX_Data,(sizeof(OK)-1)) == 0){
@@ -88,10 +317,14 @@ void RNG_LPUART1_IRQHandler(void){
 			
 			/* Clear RX_Data */
 			ChIndex = 0;
-			memset(RX_Data,0,sizeof(RX_Data));
+			memset(RX_Data,0,ARENA_XBEE_LINE);
 			
-		}else ChIndex++;
+		}else if(ChIndex < (ARENA_XBEE_LINE - 1)) ChIndex++;
 	}
+	
+	TRACE_END(TRACE_PENDSV,0);
+	PROFILE_END(PROFILE_PENDSV);
+	ISR_Monitor_Exit(ISR_MONITOR_PENDSV);
 }
 
 /**
@@ -104,15 +337,21 @@ void LPUART_Init(void){
 	RCC->IOPENR   |=   RCC_IOPENR_GPIOCEN;			/* Enable GPIOB clock */
 	RCC->APB1ENR  |=   RCC_APB1ENR_LPUART1EN;   /* Enable LP USART#1 clock */
 	
+	/* Reply lines, before PendSV can use them */
+	if(RX_Data == 0){
+		RX_Data = Arena_Alloc("XBee line",ARENA_XBEE_LINE);
+		XBee_Message = Arena_Alloc("XBee reply",ARENA_XBEE_LINE);
+	}
+	
 	//interrupt init
 	NVIC_EnableIRQ(RNG_LPUART1_IRQn);
-	NVIC_SetPriority(RNG_LPUART1_IRQn,1);
+	NVIC_SetPriority(RNG_LPUART1_IRQn,0);			/* Deploy commands must not wait behind the GPS */
 	
 	//Configure PC10 to LPUSART1_TX, PC11 to LPUSART1_RX,PC10 and PC11 TX,RX AF0 by default
   GPIOC->MODER  &= ~(( 3ul << 2* 10) | ( 3ul << 2* 11) );		/* Set to 0 */
   GPIOC->MODER  |=  (( 2ul << 2* 10) | ( 2ul << 2* 11) );		/* Set to alternate function mode */
 	
-	LPUART1->BRR  	= (unsigned long)((256.0f/BAUD)*PCLK); 		/* 9600 baud @ 32MHz */
+	LPUART1_Set_Baud(BAUD);																		/* 9600 baud @ 32MHz */
   LPUART1->CR3    = 0x0000;																	/* no flow control */
 	LPUART1->CR2    = 0x0000;																	/* 1 stop bit */
 	
@@ -124,22 +363,106 @@ void LPUART_Init(void){
 										
 }
 
+/**
+	\fn				void LPUART1_Set_Baud(uint32_t Baud)
+	\brief		Changes the LPUART1 baud rate once everything queued has been sent
+	\param		uint32_t Baud: New baud rate, BRR = 256*PCLK/Baud
+*/
+
+void LPUART1_Set_Baud(uint32_t Baud){
+	
+	/* Let the transmit ring drain first */
+	if((LPUART1->CR1 & USART_CR1_UE) != 0){
+		SPIN_BEGIN(SPIN_LPUART1_TX);
+		while(LPUART1_TX_Idle() == 0){
+			//Nop
+		}
+		SPIN_END(SPIN_LPUART1_TX);
+	}
+	
+	/* BRR can only be written with the LPUART disabled */
+	LPUART1->CR1 &= ~USART_CR1_UE;
+	LPUART1->BRR = (uint32_t)((((uint64_t)PCLK << 8) + (Baud/2)) / Baud);
+	LPUART1->CR1 |= USART_CR1_UE;
+}
+
+/**
+	\fn				int LPUART1_TX_Free(void)
+	\brief		Space left in the transmit ring
+	\returns 	int: Bytes that can be queued without blocking
+*/
+
+int LPUART1_TX_Free(void){
+	return((TX_SIZE - 1) - ((TX_Head - TX_Tail) & (TX_SIZE - 1)));
+}
+
+/**
+	\fn				int LPUART1_TX_Idle(void)
+	\brief		Checks if everything queued has left the transmitter
+	\returns 	int: 1 when the ring is empty and the last stop bit is out
+*/
+
+int LPUART1_TX_Idle(void){
+	return((TX_Tail == TX_Head) && ((LPUART1->ISR & USART_ISR_TC) == USART_ISR_TC));
+}
+
+/**
+	\fn				int LPUART1_Submit(const LPUART1_Segment* Segments, int Count)
+	\brief		Queues several buffers as one contiguous transmission, never blocks
+	\param		const LPUART1_Segment* Segments: The buffers, copied so they may be reused on return
+	\param		int Count: Number of segments
+	\returns 	int: 1 if everything was queued, 0 if it did not fit and nothing was queued
+*/
+
+int LPUART1_Submit(const LPUART1_Segment* Segments, int Count){
+	
+	/* Local Variables */
+	int Total = 0;
+	int i = 0;
+	int j = 0;
+	uint16_t Head = TX_Head;
+	
+	for(i = 0;i < Count;i++){
+		Total += Segments[i].Length;
+	}
+	if(Total > LPUART1_TX_Free()){
+		return(0);
+	}
+	
+	for(i = 0;i < Count;i++){
+		for(j = 0;j < Segments[i].Length;j++){
+			TX_Ring[Head] = Segments[i].Data[j];
+			Head = (Head + 1) & (TX_SIZE - 1);
+		}
+	}
+	
+	/* Publish then let the interrupt drain it */
+	TX_Head = Head;
+	LPUART1->CR1 |= USART_CR1_TXEIE;
+	
+	return(1);
+}
+
 /**
 	\fn				char LPUART1_PutChar(char ch)
-	\brief		Sends a character to the XBEE
+	\brief		Queues a character for the XBEE, only waits while the ring is full
 	\returns 	char ch: The character sent to the XBEE
 */
 
 char LPUART1_PutChar(char ch){
-
-	//Wait for buffer to be empty
-  while ((LPUART1->ISR & USART_ISR_TXE) == 0){
+	
+	LPUART1_Segment Segment;
+	
+	Segment.Data = (const uint8_t*)&ch;
+	Segment.Length = 1;
+	
+	//Wait for room in the ring
+  SPIN_BEGIN(SPIN_LPUART1_TX);
+  while (LPUART1_Submit(&Segment,1) == 0){
 			//Nop
 	}
+  SPIN_END(SPIN_LPUART1_TX);
 	
-	//Send character
-  LPUART1->TDR = (ch);
-
   return (ch);
 }
 
@@ -160,83 +483,323 @@ void LPUART1_Send(char c[]){
 }
 
 /**
-	\fn				void XBee_900HP_Init(void)
-	\brief		Initializes the XBEE
+	\fn				void LPUART1_Send_Bytes(const uint8_t* Data, int Length)
+	\brief		Sends binary data to the XBEE, zeros included
 */
-void XBee_900HP_Init(void){
-	/* Enter AT command mode */
-	Delay(1000);
-	LPUART1_Send(ENTER_AT_COMMAND_MODE);
-	Wait_For_OK();
+
+void LPUART1_Send_Bytes(const uint8_t* Data, int Length){
 	
-	/* Serial Address of matt's xbee */
-	LPUART1_Send(SET_DESTINATION_H);
-	Wait_For_OK();
+	int Counter = 0;
 	
-	LPUART1_Send(SET_DESTINATION_L);
-	Wait_For_OK();
+	while(Counter < Length){
+		LPUART1_PutChar((char)Data[Counter]);
+		Counter++;
+	}
+}
+
+/**
+	\fn				void XBee_Config_Start(const XBee_Step* Steps)
+	\brief		Starts an AT command sequence, XBee_Config_Poll then runs it without blocking
+	\param		const XBee_Step* Steps: XBee_900HP_Steps or XBee_ProS1_Steps
+*/
+
+void XBee_Config_Start(const XBee_Step* Steps){
+	
+	Config_Steps = Steps;
+	Config_Index = 0;
+	Config_Sent = 0;
+	Config_Attempts = 0;
+	Config_Status = XBEE_CONFIG_BUSY;
+	Config_Start = msTicks;
+	Config_Step_Start = msTicks;
+}
+
+/**
+	\fn				void XBee_Config_Goto(int Index)
+	\brief		Moves to another step of the sequence
+*/
+
+static void XBee_Config_Goto(int Index){
 	
-	/* PAN = 3001 */
-	LPUART1_Send(SET_ATID);
-	Wait_For_OK();
+	Config_Index = Index;
+	Config_Sent = 0;
+	Config_Attempts = 0;
+	Config_Step_Start = msTicks;
+}
+
+/**
+	\fn				void XBee_Config_Fail(const XBee_Step* Step)
+	\brief		A step ran out of tries, go to its Branch
+*/
+
+static void XBee_Config_Fail(const XBee_Step* Step){
 	
-	/* HP = 5 */
-	LPUART1_Send(SET_ATHP);
-	Wait_For_OK();
+	if(Step->Branch == XBEE_STEP_ABORT){
+		Config_Status = XBEE_CONFIG_FAILED;
+	}
+	else{
+		XBee_Config_Goto(Step->Branch);
+	}
+}
+
+/**
+	\fn				int XBee_Config_Exchange(const XBee_Step* Step, int Want_OK)
+	\brief		Sends the step's command and waits for the reply without blocking
+	\param		const XBee_Step* Step: The step
+	\param		int Want_OK: 1 - the reply must be OK, 0 - any reply, copied to Config_Reply
+	\returns	int: 0 - waiting, 1 - replied, -1 - out of tries
+*/
+
+static int XBee_Config_Exchange(const XBee_Step* Step, int Want_OK){
+	
+	if(Config_Sent == 0){
+		Device_Ack_Flag = FALSE;
+		XBee_Ready_To_Read = FALSE;
+		LPUART1_Send((char*)Step->Command);
+		Config_Sent = 1;
+		Config_Step_Start = msTicks;
+		return(0);
+	}
 	
-	/* Save the settings */
-	LPUART1_Send(SAVE_SETTINGS);
-	Wait_For_OK();
+	if(Want_OK && Device_Ack_Flag){
+		Device_Ack_Flag = FALSE;
+		XBee_Ready_To_Read = FALSE;
+		return(1);
+	}
 	
-	/* End AT command mode */
-	LPUART1_Send(EXIT_AT_COMMAND_MODE);
-	Wait_For_OK();
+	if((Want_OK == 0) && XBee_Ready_To_Read){
+		strncpy(Config_Reply,XBee_Message,sizeof(Config_Reply) - 1);
+		Config_Reply[strcspn(Config_Reply,"\r")] = '\0';
+		Device_Ack_Flag = FALSE;
+		XBee_Ready_To_Read = FALSE;
+		return(1);
+	}
 	
-	printf("#####  XBee 	       Initialized  #####\r\n");
+	/* Timed out or the radio answered ERROR */
+	if(((msTicks - Config_Step_Start) >= Step->Timeout) || XBee_Ready_To_Read){
+		XBee_Ready_To_Read = FALSE;
+		if(Config_Attempts < Step->Retries){
+			Config_Attempts++;
+			Config_Sent = 0;
+			return(0);
+		}
+		Config_Reply[0] = '\0';
+		return(-1);
+	}
+	
+	return(0);
 }
 
+/**
+	\fn				int XBee_Config_Matches(const char* Expected)
+	\brief		Compares the last reply with a setting, the radio answers in hex without leading zeros
+	\returns	int: 1 if they are the same
+*/
+
+static int XBee_Config_Matches(const char* Expected){
+	return(strcmp(Config_Reply,Expected) == 0);
+}
 
 /**
-	\fn				void XBee_Init(void)
-	\brief		Initializes the XBEE
+	\fn				uint32_t XBee_Config_Hash(int Index)
+	\brief		FNV-1a hash of the radio serial number and every setting checked up to the next
+						XBEE_STEP_SAVE
+	\param		int Index: The XBEE_STEP_HASH step
+	\returns	uint32_t: The hash, never 0
 */
 
-void XBee_ProS1_Init(void){
+static uint32_t XBee_Config_Hash(int Index){
 	
-	/* Enter AT command mode */
-	Delay(1000);
-	LPUART1_Send(ENTER_AT_COMMAND_MODE);
-	Wait_For_OK();
+	/* Local Variables */
+	uint32_t Hash = 2166136261u;
+	const XBee_Step* Step;
+	const char* Character;
 	
-	/* MY address = 2 */
-	LPUART1_Send(SET_ATMY);
-	Wait_For_OK();
+	for(Character = Config_Reply;*Character != '\0';Character++){
+		Hash = (Hash ^ (uint8_t)*Character)*16777619u;
+	}
 	
-	/* PAN = 3001 */
-	LPUART1_Send(SET_ATID);
-	Wait_For_OK();
+	for(Step = &Config_Steps[Index];Step->Action != XBEE_STEP_SAVE;Step++){
+		if(Step->Action == XBEE_STEP_CHECK){
+			for(Character = Step->Command;*Character != '\0';Character++){
+				Hash = (Hash ^ (uint8_t)*Character)*16777619u;
+			}
+			for(Character = Step->Expected;*Character != '\0';Character++){
+				Hash = (Hash ^ (uint8_t)*Character)*16777619u;
+			}
+		}
+	}
 	
-	/* Set Destination address high */
-	LPUART1_Send(SET_ATDH);
-	Wait_For_OK();
+	return((Hash == 0) ? 1 : Hash);
+}
+
+/**
+	\fn				int XBee_Config_Poll(void)
+	\brief		Runs the AT command sequence one step further when it can, call often
+	\returns	int: XBEE_CONFIG_BUSY, XBEE_CONFIG_DONE or XBEE_CONFIG_FAILED
+*/
+
+int XBee_Config_Poll(void){
 	
-	/* Set Destination Address low */
-	LPUART1_Send(SET_ATDL);
-	Wait_For_OK();
+	/* Local Variables */
+	const XBee_Step* Step;
+	uint32_t Elapsed = 0;
+	int Result = 0;
 	
-	/* Set Channel */
-	LPUART1_Send(SET_ATCH);
-	Wait_For_OK();
+	if(Config_Status != XBEE_CONFIG_BUSY){
+		return(Config_Status);
+	}
 	
-	/* Save the settings */
-	LPUART1_Send(SAVE_SETTINGS);
-	Wait_For_OK();
+	Step = &Config_Steps[Config_Index];
+	Elapsed = msTicks - Config_Step_Start;
 	
-	/* End AT command mode */
-	LPUART1_Send(EXIT_AT_COMMAND_MODE);
-	Wait_For_OK();
+	switch(Step->Action){
+		
+		/* No bytes for a while, needed before +++ */
+		case XBEE_STEP_GUARD:
+			if(Elapsed >= Step->Timeout){
+				XBee_Config_Goto(Config_Index + 1);
+			}
+			break;
+		
+		case XBEE_STEP_COMMAND:
+			Result = XBee_Config_Exchange(Step,1);
+			if(Result == 1){
+				XBee_Config_Goto(Config_Index + 1);
+			}
+			else if(Result < 0){
+				XBee_Config_Fail(Step);
+			}
+			break;
+		
+		/* The serial number, so a different radio never matches the hash */
+		case XBEE_STEP_READ:
+			Result = XBee_Config_Exchange(Step,0);
+			if(Result == 1){
+				XBee_Config_Goto(Config_Index + 1);
+			}
+			else if(Result < 0){
+				Config_Hash = 0;
+				XBee_Config_Fail(Step);
+			}
+			break;
+		
+		case XBEE_STEP_HASH:
+			Config_Hash = XBee_Config_Hash(Config_Index);
+			Config_Dirty = 0;
+			if(Config_Hash == EEPROM_Read_Word(EEPROM_XBEE_CONFIG_OFFSET)){
+				printf("#####  XBee 	       Settings Cached  #####\r\n");
+				XBee_Config_Goto(Step->Branch);
+			}
+			else{
+				XBee_Config_Goto(Config_Index + 1);
+			}
+			break;
+		
+		/* Only write what differs, no reply counts as different */
+		case XBEE_STEP_CHECK:
+			Result = XBee_Config_Exchange(Step,0);
+			if((Result == 1) && XBee_Config_Matches(Step->Expected)){
+				XBee_Config_Goto(Config_Index + 2);
+			}
+			else if(Result != 0){
+				printf("XBee: %.*s was %s\r\n",(int)(strlen(Step->Command) - 1),Step->Command,Config_Reply);
+				Config_Dirty = 1;
+				XBee_Config_Goto(Config_Index + 1);
+			}
+			break;
+		
+		case XBEE_STEP_SAVE:
+			Result = (Config_Dirty ? XBee_Config_Exchange(Step,1) : 1);
+			if(Result == 1){
+				if(Config_Hash != 0){
+					EEPROM_Write_Buffer(EEPROM_XBEE_CONFIG_OFFSET,&Config_Hash,sizeof(Config_Hash));
+				}
+				XBee_Config_Goto(Config_Index + 1);
+			}
+			else if(Result < 0){
+				XBee_Config_Fail(Step);
+			}
+			break;
+		
+		/* Set_Baud lets everything before leave at the old rate */
+		case XBEE_STEP_BAUD_FAST:
+			LPUART1_Set_Baud(FAST_BAUD);
+			XBee_Config_Goto(Config_Index + 1);
+			break;
+		
+		case XBEE_STEP_BAUD_DEFAULT:
+			LPUART1_Set_Baud(BAUD);
+			XBee_Config_Goto(Config_Index + 1);
+			break;
+		
+		case XBEE_STEP_API:
+			XBee_API_Set_Mode(XBEE_API_MODE_UNESCAPED);
+			XBee_Config_Goto(Config_Index + 1);
+			break;
+		
+		case XBEE_STEP_JUMP:
+			XBee_Config_Goto(Step->Branch);
+			break;
+		
+		default:
+			Config_Status = XBEE_CONFIG_DONE;
+			break;
+	}
+	
+	/* Report how long bring up took */
+	if(Config_Status != XBEE_CONFIG_BUSY){
+		Config_Time = msTicks - Config_Start;
+		printf("#####  XBee 	       %s in %u ms  #####\r\n",
+			(Config_Status == XBEE_CONFIG_DONE) ? "Initialized" : "Failed",(unsigned int)Config_Time);
+	}
+	
+	return(Config_Status);
+}
+
+/**
+	\fn				int XBee_Config_Status(void)
+	\brief		Retrieves how the AT command sequence is going
+	\returns	int: XBEE_CONFIG_BUSY, XBEE_CONFIG_DONE or XBEE_CONFIG_FAILED
+*/
+
+int XBee_Config_Status(void){
+	return(Config_Status);
+}
+
+/**
+	\fn				uint32_t XBee_Config_Time(void)
+	\brief		Retrieves how long the last AT command sequence took
+	\returns	uint32_t: ms from XBee_Config_Start to done or failed
+*/
+
+uint32_t XBee_Config_Time(void){
+	return(Config_Time);
+}
+
+/**
+	\fn				void XBee_900HP_Init(void)
+	\brief		Initializes the XBEE, blocks until XBee_900HP_Steps is done
+*/
+void XBee_900HP_Init(void){
+	
+	XBee_Config_Start(XBee_900HP_Steps);
+	while(XBee_Config_Poll() == XBEE_CONFIG_BUSY){
+		//Nop
+	}
+}
+
+/**
+	\fn				void XBee_Init(void)
+	\brief		Initializes the XBEE, blocks until XBee_ProS1_Steps is done
+*/
+
+void XBee_ProS1_Init(void){
 	
-	printf("#####  XBee 	       Initialized  #####\r\n");
+	XBee_Config_Start(XBee_ProS1_Steps);
+	while(XBee_Config_Poll() == XBEE_CONFIG_BUSY){
+		//Nop
+	}
 }
 
 /**
@@ -299,14 +862,44 @@ void Read_Xbee_ProS1_Init(void){
 void Wait_For_OK(void){
 	
 	/* Wait for XBee Acknowledge */
+	SPIN_BEGIN(SPIN_XBEE_OK);
 	while(Device_Ack_Flag == 0){
 		//Nop
 	}
+	SPIN_END(SPIN_XBEE_OK);
+	
+	/* Reset Flags */
+	Device_Ack_Flag = FALSE;
+	XBee_Ready_To_Read = FALSE;
+	
+}
+
+/**
+	\fn				int Wait_For_OK_Timeout(uint32_t Timeout)
+	\brief		Waits until the XBEE has sent the OK message or the timeout runs out
+	\param		uint32_t Timeout: ms to wait
+	\returns	int: 1 if the OK came, 0 on timeout
+*/
+
+int Wait_For_OK_Timeout(uint32_t Timeout){
+	
+	/* Local Variables */
+	unsigned int Start = msTicks;
+	int Acknowledged = 0;
+	
+	/* Wait for XBee Acknowledge */
+	SPIN_BEGIN(SPIN_XBEE_OK);
+	while((Device_Ack_Flag == 0) && ((msTicks - Start) < Timeout)){
+		//Nop
+	}
+	SPIN_END(SPIN_XBEE_OK);
+	Acknowledged = (Device_Ack_Flag != 0);
 	
 	/* Reset Flags */
 	Device_Ack_Flag = FALSE;
 	XBee_Ready_To_Read = FALSE;
 	
+	return(Acknowledged);
 }
 
 /**
@@ -317,9 +910,11 @@ void Wait_For_OK(void){
 void Wait_For_Data(void){
 	
 	/* Wait for data to be copied */
+	SPIN_BEGIN(SPIN_XBEE_DATA);
 	while(XBee_Ready_To_Read == 0){
 		//Nop
 	}
+	SPIN_END(SPIN_XBEE_DATA);
 	
 	/* Reset Flags */
 	Device_Ack_Flag = FALSE;
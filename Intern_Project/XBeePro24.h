@@ -22,13 +22,63 @@
 	 char CH[4];		/* Channel Selection										*/
  } AT_Data;
  
+ /* AT command sequence step actions */
+ #define XBEE_STEP_DONE					0					/* End of the sequence */
+ #define XBEE_STEP_GUARD				1					/* Wait Timeout ms without sending */
+ #define XBEE_STEP_COMMAND			2					/* Send Command, wait Timeout ms for OK, Retries more tries */
+ #define XBEE_STEP_BAUD_FAST		3					/* LPUART1 to 115200 */
+ #define XBEE_STEP_BAUD_DEFAULT	4					/* LPUART1 to 9600 */
+ #define XBEE_STEP_API					5					/* Radio frames are API from here */
+ #define XBEE_STEP_READ					6					/* Send Command, keep the reply for XBEE_STEP_HASH */
+ #define XBEE_STEP_HASH					7					/* Branch if the settings and radio match the saved hash */
+ #define XBEE_STEP_CHECK				8					/* Send Command, skip the next step if the reply is Expected */
+ #define XBEE_STEP_SAVE					9					/* ATWR if a CHECK differed, then save the hash */
+ #define XBEE_STEP_JUMP					10				/* Go to Branch */
+ #define XBEE_STEP_ABORT				-1				/* Branch: give up */
+ 
+ /* XBee_Config_Poll results */
+ #define XBEE_CONFIG_BUSY				0
+ #define XBEE_CONFIG_DONE				1
+ #define XBEE_CONFIG_FAILED			2
+ 
+ /* One step of an AT command sequence */
+ typedef struct XBee_Step
+ {
+	 uint8_t Action;					/* XBEE_STEP value */
+	 const char* Command;			/* AT command for XBEE_STEP_COMMAND */
+	 uint16_t Timeout;				/* ms */
+	 uint8_t Retries;					/* Extra tries before Branch */
+	 int8_t Branch;						/* Step to go to when out of tries, the hash matches or on a JUMP, or XBEE_STEP_ABORT */
+	 const char* Expected;		/* Reply XBEE_STEP_CHECK is looking for */
+ } XBee_Step;
+ 
+ /* One piece of a scatter-gather transmission */
+ typedef struct LPUART1_Segment
+ {
+	 const uint8_t* Data;
+	 int Length;
+ } LPUART1_Segment;
+ 
  extern void LPUART_Init(void);
  extern void XBee_ProS1_Init(void);
  extern void XBee_900HP_Init(void);
+ extern const XBee_Step XBee_900HP_Steps[];
+ extern const XBee_Step XBee_ProS1_Steps[];
+ extern void XBee_Config_Start(const XBee_Step* Steps);
+ extern int XBee_Config_Poll(void);
+ extern int XBee_Config_Status(void);
+ extern uint32_t XBee_Config_Time(void);
+ extern void LPUART1_Set_Baud(uint32_t Baud);
+ extern char LPUART1_PutChar(char ch);
+ extern int LPUART1_TX_Free(void);
+ extern int LPUART1_TX_Idle(void);
+ extern int LPUART1_Submit(const LPUART1_Segment* Segments, int Count);
  extern void LPUART1_Send(char c[]);
+ extern void LPUART1_Send_Bytes(const uint8_t* Data, int Length);
  extern void Read_Xbee_ProS1_Init(void);
  
 void Wait_For_OK(void);
+int Wait_For_OK_Timeout(uint32_t Timeout);
 void Wait_For_Data(void);
  
  #endif
@@ -0,0 +1,449 @@
+/*------------------------------------------------------------------------------------------------------
+ * Name:    XBee_API.c
+ * Purpose: XBee API frame encoder and decoder on LPUART1
+ * Date: 		10/19/26
+ * Author:	Christopher Jordan - Denny
+ *------------------------------------------------------------------------------------------------------
+ * Note(s): In transparent mode the radio packetizes whenever its buffer or RO timer says so and we
+						never hear if anything arrived. In API mode every TX Request is exactly one RF packet
+						and the radio answers each one with a TX Status frame.
+						
+						*	Records are batched into one TX Request until the next one would not fit in the
+							900HP's 256 byte payload.
+						*	ATAP is set after ATWR so the radio comes back up in transparent mode and the
+							+++ sequence in XBee_900HP_Steps keeps working after a reset.
+						*	Until then, or if bring up fails, records go out as they are in transparent mode.
+							The telemetry frames carry their own sync and CRC so the ground station copes.
+						
+						Frame:
+						------
+						*	0x7E, Length (MSB first), Frame Data, Checksum
+						*	Checksum = 0xFF - (sum of the Frame Data bytes)
+						*	AP = 2 escapes 0x7E, 0x7D, 0x11 and 0x13 after the start delimiter
+ *----------------------------------------------------------------------------------------------------*/
+
+/*---------------------------------------------Include Statements-------------------------------------*/
+#include <stdio.h>										// Printf
+#include "XBee_API.h"
+#include "XBeePro24.h"								// LPUART1 and AT command mode
+#include "Uplink.h"										// Ground station commands
+/*---------------------------------------------Definitions--------------------------------------------*/
+#define TRUE	1
+#define FALSE 0
+
+/* TX Request header after the length: API ID, Frame ID, 64 bit address, 0xFFFE, radius, options */
+#define TX_REQUEST_HEADER					14
+#define FRAME_HEADER							(3 + TX_REQUEST_HEADER)			/* Start delimiter and length too */
+
+/* RX Packet payload offset inside the frame data: API ID, 64 bit address, 0xFFFE, options */
+#define RX_PACKET_HEADER					12
+
+/* Receive states */
+#define RX_START									0
+#define RX_LENGTH_MSB							1
+#define RX_LENGTH_LSB							2
+#define RX_DATA										3
+#define RX_CHECKSUM								4
+/*---------------------------------------------Globals------------------------------------------------*/
+static const uint8_t Destination[8] = {0x00,0x13,0xA2,0x00,0x40,0xE3,0x5D,0xC2};	/* Same as ATDH/ATDL */
+
+volatile int			API_Mode = 							XBEE_API_MODE_OFF;
+uint8_t						Batch[XBEE_API_MAX_PAYLOAD];									/* RF payload being built */
+int								Batch_Length = 					0;
+uint32_t					Batch_Records = 				0;
+uint8_t						Frame_ID = 							0;
+XBee_API_Stats		API_Stats;
+
+/* Receive state, only touched from PendSV_Handler */
+uint8_t						RX_Frame[XBEE_API_MAX_RX];
+int								RX_State = 							RX_START;
+int								RX_Length = 						0;
+int								RX_Index = 							0;
+uint8_t						RX_Sum = 								0;
+int								RX_Escape = 						FALSE;
+/*---------------------------------------------Functions----------------------------------------------*/
+
+/**
+  \fn					void XBee_API_Set_Mode(int Mode)
+  \brief			Tells the frame code which mode the radio is in, set by the XBee_900HP_Steps
+							sequence once ATAP has been applied
+	\param			int Mode: XBEE_API_MODE_OFF, XBEE_API_MODE_UNESCAPED or XBEE_API_MODE_ESCAPED
+*/
+
+void XBee_API_Set_Mode(int Mode){
+	API_Mode = Mode;
+}
+
+/**
+  \fn					int XBee_API_Get_Mode(void)
+  \brief			Retrieves the current API mode
+	\returns		int: XBEE_API_MODE_OFF, XBEE_API_MODE_UNESCAPED or XBEE_API_MODE_ESCAPED
+*/
+
+int XBee_API_Get_Mode(void){
+	return(API_Mode);
+}
+
+/**
+  \fn					void XBee_API_Put(uint8_t Byte)
+  \brief			Sends one byte of a frame, escaping it when AP = 2
+*/
+
+static void XBee_API_Put(uint8_t Byte){
+	
+	if((API_Mode == XBEE_API_MODE_ESCAPED) && ((Byte == XBEE_API_START) || (Byte == XBEE_API_ESCAPE) ||
+		(Byte == XBEE_API_XON) || (Byte == XBEE_API_XOFF))){
+		LPUART1_PutChar(XBEE_API_ESCAPE);
+		Byte ^= 0x20;
+	}
+	
+	LPUART1_PutChar((char)Byte);
+}
+
+/**
+  \fn					void XBee_API_Flush(void)
+  \brief			Queues the batched records as one TX Request, never waits on the link
+*/
+
+void XBee_API_Flush(void){
+	
+	/* Local Variables */
+	uint8_t Header[FRAME_HEADER];
+	uint8_t Checksum = 0;
+	LPUART1_Segment Segments[3];
+	int Length = TX_REQUEST_HEADER + Batch_Length;
+	uint8_t Sum = 0;
+	int Queued = FALSE;
+	int i = 0;
+	
+	if(Batch_Length == 0){
+		return;
+	}
+	
+	/* Frame ID 0 would turn off the TX Status */
+	Frame_ID++;
+	if(Frame_ID == 0){
+		Frame_ID = 1;
+	}
+	
+	Header[0] = XBEE_API_START;
+	Header[1] = (uint8_t)(Length >> 8);
+	Header[2] = (uint8_t)Length;
+	Header[3] = XBEE_API_TX_REQUEST;
+	Header[4] = Frame_ID;
+	for(i = 0;i < 8;i++){
+		Header[5 + i] = Destination[i];
+	}
+	Header[13] = 0xFF;												/* 16 bit address unknown */
+	Header[14] = 0xFE;
+	Header[15] = 0x00;												/* Maximum hops */
+	Header[16] = 0x00;												/* Use ATTO */
+	
+	for(i = 3;i < FRAME_HEADER;i++){
+		Sum += Header[i];
+	}
+	for(i = 0;i < Batch_Length;i++){
+		Sum += Batch[i];
+	}
+	Checksum = (uint8_t)(0xFF - Sum);
+	
+	if(API_Mode == XBEE_API_MODE_ESCAPED){
+		
+		/* Worst case every byte but the start delimiter doubles */
+		if(LPUART1_TX_Free() >= (2*(FRAME_HEADER + Batch_Length + 1))){
+			LPUART1_PutChar(XBEE_API_START);
+			for(i = 1;i < FRAME_HEADER;i++){
+				XBee_API_Put(Header[i]);
+			}
+			for(i = 0;i < Batch_Length;i++){
+				XBee_API_Put(Batch[i]);
+			}
+			XBee_API_Put(Checksum);
+			Queued = TRUE;
+		}
+	}
+	else{
+		
+		/* Header, records and checksum go straight into the transmit ring */
+		Segments[0].Data = Header;
+		Segments[0].Length = FRAME_HEADER;
+		Segments[1].Data = Batch;
+		Segments[1].Length = Batch_Length;
+		Segments[2].Data = &Checksum;
+		Segments[2].Length = 1;
+		Queued = LPUART1_Submit(Segments,3);
+	}
+	
+	/* The link can't keep up, newer records matter more than these */
+	if(Queued){
+		API_Stats.Frames_Sent++;
+		API_Stats.Records_Sent += Batch_Records;
+	}
+	else{
+		API_Stats.Dropped += Batch_Records;
+	}
+	
+	Batch_Length = 0;
+	Batch_Records = 0;
+}
+
+/**
+  \fn					int XBee_API_Can_Queue(int Length)
+  \brief			Whether the transmit ring can take Length more bytes without XBee_API_Queue
+							dropping anything, even if it flushes the batch it has and the new one
+	\param			int Length: Bytes about to be queued
+	\returns		int: 1 if there is room
+*/
+
+int XBee_API_Can_Queue(int Length){
+	
+	int Needed = Length;
+	
+	if(API_Mode != XBEE_API_MODE_OFF){
+		Needed = 2*(FRAME_HEADER + 1) + Batch_Length + Length;
+		if(API_Mode == XBEE_API_MODE_ESCAPED){
+			Needed *= 2;
+		}
+	}
+	
+	return(LPUART1_TX_Free() >= Needed);
+}
+
+/**
+  \fn					int XBee_API_Request_RSSI(void)
+  \brief			Asks the radio for ATDB with a local AT Command frame, the answer lands in
+							XBee_API_Stats.RSSI. Stays in API mode so nothing waits on guard times.
+	\returns		int: 1 if the request was queued, 0 in transparent mode or with the ring full
+*/
+
+int XBee_API_Request_RSSI(void){
+	
+	/* Local Variables */
+	uint8_t Request[8];
+	LPUART1_Segment Segment;
+	uint8_t Sum = 0;
+	int i = 0;
+	
+	if((API_Mode == XBEE_API_MODE_OFF) || (LPUART1_TX_Free() < (2*sizeof(Request)))){
+		return(FALSE);
+	}
+	
+	Frame_ID++;
+	if(Frame_ID == 0){
+		Frame_ID = 1;
+	}
+	
+	Request[0] = XBEE_API_START;
+	Request[1] = 0x00;
+	Request[2] = 0x04;
+	Request[3] = XBEE_API_AT_COMMAND;
+	Request[4] = Frame_ID;
+	Request[5] = 'D';
+	Request[6] = 'B';
+	for(i = 3;i < 7;i++){
+		Sum += Request[i];
+	}
+	Request[7] = (uint8_t)(0xFF - Sum);
+	
+	if(API_Mode == XBEE_API_MODE_ESCAPED){
+		LPUART1_PutChar(XBEE_API_START);
+		for(i = 1;i < 8;i++){
+			XBee_API_Put(Request[i]);
+		}
+		return(TRUE);
+	}
+	
+	Segment.Data = Request;
+	Segment.Length = sizeof(Request);
+	return(LPUART1_Submit(&Segment,1));
+}
+
+/**
+  \fn					int XBee_API_Queue(const uint8_t* Data, int Length)
+  \brief			Adds a record to the current RF packet, sends the packet once another record
+							of the same size would not fit
+	\param			const uint8_t* Data: The record
+	\param			int Length: Record length, at most XBEE_API_MAX_PAYLOAD
+	\returns		int: 1 if the record was queued, 0 if it is too long or transparent mode dropped it
+*/
+
+int XBee_API_Queue(const uint8_t* Data, int Length){
+	
+	LPUART1_Segment Segment;
+	int i = 0;
+	
+	if((Length <= 0) || (Length > XBEE_API_MAX_PAYLOAD)){
+		return(FALSE);
+	}
+	
+	/* Transparent mode, the radio packetizes */
+	if(API_Mode == XBEE_API_MODE_OFF){
+		Segment.Data = Data;
+		Segment.Length = Length;
+		if(LPUART1_Submit(&Segment,1) == 0){
+			API_Stats.Dropped++;
+			return(FALSE);
+		}
+		API_Stats.Records_Sent++;
+		return(TRUE);
+	}
+	
+	if((Batch_Length + Length) > XBEE_API_MAX_PAYLOAD){
+		XBee_API_Flush();
+	}
+	
+	for(i = 0;i < Length;i++){
+		Batch[Batch_Length + i] = Data[i];
+	}
+	Batch_Length += Length;
+	Batch_Records++;
+	
+	/* Don't hold a full packet waiting for a record that won't fit */
+	if((Batch_Length + Length) > XBEE_API_MAX_PAYLOAD){
+		XBee_API_Flush();
+	}
+	
+	return(TRUE);
+}
+
+/**
+  \fn					void XBee_API_Handle_Frame(void)
+  \brief			Acts on a complete frame from the radio
+*/
+
+static void XBee_API_Handle_Frame(void){
+	
+	int i = 0;
+	
+	API_Stats.Frames_Received++;
+	
+	switch(RX_Frame[0]){
+		
+		/* API ID, Frame ID, 16 bit address, Retries, Delivery Status, Discovery Status */
+		case XBEE_API_TX_STATUS:
+			if(RX_Length >= 7){
+				API_Stats.Retries += RX_Frame[4];
+				API_Stats.Last_Status = RX_Frame[5];
+				if(RX_Frame[5] == 0x00){
+					API_Stats.Delivered++;
+				}
+				else{
+					API_Stats.Failed++;
+				}
+			}
+			break;
+		
+		/* RSSI of the last packet received: ID, Frame ID, 'D', 'B', status, -dBm */
+		case XBEE_API_AT_RESPONSE:
+			if((RX_Length >= 6) && (RX_Frame[2] == 'D') && (RX_Frame[3] == 'B') && (RX_Frame[4] == 0x00)){
+				API_Stats.RSSI = RX_Frame[5];
+				API_Stats.RSSI_Reads++;
+			}
+			break;
+		
+		/* Ground station commands, same framing as transparent mode */
+		case XBEE_API_RX_PACKET:
+			for(i = RX_PACKET_HEADER;i < RX_Length;i++){
+				Uplink_Receive_Byte(RX_Frame[i]);
+			}
+			break;
+		
+		default:
+			break;
+	}
+}
+
+/**
+  \fn					void XBee_API_Receive_Byte(uint8_t Byte)
+  \brief			Frame decoder, called from PendSV_Handler for every byte in API mode
+	\param			uint8_t Byte: Byte received from the radio
+*/
+
+void XBee_API_Receive_Byte(uint8_t Byte){
+	
+	/* A start delimiter always begins a new frame */
+	if(Byte == XBEE_API_START){
+		RX_State = RX_LENGTH_MSB;
+		RX_Escape = FALSE;
+		return;
+	}
+	
+	if(API_Mode == XBEE_API_MODE_ESCAPED){
+		if(Byte == XBEE_API_ESCAPE){
+			RX_Escape = TRUE;
+			return;
+		}
+		if(RX_Escape){
+			Byte ^= 0x20;
+			RX_Escape = FALSE;
+		}
+	}
+	
+	switch(RX_State){
+		
+		case RX_LENGTH_MSB:
+			RX_Length = Byte << 8;
+			RX_State = RX_LENGTH_LSB;
+			break;
+		
+		case RX_LENGTH_LSB:
+			RX_Length |= Byte;
+			RX_Index = 0;
+			RX_Sum = 0;
+			if((RX_Length == 0) || (RX_Length > XBEE_API_MAX_RX)){
+				API_Stats.Overruns++;
+				RX_State = RX_START;
+			}
+			else{
+				RX_State = RX_DATA;
+			}
+			break;
+		
+		case RX_DATA:
+			RX_Frame[RX_Index++] = Byte;
+			RX_Sum += Byte;
+			if(RX_Index == RX_Length){
+				RX_State = RX_CHECKSUM;
+			}
+			break;
+		
+		case RX_CHECKSUM:
+			if((uint8_t)(RX_Sum + Byte) == 0xFF){
+				XBee_API_Handle_Frame();
+			}
+			else{
+				API_Stats.Checksum_Errors++;
+			}
+			RX_State = RX_START;
+			break;
+		
+		default:
+			break;
+	}
+}
+
+/**
+  \fn					XBee_API_Stats* XBee_API_Get_Stats(void)
+  \brief			Retrieves the delivery counters
+	\returns		XBee_API_Stats*: The counters
+*/
+
+XBee_API_Stats* XBee_API_Get_Stats(void){
+	return(&API_Stats);
+}
+
+/**
+  \fn					void XBee_API_Print_Stats(void)
+  \brief			Prints the delivery counters to the serial monitor
+*/
+
+void XBee_API_Print_Stats(void){
+	printf("XBee: %u frames, %u records, %u delivered, %u failed, %u retries\r\n",
+		(unsigned int)API_Stats.Frames_Sent,(unsigned int)API_Stats.Records_Sent,
+		(unsigned int)API_Stats.Delivered,(unsigned int)API_Stats.Failed,(unsigned int)API_Stats.Retries);
+	printf("XBee: %u records dropped with the transmit queue full\r\n",(unsigned int)API_Stats.Dropped);
+	printf("XBee: %u received, %u checksum errors, %u overruns\r\n",
+		(unsigned int)API_Stats.Frames_Received,(unsigned int)API_Stats.Checksum_Errors,
+		(unsigned int)API_Stats.Overruns);
+	printf("XBee: RSSI -%u dBm over %u reads\r\n",(unsigned int)API_Stats.RSSI,(unsigned int)API_Stats.RSSI_Reads);
+}
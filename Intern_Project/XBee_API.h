@@ -0,0 +1,62 @@
+/*------------------------------------------------------------------------------------------------------
+ * Name:    XBee_API.h
+ * Purpose: XBee API frame encoder and decoder on LPUART1
+ * Date: 		10/19/26
+ * Author:	Christopher Jordan - Denny
+ *------------------------------------------------------------------------------------------------------
+ * Note(s):
+ *----------------------------------------------------------------------------------------------------*/
+
+/*-----------------------------------------Include Statements-----------------------------------------*/
+#include "stm32l053xx.h"							// Specific Device Header
+
+#ifndef XBEE_API_H
+#define XBEE_API_H
+
+/*-----------------------------------------API Frame Constants----------------------------------------*/
+#define XBEE_API_MODE_OFF					0							// Transparent mode
+#define XBEE_API_MODE_UNESCAPED		1							// ATAP 1
+#define XBEE_API_MODE_ESCAPED			2							// ATAP 2
+
+#define XBEE_API_START						0x7E					// Start delimiter
+#define XBEE_API_ESCAPE						0x7D					// Next byte is XOR 0x20 (AP = 2)
+#define XBEE_API_XON							0x11
+#define XBEE_API_XOFF							0x13
+
+#define XBEE_API_AT_COMMAND				0x08					// Local AT Command
+#define XBEE_API_TX_REQUEST				0x10					// Transmit Request
+#define XBEE_API_AT_RESPONSE			0x88					// Local AT Command Response
+#define XBEE_API_TX_STATUS				0x8B					// Transmit Status
+#define XBEE_API_RX_PACKET				0x90					// Receive Packet
+
+#define XBEE_API_MAX_PAYLOAD			256						// 900HP maximum RF payload (ATNP)
+#define XBEE_API_MAX_RX						64						// Largest frame kept from the radio
+
+/* Delivery counters, updated from TX Status frames */
+typedef struct XBee_API_Stats
+{
+	uint32_t Frames_Sent;								/* TX Requests sent */
+	uint32_t Records_Sent;							/* Telemetry records inside those frames */
+	uint32_t Dropped;										/* Records dropped with the transmit ring full */
+	uint32_t Delivered;									/* TX Status = 0x00 */
+	uint32_t Failed;										/* Any other TX Status */
+	uint32_t Retries;										/* Sum of the transmit retry counts */
+	uint32_t Frames_Received;						/* Good frames from the radio */
+	uint32_t Checksum_Errors;						/* Frames dropped for a bad checksum */
+	uint32_t Overruns;									/* Frames dropped for being too long */
+	uint8_t Last_Status;								/* Delivery status of the newest TX Status */
+	uint8_t RSSI;												/* -dBm of the last packet received, 0 until read */
+	uint32_t RSSI_Reads;								/* ATDB responses */
+}XBee_API_Stats;
+
+extern void XBee_API_Set_Mode(int Mode);
+extern int XBee_API_Get_Mode(void);
+extern int XBee_API_Queue(const uint8_t* Data, int Length);
+extern void XBee_API_Flush(void);
+extern int XBee_API_Can_Queue(int Length);
+extern int XBee_API_Request_RSSI(void);
+extern void XBee_API_Receive_Byte(uint8_t Byte);
+extern XBee_API_Stats* XBee_API_Get_Stats(void);
+extern void XBee_API_Print_Stats(void);
+
+#endif
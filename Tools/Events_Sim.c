@@ -0,0 +1,274 @@
+/*------------------------------------------------------------------------------------------------------
+ * Name:    Events_Sim.c
+ * Purpose: Host tool, runs the Events.c window over a lossy link and checks that deployment and
+						apogee always get through
+ * Date: 		10/19/26
+ * Author:	Christopher Jordan - Denny
+ *------------------------------------------------------------------------------------------------------
+ * Note(s): Build with any C compiler from this folder:
+							cc -O2 -IHost -I../Intern_Project -o Events_Sim Events_Sim.c ../Intern_Project/Events.c
+								../Intern_Project/Telemetry.c ../Intern_Project/FEC.c
+						Use:	Events_Sim					(exits 1 if a check fails)
+
+						The window, the frames and the FEC blocks are the board's own Events.c, Telemetry.c
+						and FEC.c. Host/stm32l053xx.h stands in for the device header, so the interrupt
+						masking does nothing here.
+
+						Runs:
+						-----
+						*	Steady: a fault every 250 ms, 40 in all, like Events_Test.c on the board
+						*	Storm: a fault every EVENTS_PERIOD for 2 s with both deployments and apogee posted
+							in the middle of it. Every one of the three has to be queued and delivered, faults
+							may be dropped
+						*	Both lose the same % of event frames and of ACKs, the ground station ACKs every
+							frame it gets like Events_Test.c
+						*	Bit errors: one event frame a block through a random bit error channel, sent as it
+							is and closed into a padded FEC block the way Events_Run sends it
+ *----------------------------------------------------------------------------------------------------*/
+
+/*---------------------------------------------Include Statements-------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "Events.h"
+#include "Telemetry.h"
+#include "FEC.h"
+/*---------------------------------------------Definitions--------------------------------------------*/
+#define EVENTS_PERIOD							10						// ms, Intern_Project.c
+#define STEADY_COUNT							40
+#define STEADY_SPACING						250						// ms between steady faults
+#define STORM_TIME								2000					// ms of a fault every EVENTS_PERIOD, under 256 events
+#define CRITICAL_TIME							1000					// ms into the storm deployment and apogee are posted
+#define RUN_LIMIT									120000				// ms before a run gives up
+#define CHANNEL_FRAMES						100000				// Frames per bit error rate
+#define FEC_DATA									32						// Intern_Project.c
+#define FEC_PARITY								8
+#define FEC_DEPTH									4
+/*---------------------------------------------Globals------------------------------------------------*/
+extern uint8_t		Next_Sequence;														/* Events.c, the sequence the next post gets */
+/*---------------------------------------------Functions----------------------------------------------*/
+
+/**
+  \fn					unsigned long Random(void)
+  \brief			30 random bits, rand() may only give 15
+*/
+
+static unsigned long Random(void){
+	return((((unsigned long)rand() & 0x7FFF) << 15) | ((unsigned long)rand() & 0x7FFF));
+}
+
+/**
+  \fn					int Lossy_Link(int Loss, int Storm)
+  \brief			Runs one set of events through a link that loses Loss % of the event frames and
+							Loss % of the ACKs
+	\param			int Loss: % of frames lost each way
+	\param			int Storm: 0 - steady faults, 1 - a fault storm with deployment and apogee
+	\returns		int: Number of failures
+*/
+
+static int Lossy_Link(int Loss, int Storm){
+	
+	/* Local Variables */
+	uint8_t Frame[TELEMETRY_MAX_FRAME];
+	uint8_t Arrived[256];
+	uint8_t Critical_Sequence[3];
+	Telemetry_Event Event;
+	Events_Stats* Stats;
+	uint32_t Now = 0;
+	uint32_t Latency = 0;
+	uint32_t Latency_Max = 0;
+	uint32_t Critical_Max = 0;
+	uint8_t Expected = 0;
+	uint8_t Received = 0;
+	int Posted = 0;
+	int Delivered = 0;
+	int Critical_Posted = 0;
+	int Critical_Delivered = 0;
+	int Failures = 0;
+	int Length = 0;
+	int Total = Storm ? (STORM_TIME/EVENTS_PERIOD) : STEADY_COUNT;
+	int i = 0;
+	
+	Events_Init();
+	memset(Arrived,0,sizeof(Arrived));
+	
+	for(Now = 0;(Now < RUN_LIMIT) && ((Posted < Total) || (Events_Pending() != 0));Now += EVENTS_PERIOD){
+	
+		if(Storm && (Now == CRITICAL_TIME)){
+	
+			/* What Deploy_Run and Check_Apogee post, the sequence each one gets is the next */
+			Critical_Sequence[0] = Next_Sequence;
+			Critical_Posted += Events_Post(TELEMETRY_EVENT_DEPLOY,TELEMETRY_DEPLOY_TIMER,Now);
+			Critical_Sequence[1] = Next_Sequence;
+			Critical_Posted += Events_Post(TELEMETRY_EVENT_APOGEE,150000,Now);
+			Critical_Sequence[2] = Next_Sequence;
+			Critical_Posted += Events_Post(TELEMETRY_EVENT_DEPLOY,TELEMETRY_DEPLOY_UPLINK,Now);
+		}
+		if((Posted < Total) && (Storm || (Now >= (uint32_t)(Posted*STEADY_SPACING)))){
+			Events_Post(TELEMETRY_EVENT_FAULT,Posted,Now);
+			Posted++;
+		}
+	
+		Length = Events_Poll(Now,Frame);
+		if((Length == 0) || ((rand() % 100) < Loss)){
+			continue;
+		}
+	
+		/* Ground station */
+		if(Telemetry_Decode_Event(Frame,Length,&Event) != TELEMETRY_OK){
+			continue;
+		}
+		if(Arrived[Event.Sequence] == 0){
+			Arrived[Event.Sequence] = 1;
+			Delivered++;
+			Latency = Now - Event.Timestamp;
+			if(Latency > Latency_Max){
+				Latency_Max = Latency;
+			}
+			if(Event.Type != TELEMETRY_EVENT_FAULT){
+				Critical_Delivered++;
+				if(Latency > Critical_Max){
+					Critical_Max = Latency;
+				}
+			}
+		}
+		while(Arrived[Expected]){
+			Expected++;
+		}
+		Received = 0;
+		for(i = 0;i < 8;i++){
+			if(Arrived[(uint8_t)(Expected + 1 + i)]){
+				Received |= (uint8_t)(1 << i);
+			}
+		}
+	
+		if((rand() % 100) >= Loss){
+			Events_Ack(Expected,Received,Now);
+		}
+	}
+	
+	Stats = Events_Get_Stats();
+	printf("%s loss %2d%%: %3d/%3d delivered, %3u dropped, %4u sent, %4u resent, %5u ms max",Storm ? "Storm " : "Steady",
+		Loss,Delivered,Total + (Storm ? 3 : 0),(unsigned int)Stats->Dropped,(unsigned int)Stats->Sent,
+		(unsigned int)Stats->Retransmissions,(unsigned int)Latency_Max);
+	if(Storm){
+		printf(", critical %d/3 in %u ms max",Critical_Delivered,(unsigned int)Critical_Max);
+		if((Critical_Posted != 3) || (Critical_Delivered != 3)){
+			Failures++;
+		}
+		for(i = 0;i < 3;i++){
+			if(Arrived[Critical_Sequence[i]] == 0){
+				Failures++;
+			}
+		}
+	}
+	printf("\n");
+	
+	return(Failures);
+}
+
+/**
+  \fn					void Flip_Bits(uint8_t* Data, int Length, unsigned long Threshold)
+  \brief			Flips each bit with a chance of Threshold in 2^30
+*/
+
+static void Flip_Bits(uint8_t* Data, int Length, unsigned long Threshold){
+	
+	int i = 0;
+	
+	for(i = 0;i < (Length*8);i++){
+		if(Random() < Threshold){
+			Data[i >> 3] ^= (uint8_t)(1 << (i & 7));
+		}
+	}
+}
+
+/**
+  \fn					int Bit_Errors(double Bit_Error_Rate)
+  \brief			Event frames through a bit error channel, uncoded and in a padded FEC block
+	\param			double Bit_Error_Rate: Chance of each bit flipping
+	\returns		int: Number of failures
+*/
+
+static int Bit_Errors(double Bit_Error_Rate){
+	
+	/* Local Variables */
+	uint8_t Frame[TELEMETRY_MAX_FRAME];
+	uint8_t Block[FEC_MAX_BLOCK];
+	Telemetry_Event Sent;
+	Telemetry_Event Event;
+	unsigned long Threshold = (unsigned long)(Bit_Error_Rate*(1UL << 30));
+	long Raw = 0;
+	long Coded = 0;
+	long Wrong = 0;
+	int Length = 0;
+	long i = 0;
+	
+	for(i = 0;i < CHANNEL_FRAMES;i++){
+	
+		Sent.Sequence = (uint8_t)i;
+		Sent.Type = TELEMETRY_EVENT_DEPLOY;
+		Sent.Timestamp = (uint32_t)Random();
+		Sent.Value = TELEMETRY_DEPLOY_TIMER;
+		Length = Telemetry_Encode_Event(&Sent,Frame);
+	
+		/* As Events_Run sent them before */
+		memcpy(Block,Frame,Length);
+		Flip_Bits(Block,Length,Threshold);
+		if(Telemetry_Decode_Event(Block,Length,&Event) == TELEMETRY_OK){
+			if(memcmp(&Event,&Sent,sizeof(Event)) == 0){
+				Raw++;
+			}
+			else{
+				Wrong++;
+			}
+		}
+	
+		/* Send_Telemetry then Send_Started_Block, the ground station finds the sync */
+		FEC_Write(Frame,Length);
+		FEC_Pad();
+		memcpy(Block,FEC_Take_Block(),FEC_Block_Length());
+		Flip_Bits(&Block[FEC_SYNC_LENGTH],FEC_Block_Length() - FEC_SYNC_LENGTH,Threshold);
+		FEC_Decode(Block);
+		if(Telemetry_Decode_Event(&Block[FEC_SYNC_LENGTH],Length,&Event) == TELEMETRY_OK){
+			if(memcmp(&Event,&Sent,sizeof(Event)) == 0){
+				Coded++;
+			}
+			else{
+				Wrong++;
+			}
+		}
+	}
+	
+	printf("BER %.0e: %5.1f%% of event frames arrive uncoded, %5.1f%% in an FEC block (%d bytes for %d)\n",
+		Bit_Error_Rate,100.0*Raw/CHANNEL_FRAMES,100.0*Coded/CHANNEL_FRAMES,FEC_Block_Length(),Length);
+	
+	/* The CRC has to stop a damaged frame, and the block can't do worse than no block */
+	return((Wrong != 0) || (Coded < Raw));
+}
+
+int main(void){
+	
+	const int Loss[4] = {0,10,30,50};
+	const double Rates[3] = {1e-3,3e-3,1e-2};
+	int Failures = 0;
+	int i = 0;
+	
+	srand(41);
+	
+	for(i = 0;i < 4;i++){
+		Failures += Lossy_Link(Loss[i],0);
+	}
+	for(i = 0;i < 4;i++){
+		Failures += Lossy_Link(Loss[i],1);
+	}
+	
+	FEC_Init(FEC_DATA,FEC_PARITY,FEC_DEPTH);
+	for(i = 0;i < 3;i++){
+		Failures += Bit_Errors(Rates[i]);
+	}
+	
+	printf("Failures: %d\n",Failures);
+	
+	return((Failures != 0) ? 1 : 0);
+}
@@ -0,0 +1,273 @@
+/*------------------------------------------------------------------------------------------------------
+ * Name:    FEC_Bench.c
+ * Purpose: Host tool, checks what the FEC.c blocks recover and times the encoder and decoder
+ * Date: 		10/19/26
+ * Author:	Christopher Jordan - Denny
+ *------------------------------------------------------------------------------------------------------
+ * Note(s): Build with any C compiler from this folder:
+							cc -O2 -I../Intern_Project -o FEC_Bench FEC_Bench.c ../Intern_Project/FEC.c
+						Use:	FEC_Bench					(exits 1 if a check fails)
+
+						The code is the one Intern_Project.c sets up, FEC_DATA 32, FEC_PARITY 8, FEC_DEPTH 4.
+						FEC_Test.c runs the same bursts and bit errors on the board, this runs them on many
+						more blocks and checks the results.
+
+						Checks:
+						-------
+						*	Blocks with a burst of up to Depth*Parity/2 bytes anywhere after the sync have
+							to come back exactly
+						*	Blocks through a random bit error channel have to come back exactly whenever no
+							codeword got more than Parity/2 wrong bytes. Past that the decoder may give up,
+							a block it says it fixed that is still wrong is counted as a miscorrection
+						*	Blocks with nothing wrong decode with nothing corrected
+ *----------------------------------------------------------------------------------------------------*/
+
+/*---------------------------------------------Include Statements-------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "FEC.h"
+/*---------------------------------------------Definitions--------------------------------------------*/
+#define FEC_DATA									32						// Intern_Project.c
+#define FEC_PARITY								8
+#define FEC_DEPTH									4
+#define DATA_BYTES								(FEC_DATA*FEC_DEPTH)
+#define BLOCKS										200						// Per burst length and bit error rate, as FEC_Test.c
+#define CHANNEL_BLOCKS						20000					// Per bit error rate for the fix-or-give-up check
+#define BENCH_BLOCKS							100000
+/*---------------------------------------------Globals------------------------------------------------*/
+volatile int		Sink = 0;																/* Keeps the benchmark loops */
+/*---------------------------------------------Functions----------------------------------------------*/
+
+/**
+  \fn					unsigned long Random(void)
+  \brief			30 random bits, rand() may only give 15
+*/
+
+static unsigned long Random(void){
+	return((((unsigned long)rand() & 0x7FFF) << 15) | ((unsigned long)rand() & 0x7FFF));
+}
+
+/**
+  \fn					int Encode_Block(uint8_t* Block)
+  \brief			Encodes one block of random data
+	\returns		int: Block length
+*/
+
+static int Encode_Block(uint8_t* Block){
+	
+	uint8_t Data[DATA_BYTES];
+	int Length = FEC_Block_Length();
+	int i = 0;
+	
+	for(i = 0;i < DATA_BYTES;i++){
+		Data[i] = (uint8_t)rand();
+	}
+	
+	FEC_Write(Data,DATA_BYTES);
+	memcpy(Block,FEC_Take_Block(),Length);
+	
+	return(Length);
+}
+
+/**
+  \fn					int Burst_Test(int Burst)
+  \brief			Corrupts a run of bytes in each block
+	\param			int Burst: Bytes corrupted in a row
+	\returns		int: Blocks repaired exactly
+*/
+
+static int Burst_Test(int Burst){
+	
+	uint8_t Block[FEC_MAX_BLOCK];
+	uint8_t Sent[FEC_MAX_BLOCK];
+	int Length = 0;
+	int Start = 0;
+	int Repaired = 0;
+	int i = 0;
+	int j = 0;
+	
+	for(i = 0;i < BLOCKS;i++){
+	
+		Length = Encode_Block(Block);
+		memcpy(Sent,Block,Length);
+	
+		/* Anywhere after the sync */
+		Start = FEC_SYNC_LENGTH + (rand() % (Length - FEC_SYNC_LENGTH - Burst + 1));
+		for(j = 0;j < Burst;j++){
+			Block[Start + j] ^= (uint8_t)(1 + (rand() % 255));
+		}
+	
+		if((FEC_Decode(Block) >= 0) && (memcmp(Block,Sent,Length) == 0)){
+			Repaired++;
+		}
+	}
+	
+	return(Repaired);
+}
+
+/**
+  \fn					int Channel_Test(double Bit_Error_Rate, long Blocks, int* Failures, long* Miscorrected)
+  \brief			Sends blocks through a random bit error channel
+	\param			double Bit_Error_Rate: Chance of each bit flipping
+	\param			long Blocks: Blocks to send
+	\param			int* Failures: Incremented for each block that should have come back and didn't
+	\param			long* Miscorrected: Incremented for each block FEC_Decode passed that is still wrong
+	\returns		long: Blocks repaired exactly
+*/
+
+static long Channel_Test(double Bit_Error_Rate, long Blocks, int* Failures, long* Miscorrected){
+	
+	uint8_t Block[FEC_MAX_BLOCK];
+	uint8_t Sent[FEC_MAX_BLOCK];
+	int Wrong[FEC_DEPTH];
+	unsigned long Threshold = (unsigned long)(Bit_Error_Rate*(1UL << 30));
+	int Length = 0;
+	int Fixable = 0;
+	int Result = 0;
+	long Repaired = 0;
+	long i = 0;
+	int j = 0;
+	
+	for(i = 0;i < Blocks;i++){
+	
+		Length = Encode_Block(Block);
+		memcpy(Sent,Block,Length);
+	
+		/* The sync is found by the ground station, only the data and parity are tested */
+		for(j = FEC_SYNC_LENGTH*8;j < (Length*8);j++){
+			if(Random() < Threshold){
+				Block[j >> 3] ^= (uint8_t)(1 << (j & 7));
+			}
+		}
+	
+		/* Data and parity byte p after the sync are both in codeword p % Depth */
+		Fixable = 1;
+		for(j = 0;j < FEC_DEPTH;j++){
+			Wrong[j] = 0;
+		}
+		for(j = FEC_SYNC_LENGTH;j < Length;j++){
+			if(Block[j] != Sent[j]){
+				Wrong[(j - FEC_SYNC_LENGTH) % FEC_DEPTH]++;
+			}
+		}
+		for(j = 0;j < FEC_DEPTH;j++){
+			if(Wrong[j] > (FEC_PARITY/2)){
+				Fixable = 0;
+			}
+		}
+	
+		Result = FEC_Decode(Block);
+		if(memcmp(Block,Sent,Length) == 0){
+			Repaired++;
+		}
+		else if(Fixable){
+			(*Failures)++;
+		}
+		else if(Result >= 0){
+			(*Miscorrected)++;
+		}
+	}
+	
+	return(Repaired);
+}
+
+/**
+  \fn					void Benchmark(void)
+  \brief			Encoder and decoder cost per block
+*/
+
+static void Benchmark(void){
+	
+	uint8_t Data[DATA_BYTES];
+	uint8_t Block[FEC_MAX_BLOCK];
+	uint8_t Sent[FEC_MAX_BLOCK];
+	clock_t Start = 0;
+	double Encode_Ns = 0;
+	double Clean_Ns = 0;
+	double Worst_Ns = 0;
+	int Length = 0;
+	long i = 0;
+	
+	memset(Data,0xA5,sizeof(Data));
+	Start = clock();
+	for(i = 0;i < BENCH_BLOCKS;i++){
+		Data[i % DATA_BYTES] = (uint8_t)i;
+		FEC_Write(Data,DATA_BYTES);
+		Sink += FEC_Take_Block()[FEC_SYNC_LENGTH + DATA_BYTES];
+	}
+	Encode_Ns = (double)(clock() - Start)*1e9/CLOCKS_PER_SEC/BENCH_BLOCKS;
+	
+	Length = Encode_Block(Sent);
+	Start = clock();
+	for(i = 0;i < BENCH_BLOCKS;i++){
+		memcpy(Block,Sent,Length);
+		Sink += FEC_Decode(Block);
+	}
+	Clean_Ns = (double)(clock() - Start)*1e9/CLOCKS_PER_SEC/BENCH_BLOCKS;
+	
+	/* Four errors a codeword, the most it can fix */
+	Start = clock();
+	for(i = 0;i < BENCH_BLOCKS;i++){
+		memcpy(Block,Sent,Length);
+		memset(&Block[FEC_SYNC_LENGTH],0x55,FEC_DEPTH*FEC_PARITY/2);
+		Sink += FEC_Decode(Block);
+	}
+	Worst_Ns = (double)(clock() - Start)*1e9/CLOCKS_PER_SEC/BENCH_BLOCKS;
+	
+	printf("%d byte block, %d data: encode %.0f ns (%.1f ns a byte), decode clean %.0f ns, %d errors %.0f ns\n",
+		Length,DATA_BYTES,Encode_Ns,Encode_Ns/DATA_BYTES,Clean_Ns,FEC_DEPTH*FEC_PARITY/2,Worst_Ns);
+}
+
+int main(void){
+	
+	const double Rates[4] = {1e-4,1e-3,3e-3,1e-2};
+	uint8_t Block[FEC_MAX_BLOCK];
+	uint8_t Sent[FEC_MAX_BLOCK];
+	int Failures = 0;
+	int Burst_Limit = FEC_DEPTH*FEC_PARITY/2;
+	int Repaired = 0;
+	long Miscorrected = 0;
+	int Length = 0;
+	int i = 0;
+	
+	srand(40);
+	
+	if(FEC_Init(FEC_DATA,FEC_PARITY,FEC_DEPTH) != FEC_OK){
+		printf("FEC_Init refused %d/%d/%d\n",FEC_DATA,FEC_PARITY,FEC_DEPTH);
+		return(1);
+	}
+	printf("Code: %d data, %d parity, depth %d, %d byte blocks, rate %.2f\n",FEC_DATA,FEC_PARITY,FEC_DEPTH,
+		FEC_Block_Length(),(double)DATA_BYTES/FEC_Block_Length());
+	
+	/* Nothing to fix */
+	for(i = 0;i < BLOCKS;i++){
+		Length = Encode_Block(Block);
+		memcpy(Sent,Block,Length);
+		if((FEC_Decode(Block) != 0) || (memcmp(Block,Sent,Length) != 0)){
+			Failures++;
+		}
+	}
+	
+	/* Up to the limit every one, past it they are lost */
+	for(i = 1;i <= Burst_Limit;i++){
+		Repaired = Burst_Test(i);
+		if(Repaired != BLOCKS){
+			printf("Burst %d: only %d/%d repaired\n",i,Repaired,BLOCKS);
+			Failures++;
+		}
+	}
+	printf("Burst %d: %d/%d repaired\n",Burst_Limit,Burst_Test(Burst_Limit),BLOCKS);
+	printf("Burst %d: %d/%d repaired\n",Burst_Limit + 8,Burst_Test(Burst_Limit + 8),BLOCKS);
+	
+	for(i = 0;i < 4;i++){
+		printf("BER %.0e: %ld/%d repaired",Rates[i],Channel_Test(Rates[i],BLOCKS,&Failures,&Miscorrected),BLOCKS);
+		printf(", %ld/%d over more blocks\n",Channel_Test(Rates[i],CHANNEL_BLOCKS,&Failures,&Miscorrected),CHANNEL_BLOCKS);
+	}
+	printf("Fixable blocks not repaired: %d, miscorrected: %ld\n",Failures,Miscorrected);
+	
+	Benchmark();
+	
+	return((Failures != 0) ? 1 : 0);
+}
@@ -0,0 +1,183 @@
+/*------------------------------------------------------------------------------------------------------
+ * Name:    Flash_Log_Decode.c
+ * Purpose: Host tool, turns the Flash_Log_Dump packets in a serial monitor log into flight CSV
+ * Date: 		10/19/26
+ * Author:	Christopher Jordan - Denny
+ *------------------------------------------------------------------------------------------------------
+ * Note(s): Build with any C compiler from this folder:
+							cc -O2 -I../Intern_Project -o Flash_Log_Decode Flash_Log_Decode.c ../Intern_Project/Telemetry.c
+						Use:	Flash_Log_Decode serial_log.bin > flight.csv	(or from stdin)
+						Send 'b' on the serial monitor before arming or after the landing to get the dump.
+
+						*	Every flash record is a Telemetry_Pack record frame, Telemetry.c has the field
+							layout and Telemetry_Decode checks the version and the frame CRC, so the columns
+							don't depend on how the board's compiler lays out Telemetry_Record
+						*	One line per record, the Telemetry_Record fields after Sequence in order, the
+							recorded flight columns of Tools/Telemetry_Bench:
+							Timestamp (us),Channels,Latitude,Longitude,GPS_Altitude,Ground_Speed,GPS_Time,
+							GPS_Status,Temperature,Humidity,Acceleration X/Y/Z,Gyroscope X/Y/Z,
+							Magnetic X/Y/Z,Pressure,Baro_Altitude,Records_Dropped,Link_Failures,RSSI,Link_Level
+						*	Timestamps are left as the board sent them, they wrap after 71 minutes
+						*	Text around the packets is skipped. A record with a bad flash CRC ends its packet,
+							a record that isn't a record frame of this TELEMETRY_VERSION is counted and skipped
+						*	Gaps in the record sequence are records the log dropped or pages it skipped. The
+							sequence starts again at 1 every power up, so a log holding several flights shows
+							restarts
+ *----------------------------------------------------------------------------------------------------*/
+
+/*---------------------------------------------Include Statements-------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "Telemetry.h"
+/*---------------------------------------------Definitions--------------------------------------------*/
+#define SYNC_1										'F'						// Flash_Log.h
+#define SYNC_2										'L'
+#define RECORD_HEADER							1
+#define RECORD_CRC								2
+#define MAX_RECORD								245
+#define MAX_INPUT									(4ul << 20)		// A 1 MB log with room for the text around it
+/*---------------------------------------------Globals------------------------------------------------*/
+unsigned long		Records = 0;
+unsigned long		Not_Frames = 0;														/* Good flash CRC, not a record frame */
+unsigned long		Missing = 0;															/* Sequence numbers skipped */
+unsigned long		Restarts = 0;															/* Sequence went back, the board was powered up again */
+unsigned int		Last_Sequence = 0;
+int							Have_Sequence = 0;
+/*---------------------------------------------Functions----------------------------------------------*/
+
+/**
+  \fn					void Print_Record(const Telemetry_Record* Record)
+  \brief			One CSV line, see the note for the columns
+*/
+
+static void Print_Record(const Telemetry_Record* Record){
+	
+	int i = 0;
+	
+	printf("%lu,%u,%ld,%ld,%ld,%u,%lu,%u,%d,%u",(unsigned long)Record->Timestamp,(unsigned int)Record->Channels,
+		(long)Record->Latitude,(long)Record->Longitude,(long)Record->GPS_Altitude,(unsigned int)Record->Ground_Speed,
+		(unsigned long)Record->GPS_Time,(unsigned int)Record->GPS_Status,(int)Record->Temperature,
+		(unsigned int)Record->Humidity);
+	for(i = 0;i < 3;i++){
+		printf(",%d",(int)Record->Acceleration[i]);
+	}
+	for(i = 0;i < 3;i++){
+		printf(",%d",(int)Record->Gyroscope[i]);
+	}
+	for(i = 0;i < 3;i++){
+		printf(",%d",(int)Record->Magnetic[i]);
+	}
+	printf(",%ld,%ld,%u,%u,%u,%u\n",(long)Record->Pressure,(long)Record->Baro_Altitude,
+		(unsigned int)Record->Records_Dropped,(unsigned int)Record->Link_Failures,(unsigned int)Record->RSSI,
+		(unsigned int)Record->Link_Level);
+}
+
+/**
+  \fn					long Decode_Packet(const unsigned char* Data, long Length, unsigned long* Bad_Pages)
+  \brief			Prints the records of one dump
+	\param			const unsigned char* Data: From the sync
+	\param			long Length: Bytes left in the input
+	\param			unsigned long* Bad_Pages: The damaged pages the board skipped are added on
+	\returns		long: Bytes used, 0 if the first record is bad so the sync was false
+*/
+
+static long Decode_Packet(const unsigned char* Data, long Length, unsigned long* Bad_Pages){
+	
+	/* Local Variables */
+	Telemetry_Record Record;
+	long Position = 2;
+	int Record_Length = 0;
+	
+	while((Position + RECORD_HEADER) <= Length){
+	
+		Record_Length = Data[Position];
+	
+		/* End of the dump */
+		if(Record_Length == 0){
+			if((Position + 3) > Length){
+				break;
+			}
+			*Bad_Pages += Data[Position + 1] | (Data[Position + 2] << 8);
+			return(Position + 3);
+		}
+	
+		if((Record_Length > MAX_RECORD) || ((Position + RECORD_HEADER + Record_Length + RECORD_CRC) > Length) ||
+			(Telemetry_CRC16(&Data[Position],RECORD_HEADER + Record_Length,0xFFFF) !=
+			(Data[Position + RECORD_HEADER + Record_Length] | (Data[Position + RECORD_HEADER + Record_Length + 1] << 8)))){
+			break;
+		}
+	
+		if(Telemetry_Decode(&Data[Position + RECORD_HEADER],Record_Length,&Record) == TELEMETRY_OK){
+			if(Have_Sequence && (Record.Sequence <= Last_Sequence)){
+				Restarts++;
+			}
+			else if(Have_Sequence){
+				Missing += Record.Sequence - Last_Sequence - 1;
+			}
+			Last_Sequence = Record.Sequence;
+			Have_Sequence = 1;
+			Print_Record(&Record);
+			Records++;
+		}
+		else{
+			Not_Frames++;
+		}
+	
+		Position += RECORD_HEADER + Record_Length + RECORD_CRC;
+	}
+	
+	/* Cut off or a serial error, keep what came before it */
+	if(Position == 2){
+		return(0);
+	}
+	fprintf(stderr,"Dump cut off after %ld bytes\n",Position);
+	
+	return(Position);
+}
+
+int main(int argc, char* argv[]){
+	
+	/* Local Variables */
+	static unsigned char Data[MAX_INPUT];
+	FILE* Input = stdin;
+	unsigned long Bad_Pages = 0;
+	long Length = 0;
+	long Used = 0;
+	long i = 0;
+	int Packets = 0;
+	
+	if(argc > 1){
+		Input = fopen(argv[1],"rb");
+		if(Input == NULL){
+			fprintf(stderr,"Can't open %s\n",argv[1]);
+			return(1);
+		}
+	}
+	Length = (long)fread(Data,1,sizeof(Data),Input);
+	
+	printf("Timestamp,Channels,Latitude,Longitude,GPS_Altitude,Ground_Speed,GPS_Time,GPS_Status,Temperature,"
+		"Humidity,Acceleration_X,Acceleration_Y,Acceleration_Z,Gyroscope_X,Gyroscope_Y,Gyroscope_Z,Magnetic_X,"
+		"Magnetic_Y,Magnetic_Z,Pressure,Baro_Altitude,Records_Dropped,Link_Failures,RSSI,Link_Level\n");
+	
+	while((i + 5) <= Length){
+		if((Data[i] != SYNC_1) || (Data[i + 1] != SYNC_2)){
+			i++;
+			continue;
+		}
+	
+		/* A false sync in the serial monitor text fails the first record's CRC */
+		Used = Decode_Packet(&Data[i],Length - i,&Bad_Pages);
+		if(Used == 0){
+			i++;
+			continue;
+		}
+		Packets++;
+		i += Used;
+	}
+	
+	fprintf(stderr,"%d dumps, %lu records, %lu not record frames, %lu missing from the sequence, %lu restarts, "
+		"%lu damaged pages\n",Packets,Records,Not_Frames,Missing,Restarts,Bad_Pages);
+	
+	return(0);
+}
@@ -0,0 +1,649 @@
+/*------------------------------------------------------------------------------------------------------
+ * Name:    Flash_Log_Sim.c
+ * Purpose: Host tool, runs Flash_Log.c against a simulated SPI NOR chip with program and erase timing
+ * Date: 		10/19/26
+ * Author:	Christopher Jordan - Denny
+ *------------------------------------------------------------------------------------------------------
+ * Note(s): Build with any C compiler from this folder:
+							cc -I../Intern_Project -o Flash_Log_Sim Flash_Log_Sim.c ../Intern_Project/Flash_Log.c
+								../Intern_Project/Telemetry.c
+						Use:	Flash_Log_Sim					(exits 1 if a check fails)
+
+						The chip:
+						---------
+						*	256 KB of 4 KB sectors and 256 byte pages, like a W25Q series part cut down
+						*	Page program and sector erase run in the background for PROGRAM_US and ERASE_US,
+							typical and worst case from the datasheet, with a random time in between for the
+							power loss runs
+						*	An erase can be suspended, SUSPEND_US until the chip takes commands, and every resume
+							costs RESUME_US of erase progress
+						*	Programming only clears bits and wraps inside the page. Programming or erasing while
+							busy, programming or erasing the suspended sector, an erase that isn't sector aligned
+							and programming bits that aren't erased are counted as misuse
+						*	A power cut clears a random part of the bits a program was clearing, or sets a
+							random part of the bits an erase was setting
+
+						Checks:
+						-------
+						*	Rate runs log a 68 byte record (a Telemetry_Pack frame) every 10, 5 and 2 ms for 60 s
+							while the flash task polls every 1 ms, the ring wraps several times. The log read
+							back has to end with the last record, be in order and only miss dropped records
+						*	Power loss runs cut the power at a random time, remount and check that every
+							record in a page that finished programming is still there, that nothing read back
+							is corrupt and that the order holds across all the restarts
+						*	A close run logs and closes, mounts the log again, closes it straight away and keeps
+							polling and appending. Nothing in the chip may change after the first close, and the
+							last record appended before it has to read back last. Flash_Log_Dump has to send
+							the same records with their CRC and the damaged page count
+ *----------------------------------------------------------------------------------------------------*/
+
+/*---------------------------------------------Include Statements-------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "Flash_Log.h"
+#include "Telemetry.h"
+/*---------------------------------------------Definitions--------------------------------------------*/
+#define CHIP_SIZE									(256*1024)
+#define PROGRAM_TYPICAL_US				700
+#define PROGRAM_WORST_US					3000
+#define ERASE_TYPICAL_US					45000
+#define ERASE_WORST_US						400000
+#define SUSPEND_US								20					// Suspend to not busy
+#define RESUME_US									200					// Erase progress lost to every suspend
+#define RECORD_LENGTH							TELEMETRY_RECORD_FRAME	// What the board logs
+#define POLL_US										1000				// Flash task period
+#define RUN_US										60000000UL	// Rate run length
+#define POWER_RUNS								1000
+#define MAX_RECORDS								200000
+
+#define OP_NONE										0
+#define OP_PROGRAM								1
+#define OP_ERASE									2
+
+#define TIMING_TYPICAL						0
+#define TIMING_WORST							1
+#define TIMING_RANDOM							2
+/*---------------------------------------------Globals------------------------------------------------*/
+static uint8_t				Memory[CHIP_SIZE];
+static uint64_t				Now = 0;										/* us */
+static uint64_t				Busy_Until = 0;
+static int						Op = OP_NONE;
+static uint32_t				Op_Address = 0;
+static uint8_t				Op_Data[FLASH_LOG_PAGE];
+static int						Op_Length = 0;
+static uint64_t				Erase_Left = 0;							/* us of a suspended erase, 0 if none */
+static uint32_t				Erase_Address = 0;
+static int						Timing = TIMING_TYPICAL;
+static unsigned long	Misuse = 0;
+static uint32_t				Durable = 0;								/* Records 0..Durable-1 are past a finished program */
+static uint8_t				Dropped[MAX_RECORDS];				/* Append turned it away */
+static uint8_t				Lost[MAX_RECORDS];					/* Still in RAM or on the chip when the power went */
+static uint8_t				Buffer[FLASH_LOG_BUFFER];
+static uint32_t				Cut_Programs = 0;						/* Power cuts in the middle of a program */
+static uint32_t				Cut_Erases = 0;
+static uint8_t				Dump[2*CHIP_SIZE];					/* Flash_Log_Dump packet */
+static long						Dump_Length = 0;
+/*---------------------------------------------Chip---------------------------------------------------*/
+
+/**
+  \fn					uint64_t Op_Time(uint64_t Typical, uint64_t Worst)
+  \brief			How long the next program or erase takes
+*/
+
+static uint64_t Op_Time(uint64_t Typical, uint64_t Worst){
+	
+	if(Timing == TIMING_WORST){
+		return(Worst);
+	}
+	if(Timing == TIMING_RANDOM){
+		/* Mostly near typical, now and then up to the worst case */
+		if((rand() % 20) == 0){
+			return(Typical + (uint64_t)rand() % (Worst - Typical));
+		}
+		return(Typical + (uint64_t)rand() % (Typical/4 + 1));
+	}
+	return(Typical);
+}
+
+/**
+  \fn					uint32_t Newest_In(const uint8_t* Page)
+  \brief			Number after the last record in a page, the records carry their number in the first
+							4 bytes
+*/
+
+static uint32_t Newest_In(const uint8_t* Page){
+	
+	uint32_t Newest = 0;
+	int Offset = FLASH_LOG_PAGE_HEADER;
+	
+	while(((Offset + 3) < FLASH_LOG_PAGE) && (Page[Offset] != FLASH_LOG_ERASED)){
+		Newest = (Page[Offset + 1] | (Page[Offset + 2] << 8) | (Page[Offset + 3] << 16) | ((uint32_t)Page[Offset + 4] << 24)) + 1;
+		Offset += FLASH_LOG_RECORD_HEADER + Page[Offset] + FLASH_LOG_RECORD_CRC;
+	}
+	
+	return(Newest);
+}
+
+/**
+  \fn					void Finish(void)
+  \brief			Lands the program or erase that was running
+*/
+
+static void Finish(void){
+	
+	int i = 0;
+	
+	if(Op == OP_PROGRAM){
+		for(i = 0;i < Op_Length;i++){
+			Memory[(Op_Address & ~(uint32_t)(FLASH_LOG_PAGE - 1)) + ((Op_Address + i) % FLASH_LOG_PAGE)] &= Op_Data[i];
+		}
+		if(Newest_In(Op_Data) > Durable){
+			Durable = Newest_In(Op_Data);
+		}
+	}
+	if(Op == OP_ERASE){
+		memset(&Memory[Op_Address],0xFF,FLASH_LOG_SECTOR);
+	}
+	
+	Op = OP_NONE;
+}
+
+static int Chip_Busy(void){
+	
+	if((Op != OP_NONE) && (Now >= Busy_Until)){
+		Finish();
+	}
+	
+	return((Op != OP_NONE) || (Now < Busy_Until));
+}
+
+static void Chip_Program(uint32_t Address, const uint8_t* Data, int Length){
+	
+	int i = 0;
+	
+	if(Chip_Busy() || (Length > FLASH_LOG_PAGE)){
+		Misuse++;
+		return;
+	}
+	if(Erase_Left && ((Address & ~(uint32_t)(FLASH_LOG_SECTOR - 1)) == Erase_Address)){
+		Misuse++;
+	}
+	for(i = 0;i < Length;i++){
+		if((Memory[Address + i] & Data[i]) != Data[i]){
+			Misuse++;
+			break;
+		}
+	}
+	
+	Op = OP_PROGRAM;
+	Op_Address = Address;
+	Op_Length = Length;
+	memcpy(Op_Data,Data,Length);
+	Busy_Until = Now + Op_Time(PROGRAM_TYPICAL_US,PROGRAM_WORST_US);
+}
+
+static void Chip_Erase(uint32_t Address){
+	
+	if(Chip_Busy() || Erase_Left || (Address % FLASH_LOG_SECTOR) || (Address >= CHIP_SIZE)){
+		Misuse++;
+		return;
+	}
+	
+	Op = OP_ERASE;
+	Op_Address = Address;
+	Busy_Until = Now + Op_Time(ERASE_TYPICAL_US,ERASE_WORST_US);
+}
+
+static void Chip_Read(uint32_t Address, uint8_t* Data, int Length){
+	
+	if(Chip_Busy()){
+		Misuse++;
+	}
+	memcpy(Data,&Memory[Address],Length);
+}
+
+static void Chip_Suspend(void){
+	
+	/* Ignored unless an erase is running, like the real part */
+	if((Op == OP_ERASE) && (Now < Busy_Until)){
+		Erase_Left = Busy_Until - Now;
+		Erase_Address = Op_Address;
+		Op = OP_NONE;
+		Busy_Until = Now + SUSPEND_US;
+	}
+}
+
+static void Chip_Resume(void){
+	
+	if(Erase_Left && (Chip_Busy() == 0)){
+		Op = OP_ERASE;
+		Op_Address = Erase_Address;
+		Busy_Until = Now + Erase_Left + RESUME_US;
+		Erase_Left = 0;
+	}
+}
+
+static const Flash_Log_Device Chip = {Chip_Busy,Chip_Program,Chip_Erase,Chip_Read,Chip_Suspend,Chip_Resume};
+static const Flash_Log_Device No_Suspend = {Chip_Busy,Chip_Program,Chip_Erase,Chip_Read,0,0};
+
+/**
+  \fn					void Power_Cut(void)
+  \brief			Leaves a program or erase half done
+*/
+
+static void Power_Cut(void){
+	
+	uint32_t Base = 0;
+	uint8_t Mask = 0;
+	int i = 0;
+	
+	if(Op == OP_PROGRAM){
+		Cut_Programs++;
+		Base = Op_Address & ~(uint32_t)(FLASH_LOG_PAGE - 1);
+		for(i = 0;i < Op_Length;i++){
+			Mask = (uint8_t)rand();
+			Memory[Base + ((Op_Address + i) % FLASH_LOG_PAGE)] &= (uint8_t)~(~Op_Data[i] & Mask);
+		}
+	}
+	if((Op == OP_ERASE) || Erase_Left){
+		Cut_Erases++;
+		Base = (Op == OP_ERASE) ? Op_Address : Erase_Address;
+		for(i = 0;i < FLASH_LOG_SECTOR;i++){
+			Memory[Base + i] |= (uint8_t)(rand() & rand());
+		}
+	}
+	
+	Op = OP_NONE;
+	Erase_Left = 0;
+	Busy_Until = Now;
+}
+/*---------------------------------------------Records------------------------------------------------*/
+
+/**
+  \fn					char Dump_Put(char Byte)
+  \brief			Flash_Log_Dump's serial port
+*/
+
+static char Dump_Put(char Byte){
+	
+	if(Dump_Length < (long)sizeof(Dump)){
+		Dump[Dump_Length++] = (uint8_t)Byte;
+	}
+	
+	return(Byte);
+}
+
+static void Make_Record(uint32_t Number, uint8_t* Record){
+	
+	int i = 0;
+	
+	for(i = 0;i < 4;i++){
+		Record[i] = (uint8_t)(Number >> (8*i));
+	}
+	for(i = 4;i < RECORD_LENGTH;i++){
+		Record[i] = (uint8_t)(Number*31 + i);
+	}
+}
+
+/**
+  \fn					int Verify(uint32_t Appended, uint32_t* Read_Count, uint32_t* Bad_Pages, uint32_t* Newest)
+  \brief			Reads the whole log back, every record after the oldest one read must be there unless
+							it was dropped or lost to a power cut
+	\param			uint32_t Appended: Records offered to Flash_Log_Append
+	\returns		int: Failures
+*/
+
+static int Verify(uint32_t Appended, uint32_t* Read_Count, uint32_t* Bad_Pages, uint32_t* Newest){
+	
+	/* Local Variables */
+	Flash_Log_Cursor Cursor;
+	uint8_t Data[FLASH_LOG_MAX_RECORD + FLASH_LOG_RECORD_CRC];
+	uint8_t Expected[RECORD_LENGTH];
+	uint32_t Number = 0;
+	uint32_t Last = 0;
+	uint32_t Count = 0;
+	uint32_t Missing = 0;
+	int Failures = 0;
+	int Length = 0;
+	
+	Flash_Log_Start_Read(&Cursor);
+	while((Length = Flash_Log_Read(&Cursor,Data)) != 0){
+	
+		Number = Data[0] | (Data[1] << 8) | (Data[2] << 16) | ((uint32_t)Data[3] << 24);
+		Make_Record(Number,Expected);
+		if((Length != RECORD_LENGTH) || (Number >= Appended) || memcmp(Data,Expected,RECORD_LENGTH)){
+			printf("  corrupt record %lu read back\n",(unsigned long)Number);
+			Failures++;
+			continue;
+		}
+		if((Count != 0) && (Number <= Last)){
+			printf("  record %lu after %lu\n",(unsigned long)Number,(unsigned long)Last);
+			Failures++;
+		}
+		if(Count != 0){
+			for(Last++;Last < Number;Last++){
+				if((Dropped[Last] == 0) && (Lost[Last] == 0)){
+					Missing++;
+				}
+			}
+		}
+	
+		Last = Number;
+		Count++;
+	}
+	
+	if(Missing != 0){
+		printf("  %lu records missing\n",(unsigned long)Missing);
+		Failures++;
+	}
+	
+	*Read_Count = Count;
+	*Bad_Pages = Cursor.Bad_Pages;
+	*Newest = Last;
+	return(Failures);
+}
+
+/**
+  \fn					void Run_For(uint64_t Length, uint64_t Period, uint32_t* Appended)
+  \brief			Appends a record every Period and polls every POLL_US
+*/
+
+static void Run_For(uint64_t Length, uint64_t Period, uint32_t* Appended){
+	
+	uint8_t Record[RECORD_LENGTH];
+	uint64_t End = Now + Length;
+	uint64_t Next_Record = Now;
+	
+	while((Now < End) && (*Appended < MAX_RECORDS)){
+		if(Now >= Next_Record){
+			Make_Record(*Appended,Record);
+			if(Flash_Log_Append(Record,RECORD_LENGTH) == 0){
+				Dropped[*Appended] = 1;
+			}
+			(*Appended)++;
+			Next_Record += Period;
+		}
+		Flash_Log_Poll();
+		Now += POLL_US;
+	}
+}
+
+/**
+  \fn					void Drain(void)
+  \brief			Flushes the last page and waits for the chip
+*/
+
+static void Drain(void){
+	
+	while(Flash_Log_Flush() == 0){
+		Now += POLL_US;
+	}
+	while(Flash_Log_Idle() == 0){
+		Now += POLL_US;
+		Flash_Log_Poll();
+	}
+}
+/*---------------------------------------------Runs---------------------------------------------------*/
+
+/**
+  \fn					int Rate_Run(const Flash_Log_Device* Device, int Mode, uint64_t Period)
+  \brief			Logs from a blank chip for RUN_US
+	\returns		int: Failures
+*/
+
+static int Rate_Run(const Flash_Log_Device* Device, int Mode, uint64_t Period){
+	
+	/* Local Variables */
+	Flash_Log_Stats* Stats;
+	uint32_t Appended = 0;
+	uint32_t Count = 0;
+	uint32_t Bad = 0;
+	uint32_t Newest = 0;
+	uint32_t Last_Kept = 0;
+	int Failures = 0;
+	
+	memset(Memory,0xFF,sizeof(Memory));
+	memset(Dropped,0,sizeof(Dropped));
+	memset(Lost,0,sizeof(Lost));
+	Now = 0;
+	Busy_Until = 0;
+	Op = OP_NONE;
+	Erase_Left = 0;
+	Misuse = 0;
+	Timing = Mode;
+	
+	Flash_Log_Init(Device,CHIP_SIZE,Buffer);
+	Run_For(RUN_US,Period,&Appended);
+	Drain();
+	Stats = Flash_Log_Get_Stats();
+	
+	Failures = Verify(Appended,&Count,&Bad,&Newest);
+	
+	/* The newest record that got in has to come back last */
+	for(Last_Kept = Appended - 1;(Last_Kept > 0) && Dropped[Last_Kept];Last_Kept--){
+		//Nop
+	}
+	if(Newest != Last_Kept){
+		printf("  last record read %lu, not %lu\n",(unsigned long)Newest,(unsigned long)Last_Kept);
+		Failures++;
+	}
+	if(Misuse != 0){
+		printf("  %lu chip misuses\n",Misuse);
+		Failures++;
+	}
+	
+	printf("%-8s %-7s %4lu Hz %8lu %7lu (%5.2f%%) %6lu %6lu %5lu %8lu %8lu %4lu  %s\n",
+		(Mode == TIMING_TYPICAL) ? "typical" : "worst",(Device->Suspend != 0) ? "yes" : "no",
+		(unsigned long)(1000000/Period),(unsigned long)Appended,(unsigned long)Stats->Dropped,
+		100.0*Stats->Dropped/Appended,(unsigned long)Stats->Pages,(unsigned long)Stats->Erases,
+		(unsigned long)Stats->Late_Erases,(unsigned long)Stats->Suspends,(unsigned long)Count,
+		(unsigned long)Bad,Failures ? "FAIL" : "ok");
+	
+	return(Failures);
+}
+
+/**
+  \fn					int Power_Runs(void)
+  \brief			Cuts the power POWER_RUNS times at random, remounting after every cut
+	\returns		int: Failures
+*/
+
+static int Power_Runs(void){
+	
+	/* Local Variables */
+	uint32_t Appended = 0;
+	uint32_t Count = 0;
+	uint32_t Bad = 0;
+	uint32_t Newest = 0;
+	uint32_t Durable_At_Cut = 0;
+	uint32_t Lost_Total = 0;
+	uint32_t Worst_Loss = 0;
+	uint32_t Loss = 0;
+	uint32_t Most_Bad = 0;
+	uint32_t i = 0;
+	int Failures = 0;
+	int Run = 0;
+	
+	memset(Memory,0xFF,sizeof(Memory));
+	memset(Dropped,0,sizeof(Dropped));
+	memset(Lost,0,sizeof(Lost));
+	Now = 0;
+	Busy_Until = 0;
+	Op = OP_NONE;
+	Erase_Left = 0;
+	Misuse = 0;
+	Durable = 0;
+	Timing = TIMING_RANDOM;
+	
+	if(Flash_Log_Init(&Chip,CHIP_SIZE,Buffer) == 0){
+		printf("  mount failed\n");
+		return(1);
+	}
+	
+	for(Run = 0;Run < POWER_RUNS;Run++){
+	
+		/* Log until the power goes */
+		Run_For(20000 + (uint64_t)rand() % 2000000,10000,&Appended);
+		Now -= POLL_US - (uint64_t)rand() % POLL_US;
+		Chip_Busy();
+		Durable_At_Cut = Durable;
+		Power_Cut();
+	
+		Loss = 0;
+		for(i = Durable_At_Cut;i < Appended;i++){
+			if((Dropped[i] == 0) && (Lost[i] == 0)){
+				Lost[i] = 1;
+				Loss++;
+			}
+		}
+		Lost_Total += Loss;
+		if(Loss > Worst_Loss){
+			Worst_Loss = Loss;
+		}
+	
+		/* Boot again, everything that finished programming has to come back */
+		Flash_Log_Init(&Chip,CHIP_SIZE,Buffer);
+		Failures += Verify(Appended,&Count,&Bad,&Newest);
+		if(Bad > Most_Bad){
+			Most_Bad = Bad;
+		}
+		if((Durable_At_Cut != 0) && ((Count == 0) || (Newest < (Durable_At_Cut - 1)))){
+			printf("  record %lu was programmed but is gone\n",(unsigned long)(Durable_At_Cut - 1));
+			Failures++;
+		}
+	}
+	
+	if(Misuse != 0){
+		printf("  %lu chip misuses\n",Misuse);
+		Failures++;
+	}
+	
+	printf("%d power cuts (%lu programming, %lu erasing), %lu records, %lu lost in RAM or mid program\n"
+		"  (at most %lu a cut), up to %lu damaged pages skipped, %lu records in the log  %s\n",
+		POWER_RUNS,(unsigned long)Cut_Programs,(unsigned long)Cut_Erases,(unsigned long)Appended,
+		(unsigned long)Lost_Total,(unsigned long)Worst_Loss,(unsigned long)Most_Bad,(unsigned long)Count,
+		Failures ? "FAIL" : "ok");
+	
+	return(Failures);
+}
+
+/**
+  \fn					int Close_Run(void)
+  \brief			Logs through an erase ahead, closes the log and checks the chip is left alone after
+	\returns		int: Failures
+*/
+
+static int Close_Run(void){
+	
+	/* Local Variables */
+	static uint8_t Closed_Memory[CHIP_SIZE];
+	uint8_t Record[RECORD_LENGTH];
+	uint32_t Appended = 0;
+	uint32_t Count = 0;
+	uint32_t Bad = 0;
+	uint32_t Newest = 0;
+	uint32_t Accepted = 0;
+	uint32_t Closes = 0;
+	uint32_t Dumped = 0;
+	long Position = 2;
+	int Length = 0;
+	int Failures = 0;
+	int i = 0;
+	
+	memset(Memory,0xFF,sizeof(Memory));
+	memset(Dropped,0,sizeof(Dropped));
+	memset(Lost,0,sizeof(Lost));
+	Now = 0;
+	Busy_Until = 0;
+	Op = OP_NONE;
+	Erase_Left = 0;
+	Misuse = 0;
+	Timing = TIMING_TYPICAL;
+	
+	/* Far enough round the ring that the oldest sectors hold records */
+	Flash_Log_Init(&Chip,CHIP_SIZE,Buffer);
+	Run_For(RUN_US/2,10000,&Appended);
+	while(Flash_Log_Close() == 0){
+		Now += POLL_US;
+	}
+	memcpy(Closed_Memory,Memory,sizeof(Memory));
+	
+	/* Mounting only reads, and a fresh mount sits right behind its oldest sector */
+	Flash_Log_Init(&Chip,CHIP_SIZE,Buffer);
+	if(memcmp(Closed_Memory,Memory,sizeof(Memory))){
+		printf("  the chip changed when mounted\n");
+		Failures++;
+	}
+	
+	for(i = 0;i < 10000;i++){
+		Make_Record(Appended,Record);
+		Closes += (uint32_t)Flash_Log_Close();
+		Accepted += (uint32_t)Flash_Log_Append(Record,RECORD_LENGTH);
+		Flash_Log_Poll();
+		Now += POLL_US;
+	}
+	if((Accepted != 0) || (Closes != 10000) || (Flash_Log_Get_Stats()->Erases != 0) ||
+		memcmp(Closed_Memory,Memory,sizeof(Memory))){
+		printf("  %lu records taken and %lu erases after the close\n",(unsigned long)Accepted,
+			(unsigned long)Flash_Log_Get_Stats()->Erases);
+		Failures++;
+	}
+	
+	Failures += Verify(Appended,&Count,&Bad,&Newest);
+	if(Newest != (Appended - 1)){
+		printf("  last record read %lu, not %lu\n",(unsigned long)Newest,(unsigned long)(Appended - 1));
+		Failures++;
+	}
+	/* Every record Verify read, then the end */
+	Dump_Length = 0;
+	if((Flash_Log_Dump(Dump_Put) == 0) || (Dump[0] != FLASH_LOG_SYNC_1) || (Dump[1] != FLASH_LOG_SYNC_2)){
+		printf("  no dump\n");
+		Failures++;
+	}
+	while(((Position + 3) < Dump_Length) && (Dump[Position] != 0)){
+		Length = Dump[Position];
+		if(Telemetry_CRC16(&Dump[Position],FLASH_LOG_RECORD_HEADER + Length,0xFFFF) !=
+			(Dump[Position + 1 + Length] | (Dump[Position + 2 + Length] << 8))){
+			break;
+		}
+		Dumped++;
+		Position += FLASH_LOG_RECORD_HEADER + Length + FLASH_LOG_RECORD_CRC;
+	}
+	if(((Position + 3) != Dump_Length) || (Dumped != Count) || ((Dump[Position + 1] | (Dump[Position + 2] << 8)) != (int)Bad)){
+		printf("  dump has %lu of %lu records\n",(unsigned long)Dumped,(unsigned long)Count);
+		Failures++;
+	}
+	if(Misuse != 0){
+		printf("  %lu chip misuses\n",Misuse);
+		Failures++;
+	}
+	
+	printf("Close: %lu records, %lu read back, chip left alone after the close, %ld byte dump  %s\n",
+		(unsigned long)Appended,(unsigned long)Count,Dump_Length,Failures ? "FAIL" : "ok");
+	
+	return(Failures);
+}
+
+int main(void){
+	
+	const uint64_t Periods[3] = {10000,5000,2000};
+	int Failures = 0;
+	int Mode = 0;
+	int i = 0;
+	
+	srand(50);
+	
+	printf("timing   suspend    rate appended dropped          pages erases  late suspends     read  bad\n");
+	for(Mode = TIMING_TYPICAL;Mode <= TIMING_WORST;Mode++){
+		for(i = 0;i < 3;i++){
+			Failures += Rate_Run(&No_Suspend,Mode,Periods[i]);
+			Failures += Rate_Run(&Chip,Mode,Periods[i]);
+		}
+	}
+	
+	Failures += Power_Runs();
+	Failures += Close_Run();
+	
+	return(Failures ? 1 : 0);
+}
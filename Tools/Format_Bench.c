@@ -0,0 +1,369 @@
+/*------------------------------------------------------------------------------------------------------
+ * Name:    Format_Bench.c
+ * Purpose: Host tool, checks Format.c against sprintf and compares their speed
+ * Date: 		10/19/26
+ * Author:	Christopher Jordan - Denny
+ *------------------------------------------------------------------------------------------------------
+ * Note(s): Build with any C compiler from this folder:
+							cc -O2 -I../Intern_Project -o Format_Bench Format_Bench.c ../Intern_Project/Format.c
+						Use:	Format_Bench					(exits 1 if a check fails)
+
+						Format_Test.c runs a short version of this on the board, where the sprintf cost is the
+						one that matters. The host has a hardware divide and float unit, so the speed ratio
+						here is far smaller than on the M0+.
+
+						Checks:
+						-------
+						*	Format_Fixed and Format_Integer over random 32 bit values, INT32_MIN included,
+							every decimal count and width, have to match a 64 bit sprintf reference exactly
+						*	Format_Float over random values has to match sprintf("%.*f") or be one count in
+							the last digit away from it, where the float multiply that scales it rounds or the
+							result is a negative zero. Only values below 2^24 once scaled are compared: it
+							scales in float, so past that the last digits are the float's rounding, not the
+							value's. The sensors stay far below it at two decimals
+						*	Random appends into small buffers: the text has to be the items that fit, whole,
+							in order, Length has to match strlen and Overflow has to be set when one was dropped
+ *----------------------------------------------------------------------------------------------------*/
+
+/*---------------------------------------------Include Statements-------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "Format.h"
+/*---------------------------------------------Definitions--------------------------------------------*/
+#define COMPARE_ITERATIONS				2000000
+#define APPEND_ITERATIONS					200000
+#define BENCH_ITERATIONS					1000000
+#define MAX_TEXT									32
+#define MAX_ITEMS									8
+/*---------------------------------------------Globals------------------------------------------------*/
+volatile int		Sink = 0;																/* Keeps the benchmark loops */
+/*---------------------------------------------Functions----------------------------------------------*/
+
+/**
+  \fn					unsigned long Random(void)
+  \brief			30 random bits, rand() may only give 15
+*/
+
+static unsigned long Random(void){
+	return((((unsigned long)rand() & 0x7FFF) << 15) | ((unsigned long)rand() & 0x7FFF));
+}
+
+/**
+  \fn					int32_t Random_Value(void)
+  \brief			Any 32 bit value, small ones and the ends of the range as often as large ones
+*/
+
+static int32_t Random_Value(void){
+	
+	unsigned long Bits = (Random() << 2) ^ Random();
+	
+	switch(rand() % 4){
+		case 0:
+			return((int32_t)(Bits % 2001) - 1000);
+		case 1:
+			return((rand() & 1) ? (int32_t)0x7FFFFFFF : (int32_t)(-0x7FFFFFFF - 1));
+		default:
+			return((int32_t)(uint32_t)Bits);
+	}
+}
+
+/**
+  \fn					void Reference_Fixed(char* Text, int32_t Value, int Decimals)
+  \brief			Format_Fixed through sprintf in 64 bits
+*/
+
+static void Reference_Fixed(char* Text, int32_t Value, int Decimals){
+	
+	long long Magnitude = (Value < 0) ? -(long long)Value : (long long)Value;
+	long long Scale = 1;
+	int i = 0;
+	
+	for(i = 0;i < Decimals;i++){
+		Scale *= 10;
+	}
+	
+	if(Decimals == 0){
+		sprintf(Text,"%s%lld",(Value < 0) ? "-" : "",Magnitude);
+	}
+	else{
+		sprintf(Text,"%s%lld.%0*lld",(Value < 0) ? "-" : "",Magnitude/Scale,Decimals,Magnitude % Scale);
+	}
+}
+
+/**
+  \fn					int Compare_Integers(void)
+  \brief			Format_Fixed and Format_Integer against sprintf
+	\returns		int: Number of mismatches
+*/
+
+static int Compare_Integers(void){
+	
+	char Fast[MAX_TEXT];
+	char Reference[MAX_TEXT];
+	Format_Buffer Text;
+	int32_t Value = 0;
+	long long Magnitude = 0;
+	int Decimals = 0;
+	int Width = 0;
+	int Mismatches = 0;
+	long i = 0;
+	
+	for(i = 0;i < COMPARE_ITERATIONS;i++){
+	
+		Value = Random_Value();
+		Decimals = rand() % 10;
+		Format_Init(&Text,Fast,sizeof(Fast));
+		Format_Fixed(&Text,Value,Decimals);
+		Reference_Fixed(Reference,Value,Decimals);
+		if((strcmp(Fast,Reference) != 0) || (Text.Length != (int)strlen(Reference)) || Text.Overflow){
+			if(Mismatches < 5){
+				printf("Fixed %ld, %d decimals: \"%s\", expected \"%s\"\n",(long)Value,Decimals,Fast,Reference);
+			}
+			Mismatches++;
+		}
+	
+		Width = rand() % 11;
+		Magnitude = (Value < 0) ? -(long long)Value : (long long)Value;
+		Format_Init(&Text,Fast,sizeof(Fast));
+		Format_Integer(&Text,Value,Width);
+		sprintf(Reference,"%s%0*lld",(Value < 0) ? "-" : "",(Width > 0) ? Width : 1,Magnitude);
+		if((strcmp(Fast,Reference) != 0) || (Text.Length != (int)strlen(Reference)) || Text.Overflow){
+			if(Mismatches < 5){
+				printf("Integer %ld, width %d: \"%s\", expected \"%s\"\n",(long)Value,Width,Fast,Reference);
+			}
+			Mismatches++;
+		}
+	}
+	
+	return(Mismatches);
+}
+
+/**
+  \fn					int Compare_Floats(long* Boundaries, long* Beyond)
+  \brief			Format_Float against sprintf("%.*f")
+	\param			long* Boundaries: Set to the values one count away from sprintf
+	\param			long* Beyond: Set to the values not compared, past 2^24 once scaled
+	\returns		int: Number of values further away than that
+*/
+
+static int Compare_Floats(long* Boundaries, long* Beyond){
+	
+	/* Ranges the sensors give, and past what 32 bits hold once scaled */
+	const float Ranges[4] = {2.0f,2000.0f,100000.0f,1e9f};
+	char Fast[MAX_TEXT];
+	char Reference[MAX_TEXT];
+	Format_Buffer Text;
+	float Value = 0.0f;
+	double Difference = 0.0;
+	double Count = 1.0;
+	int Decimals = 0;
+	int Mismatches = 0;
+	long i = 0;
+	int j = 0;
+	
+	*Boundaries = 0;
+	*Beyond = 0;
+	for(i = 0;i < COMPARE_ITERATIONS;i++){
+	
+		Decimals = rand() % 5;
+		Value = ((float)Random()/(float)(1UL << 30)*2.0f - 1.0f)*Ranges[rand() % 4];
+		for(j = 0,Count = 1.0;j < Decimals;j++){
+			Count /= 10.0;
+		}
+	
+		/* Past 2^24 once scaled the float has fewer digits than asked for, Format_Float scales in float */
+		if(((Value/Count) >= 16777216.0) || ((Value/Count) <= -16777216.0)){
+			(*Beyond)++;
+			continue;
+		}
+	
+		Format_Init(&Text,Fast,sizeof(Fast));
+		Format_Float(&Text,Value,Decimals);
+		sprintf(Reference,"%.*f",Decimals,(double)Value);
+		if(strcmp(Fast,Reference) == 0){
+			continue;
+		}
+	
+		/* Same value apart from the sign of a zero, or one count apart */
+		Difference = atof(Fast) - atof(Reference);
+		if((Difference < (Count*1.01)) && (Difference > -(Count*1.01))){
+			(*Boundaries)++;
+			continue;
+		}
+	
+		if(Mismatches < 5){
+			printf("Float %.9g, %d decimals: \"%s\", expected \"%s\"\n",(double)Value,Decimals,Fast,Reference);
+		}
+		Mismatches++;
+	}
+	
+	return(Mismatches);
+}
+
+/**
+  \fn					int Check_Appends(void)
+  \brief			Random items into buffers too small for all of them, what fits has to go in whole
+	\returns		int: Number of failures
+*/
+
+static int Check_Appends(void){
+	
+	char Small[MAX_TEXT];
+	char Item[MAX_TEXT];
+	char Expected[MAX_TEXT*MAX_ITEMS];
+	Format_Buffer Text;
+	Format_Buffer Alone;
+	int Expected_Length = 0;
+	int Dropped = 0;
+	int Size = 0;
+	int Items = 0;
+	int Added = 0;
+	int Fits = 0;
+	int Failures = 0;
+	long i = 0;
+	int j = 0;
+	
+	for(i = 0;i < APPEND_ITERATIONS;i++){
+	
+		Size = 1 + rand() % MAX_TEXT;
+		Items = 1 + rand() % MAX_ITEMS;
+		Format_Init(&Text,Small,Size);
+		Expected[0] = '\0';
+		Expected_Length = 0;
+		Dropped = 0;
+	
+		for(j = 0;j < Items;j++){
+	
+			/* The item on its own, then into the small buffer */
+			Format_Init(&Alone,Item,sizeof(Item));
+			switch(rand() % 5){
+				case 0:
+					Format_Char(&Alone,',');
+					Added = Format_Char(&Text,',');
+					break;
+				case 1:
+					Format_String(&Alone,&"$GPS,hello"[rand() % 10]);
+					Added = Format_String(&Text,Item);
+					break;
+				case 2:
+					Format_Fixed(&Alone,Random_Value(),rand() % 10);
+					Added = Format_String(&Text,Item);
+					break;
+				case 3:
+					Format_Integer(&Alone,Random_Value(),rand() % 11);
+					Added = Format_String(&Text,Item);
+					break;
+				default:
+					Format_Float(&Alone,(float)Random_Value()/1000.0f,rand() % 4);
+					Added = Format_String(&Text,Item);
+					break;
+			}
+	
+			Fits = ((Expected_Length + Alone.Length) < Size);
+			if(Fits){
+				strcat(Expected,Item);
+				Expected_Length += Alone.Length;
+			}
+			else{
+				Dropped = 1;
+			}
+			if(Added != Fits){
+				Failures++;
+			}
+		}
+	
+		if((strcmp(Small,Expected) != 0) || (Text.Length != (int)strlen(Small)) || (Text.Overflow != Dropped)){
+			if(Failures < 5){
+				printf("Size %d: \"%s\" (overflow %d), expected \"%s\" (overflow %d)\n",Size,Small,Text.Overflow,
+					Expected,Dropped);
+			}
+			Failures++;
+		}
+	}
+	
+	return(Failures);
+}
+
+/**
+  \fn					void Benchmark(void)
+  \brief			A sensor frame of nine fields, the way ISK01A1_Package_Data built it before and after
+*/
+
+static void Benchmark(void){
+	
+	const float Frame[9] = {21.53f,45.2f,-12.2f,3.05f,998.7f,120.25f,-87.5f,4.0f,1013.25f};
+	const int32_t Fixed_Frame[9] = {2153,4520,-1220,305,99870,12025,-8750,400,101325};
+	char Data[160];
+	Format_Buffer Text;
+	clock_t Start = 0;
+	double Float_Ns = 0;
+	double Fixed_Ns = 0;
+	double Two_Ns = 0;
+	double Sprintf_Ns = 0;
+	long i = 0;
+	int j = 0;
+	
+	Start = clock();
+	for(i = 0;i < BENCH_ITERATIONS;i++){
+		Format_Init(&Text,Data,sizeof(Data));
+		for(j = 0;j < 9;j++){
+			Format_Float(&Text,Frame[j],2);
+			Format_Char(&Text,',');
+		}
+		Sink += Text.Length;
+	}
+	Float_Ns = (double)(clock() - Start)*1e9/CLOCKS_PER_SEC/BENCH_ITERATIONS;
+	
+	Start = clock();
+	for(i = 0;i < BENCH_ITERATIONS;i++){
+		Format_Init(&Text,Data,sizeof(Data));
+		for(j = 0;j < 9;j++){
+			Format_Fixed(&Text,Fixed_Frame[j],2);
+			Format_Char(&Text,',');
+		}
+		Sink += Text.Length;
+	}
+	Fixed_Ns = (double)(clock() - Start)*1e9/CLOCKS_PER_SEC/BENCH_ITERATIONS;
+	
+	Start = clock();
+	for(i = 0;i < BENCH_ITERATIONS;i++){
+		Sink += sprintf(Data,"%.2f,%.2f,%.2f,%.2f,%.2f,%.2f,%.2f,%.2f,%.2f,",Frame[0],Frame[1],Frame[2],Frame[3],
+			Frame[4],Frame[5],Frame[6],Frame[7],Frame[8]);
+	}
+	Two_Ns = (double)(clock() - Start)*1e9/CLOCKS_PER_SEC/BENCH_ITERATIONS;
+	
+	Start = clock();
+	for(i = 0;i < BENCH_ITERATIONS;i++){
+		Sink += sprintf(Data,"%f,%f,%f,%f,%f,%f,%f,%f,%f",Frame[0],Frame[1],Frame[2],Frame[3],Frame[4],
+			Frame[5],Frame[6],Frame[7],Frame[8]);
+	}
+	Sprintf_Ns = (double)(clock() - Start)*1e9/CLOCKS_PER_SEC/BENCH_ITERATIONS;
+	
+	printf("9 field sensor frame: Format_Float %.0f ns, Format_Fixed %.0f ns, sprintf %%.2f %.0f ns (%.1fx), "
+		"sprintf %%f %.0f ns (%.1fx)\n",Float_Ns,Fixed_Ns,Two_Ns,Two_Ns/Float_Ns,Sprintf_Ns,Sprintf_Ns/Float_Ns);
+}
+
+int main(void){
+	
+	long Boundaries = 0;
+	long Beyond = 0;
+	int Integers = 0;
+	int Floats = 0;
+	int Appends = 0;
+	
+	srand(29);
+	
+	Integers = Compare_Integers();
+	Floats = Compare_Floats(&Boundaries,&Beyond);
+	Appends = Check_Appends();
+	printf("Fixed and integer mismatches: %d of %d\n",Integers,2*COMPARE_ITERATIONS);
+	printf("Float mismatches: %d, %ld one count off from the float scaling or a negative zero, %ld past 2^24 not compared\n",
+		Floats,Boundaries,Beyond);
+	printf("Append failures: %d of %d buffers\n",Appends,APPEND_ITERATIONS);
+	
+	Benchmark();
+	
+	return((Integers || Floats || Appends) ? 1 : 0);
+}
@@ -0,0 +1,563 @@
+/*------------------------------------------------------------------------------------------------------
+ * Name:    GPS_Bench.c
+ * Purpose: Host tool, compares bytes per fix and parse cost of the NMEA and MTK binary GPS inputs
+ * Date: 		10/19/26
+ * Author:	Christopher Jordan - Denny
+ *------------------------------------------------------------------------------------------------------
+ * Note(s): Build with any C compiler from this folder:
+							cc -O2 -I../Intern_Project -o GPS_Bench GPS_Bench.c ../Intern_Project/NMEA_Parse.c
+						Use:	GPS_Bench					(exits 1 if the two inputs decode differently)
+
+						*	A 5 Hz flight of FIXES fixes is sent both ways: a GGA and RMC sentence pair like
+							the module prints them, and one 37 byte MTK binary message
+						*	Each stream goes through the same steps FGPMMOPA6H.c takes: the USART1 receive
+							code one byte at a time, then FGPMMOPA6H_Decode_NMEA or FGPMMOPA6H_Decode_Binary.
+							FGPMMOPA6H.c needs the chip headers, so its receive, split and decode code is
+							copied here, keep them in step. The field conversions are the real NMEA_Parse.c
+						*	Every decoded fix is checked against the fix that was sent
+						*	Parse cost is host time, only the ratio carries over to the M0+, which also pays
+							for strtok and strcpy out of the C library
+ *----------------------------------------------------------------------------------------------------*/
+
+/*---------------------------------------------Include Statements-------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <time.h>
+#include "NMEA_Parse.h"
+/*---------------------------------------------Definitions--------------------------------------------*/
+#define FIXES											20000
+#define REPEATS										50						// Passes over each stream for the timing
+#define BAUD											9600
+#define BITS_PER_BYTE							10						// Start, 8 data, stop
+#define NMEA_LENGTH								128						// ARENA_NMEA_LINE
+
+#define MTK_PREAMBLE1_V19					0xD1
+#define MTK_PREAMBLE2							0xDD
+#define MTK_PAYLOAD_LENGTH				32
+#define MTK_MESSAGE_LENGTH				(3 + MTK_PAYLOAD_LENGTH + 2)
+#define MTK_LATITUDE							0
+#define MTK_LONGITUDE							4
+#define MTK_ALTITUDE							8
+#define MTK_GROUND_SPEED					12
+#define MTK_COURSE								16
+#define MTK_SATELLITES						20
+#define MTK_FIX_TYPE							21
+#define MTK_DATE									22
+#define MTK_TIME									26
+#define MTK_HDOP									30
+/*---------------------------------------------Types--------------------------------------------------*/
+/* Same fields as GPS_Fix in FGPMMOPA6H.h */
+typedef struct Bench_Fix
+{
+	int Valid;
+	int32_t Latitude;
+	int32_t Longitude;
+	int32_t Altitude;
+	int32_t Ground_Speed;
+	int32_t Course;
+	uint8_t Satellites;
+	uint8_t Fix_Type;
+	uint32_t Date;
+	uint32_t Time;
+}Bench_Fix;
+
+/* Same sizes as RMC_Data and GGA_Data in FGPMMOPA6H.h */
+typedef struct RMC_Data
+{
+	int New_Data_Ready;
+	char Message_ID[7];
+	char UTC_Time[11];
+	char Status[2];
+	char Latitude[10];
+	char N_S_Indicator[3];
+	char Longitude[11];
+	char E_W_Indicator[3];
+	char Speed_Over_Ground[8];
+	char Course_Over_Ground[7];
+	char Date[7];
+	char Mode[5];
+}RMC_Data;
+
+typedef struct GGA_Data
+{
+	int New_Data_Ready;
+	char Message_ID[7];
+	char UTC_Time[11];
+	char Latitude[10];
+	char N_S_Indicator[3];
+	char Longitude[11];
+	char E_W_Indicator[3];
+	char Position_Indicator[2];
+	char Satellites_Used[3];
+	char HDOP[5];
+	char MSL_Altitude[9];
+	char Units_Altitude[2];
+	char Geoidal_Seperation[6];
+	char Units_Geoidal_Seperation[2];
+	char Age_Of_Diff_Corr[5];
+	char Checksum[3];
+}GGA_Data;
+
+typedef struct NMEA_Field
+{
+	uint16_t Offset;
+	uint16_t Size;
+}NMEA_Field;
+
+#define FIELD(Type,Member)	{offsetof(Type,Member),sizeof(((Type*)0)->Member)}
+/*---------------------------------------------Tables-------------------------------------------------*/
+static const NMEA_Field GGA_Fields[] = {
+	FIELD(GGA_Data,Message_ID),FIELD(GGA_Data,UTC_Time),FIELD(GGA_Data,Latitude),
+	FIELD(GGA_Data,N_S_Indicator),FIELD(GGA_Data,Longitude),FIELD(GGA_Data,E_W_Indicator),
+	FIELD(GGA_Data,Position_Indicator),FIELD(GGA_Data,Satellites_Used),FIELD(GGA_Data,HDOP),
+	FIELD(GGA_Data,MSL_Altitude),FIELD(GGA_Data,Units_Altitude),FIELD(GGA_Data,Geoidal_Seperation),
+	FIELD(GGA_Data,Units_Geoidal_Seperation),FIELD(GGA_Data,Age_Of_Diff_Corr),FIELD(GGA_Data,Checksum)
+};
+#define GGA_FIELDS		((int)(sizeof(GGA_Fields)/sizeof(GGA_Fields[0])))
+
+static const NMEA_Field RMC_Fields[] = {
+	FIELD(RMC_Data,Message_ID),FIELD(RMC_Data,UTC_Time),FIELD(RMC_Data,Status),
+	FIELD(RMC_Data,Latitude),FIELD(RMC_Data,N_S_Indicator),FIELD(RMC_Data,Longitude),
+	FIELD(RMC_Data,E_W_Indicator),FIELD(RMC_Data,Speed_Over_Ground),FIELD(RMC_Data,Course_Over_Ground),
+	FIELD(RMC_Data,Date),FIELD(RMC_Data,Mode)
+};
+#define RMC_FIELDS		((int)(sizeof(RMC_Fields)/sizeof(RMC_Fields[0])))
+
+static const char GGA_Tag[] = "$GPGGA";
+static const char RMC_Tag[] = "$GPRMC";
+/*---------------------------------------------Globals------------------------------------------------*/
+static Bench_Fix			Sent[FIXES];
+static Bench_Fix			Decoded[FIXES];
+static int32_t				Sent_Minutes[FIXES][2];			/* 1e-4 minutes of the latitude and longitude */
+static int32_t				Sent_Knots[FIXES];					/* Hundredths */
+static int						Decoded_Count = 0;
+static unsigned char*	NMEA_Stream = 0;
+static long						NMEA_Bytes = 0;
+static unsigned char	MTK_Stream[FIXES*MTK_MESSAGE_LENGTH];
+static long						MTK_Bytes = 0;
+
+/* FGPMMOPA6H.c state */
+static char						Rx_Data[NMEA_LENGTH];
+static int						CharIndex = 0;
+static int						Transmission_In_Progress = 0;
+static char						GGA_Message[NMEA_LENGTH];
+static char						RMC_Message[NMEA_LENGTH];
+static char						NMEA_Copy[NMEA_LENGTH];
+static RMC_Data				RMC;
+static GGA_Data				GGA;
+static Bench_Fix			Fix;
+static uint8_t				MTK_Buffer[MTK_PAYLOAD_LENGTH];
+static uint8_t				MTK_Message[MTK_PAYLOAD_LENGTH];
+static int						MTK_New_Data_Ready = 0;
+/*---------------------------------------------Flight-------------------------------------------------*/
+
+/**
+  \fn					void Make_Flight(void)
+  \brief			A climb, a drift and a descent at 5 Hz, every value at the resolution NMEA carries so
+							both inputs can decode it exactly
+*/
+
+static void Make_Flight(void){
+	
+	int32_t Lat_Minutes = 70380;								/* 1e-4 minutes past 48 N */
+	int32_t Lon_Minutes = 310000;								/* 1e-4 minutes past 11 W */
+	int32_t Altitude = 54540;										/* cm, GGA has decimeters */
+	int32_t Knots = 0;													/* Hundredths */
+	uint32_t Day_Ms = 12*3600000UL + 35*60000UL + 19000;
+	int i = 0;
+	
+	srand(27);
+	for(i = 0;i < FIXES;i++){
+		Lat_Minutes += rand() % 41 - 20;
+		Lon_Minutes += rand() % 41 - 20;
+		Altitude += (i < FIXES/4) ? 10*(rand() % 13) : -10*(rand() % 3);
+		if(Altitude < 0){
+			Altitude = 0;
+		}
+		Knots = rand() % 50000;
+	
+		Sent[i].Valid = 1;
+		Sent[i].Fix_Type = 3;
+		Sent[i].Latitude = 48*1000000 + (Lat_Minutes*100 + 30)/60;
+		Sent[i].Longitude = -(11*1000000 + (Lon_Minutes*100 + 30)/60);
+		Sent[i].Altitude = Altitude;
+		Sent[i].Ground_Speed = (Knots*1286 + 1250)/2500;
+		Sent[i].Course = rand() % 36000;
+		Sent[i].Satellites = (uint8_t)(4 + rand() % 9);
+		Sent[i].Date = 191026;
+		Sent[i].Time = (Day_Ms/3600000)*10000000 + (Day_Ms/60000 % 60)*100000 + (Day_Ms % 60000);
+		Day_Ms += 200;
+		Sent_Minutes[i][0] = Lat_Minutes;
+		Sent_Minutes[i][1] = Lon_Minutes;
+		Sent_Knots[i] = Knots;
+	}
+}
+
+/**
+  \fn					int Add_Sentence(char* Out, const char* Body)
+  \brief			$Body*CS\r\n, returns its length
+*/
+
+static int Add_Sentence(char* Out, const char* Body){
+	
+	unsigned int Checksum = 0;
+	const char* c = Body;
+	
+	while(*c){
+		Checksum ^= (unsigned char)*c++;
+	}
+	
+	return(sprintf(Out,"$%s*%02X\r\n",Body,Checksum));
+}
+
+/**
+  \fn					void Make_Streams(void)
+  \brief			GGA then RMC per fix like the module, and the MTK binary message per fix
+*/
+
+static void Make_Streams(void){
+	
+	char Body[128];
+	char Time[16];
+	char Lat[24];
+	char Lon[24];
+	uint8_t* Message = 0;
+	uint8_t CK_A = 0;
+	uint8_t CK_B = 0;
+	int32_t Values[5];
+	int Offsets[5] = {MTK_LATITUDE,MTK_LONGITUDE,MTK_ALTITUDE,MTK_GROUND_SPEED,MTK_COURSE};
+	Bench_Fix* F = 0;
+	int i = 0;
+	int j = 0;
+	int k = 0;
+	
+	NMEA_Stream = malloc((size_t)FIXES*2*NMEA_LENGTH);
+	
+	for(i = 0;i < FIXES;i++){
+		F = &Sent[i];
+	
+		sprintf(Time,"%02lu%02lu%02lu.%03lu",(unsigned long)(F->Time/10000000),(unsigned long)(F->Time/100000 % 100),
+			(unsigned long)(F->Time/1000 % 100),(unsigned long)(F->Time % 1000));
+		sprintf(Lat,"48%02ld.%04ld",(long)(Sent_Minutes[i][0]/10000),(long)(Sent_Minutes[i][0] % 10000));
+		sprintf(Lon,"011%02ld.%04ld",(long)(Sent_Minutes[i][1]/10000),(long)(Sent_Minutes[i][1] % 10000));
+	
+		sprintf(Body,"GPGGA,%s,%s,N,%s,W,1,%02u,0.95,%ld.%ld,M,47.9,M,,",Time,Lat,Lon,F->Satellites,
+			(long)(F->Altitude/100),(long)(F->Altitude % 100)/10);
+		NMEA_Bytes += Add_Sentence((char*)&NMEA_Stream[NMEA_Bytes],Body);
+		sprintf(Body,"GPRMC,%s,A,%s,N,%s,W,%ld.%02ld,%ld.%02ld,%06lu,,,A",Time,Lat,Lon,
+			(long)(Sent_Knots[i]/100),(long)(Sent_Knots[i] % 100),
+			(long)(F->Course/100),(long)(F->Course % 100),(unsigned long)F->Date);
+		NMEA_Bytes += Add_Sentence((char*)&NMEA_Stream[NMEA_Bytes],Body);
+	
+		/* Binary, v1.9 carries 1e-7 degrees */
+		Message = &MTK_Stream[MTK_Bytes];
+		memset(Message,0,MTK_MESSAGE_LENGTH);
+		Message[0] = MTK_PREAMBLE1_V19;
+		Message[1] = MTK_PREAMBLE2;
+		Message[2] = MTK_PAYLOAD_LENGTH;
+		Values[0] = F->Latitude*10;
+		Values[1] = F->Longitude*10;
+		Values[2] = F->Altitude;
+		Values[3] = F->Ground_Speed;
+		Values[4] = F->Course;
+		for(j = 0;j < 5;j++){
+			for(k = 0;k < 4;k++){
+				Message[3 + Offsets[j] + k] = (uint8_t)((uint32_t)Values[j] >> (8*k));
+			}
+		}
+		Message[3 + MTK_SATELLITES] = F->Satellites;
+		Message[3 + MTK_FIX_TYPE] = F->Fix_Type;
+		for(k = 0;k < 4;k++){
+			Message[3 + MTK_DATE + k] = (uint8_t)(F->Date >> (8*k));
+			Message[3 + MTK_TIME + k] = (uint8_t)(F->Time >> (8*k));
+		}
+		Message[3 + MTK_HDOP] = 95;
+		CK_A = 0;
+		CK_B = 0;
+		for(j = 2;j < 3 + MTK_PAYLOAD_LENGTH;j++){
+			CK_A += Message[j];
+			CK_B += CK_A;
+		}
+		Message[3 + MTK_PAYLOAD_LENGTH] = CK_A;
+		Message[4 + MTK_PAYLOAD_LENGTH] = CK_B;
+		MTK_Bytes += MTK_MESSAGE_LENGTH;
+	}
+}
+/*---------------------------------------------NMEA Path (FGPMMOPA6H.c)-------------------------------*/
+
+static void Copy_Field(char* Field, int Size, const char* Token){
+	
+	strncpy(Field,Token,Size - 1);
+	Field[Size - 1] = '\0';
+}
+
+static void NMEA_Receive(char Byte){
+	
+	Rx_Data[CharIndex] = Byte;
+	RMC.New_Data_Ready = 0;
+	GGA.New_Data_Ready = 0;
+	
+	if(Rx_Data[CharIndex] == '$'){
+		Transmission_In_Progress = 1;
+	}
+	if(Transmission_In_Progress){
+		if(Rx_Data[CharIndex] == '\n'){
+			if(strncmp(GGA_Tag,Rx_Data,(sizeof(GGA_Tag)-1)) == 0){
+				strcpy(GGA_Message,Rx_Data);
+				GGA.New_Data_Ready = 1;
+			}
+			if(strncmp(RMC_Tag,Rx_Data,(sizeof(RMC_Tag)-1)) == 0){
+				strcpy(RMC_Message,Rx_Data);
+				RMC.New_Data_Ready = 1;
+			}
+			Transmission_In_Progress = 0;
+			CharIndex = 0;
+			memset(Rx_Data,0,NMEA_LENGTH);
+		}
+		else if(CharIndex < (NMEA_LENGTH - 1)){
+			CharIndex++;
+		}
+		else{
+			Transmission_In_Progress = 0;
+			CharIndex = 0;
+			memset(Rx_Data,0,NMEA_LENGTH);
+		}
+	}
+}
+
+static void Split(const char* Message, char* Data, const NMEA_Field* Fields, int Count){
+	
+	char* Token = 0;
+	int i = 0;
+	
+	strcpy(NMEA_Copy,Message);
+	Token = strtok(NMEA_Copy,",");
+	while((Token != NULL) && (i < Count)){
+		Copy_Field(Data + Fields[i].Offset,Fields[i].Size,Token);
+		i++;
+		Token = strtok(NULL,",");
+	}
+}
+
+static void Decode_NMEA(void){
+	
+	int32_t Value = 0;
+	
+	Split(RMC_Message,(char*)&RMC,RMC_Fields,RMC_FIELDS);
+	Split(GGA_Message,(char*)&GGA,GGA_Fields,GGA_FIELDS);
+	
+	NMEA_Parse_Coordinate(RMC.Latitude,RMC.N_S_Indicator[0],&Fix.Latitude);
+	NMEA_Parse_Coordinate(RMC.Longitude,RMC.E_W_Indicator[0],&Fix.Longitude);
+	NMEA_Parse_Meters(GGA.MSL_Altitude,&Fix.Altitude);
+	NMEA_Parse_Knots(RMC.Speed_Over_Ground,&Fix.Ground_Speed);
+	NMEA_Parse_Fixed(RMC.Course_Over_Ground,2,&Fix.Course);
+	NMEA_Parse_Time(RMC.UTC_Time,&Fix.Time);
+	if(NMEA_Parse_Fixed(GGA.Satellites_Used,0,&Value)){
+		Fix.Satellites = (uint8_t)Value;
+	}
+	if(NMEA_Parse_Fixed(RMC.Date,0,&Value)){
+		Fix.Date = (uint32_t)Value;
+	}
+	Fix.Valid = (strcmp(RMC.Status,"A") == 0);
+	Fix.Fix_Type = Fix.Valid ? 3 : 1;
+	
+	RMC.New_Data_Ready = 0;
+	GGA.New_Data_Ready = 0;
+}
+/*---------------------------------------------MTK Binary Path (FGPMMOPA6H.c)-------------------------*/
+
+static void MTK_Binary_Receive(uint8_t Data){
+	
+	static uint8_t Step = 0;
+	static uint8_t Index = 0;
+	static uint8_t CK_A = 0;
+	static uint8_t CK_B = 0;
+	
+	switch(Step){
+		case 0:
+			if(Data == MTK_PREAMBLE1_V19){
+				Step++;
+			}
+			break;
+		case 1:
+			Step = (Data == MTK_PREAMBLE2) ? 2 : 0;
+			break;
+		case 2:
+			if(Data == MTK_PAYLOAD_LENGTH){
+				CK_A = Data;
+				CK_B = Data;
+				Index = 0;
+				Step++;
+			}
+			else Step = 0;
+			break;
+		case 3:
+			MTK_Buffer[Index++] = Data;
+			CK_A += Data;
+			CK_B += CK_A;
+			if(Index == MTK_PAYLOAD_LENGTH){
+				Step++;
+			}
+			break;
+		case 4:
+			Step = (Data == CK_A) ? 5 : 0;
+			break;
+		case 5:
+			if(Data == CK_B){
+				memcpy(MTK_Message,MTK_Buffer,MTK_PAYLOAD_LENGTH);
+				MTK_New_Data_Ready = 1;
+			}
+			Step = 0;
+			break;
+		default:
+			Step = 0;
+			break;
+	}
+}
+
+static int32_t Read_Int32(uint8_t* Buffer, int Offset){
+	return((int32_t)((uint32_t)Buffer[Offset] | ((uint32_t)Buffer[Offset + 1] << 8) |
+		((uint32_t)Buffer[Offset + 2] << 16) | ((uint32_t)Buffer[Offset + 3] << 24)));
+}
+
+static void Decode_Binary(void){
+	
+	uint8_t Payload[MTK_PAYLOAD_LENGTH];
+	
+	memcpy(Payload,MTK_Message,MTK_PAYLOAD_LENGTH);
+	MTK_New_Data_Ready = 0;
+	
+	Fix.Latitude = Read_Int32(Payload,MTK_LATITUDE) / 10;
+	Fix.Longitude = Read_Int32(Payload,MTK_LONGITUDE) / 10;
+	Fix.Altitude = Read_Int32(Payload,MTK_ALTITUDE);
+	Fix.Ground_Speed = Read_Int32(Payload,MTK_GROUND_SPEED);
+	Fix.Course = Read_Int32(Payload,MTK_COURSE);
+	Fix.Satellites = Payload[MTK_SATELLITES];
+	Fix.Date = (uint32_t)Read_Int32(Payload,MTK_DATE);
+	Fix.Time = (uint32_t)Read_Int32(Payload,MTK_TIME);
+	Fix.Fix_Type = Payload[MTK_FIX_TYPE];
+	if(Fix.Fix_Type > 3){
+		Fix.Fix_Type -= 4;
+	}
+	Fix.Valid = (Fix.Fix_Type >= 2);
+}
+/*---------------------------------------------Runs---------------------------------------------------*/
+
+/**
+  \fn					void Run_NMEA(void)
+  \brief			The whole NMEA stream through the receive and decode, FGPMMOPA6H_Fix_Ready is the RMC flag
+*/
+
+static void Run_NMEA(void){
+	
+	long i = 0;
+	
+	Decoded_Count = 0;
+	for(i = 0;i < NMEA_Bytes;i++){
+		NMEA_Receive((char)NMEA_Stream[i]);
+		if(RMC.New_Data_Ready){
+			Decode_NMEA();
+			Decoded[Decoded_Count++ % FIXES] = Fix;
+		}
+	}
+}
+
+static void Run_MTK(void){
+	
+	long i = 0;
+	
+	Decoded_Count = 0;
+	for(i = 0;i < MTK_Bytes;i++){
+		MTK_Binary_Receive(MTK_Stream[i]);
+		if(MTK_New_Data_Ready){
+			Decode_Binary();
+			Decoded[Decoded_Count++ % FIXES] = Fix;
+		}
+	}
+}
+
+/**
+  \fn					int Check(const char* Name)
+  \brief			Every fix sent came out of the run unchanged
+	\returns		int: Fixes that didn't
+*/
+
+static int Check(const char* Name){
+	
+	int Failures = 0;
+	int i = 0;
+	
+	for(i = 0;i < FIXES;i++){
+		if((Decoded[i].Valid != Sent[i].Valid) || (Decoded[i].Fix_Type != Sent[i].Fix_Type) ||
+			(Decoded[i].Latitude != Sent[i].Latitude) || (Decoded[i].Longitude != Sent[i].Longitude) ||
+			(Decoded[i].Altitude != Sent[i].Altitude) || (Decoded[i].Ground_Speed != Sent[i].Ground_Speed) ||
+			(Decoded[i].Course != Sent[i].Course) || (Decoded[i].Satellites != Sent[i].Satellites) ||
+			(Decoded[i].Date != Sent[i].Date) || (Decoded[i].Time != Sent[i].Time)){
+			if(Failures == 0){
+				printf("%s fix %d: lat %ld/%ld lon %ld/%ld alt %ld/%ld speed %ld/%ld time %lu/%lu\n",Name,i,
+					(long)Decoded[i].Latitude,(long)Sent[i].Latitude,(long)Decoded[i].Longitude,(long)Sent[i].Longitude,
+					(long)Decoded[i].Altitude,(long)Sent[i].Altitude,(long)Decoded[i].Ground_Speed,
+					(long)Sent[i].Ground_Speed,(unsigned long)Decoded[i].Time,(unsigned long)Sent[i].Time);
+			}
+			Failures++;
+		}
+	}
+	if(Decoded_Count != FIXES){
+		Failures++;
+	}
+	
+	return(Failures);
+}
+
+/**
+  \fn					double Time_Run(void (*Run)(void))
+  \brief			Host ns per fix of a run
+*/
+
+static double Time_Run(void (*Run)(void)){
+	
+	clock_t Start = 0;
+	int i = 0;
+	
+	Start = clock();
+	for(i = 0;i < REPEATS;i++){
+		Run();
+	}
+	
+	return((double)(clock() - Start) * 1e9 / CLOCKS_PER_SEC / ((double)REPEATS*FIXES));
+}
+
+int main(void){
+	
+	int NMEA_Failures = 0;
+	int MTK_Failures = 0;
+	double NMEA_Ns = 0;
+	double MTK_Ns = 0;
+	double NMEA_Per_Fix = 0;
+	double MTK_Per_Fix = 0;
+	
+	Make_Flight();
+	Make_Streams();
+	
+	Run_NMEA();
+	NMEA_Failures = Check("NMEA");
+	Run_MTK();
+	MTK_Failures = Check("MTK");
+	
+	NMEA_Ns = Time_Run(Run_NMEA);
+	MTK_Ns = Time_Run(Run_MTK);
+	NMEA_Per_Fix = (double)NMEA_Bytes/FIXES;
+	MTK_Per_Fix = (double)MTK_Bytes/FIXES;
+	
+	printf("%d fixes         bytes/fix  UART ms/fix at %d  parse ns/fix  bad fixes\n",FIXES,BAUD);
+	printf("NMEA GGA+RMC     %9.1f  %18.1f  %12.0f  %9d\n",NMEA_Per_Fix,NMEA_Per_Fix*BITS_PER_BYTE*1000/BAUD,NMEA_Ns,NMEA_Failures);
+	printf("MTK binary       %9.1f  %18.1f  %12.0f  %9d\n",MTK_Per_Fix,MTK_Per_Fix*BITS_PER_BYTE*1000/BAUD,MTK_Ns,MTK_Failures);
+	printf("binary is %.1fx fewer bytes and %.1fx less parse time\n",NMEA_Per_Fix/MTK_Per_Fix,NMEA_Ns/MTK_Ns);
+	
+	free(NMEA_Stream);
+	
+	return((NMEA_Failures || MTK_Failures) ? 1 : 0);
+}
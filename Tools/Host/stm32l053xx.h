@@ -0,0 +1,23 @@
+/*------------------------------------------------------------------------------------------------------
+ * Name:    stm32l053xx.h
+ * Purpose: Host tool shim, stands in for the device header so board sources build on the host
+ * Date: 		10/19/26
+ * Author:	Christopher Jordan - Denny
+ *------------------------------------------------------------------------------------------------------
+ * Note(s): Put -IHost on the build line of a tool that builds a board source. The tools run in one
+						thread with nothing to interrupt them, so the interrupt masking does nothing.
+						Only what the board sources built by the tools use is here.
+ *----------------------------------------------------------------------------------------------------*/
+
+/*-----------------------------------------Include Statements-----------------------------------------*/
+#include <stdint.h>
+
+#ifndef STM32L053XX_H
+#define STM32L053XX_H
+
+/*-----------------------------------------Definitions------------------------------------------------*/
+#define __get_PRIMASK()						(0u)
+#define __disable_irq()
+#define __set_PRIMASK(Mask)				((void)(Mask))
+
+#endif
@@ -0,0 +1,312 @@
+/*------------------------------------------------------------------------------------------------------
+ * Name:    NMEA_Parse_Bench.c
+ * Purpose: Host tool, fuzzes NMEA_Parse.c and compares its throughput with atof and atoi
+ * Date: 		10/19/26
+ * Author:	Christopher Jordan - Denny
+ *------------------------------------------------------------------------------------------------------
+ * Note(s): Build with any C compiler from this folder:
+							cc -O2 -I../Intern_Project -o NMEA_Parse_Bench NMEA_Parse_Bench.c
+								../Intern_Project/NMEA_Parse.c
+						Add -fsanitize=address,undefined to have overflow and reads past a field trapped too.
+						Use:	NMEA_Parse_Bench					(exits 1 if a check fails)
+
+						Checks:
+						-------
+						*	Known fields from real sentences
+						*	Random fields of digits, '.', signs and delimiters, every one in a buffer of its
+							own length so a read past the end shows up under the address sanitizer.
+							NMEA_Parse_Fixed has to agree with a 64 bit reference on the characters used and
+							the value, the other parsers have to stay inside the field, leave the output alone
+							when they fail and give a value in range when they don't
+						*	Random values printed the way the module prints them and parsed back exactly
+ *----------------------------------------------------------------------------------------------------*/
+
+/*---------------------------------------------Include Statements-------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <time.h>
+#include "NMEA_Parse.h"
+/*---------------------------------------------Definitions--------------------------------------------*/
+#define FUZZ_ITERATIONS						2000000
+#define ROUND_TRIPS								1000000
+#define BENCH_ITERATIONS					2000000
+#define MAX_FIELD									24
+#define UNTOUCHED									0x5A5A5A5A					// Output before a parse that should fail
+#define IS_DIGIT(c)								(((c) >= '0') && ((c) <= '9'))
+/*---------------------------------------------Globals------------------------------------------------*/
+volatile int32_t		Sink = 0;															/* Keeps the benchmark loops */
+volatile double			Float_Sink = 0;
+/*---------------------------------------------Functions----------------------------------------------*/
+
+/**
+  \fn					unsigned long Random(void)
+  \brief			30 random bits, rand() may only give 15
+*/
+
+static unsigned long Random(void){
+	return(((unsigned long)rand() << 15) ^ (unsigned long)rand());
+}
+
+/**
+  \fn					int Reference_Fixed(const char* Field, int Decimals, int32_t* Value)
+  \brief			NMEA_Parse_Fixed in 64 bits: accepted when the scaled value has at most 9 digits
+*/
+
+static int Reference_Fixed(const char* Field, int Decimals, int32_t* Value){
+	
+	const char* Position = Field;
+	long long Result = 0;
+	int Negative = 0;
+	int Found_Digit = 0;
+	int Fraction_Digits = 0;
+	
+	if((*Position == '-') || (*Position == '+')){
+		Negative = (*Position == '-');
+		Position++;
+	}
+	while(IS_DIGIT(*Position)){
+		if(Result < 1000000000000LL){
+			Result = Result*10 + (*Position - '0');
+		}
+		Found_Digit = 1;
+		Position++;
+	}
+	if(*Position == '.'){
+		Position++;
+		while(IS_DIGIT(*Position)){
+			if(Fraction_Digits < Decimals){
+				if(Result < 1000000000000LL){
+					Result = Result*10 + (*Position - '0');
+				}
+				Fraction_Digits++;
+			}
+			Found_Digit = 1;
+			Position++;
+		}
+	}
+	for(;Fraction_Digits < Decimals;Fraction_Digits++){
+		if(Result < 1000000000000LL){
+			Result *= 10;
+		}
+	}
+	
+	if((Found_Digit == 0) || (Result >= 1000000000LL)){
+		return(0);
+	}
+	
+	*Value = (int32_t)(Negative ? -Result : Result);
+	
+	return((int)(Position - Field));
+}
+
+/**
+  \fn					int Known_Values(void)
+  \brief			A few fields from real sentences and the edges of the digit limit
+	\returns		int: Number of failures
+*/
+
+static int Known_Values(void){
+	
+	int Failures = 0;
+	int32_t Value = 0;
+	uint32_t Time = 0;
+	
+	if((NMEA_Parse_Coordinate("4807.038,N",'N',&Value) != 8) || (Value != 48117300)) Failures++;
+	if((NMEA_Parse_Coordinate("01131.000,E",'W',&Value) != 9) || (Value != -11516667)) Failures++;
+	if((NMEA_Parse_Time("123519.123,",&Time) != 10) || (Time != 123519123)) Failures++;
+	if((NMEA_Parse_Knots("022.4",&Value) != 5) || (Value != 1152)) Failures++;
+	if((NMEA_Parse_Meters("-545.4*",&Value) != 6) || (Value != -54540)) Failures++;
+	if(NMEA_Parse_Fixed("",2,&Value) != 0) Failures++;
+	if(NMEA_Parse_Fixed(".",2,&Value) != 0) Failures++;
+	if((NMEA_Parse_Fixed("999999999",0,&Value) != 9) || (Value != 999999999)) Failures++;
+	if((NMEA_Parse_Fixed("-0000999999999",0,&Value) != 14) || (Value != -999999999)) Failures++;
+	if(NMEA_Parse_Fixed("9999999999",0,&Value) != 0) Failures++;
+	if(NMEA_Parse_Fixed("99999999999999999999",0,&Value) != 0) Failures++;
+	if(NMEA_Parse_Fixed("9999999.99",3,&Value) != 0) Failures++;
+	if(NMEA_Parse_Fixed("99999999",2,&Value) != 0) Failures++;
+	if(NMEA_Parse_Time("256000.000",&Time) != 0) Failures++;
+	
+	return(Failures);
+}
+
+/**
+  \fn					int Fuzz(void)
+  \brief			Random fields through every parser
+	\returns		int: Number of failures
+*/
+
+static int Fuzz(void){
+	
+	const char Alphabet[] = "00123456789999..-+,*NSEW";
+	char* Field = 0;
+	int Failures = 0;
+	int Length = 0;
+	int Used = 0;
+	int Expected_Used = 0;
+	int Decimals = 0;
+	int32_t Value = 0;
+	int32_t Expected = 0;
+	uint32_t Time = 0;
+	long i = 0;
+	int j = 0;
+	
+	for(i = 0;i < FUZZ_ITERATIONS;i++){
+	
+		/* Mostly digits, long enough to run past 9 of them */
+		Length = rand() % MAX_FIELD;
+		Field = malloc((size_t)Length + 1);
+		for(j = 0;j < Length;j++){
+			Field[j] = Alphabet[rand() % (sizeof(Alphabet) - 1)];
+		}
+		Field[Length] = '\0';
+	
+		Decimals = rand() % 9;
+		Value = UNTOUCHED;
+		Expected = UNTOUCHED;
+		Used = NMEA_Parse_Fixed(Field,Decimals,&Value);
+		Expected_Used = Reference_Fixed(Field,Decimals,&Expected);
+		if((Used != Expected_Used) || (Value != Expected)){
+			if(Failures < 5){
+				printf("Fixed \"%s\" %d decimals: %d/%ld, expected %d/%ld\n",Field,Decimals,Used,(long)Value,Expected_Used,(long)Expected);
+			}
+			Failures++;
+		}
+	
+		Value = UNTOUCHED;
+		Used = NMEA_Parse_Coordinate(Field,"NSEW"[rand() % 4],&Value);
+		if((Used > Length) || ((Used == 0) && (Value != UNTOUCHED)) ||
+			((Used != 0) && ((Value > 181000000) || (Value < -181000000)))){
+			Failures++;
+		}
+	
+		Time = UNTOUCHED;
+		Used = NMEA_Parse_Time(Field,&Time);
+		if((Used > Length) || ((Used == 0) && (Time != UNTOUCHED)) || ((Used != 0) && (Time > 235960999))){
+			Failures++;
+		}
+	
+		Value = UNTOUCHED;
+		Used = NMEA_Parse_Knots(Field,&Value);
+		if((Used > Length) || ((Used == 0) && (Value != UNTOUCHED)) ||
+			((Used != 0) && ((Value < 0) || (Value > 514444)))){
+			Failures++;
+		}
+	
+		free(Field);
+	}
+	
+	return(Failures);
+}
+
+/**
+  \fn					int Round_Trips(void)
+  \brief			Values printed like the module prints them have to come back exactly
+	\returns		int: Number of failures
+*/
+
+static int Round_Trips(void){
+	
+	char Field[MAX_FIELD];
+	int Failures = 0;
+	long Degrees = 0;
+	long Minutes = 0;										/* 1e-4 minutes */
+	long Whole = 0;
+	long Hundredths = 0;
+	int32_t Value = 0;
+	int32_t Expected = 0;
+	uint32_t Time = 0;
+	uint32_t Expected_Time = 0;
+	long i = 0;
+	
+	for(i = 0;i < ROUND_TRIPS;i++){
+	
+		/* dddmm.mmmm */
+		Degrees = (long)(Random() % 181);
+		Minutes = (long)(Random() % 600000);
+		sprintf(Field,"%03ld%02ld.%04ld",Degrees,Minutes/10000,Minutes % 10000);
+		Expected = (int32_t)(Degrees*1000000 + (Minutes*100 + 30)/60);
+		if((NMEA_Parse_Coordinate(Field,'W',&Value) != 10) || (Value != -Expected)) Failures++;
+	
+		/* hhmmss.sss */
+		Expected_Time = (uint32_t)((Random() % 24)*10000000 + (Random() % 60)*100000 + (Random() % 60000));
+		sprintf(Field,"%09lu",(unsigned long)Expected_Time);
+		memmove(&Field[7],&Field[6],4);
+		Field[6] = '.';
+		if((NMEA_Parse_Time(Field,&Time) != 10) || (Time != Expected_Time)) Failures++;
+	
+		/* Knots and meters */
+		Whole = (long)(Random() % 10000);
+		Hundredths = (long)(Random() % 100);
+		sprintf(Field,"%ld.%02ld",Whole,Hundredths);
+		Expected = (int32_t)(((Whole*100 + Hundredths)*1286 + 1250)/2500);
+		if((NMEA_Parse_Knots(Field,&Value) != (int)strlen(Field)) || (Value != Expected)) Failures++;
+		sprintf(Field,"-%ld.%ld",Whole,Hundredths/10);
+		if((NMEA_Parse_Meters(Field,&Value) != (int)strlen(Field)) || (Value != -(Whole*100 + (Hundredths/10)*10))) Failures++;
+	}
+	
+	return(Failures);
+}
+
+/**
+  \fn					void Benchmark(void)
+  \brief			The fields of a GGA and RMC pair, fixed point against what the old code called
+*/
+
+static void Benchmark(void){
+	
+	clock_t Start = 0;
+	double Fixed_Ns = 0;
+	double Libc_Ns = 0;
+	int32_t Value = 0;
+	uint32_t Time = 0;
+	long i = 0;
+	
+	Start = clock();
+	for(i = 0;i < BENCH_ITERATIONS;i++){
+		NMEA_Parse_Coordinate("4807.0380",'N',&Value);
+		Sink = Value;
+		NMEA_Parse_Coordinate("01131.0000",'E',&Value);
+		Sink = Value;
+		NMEA_Parse_Knots("022.40",&Value);
+		Sink = Value;
+		NMEA_Parse_Meters("545.4",&Value);
+		Sink = Value;
+		NMEA_Parse_Time("123519.000",&Time);
+		Sink = (int32_t)Time;
+	}
+	Fixed_Ns = (double)(clock() - Start)*1e9/CLOCKS_PER_SEC/BENCH_ITERATIONS;
+	
+	Start = clock();
+	for(i = 0;i < BENCH_ITERATIONS;i++){
+		Float_Sink = atof("4807.0380");
+		Float_Sink = atof("01131.0000");
+		Float_Sink = atof("022.40")*1.15077945;
+		Float_Sink = atof("545.4")*3.28084;
+		Sink = atoi("123519.000");
+	}
+	Libc_Ns = (double)(clock() - Start)*1e9/CLOCKS_PER_SEC/BENCH_ITERATIONS;
+	
+	printf("5 fields of a GGA/RMC pair: fixed point %.0f ns, atof/atoi %.0f ns (%.1fx)\n",Fixed_Ns,Libc_Ns,Libc_Ns/Fixed_Ns);
+}
+
+int main(void){
+	
+	int Known = 0;
+	int Fuzzed = 0;
+	int Trips = 0;
+	
+	srand(28);
+	
+	Known = Known_Values();
+	Fuzzed = Fuzz();
+	Trips = Round_Trips();
+	printf("Known values failures: %d\n",Known);
+	printf("Fuzz failures: %d of %d fields\n",Fuzzed,FUZZ_ITERATIONS);
+	printf("Round trip failures: %d of %d\n",Trips,ROUND_TRIPS);
+	
+	Benchmark();
+	
+	return((Known || Fuzzed || Trips) ? 1 : 0);
+}
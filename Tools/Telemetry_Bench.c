@@ -0,0 +1,689 @@
+/*------------------------------------------------------------------------------------------------------
+ * Name:    Telemetry_Bench.c
+ * Purpose: Host tool, round trips Telemetry.c frames, compares their size with the text packets and
+						measures the delta frame compression
+ * Date: 		10/19/26
+ * Author:	Christopher Jordan - Denny
+ *------------------------------------------------------------------------------------------------------
+ * Note(s): Build with any C compiler from this folder:
+							cc -O2 -I../Intern_Project -o Telemetry_Bench Telemetry_Bench.c ../Intern_Project/Telemetry.c -lm
+						Use:	Telemetry_Bench [flight.csv]		(exits 1 if a check fails)
+
+						Checks:
+						-------
+						*	Records with every field random over its whole range, and event frames, go through
+							Telemetry_Encode and Telemetry_Decode and have to come back unchanged
+						*	Every frame is sent again with 1 to 3 bits flipped, and cut short, and the decoder
+							has to turn every one of them away
+
+						Bytes per frame:
+						----------------
+						*	A simulated flight, sampled every SENSOR_PERIOD ms, is sent as the original text
+							packets (%f sensors and the $GPS packet), as the text packets at two decimals, and
+							as binary record frames
+
+						Compression:
+						------------
+						*	The flight goes through Telemetry_Compress and Telemetry_Decompress at several
+							keyframe intervals, with every channel and with the black box channels only, and
+							with frames dropped at random. Every frame decoded has to match its record to the
+							precision of its field, the rest have to wait for the next keyframe
+						*	The flight is simulated, or read from a recorded flight: one record per line,
+							the Telemetry_Record fields after Sequence in order, comma separated
+							(Timestamp in us,Channels,Latitude,...,RSSI,Link_Level). Lines that don't start with a
+							number are skipped
+						*	Baro altitudes past the 24 bit keyframe field have to come back clamped from both
+							frame types
+ *----------------------------------------------------------------------------------------------------*/
+
+/*---------------------------------------------Include Statements-------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "Telemetry.h"
+/*---------------------------------------------Definitions--------------------------------------------*/
+#define ROUND_TRIPS								200000
+#define SENSOR_PERIOD							10						// ms, Intern_Project.c
+#define GPS_PERIOD								200						// ms between fixes at 5 Hz
+#define FLIGHT_MS									300000				// Simulated: a minute on the pad, up and down
+#define MAX_RECORDS								200000
+#define CSV_FIELDS								25
+#define BARO_ALTITUDE_MAX					8388607				// Telemetry.c
+#define BLACK_BOX_CHANNELS				(TELEMETRY_CHANNEL_IMU | TELEMETRY_CHANNEL_BARO)
+/*---------------------------------------------Tables-------------------------------------------------*/
+/* Field_Channel and Field_Step from Telemetry.c, in Telemetry_Get_Fields order */
+static const unsigned char Field_Channel[TELEMETRY_FIELDS] = {
+	TELEMETRY_CHANNEL_GPS,TELEMETRY_CHANNEL_GPS,TELEMETRY_CHANNEL_GPS,
+	TELEMETRY_CHANNEL_GPS,TELEMETRY_CHANNEL_GPS,TELEMETRY_CHANNEL_GPS,
+	TELEMETRY_CHANNEL_ENV,TELEMETRY_CHANNEL_ENV,
+	TELEMETRY_CHANNEL_IMU,TELEMETRY_CHANNEL_IMU,TELEMETRY_CHANNEL_IMU,
+	TELEMETRY_CHANNEL_IMU,TELEMETRY_CHANNEL_IMU,TELEMETRY_CHANNEL_IMU,
+	TELEMETRY_CHANNEL_IMU,TELEMETRY_CHANNEL_IMU,TELEMETRY_CHANNEL_IMU,
+	TELEMETRY_CHANNEL_BARO,TELEMETRY_CHANNEL_BARO,
+	TELEMETRY_CHANNEL_HEALTH,TELEMETRY_CHANNEL_HEALTH,
+	TELEMETRY_CHANNEL_HEALTH,TELEMETRY_CHANNEL_HEALTH
+};
+static const int Field_Step[TELEMETRY_FIELDS] = {1,1,10,10,1,1,10,50,4,4,4,5,5,5,10,10,10,1,1,1,1,1,1};
+/*---------------------------------------------Globals------------------------------------------------*/
+static Telemetry_Record		Flight[MAX_RECORDS];
+static int								Flight_Records = 0;
+static unsigned long			Flight_Ms = 0;
+/*---------------------------------------------Functions----------------------------------------------*/
+
+/**
+  \fn					unsigned long Random(void)
+  \brief			30 random bits, rand() may only give 15
+*/
+
+static unsigned long Random(void){
+	return(((unsigned long)rand() << 15) ^ (unsigned long)rand());
+}
+
+/**
+  \fn					int32_t Random_Range(long Low, long High)
+  \brief			Random value from Low to High
+*/
+
+static int32_t Random_Range(long Low, long High){
+	return((int32_t)(Low + (long)(Random() % (unsigned long)(High - Low + 1))));
+}
+
+/**
+  \fn					double Noise(double Size)
+  \brief			Roughly normal noise of standard deviation Size
+*/
+
+static double Noise(double Size){
+	return(Size*((double)(rand() % 1001) + (rand() % 1001) + (rand() % 1001) - 1500)/500);
+}
+
+/**
+  \fn					int Same_Record(const Telemetry_Record* A, const Telemetry_Record* B)
+  \brief			Field by field, the struct has padding
+*/
+
+static int Same_Record(const Telemetry_Record* A, const Telemetry_Record* B){
+	
+	int i = 0;
+	
+	if((A->Sequence != B->Sequence) || (A->Timestamp != B->Timestamp) || (A->Channels != B->Channels) ||
+		(A->Latitude != B->Latitude) || (A->Longitude != B->Longitude) || (A->GPS_Altitude != B->GPS_Altitude) ||
+		(A->Ground_Speed != B->Ground_Speed) || (A->GPS_Time != B->GPS_Time) || (A->GPS_Status != B->GPS_Status) ||
+		(A->Temperature != B->Temperature) || (A->Humidity != B->Humidity) || (A->Pressure != B->Pressure) ||
+		(A->Baro_Altitude != B->Baro_Altitude) || (A->Records_Dropped != B->Records_Dropped) ||
+		(A->Link_Failures != B->Link_Failures) || (A->RSSI != B->RSSI) || (A->Link_Level != B->Link_Level)){
+		return(0);
+	}
+	for(i = 0;i < 3;i++){
+		if((A->Acceleration[i] != B->Acceleration[i]) || (A->Gyroscope[i] != B->Gyroscope[i]) ||
+			(A->Magnetic[i] != B->Magnetic[i])){
+			return(0);
+		}
+	}
+	
+	return(1);
+}
+
+/**
+  \fn					void Random_Record(Telemetry_Record* Record)
+  \brief			Every field anywhere in the range the frame carries
+*/
+
+static void Random_Record(Telemetry_Record* Record){
+	
+	int i = 0;
+	
+	memset(Record,0,sizeof(*Record));
+	Record->Timestamp = (uint32_t)Random() ^ ((uint32_t)Random() << 2);
+	Record->Channels = (uint8_t)(rand() % 256);
+	Record->Latitude = Random_Range(-90000000,90000000);
+	Record->Longitude = Random_Range(-180000000,180000000);
+	Record->GPS_Altitude = (int32_t)(Random() ^ (Random() << 2));
+	Record->Ground_Speed = (uint16_t)rand();
+	Record->GPS_Time = (uint32_t)Random_Range(0,235960999);
+	Record->GPS_Status = (uint8_t)rand();
+	Record->Temperature = (int16_t)rand();
+	Record->Humidity = (uint16_t)rand();
+	for(i = 0;i < 3;i++){
+		Record->Acceleration[i] = (int16_t)Random();
+		Record->Gyroscope[i] = (int16_t)Random();
+		Record->Magnetic[i] = (int16_t)Random();
+	}
+	Record->Pressure = (int32_t)(Random() ^ (Random() << 2));
+	Record->Baro_Altitude = Random_Range(-8388608,8388607);
+	Record->Records_Dropped = (uint16_t)Random();
+	Record->Link_Failures = (uint16_t)Random();
+	Record->RSSI = (uint8_t)rand();
+	Record->Link_Level = (uint8_t)rand();
+}
+
+/**
+  \fn					int Damaged_Accepted(const uint8_t* Frame, int Length, int Type)
+  \brief			Flips 1 to 3 bits after the sync, then cuts the frame short
+	\returns		int: Damaged frames the decoder took as good
+*/
+
+static int Damaged_Accepted(const uint8_t* Frame, int Length, int Type){
+	
+	uint8_t Copy[TELEMETRY_MAX_FRAME];
+	Telemetry_Record Record;
+	Telemetry_Event Event;
+	int Accepted = 0;
+	int Bits = 0;
+	int Bit = 0;
+	int i = 0;
+	
+	memcpy(Copy,Frame,Length);
+	Bits = 1 + rand() % 3;
+	for(i = 0;i < Bits;i++){
+		Bit = 16 + rand() % (8*(Length - 2));
+		Copy[Bit/8] ^= (uint8_t)(1 << (Bit % 8));
+	}
+	if(memcmp(Copy,Frame,Length) != 0){
+		if(Type == TELEMETRY_TYPE_RECORD){
+			Accepted += (Telemetry_Decode(Copy,Length,&Record) == TELEMETRY_OK);
+		}
+		else{
+			Accepted += (Telemetry_Decode_Event(Copy,Length,&Event) == TELEMETRY_OK);
+		}
+	}
+	
+	if(Type == TELEMETRY_TYPE_RECORD){
+		Accepted += (Telemetry_Decode(Frame,1 + rand() % (Length - 1),&Record) == TELEMETRY_OK);
+	}
+	else{
+		Accepted += (Telemetry_Decode_Event(Frame,1 + rand() % (Length - 1),&Event) == TELEMETRY_OK);
+	}
+	
+	return(Accepted);
+}
+
+/**
+  \fn					int Round_Trips(void)
+  \brief			Random records and events through the encoder and decoder
+	\returns		int: Number of failures
+*/
+
+static int Round_Trips(void){
+	
+	uint8_t Frame[TELEMETRY_MAX_FRAME];
+	Telemetry_Record Record;
+	Telemetry_Record Decoded;
+	Telemetry_Event Event;
+	Telemetry_Event Event_Decoded;
+	int Failures = 0;
+	int Accepted = 0;
+	int Length = 0;
+	long i = 0;
+	
+	for(i = 0;i < ROUND_TRIPS;i++){
+		Random_Record(&Record);
+		Length = Telemetry_Encode(&Record,Frame);
+		if((Length != TELEMETRY_HEADER_LENGTH + TELEMETRY_RECORD_LENGTH + TELEMETRY_CRC_LENGTH) ||
+			(Telemetry_Decode(Frame,Length,&Decoded) != TELEMETRY_OK) || (Same_Record(&Record,&Decoded) == 0)){
+			Failures++;
+		}
+		Accepted += Damaged_Accepted(Frame,Length,TELEMETRY_TYPE_RECORD);
+	
+		Event.Sequence = (uint8_t)rand();
+		Event.Type = (uint8_t)rand();
+		Event.Timestamp = (uint32_t)Random() ^ ((uint32_t)Random() << 2);
+		Event.Value = (int32_t)(Random() ^ (Random() << 2));
+		Length = Telemetry_Encode_Event(&Event,Frame);
+		if((Telemetry_Decode_Event(Frame,Length,&Event_Decoded) != TELEMETRY_OK) || (Event_Decoded.Sequence != Event.Sequence) ||
+			(Event_Decoded.Type != Event.Type) || (Event_Decoded.Timestamp != Event.Timestamp) || (Event_Decoded.Value != Event.Value)){
+			Failures++;
+		}
+		Accepted += Damaged_Accepted(Frame,Length,TELEMETRY_TYPE_EVENT);
+	}
+	
+	printf("%d records and events: %d did not round trip, %d damaged frames accepted\n",ROUND_TRIPS,Failures,Accepted);
+	
+	return(Failures + Accepted);
+}
+
+/**
+  \fn					void Make_Flight(void)
+  \brief			Pad, a 3 s boost, coast to apogee, then a 20 m/s descent under the chute, with sensor
+							noise and a GPS fix every GPS_PERIOD
+*/
+
+static void Make_Flight(void){
+	
+	Telemetry_Record* Record = 0;
+	double Altitude = 0;									/* m above the pad */
+	double Velocity = 0;									/* m/s */
+	double Acceleration = 0;							/* g along the rocket */
+	double Time = 0;											/* s since the launch */
+	uint32_t Day_Ms = 15*3600000UL + 2*60000UL;
+	int Launched = 0;
+	int Chute = 0;
+	int i = 0;
+	int j = 0;
+	
+	Flight_Records = FLIGHT_MS/SENSOR_PERIOD;
+	Flight_Ms = FLIGHT_MS;
+	for(i = 0;i < Flight_Records;i++){
+		Record = &Flight[i];
+		Time = (double)(i*SENSOR_PERIOD)/1000 - 60;
+	
+		/* 60 s on the pad, then fly */
+		Acceleration = 1;
+		if(Time >= 0){
+			Launched = 1;
+		}
+		if(Launched){
+			if(Time < 3){
+				Acceleration = 11;
+			}
+			else if((Velocity < 0) && (Chute == 0)){
+				Chute = 1;
+			}
+			else if(Chute == 0){
+				Acceleration = 0;
+			}
+			Velocity += (Chute ? 0 : (Acceleration - 1)*9.81*SENSOR_PERIOD/1000);
+			if(Chute){
+				Velocity = -20;
+			}
+			Altitude += Velocity*SENSOR_PERIOD/1000;
+			if(Altitude <= 0){
+				Altitude = 0;
+				Velocity = 0;
+				Launched = Chute ? 0 : Launched;
+			}
+		}
+	
+		Record->Timestamp = (uint32_t)(i*SENSOR_PERIOD*1000UL);
+		Record->Channels = TELEMETRY_CHANNEL_ALL;
+	
+		/* GPS moves at 5 Hz */
+		if((i == 0) || ((i*SENSOR_PERIOD) % GPS_PERIOD) != 0){
+			if(i != 0){
+				Record->Latitude = Flight[i - 1].Latitude;
+				Record->Longitude = Flight[i - 1].Longitude;
+				Record->GPS_Altitude = Flight[i - 1].GPS_Altitude;
+				Record->Ground_Speed = Flight[i - 1].Ground_Speed;
+				Record->GPS_Time = Flight[i - 1].GPS_Time;
+			}
+			else{
+				Record->Latitude = 32990250;
+				Record->Longitude = -106975320;
+			}
+		}
+		else{
+			Record->Latitude = Flight[i - 1].Latitude + (int32_t)Noise(1) + (Launched ? 2 : 0);
+			Record->Longitude = Flight[i - 1].Longitude + (int32_t)Noise(1) + (Launched ? 3 : 0);
+			Record->GPS_Altitude = 136200 + (int32_t)(Altitude*100 + Noise(150));
+			Record->Ground_Speed = (uint16_t)(Launched ? 800 + (int)Noise(50) : (int)fabs(Noise(5)));
+			Record->GPS_Time = (Day_Ms/3600000)*10000000 + (Day_Ms/60000 % 60)*100000 + (Day_Ms % 60000);
+			Day_Ms += GPS_PERIOD;
+		}
+		Record->GPS_Status = TELEMETRY_GPS_VALID | 9;
+	
+		/* Sensors */
+		Record->Temperature = (int16_t)(2540 - Altitude*0.65 + Noise(3));
+		Record->Humidity = (uint16_t)(1850 + Noise(10));
+		Record->Acceleration[0] = (int16_t)Noise(15);
+		Record->Acceleration[1] = (int16_t)Noise(15);
+		Record->Acceleration[2] = (int16_t)(Acceleration*1000 + Noise(15));
+		for(j = 0;j < 3;j++){
+			Record->Gyroscope[j] = (int16_t)(Noise(Launched ? 40 : 3));
+		}
+		Record->Magnetic[0] = (int16_t)(230 + Noise(4));
+		Record->Magnetic[1] = (int16_t)(-45 + Noise(4));
+		Record->Magnetic[2] = (int16_t)(410 + Noise(4));
+		Record->Pressure = (int32_t)(87520*exp(-Altitude/8434.0) + Noise(3));
+		Record->Baro_Altitude = (int32_t)(136200 + Altitude*100 + Noise(30));
+		Record->Records_Dropped = (uint16_t)(i/20000);
+		Record->Link_Failures = (uint16_t)(i/3000);
+		Record->RSSI = (uint8_t)(45 + Altitude/100 + fabs(Noise(2)));
+		Record->Link_Level = (uint8_t)((Altitude > 2000) ? 1 : 0);
+	}
+}
+
+/**
+  \fn					int Checksum(const char* Text)
+  \brief			The old additive checksum
+*/
+
+static int Checksum(const char* Text){
+	
+	int Sum = 0;
+	
+	while(*Text){
+		Sum += *Text++;
+	}
+	
+	return(Sum);
+}
+
+/**
+  \fn					int Text_Bytes(const Telemetry_Record* Record, int Decimals, int New_Fix)
+  \brief			The %sensor packet, and the $GPS packet when the fix is new, the way
+							ISK01A1_Package_Data and FGPMMOPA6H_Package_Data built them
+	\param			int Decimals: 6 for the original %f packets, 2 after the fixed point formatter
+	\param			int New_Fix: A $GPS packet goes out too
+	\returns		int: Bytes sent
+*/
+
+static int Text_Bytes(const Telemetry_Record* Record, int Decimals, int New_Fix){
+	
+	char Temp[256];
+	char Packet[300];
+	int Bytes = 0;
+	long Minutes = 0;
+	
+	sprintf(Temp,"%.*f,%.*f,%.*f,%.*f,%.*f,%.*f,%.*f,%.*f,%.*f",
+		Decimals,Record->Temperature/100.0,Decimals,Record->Humidity/100.0,
+		Decimals,(double)Record->Acceleration[0],Decimals,(double)Record->Acceleration[1],Decimals,(double)Record->Acceleration[2],
+		Decimals,Record->Gyroscope[0]*100.0,Decimals,Record->Gyroscope[1]*100.0,Decimals,Record->Gyroscope[2]*100.0,
+		Decimals,Record->Pressure/100.0);
+	Bytes += sprintf(Packet,"%%%s*%i\r\n",Temp,Checksum(Temp));
+	
+	if(New_Fix){
+		Minutes = (long)((labs(Record->Latitude) % 1000000)*60/100);
+		sprintf(Temp,"%lu:%02lu:%02lu,%02ld%02ld.%04ld,N,",(unsigned long)(Record->GPS_Time/10000000),
+			(unsigned long)(Record->GPS_Time/100000 % 100),(unsigned long)(Record->GPS_Time/1000 % 100),
+			(long)(labs(Record->Latitude)/1000000),Minutes/10000,Minutes % 10000);
+		Minutes = (long)((labs(Record->Longitude) % 1000000)*60/100);
+		sprintf(Temp + strlen(Temp),"%03ld%02ld.%04ld,W,%.*f,%.1f",(long)(labs(Record->Longitude)/1000000),
+			Minutes/10000,Minutes % 10000,Decimals,Record->Ground_Speed*0.02237,Record->GPS_Altitude/100.0);
+		Bytes += sprintf(Packet,"$%s*%i\r\n",Temp,Checksum(Temp));
+	}
+	
+	return(Bytes);
+}
+
+/**
+  \fn					void Frame_Sizes(void)
+  \brief			Bytes per frame of the simulated flight, text against binary
+*/
+
+static void Frame_Sizes(void){
+	
+	uint8_t Frame[TELEMETRY_MAX_FRAME];
+	Telemetry_Record Record;
+	unsigned long Text_F = 0;
+	unsigned long Text_2 = 0;
+	unsigned long Binary = 0;
+	int New_Fix = 0;
+	int i = 0;
+	
+	for(i = 0;i < Flight_Records;i++){
+		New_Fix = (i == 0) || (Flight[i].GPS_Time != Flight[i - 1].GPS_Time);
+		Text_F += Text_Bytes(&Flight[i],6,New_Fix);
+		Text_2 += Text_Bytes(&Flight[i],2,New_Fix);
+		Record = Flight[i];
+		Binary += Telemetry_Encode(&Record,Frame);
+	}
+	
+	printf("%d frames over %lu s                 bytes/frame  bytes/s\n",Flight_Records,Flight_Ms/1000);
+	printf("text packets, %%f                    %11.1f  %7.0f\n",(double)Text_F/Flight_Records,(double)Text_F*1000/Flight_Ms);
+	printf("text packets, two decimals          %11.1f  %7.0f\n",(double)Text_2/Flight_Records,(double)Text_2*1000/Flight_Ms);
+	printf("binary record frames                %11.1f  %7.0f  (every field, GPS each frame)\n",(double)Binary/Flight_Records,(double)Binary*1000/Flight_Ms);
+}
+
+/**
+  \fn					int Load_Flight(const char* Name)
+  \brief			Reads a recorded flight, see the note for the columns
+	\returns		int: Records read, 0 if the file can't be opened or has none
+*/
+
+static int Load_Flight(const char* Name){
+	
+	FILE* File = fopen(Name,"r");
+	char Line[512];
+	char* Position = 0;
+	char* End = 0;
+	long Values[CSV_FIELDS];
+	Telemetry_Record* Record = 0;
+	int Count = 0;
+	int i = 0;
+	
+	if(File == NULL){
+		fprintf(stderr,"Can't open %s\n",Name);
+		return(0);
+	}
+	
+	Flight_Records = 0;
+	while((Flight_Records < MAX_RECORDS) && (fgets(Line,sizeof(Line),File) != NULL)){
+		Position = Line;
+		for(Count = 0;Count < CSV_FIELDS;Count++){
+			Values[Count] = strtol(Position,&End,10);
+			if(End == Position){
+				break;
+			}
+			Position = (*End == ',') ? End + 1 : End;
+		}
+		if(Count != CSV_FIELDS){
+			continue;
+		}
+		
+		Record = &Flight[Flight_Records++];
+		memset(Record,0,sizeof(*Record));
+		Record->Timestamp = (uint32_t)Values[0];
+		Record->Channels = (uint8_t)Values[1];
+		Record->Latitude = (int32_t)Values[2];
+		Record->Longitude = (int32_t)Values[3];
+		Record->GPS_Altitude = (int32_t)Values[4];
+		Record->Ground_Speed = (uint16_t)Values[5];
+		Record->GPS_Time = (uint32_t)Values[6];
+		Record->GPS_Status = (uint8_t)Values[7];
+		Record->Temperature = (int16_t)Values[8];
+		Record->Humidity = (uint16_t)Values[9];
+		for(i = 0;i < 3;i++){
+			Record->Acceleration[i] = (int16_t)Values[10 + i];
+			Record->Gyroscope[i] = (int16_t)Values[13 + i];
+			Record->Magnetic[i] = (int16_t)Values[16 + i];
+		}
+		Record->Pressure = (int32_t)Values[19];
+		Record->Baro_Altitude = (int32_t)Values[20];
+		Record->Records_Dropped = (uint16_t)Values[21];
+		Record->Link_Failures = (uint16_t)Values[22];
+		Record->RSSI = (uint8_t)Values[23];
+		Record->Link_Level = (uint8_t)Values[24];
+	}
+	fclose(File);
+	
+	if(Flight_Records == 0){
+		fprintf(stderr,"No records in %s\n",Name);
+		return(0);
+	}
+	Flight_Ms = (Flight[Flight_Records - 1].Timestamp - Flight[0].Timestamp)/1000 + SENSOR_PERIOD;
+	
+	return(Flight_Records);
+}
+
+/**
+  \fn					void Get_Fields(const Telemetry_Record* Record, long* Fields)
+  \brief			Telemetry_Get_Fields, baro clamped the way the frames carry it
+*/
+
+static void Get_Fields(const Telemetry_Record* Record, long* Fields){
+	
+	int i = 0;
+	
+	Fields[0] = Record->Latitude;
+	Fields[1] = Record->Longitude;
+	Fields[2] = Record->GPS_Altitude;
+	Fields[3] = Record->Ground_Speed;
+	Fields[4] = (long)Record->GPS_Time;
+	Fields[5] = Record->GPS_Status;
+	Fields[6] = Record->Temperature;
+	Fields[7] = Record->Humidity;
+	for(i = 0;i < 3;i++){
+		Fields[8 + i] = Record->Acceleration[i];
+		Fields[11 + i] = Record->Gyroscope[i];
+		Fields[14 + i] = Record->Magnetic[i];
+	}
+	Fields[17] = Record->Pressure;
+	Fields[18] = Record->Baro_Altitude;
+	if(Fields[18] > BARO_ALTITUDE_MAX){
+		Fields[18] = BARO_ALTITUDE_MAX;
+	}
+	if(Fields[18] < -BARO_ALTITUDE_MAX){
+		Fields[18] = -BARO_ALTITUDE_MAX;
+	}
+	Fields[19] = Record->Records_Dropped;
+	Fields[20] = Record->Link_Failures;
+	Fields[21] = Record->RSSI;
+	Fields[22] = Record->Link_Level;
+}
+
+/**
+  \fn					int Close_Enough(const Telemetry_Record* Sent, const Telemetry_Record* Decoded)
+  \brief			Every field of the channels sent is within half its step
+*/
+
+static int Close_Enough(const Telemetry_Record* Sent, const Telemetry_Record* Decoded){
+	
+	long Sent_Fields[TELEMETRY_FIELDS];
+	long Decoded_Fields[TELEMETRY_FIELDS];
+	int i = 0;
+	
+	if((Sent->Sequence != Decoded->Sequence) || (Sent->Timestamp != Decoded->Timestamp)){
+		return(0);
+	}
+	
+	Get_Fields(Sent,Sent_Fields);
+	Get_Fields(Decoded,Decoded_Fields);
+	for(i = 0;i < TELEMETRY_FIELDS;i++){
+		if((Sent->Channels & Field_Channel[i]) && (labs(Sent_Fields[i] - Decoded_Fields[i]) > Field_Step[i]/2)){
+			return(0);
+		}
+	}
+	
+	return(1);
+}
+
+/**
+  \fn					int Compression(int Interval, int Channels, int Loss)
+  \brief			Sends the flight through Telemetry_Compress and decodes what gets through
+	\param			int Channels: Channels sampled, ANDed with each record's own
+	\param			int Loss: Percent of frames dropped
+	\returns		int: Frames decoded wrong
+*/
+
+static int Compression(int Interval, int Channels, int Loss){
+	
+	uint8_t Frame[TELEMETRY_MAX_FRAME];
+	Telemetry_Decoder Decoder;
+	Telemetry_Record Record;
+	Telemetry_Record Decoded;
+	Telemetry_Stats Before = *Telemetry_Get_Stats();
+	Telemetry_Stats* After = 0;
+	long Decoded_Frames = 0;
+	long Waiting = 0;
+	long Wrong = 0;
+	long Sent = 0;
+	int Length = 0;
+	int Result = 0;
+	int i = 0;
+	
+	memset(&Decoder,0,sizeof(Decoder));
+	Telemetry_Set_Keyframe_Interval(Interval);
+	
+	for(i = 0;i < Flight_Records;i++){
+		Record = Flight[i];
+		Record.Channels &= (uint8_t)Channels;
+		Length = Telemetry_Compress(&Record,Frame);
+		if((rand() % 100) < Loss){
+			continue;
+		}
+		Sent++;
+		
+		Result = Telemetry_Decompress(&Decoder,Frame,Length,&Decoded);
+		if(Result == TELEMETRY_ERROR_KEYFRAME){
+			Waiting++;
+		}
+		else if((Result != TELEMETRY_OK) || (Close_Enough(&Record,&Decoded) == 0)){
+			Wrong++;
+		}
+		else{
+			Decoded_Frames++;
+		}
+	}
+	
+	After = Telemetry_Get_Stats();
+	printf("%8d     0x%02X  %4d%%  %11.1f  %5.2f  %6.2f%%  %6.2f%%  %5ld\n",Interval,Channels,Loss,
+		(double)(After->Sent_Bytes - Before.Sent_Bytes)/(After->Frames - Before.Frames),
+		(double)(After->Raw_Bytes - Before.Raw_Bytes)/(After->Sent_Bytes - Before.Sent_Bytes),
+		100.0*Decoded_Frames/Sent,100.0*Waiting/Sent,Wrong);
+	
+	return((int)Wrong);
+}
+
+/**
+  \fn					int Baro_Clamp(void)
+  \brief			Baro altitudes anywhere in 32 bits, keyframes and deltas have to give the clamped value
+	\returns		int: Number of failures
+*/
+
+static int Baro_Clamp(void){
+	
+	uint8_t Frame[TELEMETRY_MAX_FRAME];
+	Telemetry_Decoder Decoder;
+	Telemetry_Record Record;
+	Telemetry_Record Decoded;
+	long Fields[TELEMETRY_FIELDS];
+	int Failures = 0;
+	int Checked = 0;
+	int Length = 0;
+	int i = 0;
+	
+	memset(&Decoder,0,sizeof(Decoder));
+	memset(&Record,0,sizeof(Record));
+	Telemetry_Set_Keyframe_Interval(4);
+	
+	for(i = 0;i < 10000;i++){
+		Record.Channels = TELEMETRY_CHANNEL_BARO;
+		Record.Baro_Altitude = (int32_t)(Random() ^ (Random() << 2));
+		Length = Telemetry_Compress(&Record,Frame);
+		if(Telemetry_Decompress(&Decoder,Frame,Length,&Decoded) == TELEMETRY_OK){
+			Get_Fields(&Record,Fields);
+			if(Decoded.Baro_Altitude != Fields[18]){
+				Failures++;
+			}
+			Checked++;
+		}
+	}
+	
+	printf("%d baro altitudes past 24 bits: %d not clamped\n",Checked,Failures);
+	
+	return(Failures + (Checked == 0));
+}
+
+int main(int argc, char* argv[]){
+	
+	const int Intervals[3] = {10,TELEMETRY_KEYFRAME_INTERVAL,50};
+	int Failures = 0;
+	int i = 0;
+	
+	srand(30);
+	Failures += Round_Trips();
+	Failures += Baro_Clamp();
+	
+	if(argc > 1){
+		if(Load_Flight(argv[1]) == 0){
+			return(1);
+		}
+	}
+	else{
+		Make_Flight();
+	}
+	Frame_Sizes();
+	
+	printf("\ninterval channels   loss  bytes/frame  ratio  decoded  waiting  wrong\n");
+	for(i = 0;i < 3;i++){
+		Failures += Compression(Intervals[i],TELEMETRY_CHANNEL_ALL,0);
+	}
+	Failures += Compression(TELEMETRY_KEYFRAME_INTERVAL,BLACK_BOX_CHANNELS,0);
+	for(i = 0;i < 3;i++){
+		Failures += Compression(Intervals[i],TELEMETRY_CHANNEL_ALL,5);
+		Failures += Compression(Intervals[i],TELEMETRY_CHANNEL_ALL,20);
+	}
+	
+	return(Failures ? 1 : 0);
+}
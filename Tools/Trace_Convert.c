@@ -0,0 +1,284 @@
+/*------------------------------------------------------------------------------------------------------
+ * Name:    Trace_Convert.c
+ * Purpose: Host tool, turns the Trace_Dump packets in a serial monitor log into Chrome trace JSON
+ * Date: 		10/19/26
+ * Author:	Christopher Jordan - Denny
+ *------------------------------------------------------------------------------------------------------
+ * Note(s): Build with any C compiler:	cc -o Trace_Convert Trace_Convert.c
+						Use:	Trace_Convert serial_log.bin > trace.json	(or from stdin)
+						Open trace.json in chrome://tracing or ui.perfetto.dev.
+						*	Text around the packets is skipped, packets with a bad CRC are dropped
+						*	Interrupts get a row each, tasks, pipeline stages and I2C share the main row, so
+							preemption shows as overlap between rows
+						*	Timestamps are unwrapped across the 32 bit microsecond wrap, several captures end up
+							on one timeline
+						*	An end without its begin is dropped, a begin still open at the end of a capture is
+							closed at the capture's last timestamp
+						*	The id list has to match Trace.h
+ *----------------------------------------------------------------------------------------------------*/
+
+/*---------------------------------------------Include Statements-------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+/*---------------------------------------------Definitions--------------------------------------------*/
+#define SYNC_1										'T'
+#define SYNC_2										'R'
+#define RECORD_LENGTH							8
+#define MAX_EVENTS								255
+#define PACKET_LENGTH							(4 + RECORD_LENGTH*MAX_EVENTS + 2)
+
+#define BEGIN_EVENT								0
+#define END_EVENT									1
+#define INSTANT_EVENT							2
+
+/* Trace.h ids */
+#define ID_SYSTICK								0
+#define ID_TIM2										1
+#define ID_GPS_UART								2
+#define ID_XBEE_UART							3
+#define ID_PENDSV									4
+#define ID_I2C_READ								5
+#define ID_I2C_WRITE							6
+#define ID_TASK										7
+#define ID_STAGE									8
+#define ID_STALL									9
+#define ID_SPI_DMA								10
+#define IDS												11
+
+#define MAIN_ROW									0						// Rows 1 to 6 are the interrupts
+#define DMA_ROW										6
+#define ROWS											7
+#define MAX_DEPTH									16
+#define NAME_LENGTH								32
+/*---------------------------------------------Tables-------------------------------------------------*/
+static const char* const Row_Name[ROWS] = {"Main","SysTick","TIM2","USART1 (GPS)","LPUART1 (XBee)","PendSV","SPI DMA"};
+static const char* const Stage_Name[3] = {"Acquire","Encode","Transmit"};
+/*---------------------------------------------Globals------------------------------------------------*/
+char			Open_Name[ROWS][MAX_DEPTH][NAME_LENGTH];					/* Begins waiting for their end */
+int				Depth[ROWS];
+double		Last_Time = 0;																		/* Unwrapped us of the last event */
+unsigned long Last_Raw = 0;
+int				Have_Time = 0;
+int				First_Event = 1;
+/*---------------------------------------------Functions----------------------------------------------*/
+
+/**
+  \fn					unsigned int CRC16(const unsigned char* Data, int Length)
+  \brief			CRC-16/CCITT starting at 0xFFFF, same as Telemetry_CRC16
+*/
+
+unsigned int CRC16(const unsigned char* Data, int Length){
+	
+	unsigned int CRC = 0xFFFF;
+	int i = 0;
+	int Bit = 0;
+	
+	for(i = 0;i < Length;i++){
+		CRC ^= ((unsigned int)Data[i]) << 8;
+		for(Bit = 0;Bit < 8;Bit++){
+			CRC = (CRC & 0x8000) ? ((CRC << 1) ^ 0x1021) : (CRC << 1);
+			CRC &= 0xFFFF;
+		}
+	}
+	
+	return(CRC);
+}
+
+/**
+  \fn					int Row_Of(int Id)
+  \brief			Which timeline row an id belongs on
+*/
+
+int Row_Of(int Id){
+	
+	if(Id <= ID_PENDSV){
+		return(Id + 1);
+	}
+	if(Id == ID_SPI_DMA){
+		return(DMA_ROW);
+	}
+	return(MAIN_ROW);
+}
+
+/**
+  \fn					void Name_Of(int Id, unsigned int Arg, char* Name)
+  \brief			Event name from its id and argument
+*/
+
+void Name_Of(int Id, unsigned int Arg, char* Name){
+	
+	switch(Id){
+		case ID_I2C_READ:
+			sprintf(Name,"I2C read 0x%02X",Arg);
+			break;
+		case ID_I2C_WRITE:
+			sprintf(Name,"I2C write 0x%02X",Arg);
+			break;
+		case ID_TASK:
+			sprintf(Name,"Task %u",Arg);
+			break;
+		case ID_STAGE:
+			sprintf(Name,"%s",(Arg < 3) ? Stage_Name[Arg] : "Stage");
+			break;
+		case ID_STALL:
+			sprintf(Name,"Stall %s",(Arg < 3) ? Stage_Name[Arg] : "");
+			break;
+		case ID_SPI_DMA:
+			sprintf(Name,"%s SPI%u",Row_Name[DMA_ROW],Arg);
+			break;
+		default:
+			if((Id >= 0) && (Id <= ID_PENDSV)){
+				sprintf(Name,"%s",Row_Name[Id + 1]);
+			}
+			else{
+				sprintf(Name,"Id %d",Id);
+			}
+			break;
+	}
+}
+
+/**
+  \fn					void Emit(const char* Name, const char* Phase, double Time, int Row)
+  \brief			Writes one trace event object
+*/
+
+void Emit(const char* Name, const char* Phase, double Time, int Row){
+	
+	printf("%s\n{\"name\":\"%s\",\"ph\":\"%s\",\"ts\":%.0f,\"pid\":1,\"tid\":%d%s}",
+		First_Event ? "" : ",",Name,Phase,Time,Row,(Phase[0] == 'i') ? ",\"s\":\"t\"" : "");
+	First_Event = 0;
+}
+
+/**
+  \fn					double Unwrap(unsigned long Raw)
+  \brief			32 bit microseconds to a timeline that keeps counting up
+*/
+
+double Unwrap(unsigned long Raw){
+	
+	if(Have_Time){
+		Last_Time += (double)((Raw - Last_Raw) & 0xFFFFFFFFUL);
+	}
+	else{
+		Last_Time = (double)Raw;
+		Have_Time = 1;
+	}
+	Last_Raw = Raw;
+	
+	return(Last_Time);
+}
+
+/**
+  \fn					void Convert_Packet(const unsigned char* Packet, int Count)
+  \brief			Writes the events of one packet with a good CRC
+*/
+
+void Convert_Packet(const unsigned char* Packet, int Count){
+	
+	/* Local Variables */
+	const unsigned char* Record;
+	char Name[NAME_LENGTH];
+	unsigned long Raw = 0;
+	double Time = 0;
+	int Type = 0;
+	int Id = 0;
+	int Row = 0;
+	int i = 0;
+	
+	for(i = 0;i < Count;i++){
+		Record = &Packet[4 + i*RECORD_LENGTH];
+		Raw = (unsigned long)Record[0] | ((unsigned long)Record[1] << 8) |
+			((unsigned long)Record[2] << 16) | ((unsigned long)Record[3] << 24);
+		Type = Record[4];
+		Id = Record[5];
+		Name_Of(Id,(unsigned int)(Record[6] | (Record[7] << 8)),Name);
+		Row = Row_Of(Id);
+		Time = Unwrap(Raw);
+		
+		if(Type == BEGIN_EVENT){
+			if(Depth[Row] < MAX_DEPTH){
+				strcpy(Open_Name[Row][Depth[Row]],Name);
+				Depth[Row]++;
+				Emit(Name,"B",Time,Row);
+			}
+		}
+		else if(Type == END_EVENT){
+			if((Depth[Row] > 0) && (strcmp(Open_Name[Row][Depth[Row] - 1],Name) == 0)){
+				Depth[Row]--;
+				Emit(Name,"E",Time,Row);
+			}
+		}
+		else{
+			Emit(Name,"i",Time,Row);
+		}
+	}
+	
+	/* The capture stopped before these ended */
+	for(Row = 0;Row < ROWS;Row++){
+		while(Depth[Row] > 0){
+			Depth[Row]--;
+			Emit(Open_Name[Row][Depth[Row]],"E",Last_Time,Row);
+		}
+	}
+}
+
+int main(int argc, char* argv[]){
+	
+	/* Local Variables */
+	static unsigned char Data[1 << 20];
+	FILE* Input = stdin;
+	long Length = 0;
+	long i = 0;
+	int Count = 0;
+	int Packets = 0;
+	int Bad = 0;
+	int Lost = 0;
+	int Row = 0;
+	
+	if(argc > 1){
+		Input = fopen(argv[1],"rb");
+		if(Input == NULL){
+			fprintf(stderr,"Can't open %s\n",argv[1]);
+			return(1);
+		}
+	}
+	Length = (long)fread(Data,1,sizeof(Data),Input);
+	
+	printf("{\"traceEvents\":[");
+	for(Row = 0;Row < ROWS;Row++){
+		printf("%s\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,\"args\":{\"name\":\"%s\"}}",
+			First_Event ? "" : ",",Row,Row_Name[Row]);
+		First_Event = 0;
+	}
+	
+	while((i + 6) <= Length){
+		if((Data[i] != SYNC_1) || (Data[i + 1] != SYNC_2)){
+			i++;
+			continue;
+		}
+		
+		/* A false sync in the serial monitor text can claim more than is left */
+		Count = Data[i + 2];
+		if((i + 4 + RECORD_LENGTH*Count + 2) > Length){
+			i++;
+			continue;
+		}
+		if(CRC16(&Data[i + 2],2 + RECORD_LENGTH*Count) !=
+			((unsigned int)(Data[i + 4 + RECORD_LENGTH*Count] << 8) | Data[i + 5 + RECORD_LENGTH*Count])){
+			Bad++;
+			i++;
+			continue;
+		}
+		
+		Convert_Packet(&Data[i],Count);
+		Lost += Data[i + 3];
+		Packets++;
+		i += 4 + RECORD_LENGTH*Count + 2;
+	}
+	
+	printf("\n],\"displayTimeUnit\":\"ms\"}\n");
+	fprintf(stderr,"%d captures, %d bad packets, %d events lost to a full ring\n",Packets,Bad,Lost);
+	
+	return(0);
+}